@@ -73,10 +73,9 @@ public:
   int IDX_flood_dir;     ///< Flood current direction (in degrees)
   int IDX_ebb_dir;       ///< Ebb current direction (in degrees)
   int IDX_Useable;       ///< Flag indicating if the entry is usable
-  int Valid15;           ///< Validity flag for 15-minute interval data
-  float Value15;         ///< Value for 15-minute interval data
-  float Dir15;           ///< Direction for 15-minute interval data
-  bool Ret15;            ///< Return flag for 15-minute interval data
+  time_t curve15_start;  ///< Time of the first value in curve15
+  float *curve15;  ///< Values at 15-minute intervals, NAN if not yet computed
+                   ///< (dynamically allocated)
   char *IDX_tzname;      ///< Timezone name (dynamically allocated)
   int IDX_ref_file_num;  ///< Reference file number
   char IDX_reference_name[MAXNAMELEN];  ///< Name of the reference station
@@ -116,6 +115,12 @@ public:
   time_t recent_high_time;  ///< Time of the most recent high tide
   float recent_low_level;   ///< Most recently calculated low tide level
   time_t recent_low_time;   ///< Time of the most recent low tide
+
+  // Range used to correct secondary stations, see time2asecondary()
+  time_t sec_low_time;    ///< Time of the lowest tide around recent times
+  double sec_low_level;   ///< Normalized level at sec_low_time
+  time_t sec_high_time;   ///< Time of the highest tide around recent times
+  double sec_high_level;  ///< Normalized level at sec_high_time
 };
 
 WX_DECLARE_OBJARRAY(IDX_entry, ArrayOfIDXEntry);
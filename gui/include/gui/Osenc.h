@@ -43,6 +43,7 @@
 #include <string.h>
 #include <stdint.h>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -357,6 +358,45 @@ private:
   bool m_ok;
 };
 
+//--------------------------------------------------------------------------
+//      Osenc_instreamMap definition
+//      The whole file mapped to memory, records can be used in place
+//--------------------------------------------------------------------------
+class Osenc_instreamMap : public Osenc_instream {
+public:
+  Osenc_instreamMap();
+  ~Osenc_instreamMap();
+
+  bool Open(const wxString &senc_file_name);
+  void Close();
+
+  Osenc_instream &Read(void *buffer, size_t size);
+  bool IsOk();
+  bool isAvailable();
+  void Shutdown();
+
+  /**
+   * Return pointer to the next size bytes of the file and skip them, or
+   * NULL if the file is too short. The mapping is copy on write, changes
+   * are never written back to the file.
+   */
+  unsigned char *ReadInPlace(size_t size);
+
+  /** Return true if p points into the mapped file. */
+  bool Contains(const void *p) const;
+
+private:
+  void Init();
+
+  unsigned char *m_data;
+  size_t m_size;
+  size_t m_pos;
+  bool m_ok;
+#ifdef __WXMSW__
+  void *m_mapping;  // HANDLE
+#endif
+};
+
 //--------------------------------------------------------------------------
 //      Osenc_outstream definition
 //--------------------------------------------------------------------------
@@ -414,6 +454,12 @@ public:
   int ingest200(const wxString &senc_file_name, S57ObjVector *pObjectVector,
                 VE_ElementVector *pVEArray, VC_ElementVector *pVCArray);
 
+  /**
+   * The file mapping used by last ingest200(), if any. Edge and connected
+   * node points may point into it, check with Contains() before freeing.
+   */
+  std::shared_ptr<Osenc_instreamMap> getSencMap() { return m_senc_map; }
+
   //  SENC creation, by Version desired...
   void SetLODMeters(double meters) { m_LOD_meters = meters; }
   void setRegistrar(S57ClassRegistrar *registrar) { m_poRegistrar = registrar; }
@@ -507,6 +553,10 @@ private:
   std::string GetFeatureAcronymFromTypecode(int typeCode);
   std::string GetAttributeAcronymFromTypecode(int typeCode);
 
+  unsigned char *readPayload(Osenc_instream &stream,
+                             const OSENC_Record_Base &record);
+  float *getPointArray(uint8_t *data, size_t count);
+
   PolyTessGeo *BuildPolyTessGeo(_OSENC_AreaGeometry_Record_Payload *record,
                                 unsigned char **bytes_consumed);
   bool CalculateExtent(S57Reader *poReader, S57ClassRegistrar *poRegistrar);
@@ -548,6 +598,7 @@ private:
 
   unsigned char *pBuffer;
   size_t bufferSize;
+  std::shared_ptr<Osenc_instreamMap> m_senc_map;
 
   Extent m_extent;
 
@@ -26,8 +26,11 @@
 #ifndef __SENCMGR_H__
 #define __SENCMGR_H__
 
+#include <memory>
 #include <vector>
 
+#include "model/thread_pool.h"
+
 // ----------------------------------------------------------------------------
 // Useful Prototypes
 // ----------------------------------------------------------------------------
@@ -41,7 +44,6 @@
 //----------------------------------------------------------------------------
 
 class s57chart;
-class SENCBuildThread;
 
 typedef enum {
   THREAD_INACTIVE = 0,
@@ -74,7 +76,7 @@ public:
   double ref_lat, ref_lon;
   double m_LOD_meters;
 
-  SENCBuildThread *m_thread;
+  std::shared_ptr<ThreadPool::Job> m_job;
 
   SENCThreadStatus m_status;
   EVENTSENCResult m_SENCResult;
@@ -101,7 +103,7 @@ private:
 /**
  * Manager for S57 chart SENC creation threads.
  * Manages the creation of SENC (Simplified Electronic Navigational Chart) files
- * from S57 charts using background threads. Handles scheduling and executing
+ * from S57 charts on the shared ThreadPool. Handles scheduling and executing
  * SENC build jobs.
  */
 class SENCThreadManager : public wxEvtHandler {
@@ -124,12 +126,12 @@ public:
 };
 
 //----------------------------------------------------------------------------
-// s57 Chart Thread based SENC creator
+// s57 Chart SENC creator, run on a ThreadPool worker
 //----------------------------------------------------------------------------
-class SENCBuildThread : public wxThread {
+class SENCBuildJob {
 public:
-  SENCBuildThread(SENCJobTicket *ticket, SENCThreadManager *manager);
-  void *Entry();
+  SENCBuildJob(SENCJobTicket *ticket, SENCThreadManager *manager);
+  void Run();
 
   wxString m_FullPath000;
   wxString m_SENCFileName;
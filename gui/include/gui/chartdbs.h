@@ -26,10 +26,12 @@
 #ifndef __CHARTDBS_H__
 #define __CHARTDBS_H__
 
+#include <climits>
 #include <map>
 #include <memory>
 #include <vector>
 
+#include "model/ll_rtree.h"
 #include "model/ocpn_types.h"
 #include "bbox.h"
 #include "LLRegion.h"
@@ -370,6 +372,21 @@ public:
   wxString GetDBChartFileName(int dbIndex);
   void ApplyGroupArray(ChartGroupArray *pGroupArray);
   bool IsChartAvailable(int dbIndex);
+
+  /**
+   * Find charts whose bounding box contains a position using the spatial
+   * index, a superset of the charts actually covering it.
+   * @param group Chart group index, all charts if <= 0
+   * @param out Filled with database indexes in ascending order.
+   * @param scale_min, scale_max Scale band of returned charts.
+   */
+  void GetChartsAt(double lat, double lon, int group, std::vector<int> &out,
+                   int scale_min = 0, int scale_max = INT_MAX) const;
+
+  /** Like GetChartsAt(), for charts whose bounding box overlaps box. */
+  void GetChartsInBox(const LLBBox &box, int group, std::vector<int> &out,
+                      int scale_min = 0, int scale_max = INT_MAX) const;
+
   ChartTable active_chartTable;
   std::map<wxString, int> active_chartTable_pathindex;
 
@@ -394,6 +411,11 @@ protected:
 private:
   bool IsChartDirUsed(const wxString &theDir);
 
+  /** Rebuild spatial index from scratch after bulk table changes. */
+  void BuildChartIndex();
+  LLRTree<int>::Item GetChartIndexItem(int db_index) const;
+  void FilterChartGroup(int group, std::vector<int> &db_indexes) const;
+
   int SearchDirAndAddCharts(wxString &dir_name_base,
                             ChartClassDescriptor &chart_desc,
                             wxGenericProgressDialog *pprog);
@@ -425,6 +447,9 @@ private:
   int m_nentries;
 
   LLBBox m_dummy_bbox;
+
+  /** Chart bounding boxes keyed by database index. */
+  LLRTree<int> m_chart_index;
 };
 
 //-------------------------------------------------------------------------------------------
@@ -240,6 +240,17 @@ protected:
   virtual int BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
                              int sub_samp);
 
+  /**
+   * Map the bitmap file to memory. Scanlines are then decoded in place
+   * without seeking, reading or copying, and several rows can be decoded
+   * in parallel. If mapping fails, rows are read from ifs_bitmap.
+   */
+  bool MapBitmapFile(const wxString &path);
+  void UnmapBitmapFile();
+
+  /** Free raw line data unless it points into the mapped bitmap file. */
+  void FreeRawLine(unsigned char *pix);
+
   bool GetViewUsingCache(wxRect &source, wxRect &dest, const OCPNRegion &Region,
                          ScaleTypeEnum scale_type);
   bool GetView(wxRect &source, wxRect &dest, ScaleTypeEnum scale_type);
@@ -299,6 +310,12 @@ protected:
   wxInputStream *ifss_bitmap;
   wxBufferedInputStream *ifs_bitmap;
 
+  unsigned char *m_bitmap_map;  // Mapped bitmap file, or NULL
+  size_t m_bitmap_map_size;
+#ifdef __WXMSW__
+  void *m_bitmap_mapping;  // HANDLE
+#endif
+
   wxString *pBitmapFilePath;
 
   unsigned char *ifs_buf;
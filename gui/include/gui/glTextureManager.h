@@ -27,6 +27,10 @@
 #ifndef __GLTEXTUREMANAGER_H__
 #define __GLTEXTUREMANAGER_H__
 
+#include <memory>
+
+#include "model/thread_pool.h"
+
 const wxEventType wxEVT_OCPN_COMPRESSIONTHREAD = wxNewEventType();
 
 class JobTicket;
@@ -46,15 +50,6 @@ public:
   wxString msgx;
 };
 
-class CompressionPoolThread : public wxThread {
-public:
-  CompressionPoolThread(JobTicket *ticket, wxEvtHandler *message_target);
-  void *Entry();
-
-  wxEvtHandler *m_pMessageTarget;
-  JobTicket *m_ticket;
-};
-
 class OCPN_CompressionThreadEvent : public wxEvent {
 public:
   OCPN_CompressionThreadEvent(wxEventType commandType = wxEVT_NULL, int id = 0);
@@ -75,7 +70,6 @@ private:
   JobTicket *m_ticket;
 };
 
-class CompressionPoolThread;
 class JobTicket {
 public:
   JobTicket();
@@ -89,7 +83,8 @@ public:
   int ident;
   bool b_throttle;
 
-  CompressionPoolThread *pthread;
+  wxEvtHandler *m_message_target;          ///< Receives progress and completion
+  std::shared_ptr<ThreadPool::Job> m_job;  ///< Set when running on ThreadPool
   unsigned char *level0_bits;
   unsigned char *comp_bits_array[10];
   wxString m_ChartPath;
@@ -137,6 +132,7 @@ private:
   bool DoJob(JobTicket *pticket);
   bool DoThreadJob(JobTicket *pticket);
   bool StartTopJob();
+  void AbortJob(JobTicket *ticket);
 
   JobList running_list;
   JobList todo_list;
@@ -143,6 +143,16 @@ protected:
   void FlushTiles(void);
   bool RenderTile(SharedTilePtr tile, int zoom_level, const ViewPort& vpoint);
 
+  /**
+   * Request tiles likely to be needed soon from the worker threads: the
+   * ones beyond the screen edge in the direction of motion, and the next
+   * zoom level. They are loaded when no visible tile is waiting.
+   * @param vp Current viewport
+   * @param box Screen bounding box
+   * @param zoom Zoom level currently shown
+   */
+  void PrefetchTiles(const ViewPort& vp, const LLBBox& box, int zoom);
+
   //    Protected Data
 
   float m_lon_max;
@@ -173,7 +183,10 @@ protected:
 
   uint32_t m_tile_count;
   std::unique_ptr<MbtTilesThread> m_worker_thread;
-  std::thread m_thread;
+
+  /// View center at last prefetch, giving the direction of motion
+  double m_prefetch_lat;
+  double m_prefetch_lon;
 
 #ifdef ocpnUSE_GL
   GLShaderProgram* m_tile_shader_program;
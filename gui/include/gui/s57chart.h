@@ -28,6 +28,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include <wx/wx.h>
 #include <wx/dir.h>
@@ -45,6 +46,7 @@
 
 #include "OCPNRegion.h"
 #include "chartbase.h"  // ChartBase
+#include "model/ll_rtree.h"
 
 // ----------------------------------------------------------------------------
 // Useful Prototypes
@@ -97,10 +99,20 @@ class VE_Element;
 class VC_Element;
 class connector_segment;
 class ChartPlugInWrapper;
+class Osenc_instreamMap;
 
 // Declare the Array of S57Obj
 WX_DECLARE_OBJARRAY(S57Obj, ArrayOfS57Obj);
 
+/** s57chart render loop counters, all counting since chart was loaded. */
+struct S57RenderStats {
+  size_t listed;        ///< Objects in the razRules lists walked
+  size_t visited;       ///< Objects returned by the spatial index
+  size_t drawn;         ///< Objects actually rendered by s52plib
+  size_t symbols;       ///< OpenGL raster symbols and soundings drawn
+  size_t symbol_draws;  ///< OpenGL draw calls used for these symbols
+};
+
 /**
  * Represents an S57 format electronic navigational chart in OpenCPN.
  *
@@ -179,6 +191,8 @@ public:
 
   int _insertRules(S57Obj *obj, LUPrec *LUP, s57chart *pOwner);
 
+  const S57RenderStats &GetRenderStats() const { return m_render_stats; }
+
   virtual ListOfObjRazRules *GetObjRuleListAtLatLon(
       float lat, float lon, float select_radius, ViewPort *VPoint,
       int selection_mask = MASK_ALL);
@@ -290,8 +304,32 @@ protected:
   ObjRazRules *razRules[PRIO_NUM][LUPNAME_NUM];
   double m_next_safe_cnt;
 
+  /**
+   * Objects in razRules[prio][type] which may overlap the s52plib view
+   * box, in list order. The result is valid until next invocation.
+   */
+  const std::vector<ObjRazRules *> &GetViewObjects(int prio, int type);
+
 private:
+  /**
+   * Spatial index of one razRules list. Object boxes change while
+   * rendering as s52plib adds symbols and text, and when rescaling point
+   * objects. Margin bounds how far boxes extend outside the indexed ones
+   * until the tree is rebuilt.
+   */
+  struct ObjListIndex {
+    std::vector<ObjRazRules *> objects;     ///< List order, id is the index
+    std::vector<LLRTree<int>::Item> boxes;  ///< Indexed box of each id
+    LLRTree<int> tree;
+    double margin = 0;  ///< Degrees
+    bool stale = true;
+  };
+
+  void BuildObjIndex(ObjListIndex &index, ObjRazRules *list);
+  void UpdateViewMargin();
+
   int GetLineFeaturePointArray(S57Obj *obj, void **ret_array);
+  void FreeSencPoints(float *points);
   void SetSafetyContour(void);
 
   bool DoRenderViewOnDC(wxMemoryDC &dc, const ViewPort &VPoint,
@@ -324,6 +362,8 @@ private:
   OGRFeature *GetChartNextM_COVR(int &catcov);
 
   void FreeObjectsAndRules();
+  /** Drop the texts of all objects from the s52plib declutter list. */
+  void RemoveDeclutterTexts();
   const char *getName(OGRFeature *feature);
 
   bool DoRenderOnGL(const wxGLContext &glc, const ViewPort &VPoint);
@@ -388,10 +428,18 @@ private:
   std::unordered_map<unsigned, VC_Element *> m_vc_hash;
   std::vector<connector_segment *> m_pcs_vector;
   std::vector<VE_Element *> m_pve_vector;
+  /** Mapped SENC file, edge and node points may point into it. */
+  std::shared_ptr<Osenc_instreamMap> m_senc_map;
 
   wxString m_TempFilePath;
   bool m_disableBackgroundSENC;
 
+  ObjListIndex m_obj_index[PRIO_NUM][LUPNAME_NUM];
+  ObjListIndex *m_view_index;  ///< Index of last GetViewObjects() result
+  std::vector<int> m_view_ids;
+  std::vector<ObjRazRules *> m_view_objects;
+  S57RenderStats m_render_stats;
+
 protected:
   sm_parms vp_transform;
 };
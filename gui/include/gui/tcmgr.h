@@ -32,6 +32,8 @@
 
 #include <wx/datetime.h>
 
+#include "bbox.h"
+#include "model/ll_grid_index.h"
 #include "Station_Data.h"
 #include "IDX_entry.h"
 #include "TC_Error_Code.h"
@@ -98,6 +100,14 @@ public:
   bool GetTideOrCurrent(time_t t, int idx, float &value, float &dir);
   bool GetTideOrCurrent15(time_t t, int idx, float &tcvalue, float &dir,
                           bool &bnew_val);
+  /**
+   * Compute count values at times t, t + step, ... into tcvalue and, unless
+   * NULL, dir as many GetTideOrCurrent() calls would. Stations without
+   * offsets are evaluated as one harmonic series instead of one sample at
+   * a time.
+   */
+  bool GetTideOrCurrentSeries(time_t t, int step, int count, int idx,
+                              float *tcvalue, float *dir);
   bool GetTideFlowSens(time_t t, int sch_step, int idx, float &tcvalue_now,
                        float &tcvalue_prev, bool &w_t);
   void GetHightOrLowTide(time_t t, int sch_step_1, int sch_step_2,
@@ -115,8 +125,20 @@ public:
 
   int Get_max_IDX() const { return m_Combined_IDX_array.size() - 1; }
 
+  /**
+   * Return the max_count tide stations closest to xlat, xlon keyed by
+   * distance in NM.
+   */
   std::map<double, const IDX_entry *> GetStationsForLL(double xlat,
-                                                       double xlon) const;
+                                                       double xlon,
+                                                       int max_count) const;
+
+  /**
+   * Return ascending indexes of tide ('T', 't') or current ('C', 'c')
+   * stations for which bbox.ContainsMarge(lat, lon, marge) is true.
+   */
+  std::vector<int> GetStationsInBBox(const LLBBox &bbox, double marge,
+                                     char type) const;
 
   int GetStationIDXbyName(const wxString &prefix, double xlat,
                           double xlon) const;
@@ -126,6 +148,7 @@ public:
 
 private:
   void PurgeData();
+  void BuildStationIndex();
 
   void LoadMRU(void);
   void SaveMRU(void);
@@ -139,6 +162,10 @@ private:
   std::vector<std::string> m_sourcefile_array;
 
   std::vector<IDX_entry *> m_Combined_IDX_array;
+
+  /** Positions of tide and current stations, by m_Combined_IDX_array index */
+  LLGridIndex<int> m_tide_index;
+  LLGridIndex<int> m_current_index;
 };
 
 /* $Id: tcd.h.in 3744 2010-08-17 22:34:46Z flaterco $ */
@@ -31,4 +31,7 @@ WX_DEFINE_OBJARRAY(ArrayOfIDXEntry);
 
 IDX_entry::IDX_entry() { memset(this, 0, sizeof(IDX_entry)); }
 
-IDX_entry::~IDX_entry() { free(IDX_tzname); }
+IDX_entry::~IDX_entry() {
+  free(IDX_tzname);
+  free(curve15);
+}
@@ -748,6 +748,12 @@ void MarkInfoDlg::OnTideStationCombobox(wxCommandEvent& event) {
   int count = m_comboBoxTideStation->GetCount();
   int sel = m_comboBoxTideStation->GetSelection();
   if (sel == count - 1) {
+    if ((int)m_tss.size() < count + TIDESTATION_BATCH_SIZE) {
+      double lat = fromDMM(m_textLatitude->GetValue());
+      double lon = fromDMM(m_textLongitude->GetValue());
+      m_tss =
+          ptcmgr->GetStationsForLL(lat, lon, count + TIDESTATION_BATCH_SIZE);
+    }
     wxString n;
     int i = 0;
     for (auto ts : m_tss) {
@@ -772,7 +778,7 @@ void MarkInfoDlg::OnNotebookPageChanged(wxNotebookEvent& event) {
     m_lasttspos = m_textLatitude->GetValue() + m_textLongitude->GetValue();
     double lat = fromDMM(m_textLatitude->GetValue());
     double lon = fromDMM(m_textLongitude->GetValue());
-    m_tss = ptcmgr->GetStationsForLL(lat, lon);
+    m_tss = ptcmgr->GetStationsForLL(lat, lon, TIDESTATION_BATCH_SIZE);
     wxString s = m_comboBoxTideStation->GetStringSelection();
     wxString n;
     int i = 0;
@@ -32,6 +32,15 @@
 
 #include <setjmp.h>
 
+#ifdef __WXMSW__
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <wx/wfstream.h>
 #include <wx/filename.h>
 #include <wx/progdlg.h>
@@ -139,6 +148,101 @@ void Osenc_instreamFile::Init() {
   m_ok = false;
 }
 
+//--------------------------------------------------------------------------
+//      Osenc_instreamMap implementation
+//      The whole file mapped to memory, records can be used in place
+//--------------------------------------------------------------------------
+Osenc_instreamMap::Osenc_instreamMap() { Init(); }
+
+Osenc_instreamMap::~Osenc_instreamMap() { Close(); }
+
+bool Osenc_instreamMap::Open(const wxString &senc_file_name) {
+  Close();
+#ifdef __WXMSW__
+  HANDLE file = CreateFileW(senc_file_name.wc_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER size;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+    m_mapping = CreateFileMappingW(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (m_mapping) {
+      m_data = (unsigned char *)MapViewOfFile(m_mapping, FILE_MAP_COPY, 0, 0,
+                                              0);
+      m_size = static_cast<size_t>(size.QuadPart);
+    }
+  }
+  CloseHandle(file);
+#else
+  int fd = open(senc_file_name.fn_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void *data = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      fd, 0);
+    if (data != MAP_FAILED) {
+      m_data = (unsigned char *)data;
+      m_size = st.st_size;
+      madvise(data, st.st_size, MADV_SEQUENTIAL);
+    }
+  }
+  close(fd);
+#endif
+  if (!m_data) {
+    Close();
+    return false;
+  }
+  m_ok = true;
+  return true;
+}
+
+void Osenc_instreamMap::Close() {
+#ifdef __WXMSW__
+  if (m_data) UnmapViewOfFile(m_data);
+  if (m_mapping) CloseHandle(m_mapping);
+#else
+  if (m_data) munmap(m_data, m_size);
+#endif
+  Init();
+}
+
+Osenc_instream &Osenc_instreamMap::Read(void *buffer, size_t size) {
+  unsigned char *data = ReadInPlace(size);
+  if (data) memcpy(buffer, data, size);
+  return *this;
+}
+
+unsigned char *Osenc_instreamMap::ReadInPlace(size_t size) {
+  if (!m_ok || size > m_size - m_pos) {
+    m_ok = false;
+    return NULL;
+  }
+  unsigned char *data = m_data + m_pos;
+  m_pos += size;
+  return data;
+}
+
+bool Osenc_instreamMap::Contains(const void *p) const {
+  const unsigned char *c = (const unsigned char *)p;
+  return m_data && c >= m_data && c < m_data + m_size;
+}
+
+bool Osenc_instreamMap::IsOk() { return m_ok; }
+
+bool Osenc_instreamMap::isAvailable() { return true; }
+
+void Osenc_instreamMap::Shutdown() {}
+
+void Osenc_instreamMap::Init() {
+  m_data = NULL;
+  m_size = 0;
+  m_pos = 0;
+  m_ok = false;
+#ifdef __WXMSW__
+  m_mapping = NULL;
+#endif
+}
+
 //--------------------------------------------------------------------------
 //      Osenc_outstreamFile implementation
 //      A simple file stream implementation based on wxFFileOutStream
@@ -536,10 +640,17 @@ int Osenc::ingest200(const wxString &senc_file_name,
   //     }
   //     wxBufferedInputStream fpx( fpx_u );
 
-  //    Sanity check for existence of file
-  Osenc_instreamFile fpx;
-  fpx.Open(senc_file_name);
-  if (!fpx.IsOk()) return ERROR_SENCFILE_NOT_FOUND;
+  //    Map the file, so that records are used in place. If that fails,
+  //    read them one by one into the persistent buffer.
+  m_senc_map = std::make_shared<Osenc_instreamMap>();
+  Osenc_instreamFile fpf;
+  Osenc_instream *fpx = m_senc_map.get();
+  if (!m_senc_map->Open(senc_file_name)) {
+    m_senc_map.reset();
+    fpf.Open(senc_file_name);
+    fpx = &fpf;
+  }
+  if (!fpx->IsOk()) return ERROR_SENCFILE_NOT_FOUND;
 
   S57Obj *obj = 0;
   int featureID;
@@ -552,8 +663,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
 
     //        long off = fpx.TellI();
 
-    fpx.Read(&record, sizeof(OSENC_Record_Base));
-    if (!fpx.IsOk()) {
+    fpx->Read(&record, sizeof(OSENC_Record_Base));
+    if (!fpx->IsOk()) {
       dun = 1;
       break;
     }
@@ -561,10 +672,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
     // Process Records
     switch (record.record_type) {
       case HEADER_SENC_VERSION: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -573,10 +682,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
         break;
       }
       case HEADER_CELL_NAME: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -584,10 +691,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
         break;
       }
       case HEADER_CELL_PUBLISHDATE: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -596,10 +701,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case HEADER_CELL_EDITION: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -610,10 +713,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case HEADER_CELL_UPDATEDATE: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -622,10 +723,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case HEADER_CELL_UPDATE: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -636,10 +735,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case HEADER_CELL_NATIVESCALE: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -649,10 +746,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case HEADER_CELL_SENCCREATEDATE: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -660,10 +755,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case CELL_EXTENT_RECORD: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -683,10 +776,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case CELL_COVR_RECORD: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -695,10 +786,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case CELL_NOCOVR_RECORD: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -707,10 +796,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case FEATURE_ID_RECORD: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -747,10 +834,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case FEATURE_ATTRIBUTE_RECORD: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -823,10 +908,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case FEATURE_GEOMETRY_RECORD_POINT: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -844,10 +927,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case FEATURE_GEOMETRY_RECORD_AREA: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -887,10 +968,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case FEATURE_GEOMETRY_RECORD_LINE: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -920,10 +999,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case FEATURE_GEOMETRY_RECORD_MULTIPOINT: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -950,10 +1027,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case VECTOR_EDGE_NODE_TABLE_RECORD: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -974,10 +1049,7 @@ int Osenc::ingest200(const wxString &senc_file_name,
           pRun += sizeof(int);
 
           float *pPoints = NULL;
-          if (pointCount) {
-            pPoints = (float *)malloc(pointCount * 2 * sizeof(float));
-            memcpy(pPoints, pRun, pointCount * 2 * sizeof(float));
-          }
+          if (pointCount) pPoints = getPointArray(pRun, pointCount * 2);
           pRun += pointCount * 2 * sizeof(float);
 
           VE_Element *pvee = new VE_Element;
@@ -993,10 +1065,8 @@ int Osenc::ingest200(const wxString &senc_file_name,
       }
 
       case VECTOR_CONNECTED_NODE_TABLE_RECORD: {
-        unsigned char *buf =
-            getBuffer(record.record_length - sizeof(OSENC_Record_Base));
-        if (!fpx.Read(buf, record.record_length - sizeof(OSENC_Record_Base))
-                 .IsOk()) {
+        unsigned char *buf = readPayload(*fpx, record);
+        if (!buf) {
           dun = 1;
           break;
         }
@@ -1012,8 +1082,7 @@ int Osenc::ingest200(const wxString &senc_file_name,
           int featureIndex = *(int *)pRun;
           pRun += sizeof(int);
 
-          float *pPoint = (float *)malloc(2 * sizeof(float));
-          memcpy(pPoint, pRun, 2 * sizeof(float));
+          float *pPoint = getPointArray(pRun, 2);
           pRun += 2 * sizeof(float);
 
           VC_Element *pvce = new VC_Element;
@@ -1035,6 +1104,33 @@ int Osenc::ingest200(const wxString &senc_file_name,
   return ret_val;
 }
 
+/**
+ * Return the payload of record just read from stream, in place if the
+ * file is mapped, else in the persistent buffer. NULL on errors.
+ */
+unsigned char *Osenc::readPayload(Osenc_instream &stream,
+                                  const OSENC_Record_Base &record) {
+  if (record.record_length < sizeof(OSENC_Record_Base)) return NULL;
+  size_t size = record.record_length - sizeof(OSENC_Record_Base);
+  if (m_senc_map) return m_senc_map->ReadInPlace(size);
+
+  unsigned char *buf = getBuffer(size);
+  if (!stream.Read(buf, size).IsOk()) return NULL;
+  return buf;
+}
+
+/**
+ * Return count floats at data, in place if data is in the file mapping
+ * and suitably aligned, else a copy to be free()'d.
+ */
+float *Osenc::getPointArray(uint8_t *data, size_t count) {
+  if (m_senc_map && reinterpret_cast<uintptr_t>(data) % alignof(float) == 0)
+    return (float *)data;
+  float *points = (float *)malloc(count * sizeof(float));
+  memcpy(points, data, count * sizeof(float));
+  return points;
+}
+
 int Osenc::ingestCell(OGRS57DataSource *poS57DS, const wxString &FullPath000,
                       const wxString &working_dir) {
   //      Analyze Updates
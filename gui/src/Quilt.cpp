@@ -1367,25 +1367,22 @@ bool Quilt::BuildExtendedChartStackAndCandidateArray(int ref_db_index,
     //             }
   }
 
-  //    Search the entire database, potentially adding all charts
+  //    Search the database, potentially adding all charts in the group
   //    which intersect the ViewPort in any way
   //    .AND. other requirements.
   //    Again, skipping cm93 for now
-  int n_all_charts = ChartData->GetChartTableEntries();
-
   LLBBox viewbox = vp_local.GetBBox();
   int sure_index = -1;
   int sure_index_scale = 0;
   int sure_index_type = -1;
 
-  for (int i = 0; i < n_all_charts; i++) {
+  std::vector<int> view_charts;
+  ChartData->GetChartsInBox(viewbox, m_parent->m_groupIndex, view_charts);
+
+  for (int i : view_charts) {
     //    We can eliminate some charts immediately
     //    Try to make these tests in some sensible order....
 
-    int groupIndex = m_parent->m_groupIndex;
-    if ((groupIndex > 0) && (!ChartData->IsChartInGroup(i, groupIndex)))
-      continue;
-
     const ChartTableEntry &cte = ChartData->GetChartTableEntry(i);
 
     if (cte.GetChartType() == CHART_TYPE_CM93COMP)
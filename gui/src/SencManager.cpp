@@ -142,11 +142,10 @@ void SENCThreadManager::StartTopJob() {
       // printf("Starting job:  %s\n", (const
       // char*)startCandidate->m_FullPath000.mb_str());
 
-      SENCBuildThread *thread = new SENCBuildThread(startCandidate, this);
-      startCandidate->m_thread = thread;
+      SENCBuildJob job(startCandidate, this);
       startCandidate->m_status = THREAD_STARTED;
-      thread->SetPriority(20);
-      thread->Run();
+      startCandidate->m_job = ThreadPool::GetInstance().Submit(
+          [job]() mutable { job.Run(); }, ThreadPool::Lane::kVisible);
       nRunning++;
     }
   }
@@ -251,20 +250,18 @@ void SENCThreadManager::OnEvtThread(OCPN_BUILDSENC_ThreadEvent &event) {
 }
 
 //----------------------------------------------------------------------------------
-//      SENCBuildThread Implementation
+//      SENCBuildJob Implementation
 //----------------------------------------------------------------------------------
 
-SENCBuildThread::SENCBuildThread(SENCJobTicket *ticket,
-                                 SENCThreadManager *manager) {
+SENCBuildJob::SENCBuildJob(SENCJobTicket *ticket, SENCThreadManager *manager) {
   m_FullPath000 = ticket->m_FullPath000;
   m_SENCFileName = ticket->m_SENCFileName;
+  m_chart = ticket->m_chart;
   m_manager = manager;
   m_ticket = ticket;
-
-  Create();
 }
 
-void *SENCBuildThread::Entry() {
+void SENCBuildJob::Run() {
   // #ifdef __MSVC__
   //   _set_se_translator(my_translate);
 
@@ -309,7 +306,7 @@ void *SENCBuildThread::Entry() {
     // else
     //  return ret;
 
-    return 0;
+    return;
   }  // try
 
   // #ifdef __MSVC__
@@ -324,7 +321,7 @@ void *SENCBuildThread::Entry() {
       //             m_manager->QueueEvent(Nevent.Clone());
     }
 
-    return 0;
+    return;
   }
   // #endif
 }
@@ -171,7 +171,7 @@ TC_Error_Code TCDS_Ascii_Harmonic::init_index_file() {
         pIDX->pDataSource = NULL;
 
         index_in_memory = TRUE;
-        pIDX->Valid15 = 0;
+        pIDX->curve15 = NULL;
 
         if (TC_NO_ERROR != build_IDX_entry(pIDX)) {
         }
@@ -379,7 +379,7 @@ TC_Error_Code TCDS_Binary_Harmonic::LoadData(const wxString &data_file_path) {
     pIDX->source_data_type = SOURCE_TYPE_BINARY_HARMONIC;
     pIDX->pDataSource = NULL;
 
-    pIDX->Valid15 = 0;
+    pIDX->curve15 = NULL;
 
     pIDX->pref_sta_data = NULL;  // no reference data yet
     pIDX->IDX_Useable = 1;       // but assume data is OK
@@ -619,7 +619,7 @@ void TCWin::OnPaint(wxPaintEvent &event) {
     //    Build the array of values, capturing max and min and HW/LW list
 
     if (!btc_valid) {
-      float dir;
+      float dir[26];
       tcmax = -10;
       tcmin = 10;
       float val = -100;
@@ -640,10 +640,11 @@ void TCWin::OnPaint(wxPaintEvent &event) {
       ptcmgr->GetTideFlowSens(tt_localtz, BACKWARD_TEN_MINUTES_STEP,
                               pIDX->IDX_rec_num, tcv[0], val, wt);
 
+      ptcmgr->GetTideOrCurrentSeries(tt_localtz, FORWARD_ONE_HOUR_STEP, 26,
+                                     pIDX->IDX_rec_num, tcv, dir);
       for (i = 0; i < 26; i++) {
         int tt = tt_localtz + (i * FORWARD_ONE_HOUR_STEP);
 
-        ptcmgr->GetTideOrCurrent(tt, pIDX->IDX_rec_num, tcv[i], dir);
         tt_tcv[i] = tt;  // store the corresponding time_t value
         if (tcv[i] > tcmax) tcmax = tcv[i];
 
@@ -697,7 +698,7 @@ void TCWin::OnPaint(wxPaintEvent &event) {
           s.Append(s1);
           Station_Data *pmsd = pIDX->pref_sta_data;  // write unit
           if (pmsd) s.Append(wxString(pmsd->units_abbrv, wxConvUTF8));
-          s1.Printf(_T("  %03.0f"), dir);  // write direction
+          s1.Printf(_T("  %03.0f"), dir[i]);  // write direction
           s.Append(s1);
 
           wxListItem li;
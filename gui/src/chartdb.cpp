@@ -465,24 +465,14 @@ int ChartDB::BuildChartStack(ChartStack *cstk, float lat, float lon,
 
   if (!cstk) return 0;  // Chartstack not ready yet
 
-  int nEntry = GetChartTableEntries();
+  //    Only charts in the active group with a bounding box containing the
+  //    position are candidates
+  std::vector<int> candidates;
+  GetChartsAt(lat, lon, groupIndex, candidates);
 
-  for (int db_index = 0; db_index < nEntry; db_index++) {
+  for (int db_index : candidates) {
     const ChartTableEntry &cte = GetChartTableEntry(db_index);
 
-    //    Check to see if the candidate chart is in the currently active group
-    bool b_group_add = false;
-    if (groupIndex > 0) {
-      const int ng = cte.GetGroupArray().size();
-      for (int ig = 0; ig < ng; ig++) {
-        if (groupIndex == cte.GetGroupArray()[ig]) {
-          b_group_add = true;
-          break;
-        }
-      }
-    } else
-      b_group_add = true;
-
     bool b_writable_add = true;
     //  On android, SDK > 29, we require that the directory of charts be
     //  "writable" as determined by Android Java file system
@@ -492,7 +482,7 @@ int ChartDB::BuildChartStack(ChartStack *cstk, float lat, float lon,
 #endif
 
     bool b_pos_add = false;
-    if (b_group_add && b_writable_add) {
+    if (b_writable_add) {
       //  Plugin loading is deferred, so the chart may have been disabled
       //  elsewhere. Tentatively reenable the chart so that it appears in the
       //  piano. It will get disabled later if really not useable
@@ -520,7 +510,7 @@ int ChartDB::BuildChartStack(ChartStack *cstk, float lat, float lon,
 
     bool b_available = true;
     //  Verify PlugIn charts are actually available
-    if (b_group_add && b_pos_add && (cte.GetChartType() == CHART_TYPE_PLUGIN)) {
+    if (b_pos_add && (cte.GetChartType() == CHART_TYPE_PLUGIN)) {
       ChartTableEntry *pcte = (ChartTableEntry *)&cte;
       if (!IsChartAvailable(db_index)) {
         pcte->SetAvailable(false);
@@ -531,7 +521,7 @@ int ChartDB::BuildChartStack(ChartStack *cstk, float lat, float lon,
       }
     }
 
-    if (b_group_add && b_pos_add && b_available) {  // add it
+    if (b_pos_add && b_available) {  // add it
       j++;
       cstk->nEntry = j;
       cstk->SetDBIndex(j - 1, db_index);
@@ -23,6 +23,8 @@
  *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
  **************************************************************************/
 
+#include <algorithm>
+
 #include <wx/wxprec.h>
 
 #ifndef WX_PRECOMP
@@ -1221,11 +1223,13 @@ bool ChartDatabase::Read(const wxString &filePath) {
   bValid = true;
   entry.SetAvailable(true);
 
+  BuildChartIndex();
   m_nentries = active_chartTable.GetCount();
   return true;
 
 read_error:
   bValid = false;
+  BuildChartIndex();
   m_nentries = active_chartTable.GetCount();
   return false;
 }
@@ -1583,6 +1587,7 @@ bool ChartDatabase::Update(ArrayOfCDI &dir_array, bool bForce,
     active_chartTable[i].SetEntryOffset(i);
   }
 
+  BuildChartIndex();
   m_nentries = active_chartTable.GetCount();
 
   bValid = true;
@@ -2402,17 +2407,30 @@ bool ChartDatabase::AddSingleChart(wxString &ChartFullPath,
   bool b_recurse = true;
   if (!b_force_full_search) b_recurse = IsChartDirUsed(dir_name);
 
+  unsigned int n_old = active_chartTable.GetCount();
   bool rv = AddChart(ChartFullPath, desc, NULL, 0, b_recurse);
 
   //  remove duplicates marked in AddChart()
 
+  bool b_removed = false;
   for (unsigned int i = 0; i < active_chartTable.GetCount(); i++) {
     if (!active_chartTable[i].GetbValid()) {
       active_chartTable.RemoveAt(i);
+      if (i < n_old) n_old--;
+      b_removed = true;
       i--;  // entry is gone, recheck this index for next entry
     }
   }
 
+  //  Index the new chart. If an old one was replaced the indexes have
+  //  shifted, rebuild.
+  if (b_removed) {
+    BuildChartIndex();
+  } else {
+    for (unsigned int i = n_old; i < active_chartTable.GetCount(); i++)
+      m_chart_index.Insert(GetChartIndexItem(i));
+  }
+
   //    Update the Entry index fields
   for (unsigned int i = 0; i < active_chartTable.GetCount(); i++)
     active_chartTable[i].SetEntryOffset(i);
@@ -2470,6 +2488,11 @@ bool ChartDatabase::RemoveSingleChart(wxString &ChartFullPath) {
   for (unsigned int i = 0; i < active_chartTable.GetCount(); i++) {
     if (ChartFullPath.IsSameAs(GetChartTableEntry(i).GetFullSystemPath())) {
       active_chartTable.RemoveAt(i);
+      const int removed = i;
+      m_chart_index.Remove(removed);
+      m_chart_index.RenumberIds([removed](int db_index) {
+        return db_index > removed ? db_index - 1 : db_index;
+      });
       break;
     }
   }
@@ -2781,6 +2804,78 @@ bool ChartDatabase::IsChartAvailable(int dbIndex) {
   return false;
 }
 
+LLRTree<int>::Item ChartDatabase::GetChartIndexItem(int db_index) const {
+  const ChartTableEntry &cte = GetChartTableEntry(db_index);
+
+  //  Index the enabled extent, see ChartTableEntry::Disable()
+  float lat_min = cte.GetLatMin();
+  float lat_max = cte.GetLatMax();
+  if (lat_max > 90.) {
+    lat_min -= (float)1000.;
+    lat_max -= (float)1000.;
+  }
+  LLRTree<int>::Item item{db_index,         lat_min,         lat_max,
+                          cte.GetLonMin(), cte.GetLonMax(), cte.GetScale()};
+
+  //  Callers test either these values or the LLBBox, cover both
+  const LLBBox &box = cte.GetBBox();
+  if (box.GetValid()) {
+    item.lat_min = wxMin(item.lat_min, (float)box.GetMinLat());
+    item.lat_max = wxMax(item.lat_max, (float)box.GetMaxLat());
+    item.lon_min = wxMin(item.lon_min, (float)box.GetMinLon());
+    item.lon_max = wxMax(item.lon_max, (float)box.GetMaxLon());
+  }
+
+  //  The cm93 composite chart is always a candidate, whatever its extent
+  if (cte.GetChartType() == CHART_TYPE_CM93COMP) {
+    item.lat_min = -90.;
+    item.lat_max = 90.;
+    item.lon_min = -360.;
+    item.lon_max = 360.;
+  }
+  return item;
+}
+
+void ChartDatabase::BuildChartIndex() {
+  std::vector<LLRTree<int>::Item> items;
+  items.reserve(active_chartTable.GetCount());
+  for (unsigned int i = 0; i < active_chartTable.GetCount(); i++)
+    items.push_back(GetChartIndexItem(i));
+  m_chart_index.Build(std::move(items));
+}
+
+void ChartDatabase::FilterChartGroup(int group,
+                                     std::vector<int> &db_indexes) const {
+  std::sort(db_indexes.begin(), db_indexes.end());
+  if (group <= 0) return;
+  auto not_in_group = [&](int db_index) {
+    const std::vector<int> &groups =
+        GetChartTableEntry(db_index).GetGroupArray();
+    return std::find(groups.begin(), groups.end(), group) == groups.end();
+  };
+  db_indexes.erase(
+      std::remove_if(db_indexes.begin(), db_indexes.end(), not_in_group),
+      db_indexes.end());
+}
+
+void ChartDatabase::GetChartsAt(double lat, double lon, int group,
+                                std::vector<int> &out, int scale_min,
+                                int scale_max) const {
+  out.clear();
+  m_chart_index.QueryPoint(lat, lon, out, scale_min, scale_max);
+  FilterChartGroup(group, out);
+}
+
+void ChartDatabase::GetChartsInBox(const LLBBox &box, int group,
+                                   std::vector<int> &out, int scale_min,
+                                   int scale_max) const {
+  out.clear();
+  if (!box.GetValid()) return;
+  m_chart_index.Query(box.GetMinLat(), box.GetMaxLat(), box.GetMinLon(),
+                      box.GetMaxLon(), out, scale_min, scale_max);
+  FilterChartGroup(group, out);
+}
+
 void ChartDatabase::ApplyGroupArray(ChartGroupArray *pGroupArray) {
   wxString separator(wxFileName::GetPathSeparator());
 
@@ -34,6 +34,7 @@
 // ----------------------------------------------------------------------------
 
 #include <assert.h>
+#include <algorithm>
 
 // For compilers that support precompilation, includes "wx.h".
 #include <wx/wxprec.h>
@@ -52,10 +53,19 @@
 #include <wx/fileconf.h>
 #include <sys/stat.h>
 
+#ifdef __WXMSW__
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include "config.h"
 #include "chartimg.h"
 #include "ocpn_pixel.h"
 #include "model/chartdata_input_stream.h"
+#include "model/thread_pool.h"
 
 #ifndef __WXMSW__
 #include <signal.h>
@@ -566,6 +576,7 @@ InitReturn ChartGEO::Init(const wxString &name, ChartInitFlag init_flags) {
   ifss_bitmap =
       new wxFFileInputStream(*pBitmapFilePath);  // open the bitmap file
   ifs_bitmap = new wxBufferedInputStream(*ifss_bitmap);
+  MapBitmapFile(*pBitmapFilePath);
 
   if (!ifss_bitmap->IsOk()) {
     free(pPlyTable);
@@ -1376,12 +1387,12 @@ InitReturn ChartKAP::Init(const wxString &name, ChartInitFlag init_flags) {
         m_nCOVREntries = covrRegion.contours.size();
         m_pCOVRTablePoints = (int *)malloc(m_nCOVREntries * sizeof(int));
         m_pCOVRTable = (float **)malloc(m_nCOVREntries * sizeof(float *));
-        std::list<poly_contour>::iterator it = covrRegion.contours.begin();
+        std::vector<poly_contour>::iterator it = covrRegion.contours.begin();
         for (int i = 0; i < m_nCOVREntries; i++) {
           m_pCOVRTablePoints[i] = it->size();
           m_pCOVRTable[i] =
               (float *)malloc(m_pCOVRTablePoints[i] * 2 * sizeof(float));
-          std::list<contour_pt>::iterator jt = it->begin();
+          poly_contour::iterator jt = it->begin();
           for (int j = 0; j < m_pCOVRTablePoints[i]; j++) {
             m_pCOVRTable[i][2 * j + 0] = jt->y;
             m_pCOVRTable[i][2 * j + 1] = jt->x;
@@ -1511,6 +1522,7 @@ InitReturn ChartKAP::Init(const wxString &name, ChartInitFlag init_flags) {
 
   ifss_bitmap = stream;
   ifs_bitmap = new wxBufferedInputStream(*ifss_bitmap);
+  MapBitmapFile(tempfile.empty() ? name : tempfile);
 
   //    Perform common post-init actions in ChartBaseBSB
   InitReturn pi_ret = PostInit();
@@ -1560,6 +1572,12 @@ ChartBaseBSB::ChartBaseBSB() {
   ifss_bitmap = NULL;
   ifs_hdr = NULL;
 
+  m_bitmap_map = NULL;
+  m_bitmap_map_size = 0;
+#ifdef __WXMSW__
+  m_bitmap_mapping = NULL;
+#endif
+
   for (int i = 0; i < N_BSB_COLORS; i++) pPalettes[i] = NULL;
 
   bGeoErrorSent = false;
@@ -1616,9 +1634,10 @@ ChartBaseBSB::~ChartBaseBSB() {
     free(cPoints.wpy);
   }
 
-  //    Free the line cache
+  //    Free the line cache, before unmapping the raw lines it may point to
   FreeLineCacheRows();
   free(pLineCache);
+  UnmapBitmapFile();
 
   delete pPixCache;
 
@@ -1635,7 +1654,7 @@ void ChartBaseBSB::FreeLineCacheRows(int start, int end) {
       CachedLine *pt = &pLineCache[ylc];
       if (pt->bValid) {
         free(pt->pTileOffset);
-        free(pt->pPix);
+        FreeRawLine(pt->pPix);
         pt->bValid = false;
       }
     }
@@ -2029,7 +2048,7 @@ void ChartBaseBSB::InvalidateLineCache(void) {
     for (int ylc = 0; ylc < Size_Y; ylc++) {
       pt = &pLineCache[ylc];
       if (pt) {
-        free(pt->pPix);
+        FreeRawLine(pt->pPix);
         pt->pPix = NULL;
         free(pt->pTileOffset);
         pt->pTileOffset = NULL;
@@ -3701,17 +3720,11 @@ bool ChartBaseBSB::GetChartBits(wxRect &source, unsigned char *pPix,
                                 int sub_samp) {
   wxCriticalSectionLocker locker(m_critSect);
 
-  int iy;
 #define FILL_BYTE 0
 
-  //    Decode the KAP file RLL stream into image pPix
-
-  unsigned char *pCP;
-  pCP = pPix;
-
-  iy = source.y;
-
-  while (iy < source.y + source.height) {
+  //    Decode the KAP file RLL stream into image pPix, one row of pixels
+  //    at pCP for each sub_samp chart rows
+  auto get_row = [&](int iy, unsigned char *pCP) {
     if ((iy >= 0) && (iy < Size_Y)) {
       if (source.x >= 0) {
         if ((source.x + source.width) > Size_X) {
@@ -3744,11 +3757,24 @@ bool ChartBaseBSB::GetChartBits(wxRect &source, unsigned char *pPix,
     {
       memset(pCP, FILL_BYTE, source.width * BPP / 8);
     }
-
-    pCP += source.width * BPP / 8 * sub_samp;
-
-    iy += sub_samp;
-  }  // while iy
+  };
+
+  //    Rows are independent once the line index is built. With the bitmap
+  //    file mapped they do not share a stream, so bands of rows are decoded
+  //    in parallel.
+  static const int kBandRows = 32;
+  const int rows = std::max(0, (source.height + sub_samp - 1) / sub_samp);
+  const size_t bands = (rows + kBandRows - 1) / kBandRows;
+  const size_t row_stride = (size_t)source.width * BPP / 8 * sub_samp;
+  auto get_band = [&](size_t band) {
+    const int end = std::min(rows, (int)(band + 1) * kBandRows);
+    for (int row = (int)band * kBandRows; row < end; row++)
+      get_row(source.y + row * sub_samp, pPix + row * row_stride);
+  };
+  if (m_bitmap_map && bands > 1)
+    ThreadPool::GetInstance().ParallelFor(bands, get_band);
+  else
+    for (size_t band = 0; band < bands; band++) get_band(band);
 
   return true;
 }
@@ -3928,7 +3954,7 @@ class OCPNStopWatch {
   do {                      \
     free(pt->pTileOffset);  \
     pt->pTileOffset = NULL; \
-    free(pt->pPix);         \
+    FreeRawLine(pt->pPix);  \
     pt->pPix = NULL;        \
     pt->bValid = false;     \
     return 0;               \
@@ -3976,32 +4002,43 @@ int ChartBaseBSB::BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
 #else
     pt->pTileOffset = (TileOffsetCache *)calloc(
         sizeof(TileOffsetCache) * (Size_X / TILE_SIZE + 1), 1);
-    pt->pPix = (unsigned char *)malloc(pt->size);
+    pt->pPix = m_bitmap_map ? NULL : (unsigned char *)malloc(pt->size);
 #endif
     if (pline_table[y] == 0 || pline_table[y + 1] == 0) FAIL;
 
-    // as of 2015, in wxWidgets buffered streams don't test for a zero seek
-    // so we check here to possibly avoid this seek with a measured performance
-    // gain
-    if (ifs_bitmap->TellI() != pline_table[y] &&
-        wxInvalidOffset == ifs_bitmap->SeekI(pline_table[y], wxFromStart))
-      FAIL;
+#ifndef USE_OLD_CACHE
+    if (m_bitmap_map) {
+      //  Decode the raw line in place
+      if (pt->size < 0 || (size_t)pline_table[y + 1] > m_bitmap_map_size)
+        FAIL;
+      pt->pPix = m_bitmap_map + pline_table[y];
+      lp = pt->pPix;
+    } else
+#endif
+    {
+      // as of 2015, in wxWidgets buffered streams don't test for a zero seek
+      // so we check here to possibly avoid this seek with a measured
+      // performance gain
+      if (ifs_bitmap->TellI() != pline_table[y] &&
+          wxInvalidOffset == ifs_bitmap->SeekI(pline_table[y], wxFromStart))
+        FAIL;
 
 #ifdef USE_OLD_CACHE
-    if (pt->size > ifs_bufsize) {
-      unsigned char *tmp = ifs_buf;
-      if (!(ifs_buf = (unsigned char *)realloc(ifs_buf, pt->size))) {
-        free(tmp);
-        FAIL;
+      if (pt->size > ifs_bufsize) {
+        unsigned char *tmp = ifs_buf;
+        if (!(ifs_buf = (unsigned char *)realloc(ifs_buf, pt->size))) {
+          free(tmp);
+          FAIL;
+        }
+        ifs_bufsize = pt->size;
       }
-      ifs_bufsize = pt->size;
-    }
 
-    lp = ifs_buf;
+      lp = ifs_buf;
 #else
-    lp = pt->pPix;
+      lp = pt->pPix;
 #endif
-    ifs_bitmap->Read(lp, pt->size);
+      ifs_bitmap->Read(lp, pt->size);
+    }
 
 #ifdef USE_OLD_CACHE
     pCL = pt->pPix;
@@ -4353,12 +4390,69 @@ int ChartBaseBSB::BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
 #ifndef USE_OLD_CACHE
     free(pt->pTileOffset);
 #endif
-    free(pt->pPix);
+    FreeRawLine(pt->pPix);
   }
 
   return 1;
 }
 
+bool ChartBaseBSB::MapBitmapFile(const wxString &path) {
+  UnmapBitmapFile();
+#ifdef __WXMSW__
+  HANDLE file = CreateFileW(path.wc_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER size;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+    m_bitmap_mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0,
+                                          NULL);
+    if (m_bitmap_mapping) {
+      m_bitmap_map = (unsigned char *)MapViewOfFile(m_bitmap_mapping,
+                                                    FILE_MAP_READ, 0, 0, 0);
+      m_bitmap_map_size = static_cast<size_t>(size.QuadPart);
+    }
+  }
+  CloseHandle(file);
+#else
+  int fd = open(path.fn_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      m_bitmap_map = (unsigned char *)data;
+      m_bitmap_map_size = st.st_size;
+    }
+  }
+  close(fd);
+#endif
+  if (!m_bitmap_map) {
+    UnmapBitmapFile();
+    return false;
+  }
+  return true;
+}
+
+void ChartBaseBSB::UnmapBitmapFile() {
+#ifdef __WXMSW__
+  if (m_bitmap_map) UnmapViewOfFile(m_bitmap_map);
+  if (m_bitmap_mapping) CloseHandle(m_bitmap_mapping);
+  m_bitmap_mapping = NULL;
+#else
+  if (m_bitmap_map) munmap(m_bitmap_map, m_bitmap_map_size);
+#endif
+  m_bitmap_map = NULL;
+  m_bitmap_map_size = 0;
+}
+
+void ChartBaseBSB::FreeRawLine(unsigned char *pix) {
+  if (m_bitmap_map && pix >= m_bitmap_map &&
+      pix <= m_bitmap_map + m_bitmap_map_size)
+    return;
+  free(pix);
+}
+
 int *ChartBaseBSB::GetPalettePtr(BSB_Color_Capability color_index) {
   if (pPalettes[color_index]) {
     if (palette_direction == PaletteFwd)
@@ -13048,7 +13048,7 @@ void ChartCanvas::DrawAllTidesInBBox(ocpnDC &dc, LLBBox &BBox) {
   {
     double marge = 0.05;
     std::vector<LLBBox> drawn_boxes;
-    for (int i = 1; i < ptcmgr->Get_max_IDX() + 1; i++) {
+    for (int i : ptcmgr->GetStationsInBBox(BBox, marge, 'T')) {
       const IDX_entry *pIDX = ptcmgr->GetIDX_entry(i);
 
       char type = pIDX->IDX_type;          // Entry "TCtcIUu" identifier
@@ -13350,7 +13350,7 @@ void ChartCanvas::DrawAllCurrentsInBBox(ocpnDC &dc, LLBBox &BBox) {
   scale_factor *= GetContentScaleFactor();
 
   {
-    for (int i = 1; i < ptcmgr->Get_max_IDX() + 1; i++) {
+    for (int i : ptcmgr->GetStationsInBBox(BBox, marge, 'C')) {
       const IDX_entry *pIDX = ptcmgr->GetIDX_entry(i);
       double lon = pIDX->IDX_lon;
       double lat = pIDX->IDX_lat;
@@ -189,6 +189,7 @@ WX_DECLARE_OBJARRAY(compress_target, ArrayOfCompressTargets);
 // WX_DEFINE_OBJARRAY(ArrayOfCompressTargets);
 
 JobTicket::JobTicket() {
+  m_message_target = NULL;
   for (int i = 0; i < 10; i++) {
     compcomp_size_array[i] = 0;
     comp_bits_array[i] = NULL;
@@ -391,13 +392,13 @@ bool JobTicket::DoJob() {
   rect.width = dim;
   rect.height = dim;
   for (int y = 0; y < ny_tex; y++) {
-    if (pthread && pthread->m_pMessageTarget) {
+    if (m_message_target) {
       OCPN_CompressionThreadEvent Nevent(wxEVT_OCPN_COMPRESSIONTHREAD, 0);
       Nevent.nstat = y;
       Nevent.nstat_max = ny_tex;
       Nevent.type = 1;
       Nevent.SetTicket(this);
-      pthread->m_pMessageTarget->AddPendingEvent(Nevent);
+      m_message_target->AddPendingEvent(Nevent);
     }
 
     rect.x = 0;
@@ -632,7 +633,6 @@ wxEvent *OCPN_CompressionThreadEvent::Clone() const {
       newevent->m_ticket->level_min_request = this->m_ticket->level_min_request;
       newevent->m_ticket->ident = this->m_ticket->ident;
       newevent->m_ticket->b_throttle = this->m_ticket->b_throttle;
-      newevent->m_ticket->pthread = this->m_ticket->pthread;
       newevent->m_ticket->level0_bits = this->m_ticket->level0_bits;
       newevent->m_ticket->m_ChartPath = this->m_ticket->m_ChartPath;
       newevent->m_ticket->b_abort = this->m_ticket->b_abort;
@@ -655,52 +655,39 @@ wxEvent *OCPN_CompressionThreadEvent::Clone() const {
   return newevent;
 }
 
-CompressionPoolThread::CompressionPoolThread(JobTicket *ticket,
-                                             wxEvtHandler *message_target) {
-  m_pMessageTarget = message_target;
-  m_ticket = ticket;
-
-  Create();
-}
-
-void *CompressionPoolThread::Entry() {
+/** Run compression job on a ThreadPool worker, notify ticket's target. */
+static void RunCompressionJob(JobTicket *ticket) {
+  wxEvtHandler *message_target = ticket->m_message_target;
 #ifdef __MSVC__
   _set_se_translator(my_translate);
 
-  //  On Windows, if anything in this thread produces a SEH exception (like
-  //  access violation) we handle the exception locally, and simply alow the
-  //  thread to exit smoothly with no results. Upstream will notice that nothing
+  //  On Windows, if anything in this job produces a SEH exception (like
+  //  access violation) we handle the exception locally, and simply allow the
+  //  job to finish smoothly with no results. Upstream will notice that nothing
   //  got done, and maybe try again later.
 
   try
 #endif
   {
-    SetPriority(WXTHREAD_MIN_PRIORITY);
-
-    if (!m_ticket->DoJob()) m_ticket->b_isaborted = true;
+    if (!ticket->DoJob()) ticket->b_isaborted = true;
 
-    if (m_pMessageTarget) {
+    if (message_target) {
       OCPN_CompressionThreadEvent Nevent(wxEVT_OCPN_COMPRESSIONTHREAD, 0);
-      Nevent.SetTicket(m_ticket);
+      Nevent.SetTicket(ticket);
       Nevent.type = 0;
-      m_pMessageTarget->QueueEvent(Nevent.Clone());
-      // from here m_ticket is undefined (if deleted in event handler)
+      message_target->QueueEvent(Nevent.Clone());
+      // from here ticket is undefined (if deleted in event handler)
     }
-
-    return 0;
-
   }  // try
 #ifdef __MSVC__
   catch (SE_Exception e) {
-    if (m_pMessageTarget) {
+    if (message_target) {
       OCPN_CompressionThreadEvent Nevent(wxEVT_OCPN_COMPRESSIONTHREAD, 0);
-      m_ticket->b_isaborted = true;
-      Nevent.SetTicket(m_ticket);
+      ticket->b_isaborted = true;
+      Nevent.SetTicket(ticket);
       Nevent.type = 0;
-      m_pMessageTarget->QueueEvent(Nevent.Clone());
+      message_target->QueueEvent(Nevent.Clone());
     }
-
-    return 0;
   }
 #endif
 }
@@ -1089,10 +1076,16 @@ bool glTextureManager::DoThreadJob(JobTicket *pticket) {
 
   ///    qDebug() << "Starting job" << GetRunningJobCount() <<  (unsigned
   ///    long)todo_list.GetCount() << g_tex_mem_used;
-  CompressionPoolThread *t = new CompressionPoolThread(pticket, this);
-  pticket->pthread = t;
+  // Compressing all charts must not delay the tiles on screen.
+  ThreadPool::Lane lane = ThreadPool::Lane::kVisible;
+  if (pticket->b_inCompressAll)
+    lane = ThreadPool::Lane::kBackground;
+  else if (pticket->b_throttle)
+    lane = ThreadPool::Lane::kPrefetch;
 
-  t->Run();
+  pticket->m_message_target = this;
+  pticket->m_job = ThreadPool::GetInstance().Submit(
+      [pticket] { RunCompressionJob(pticket); }, lane);
 
   return true;
 }
@@ -1130,9 +1123,7 @@ void glTextureManager::PurgeJobList(wxString chart_path) {
     wxJobListNode *node = running_list.GetFirst();
     while (node) {
       JobTicket *ticket = node->GetData();
-      if (ticket->m_ChartPath.IsSameAs(chart_path)) {
-        ticket->b_abort = true;
-      }
+      if (ticket->m_ChartPath.IsSameAs(chart_path)) AbortJob(ticket);
       node = node->GetNext();
     }
 
@@ -1150,13 +1141,23 @@ void glTextureManager::PurgeJobList(wxString chart_path) {
     //  Mark all running tasks for "abort"
     node = running_list.GetFirst();
     while (node) {
-      JobTicket *ticket = node->GetData();
-      ticket->b_abort = true;
+      AbortJob(node->GetData());
       node = node->GetNext();
     }
   }
 }
 
+void glTextureManager::AbortJob(JobTicket *ticket) {
+  ticket->b_abort = true;
+  // A job still queued in the pool will never run, post its completion here
+  if (ticket->m_job && ticket->m_job->Cancel()) {
+    OCPN_CompressionThreadEvent Nevent(wxEVT_OCPN_COMPRESSIONTHREAD, 0);
+    Nevent.SetTicket(ticket);
+    Nevent.type = 0;
+    QueueEvent(Nevent.Clone());
+  }
+}
+
 void glTextureManager::ClearJobList() {
   wxJobListNode *node = todo_list.GetFirst();
   while (node) {
@@ -174,6 +174,9 @@ ChartMbTiles::ChartMbTiles() {
   m_lat_min = LAT_UNDEF;
   m_lat_max = LAT_UNDEF;
 
+  m_prefetch_lat = NAN;
+  m_prefetch_lon = NAN;
+
 #ifdef OCPN_USE_CONFIG
   wxFileConfig* pfc = (wxFileConfig*)pConfig;
   pfc->SetPath(_T ( "/Settings" ));
@@ -359,6 +362,10 @@ InitReturn ChartMbTiles::Init(const wxString& name, ChartInitFlag init_flags) {
 
       else if (!strncmp(col_name, "format", 6)) {
         m_format = std::string(col_value);
+        if (m_format == "png")
+          m_image_type = wxBITMAP_TYPE_PNG;
+        else if (m_format == "jpg" || m_format == "jpeg")
+          m_image_type = wxBITMAP_TYPE_JPEG;
       }
 
       // Get the min and max zoom values present in the db
@@ -519,12 +526,12 @@ InitReturn ChartMbTiles::Init(const wxString& name, ChartInitFlag init_flags) {
     m_nCOVREntries = covr_region.contours.size();
     m_pCOVRTablePoints = (int*)malloc(m_nCOVREntries * sizeof(int));
     m_pCOVRTable = (float**)malloc(m_nCOVREntries * sizeof(float*));
-    std::list<poly_contour>::iterator it = covr_region.contours.begin();
+    std::vector<poly_contour>::iterator it = covr_region.contours.begin();
     for (int i = 0; i < m_nCOVREntries; i++) {
       m_pCOVRTablePoints[i] = it->size();
       m_pCOVRTable[i] =
           (float*)malloc(m_pCOVRTablePoints[i] * 2 * sizeof(float));
-      std::list<contour_pt>::iterator jt = it->begin();
+      poly_contour::iterator jt = it->begin();
       for (int j = 0; j < m_pCOVRTablePoints[i]; j++) {
         m_pCOVRTable[i][2 * j + 0] = jt->y;
         m_pCOVRTable[i][2 * j + 1] = jt->x;
@@ -986,6 +993,8 @@ bool ChartMbTiles::RenderRegionViewOnGL(const wxGLContext& glc,
   // screens or hdpi displays
   m_tile_cache->CleanCache(m_tile_count * 3);
 
+  if (!is_two_pass) PrefetchTiles(vpoint, screenBox, viewZoom);
+
   if (m_last_clean_zoom != viewZoom) {
     m_tile_cache->DeepCleanCache();
     m_last_clean_zoom = viewZoom;
@@ -995,6 +1004,66 @@ bool ChartMbTiles::RenderRegionViewOnGL(const wxGLContext& glc,
   return true;
 }
 
+void ChartMbTiles::PrefetchTiles(const ViewPort& vp, const LLBBox& box,
+                                 int zoom) {
+  // Only when the readers have caught up with the visible tiles
+  if (!m_worker_thread || m_worker_thread->GetQueueSize() > 0) return;
+
+  auto request = [&](int z, int ix, int iy) {
+    if (ix < 0 || ix >= (1 << z)) return;
+    if (iy > m_tile_cache->GetNorthLimit(z)) return;
+    if (iy < m_tile_cache->GetSouthLimit(z)) return;
+    SharedTilePtr tile = m_tile_cache->GetTile(z, ix, iy);
+    if (tile->m_requested || !tile->m_is_available) return;
+    if (tile->m_teximage || tile->m_gl_texture_name) return;
+    m_worker_thread->RequestTile(tile, true);
+  };
+
+  // The row or column of tiles next to the screen edge in the direction
+  // the view moved since last time.
+  double dlat = 0;
+  double dlon = 0;
+  if (!std::isnan(m_prefetch_lat)) {
+    dlat = vp.clat - m_prefetch_lat;
+    dlon = vp.clon - m_prefetch_lon;
+  }
+  m_prefetch_lat = vp.clat;
+  m_prefetch_lon = vp.clon;
+
+  int top, bot, left, right;
+  auto tile_range = [&](int z, double lat_min, double lon_min, double lat_max,
+                        double lon_max) {
+    top = wxMin(m_tile_cache->GetNorthLimit(z),
+                MbTileDescriptor::Lat2tiley(lat_max, z));
+    bot = wxMax(m_tile_cache->GetSouthLimit(z),
+                MbTileDescriptor::Lat2tiley(lat_min, z));
+    left = wxMax(0, MbTileDescriptor::Long2tilex(lon_min, z));
+    right = wxMin((1 << z) - 1, MbTileDescriptor::Long2tilex(lon_max, z));
+  };
+
+  tile_range(zoom, box.GetMinLat(), box.GetMinLon(), box.GetMaxLat(),
+             box.GetMaxLon());
+  if (dlon > 0)
+    for (int iy = bot; iy <= top; iy++) request(zoom, right + 1, iy);
+  else if (dlon < 0)
+    for (int iy = bot; iy <= top; iy++) request(zoom, left - 1, iy);
+  if (dlat > 0)
+    for (int ix = left; ix <= right; ix++) request(zoom, ix, top + 1);
+  else if (dlat < 0)
+    for (int ix = left; ix <= right; ix++) request(zoom, ix, bot - 1);
+
+  // The next zoom level, for the center half of the screen only. That is
+  // about as many tiles as the screen, where zooming in is likely to go.
+  if (zoom >= m_max_zoom || m_tile_type == MbTilesType::OVERLAY) return;
+  const double half_lat = (box.GetMaxLat() - box.GetMinLat()) / 4;
+  const double half_lon = (box.GetMaxLon() - box.GetMinLon()) / 4;
+  tile_range(zoom + 1, vp.clat - half_lat, vp.clon - half_lon,
+             vp.clat + half_lat, vp.clon + half_lon);
+  for (int iy = bot; iy <= top; iy++) {
+    for (int ix = left; ix <= right; ix++) request(zoom + 1, ix, iy);
+  }
+}
+
 bool ChartMbTiles::RenderRegionViewOnDC(wxMemoryDC& dc, const ViewPort& VPoint,
                                         const OCPNRegion& Region) {
   gFrame->GetPrimaryCanvas()->SetAlertString(
@@ -1004,10 +1073,16 @@ bool ChartMbTiles::RenderRegionViewOnDC(wxMemoryDC& dc, const ViewPort& VPoint,
 }
 
 bool ChartMbTiles::StartThread() {
-  // Create the worker thread
-  m_worker_thread = std::make_unique<MbtTilesThread>(m_db);
-  m_thread = std::thread([&] { m_worker_thread->Run(); });
-  m_thread.detach();
+  // Create the worker threads, a few readers are enough to keep up with
+  // panning while leaving cores to the rest of the application.
+  std::string path = m_FullPath.ToStdString(wxConvUTF8);
+  int readers = wxMax(1, wxMin(4, (int)std::thread::hardware_concurrency()));
+  m_worker_thread =
+      std::make_unique<MbtTilesThread>(path, m_image_type, readers);
+  MbtTilesThread* worker = m_worker_thread.get();
+  for (int i = 0; i < worker->GetReaderCount(); i++) {
+    std::thread([worker] { worker->Run(); }).detach();
+  }
   return true;
 }
 
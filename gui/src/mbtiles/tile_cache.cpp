@@ -45,34 +45,29 @@ SharedTilePtr TileCache::GetTile(int z, int x, int y) {
   uint64_t index = MbTileDescriptor::GetMapKey(z, x, y);
   auto ref = m_tile_map.find(index);
   if (ref != m_tile_map.end()) {
-    // The tile is in the cache
-    ref->second->SetTimestamp();
-    return ref->second;
+    // The tile is in the cache, move it to the front of the LRU list
+    ref->second.tile->SetTimestamp();
+    m_lru.splice(m_lru.begin(), m_lru, ref->second.lru_pos);
+    return ref->second.tile;
   }
 
   // The tile is not in the cache : create an empty one and add it to the tile
   // map and list
   auto tile = std::make_shared<MbTileDescriptor>(z, x, y, on_delete);
-  m_tile_map[index] = tile;
+  m_lru.push_front(index);
+  m_tile_map[index] = CacheEntry{tile, m_lru.begin()};
   return tile;
 }
 
-void TileCache::CleanCache(uint32_t max_tiles) {
-  if (m_tile_map.size() <= max_tiles) return;
-
-  // Create a sorted list of keys, oldest first.
-  std::vector<uint64_t> keys;
-  for (auto& kv : m_tile_map) keys.push_back(kv.first);
-  auto compare = [&](const uint64_t lhs, const uint64_t rhs) {
-    return m_tile_map[lhs]->m_last_used < m_tile_map[rhs]->m_last_used;
-  };
-  std::sort(keys.begin(), keys.end(), compare);
+void TileCache::RemoveOldest() {
+  uint64_t key = m_lru.back();
+  std::lock_guard lock(TileCache::GetMutex(key));
+  m_tile_map.erase(key);
+  m_lru.pop_back();
+}
 
-  for (size_t i = 0; i < m_tile_map.size() - max_tiles; i += 1) {
-    std::lock_guard lock(TileCache::GetMutex(m_tile_map[keys[i]]));
-    auto tile = m_tile_map[keys[i]];
-    m_tile_map.erase(keys[i]);
-  }
+void TileCache::CleanCache(uint32_t max_tiles) {
+  while (m_tile_map.size() > max_tiles) RemoveOldest();
 }
 
 void TileCache::DeepCleanCache() {
@@ -82,21 +77,16 @@ void TileCache::DeepCleanCache() {
 
   auto age_limit = std::chrono::duration<int>(5);  // 5 seconds
 
-  std::vector<uint64_t> keys;
-  for (auto& kv : m_tile_map) keys.push_back(kv.first);
-
-  for (size_t i = 0; i < keys.size(); i += 1) {
-    std::lock_guard lock(TileCache::GetMutex(m_tile_map[keys[i]]));
-    auto tile = m_tile_map[keys[i]];
+  //  Looking for tiles that have been fetched from sql,
+  //  but not yet rendered.  Such tiles contain a large bitmap allocation.
+  //  After some time, it is likely they never will be needed in short term.
+  //  So safe to delete, and reload as necessary.
+  //  The LRU list is ordered by last use, stop at the first recent tile.
+  while (!m_lru.empty()) {
+    const auto& tile = m_tile_map[m_lru.back()].tile;
     const std::chrono::duration<double> elapsed_seconds{time_now -
                                                         tile->m_last_used};
-
-    //  Looking for tiles that have been fetched from sql,
-    //  but not yet rendered.  Such tiles contain a large bitmap allocation.
-    //  After some time, it is likely they never will be needed in short term.
-    //  So safe to delete, and reload as necessary.
-    if (elapsed_seconds > age_limit) {
-      m_tile_map.erase(keys[i]);
-    }
+    if (elapsed_seconds <= age_limit) break;
+    RemoveOldest();
   }
 }
@@ -1,6 +1,7 @@
 #ifndef _TILECACHE_H_
 #define _TILECACHE_H_
 
+#include <list>
 #include <mutex>
 
 #include "tile_descr.h"
@@ -17,9 +18,17 @@ class TileCache {
     int m_tile_y_max;
   };
 
+  /** Cached tile and its position in the LRU list. */
+  struct CacheEntry {
+    SharedTilePtr tile;
+    std::list<uint64_t>::iterator lru_pos;
+  };
+
 private:
   const double kEps = 6e-6;  // about 1cm on earth's surface at equator
-  std::unordered_map<uint64_t, SharedTilePtr> m_tile_map;
+  std::unordered_map<uint64_t, CacheEntry> m_tile_map;
+  /// Tile keys, most recently used first
+  std::list<uint64_t> m_lru;
   const int m_min_zoom;
   const int m_max_zoom;
   const int m_nb_zoom;
@@ -48,7 +57,10 @@ public:
   static std::mutex& GetMutex(const SharedTilePtr& tile);
 
   /** Flush the tile cache, including OpenGL texture memory if needed */
-  void Flush() { m_tile_map.clear(); }
+  void Flush() {
+    m_tile_map.clear();
+    m_lru.clear();
+  }
 
   /**
    * Get the north limit of the cache area for a given zoom in WMTS coordinates.
@@ -81,13 +93,19 @@ public:
   SharedTilePtr GetTile(int z, int x, int y);
 
   /**
-   *  Reduce the size of the cache if it exceeds the given limit. Must
-   *  only be called by rendering thread since it uses OpenGL calls.
+   *  Reduce the size of the cache if it exceeds the given limit, removing
+   *  the least recently used tiles. Must only be called by rendering
+   *  thread since it uses OpenGL calls.
    *  @param max_tiles Maximum number of tiles to be kept in the cache.
    */
   void CleanCache(uint32_t max_tiles);
 
+  /** Remove all tiles not used during the last 5 seconds. */
   void DeepCleanCache();
+
+private:
+  /** Remove the least recently used tile. */
+  void RemoveOldest();
 };
 
 #endif
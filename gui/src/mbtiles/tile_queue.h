@@ -2,12 +2,15 @@
 #define _MBTILESTILEQUEUE_H_
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
-#include <vector>
 
 #include "tile_descr.h"
 
-/** A thread safe tile queue between two threads. */
+/**
+ * A thread safe tile queue between the render thread and the tile readers.
+ * Tiles needed on screen are always popped before prefetched ones.
+ */
 class TileQueue {
 public:
   TileQueue() {}
@@ -15,13 +18,18 @@ public:
   /**
    *  Push a tile to the queue.
    *  @param tile Pointer to tile descriptor to be pushed.
+   *  @param prefetch If true, tile is not yet visible and only loaded when
+   *  no visible tile is waiting.
    */
-  void Push(SharedTilePtr tile) {
+  void Push(SharedTilePtr tile, bool prefetch = false) {
     {
       std::lock_guard lock(m_mutex);
-      m_tile_list.push_back(tile);
+      if (prefetch)
+        m_prefetch_list.push_back(tile);
+      else
+        m_tile_list.push_back(tile);
     }
-    m_cv.notify_all();
+    m_cv.notify_one();
   }
 
   /**
@@ -32,20 +40,23 @@ public:
    */
   SharedTilePtr Pop() {
     std::unique_lock lock(m_mutex);
-    m_cv.wait(lock, [&] { return m_tile_list.size() > 0; });
-    auto tile = m_tile_list.at(0);
-    m_tile_list.erase(m_tile_list.cbegin());
+    m_cv.wait(lock,
+              [&] { return !m_tile_list.empty() || !m_prefetch_list.empty(); });
+    auto& list = m_tile_list.empty() ? m_prefetch_list : m_tile_list;
+    auto tile = list.front();
+    list.pop_front();
     return tile;
   }
 
-  /**  Retrieve current size of queue. */
+  /**  Retrieve current size of queue, including prefetched tiles. */
   uint32_t GetSize() {
     std::lock_guard lock(m_mutex);
-    return m_tile_list.size();
+    return m_tile_list.size() + m_prefetch_list.size();
   }
 
 private:
-  std::vector<SharedTilePtr> m_tile_list;
+  std::deque<SharedTilePtr> m_tile_list;
+  std::deque<SharedTilePtr> m_prefetch_list;
   std::mutex m_mutex;
   std::condition_variable m_cv;
 };
@@ -1,4 +1,5 @@
 
+#include <memory>
 #include <mutex>
 
 #include <wx/thread.h>
@@ -17,19 +18,20 @@ void my_translate_mbtile(unsigned int code, _EXCEPTION_POINTERS* ep) {
  * Request a tile to be loaded by the thread. This method is thread
  * safe.
  * @param tile Pointer to the tile to load
+ * @param prefetch If true, tile is loaded after all visible ones.
  */
-void MbtTilesThread::RequestTile(SharedTilePtr tile) {
+void MbtTilesThread::RequestTile(SharedTilePtr tile, bool prefetch) {
   tile->m_requested = true;
-  m_tile_queue.Push(tile);
+  m_tile_queue.Push(tile, prefetch);
 }
 
 void MbtTilesThread::RequestStop() {
   m_exit_thread = true;
-  m_tile_queue.Push(nullptr);
+  for (int i = 0; i < m_reader_count; i++) m_tile_queue.Push(nullptr);
   int tsec = 10;
   wxMilliSleep(10);
 
-  while ((!m_finished) && (tsec--)) {
+  while ((m_finished < m_reader_count) && (tsec--)) {
     wxYield();
     wxMilliSleep(10);
   }
@@ -48,6 +50,20 @@ void MbtTilesThread::Run() {
 
 #endif
 
+  // Own connection and prepared statement, only used by this thread
+  std::unique_ptr<SQLite::Database> db;
+  std::unique_ptr<SQLite::Statement> query;
+  try {
+    db = std::make_unique<SQLite::Database>(m_path, SQLite::OPEN_READONLY);
+    db->exec("PRAGMA mmap_size=268435456");
+    query = std::make_unique<SQLite::Statement>(
+        *db,
+        "select tile_data from tiles where zoom_level = ? AND "
+        "tile_column = ? AND tile_row = ?");
+  } catch (std::exception& e) {
+    wxLogMessage("mbtiles reader std::exception: %s", e.what());
+  }
+
   SharedTilePtr tile;
   do {
     // Wait for the next job
@@ -55,23 +71,30 @@ void MbtTilesThread::Run() {
     // Only process non null tiles. A null pointer can be sent to force the
     // thread to check for a deletion request
     if (tile != nullptr) {
-      LoadTile(tile);
+      if (query)
+        LoadTile(*query, tile);
+      else
+        tile->m_is_available = false;
     }
     // Only request a refresh of the display when there is no more tiles in
     // the queue.
-    if (m_tile_queue.GetSize() == 0) {
+    if (tile != nullptr && m_tile_queue.GetSize() == 0) {
       wxGetApp().GetTopWindow()->GetEventHandler()->CallAfter(
           &MyFrame::RefreshAllCanvas, true);
     }
     // Check if the thread has been requested to be destroyed
   } while (!m_exit_thread);
 
+  // Statement must be finalized before its connection is closed
+  query.reset();
+  db.reset();
+
   // Since the worker is a detached thread, we need a special mecanism to
   // allow the main thread to wait for its deletion
-  m_finished = true;
+  m_finished++;
 }
 
-void MbtTilesThread::LoadTile(SharedTilePtr tile) {
+void MbtTilesThread::LoadTile(SQLite::Statement& query, SharedTilePtr tile) {
   std::lock_guard lock(TileCache::GetMutex(tile));
 
   // If the tile has not been found in the SQL database in a previous attempt,
@@ -85,32 +108,36 @@ void MbtTilesThread::LoadTile(SharedTilePtr tile) {
 
   // Fetch the tile data from the mbtile database
   try {
-    char qrs[2100];
-
-    // Compile a SQL query, getting the specific blob
-    sprintf(qrs,
-            "select tile_data, length(tile_data) from tiles where zoom_level "
-            "= %d AND tile_column=%d AND tile_row=%d",
-            tile->m_zoom_level, tile->m_tile_x, tile->m_tile_y);
-    SQLite::Statement query(*m_db, qrs);
+    query.reset();
+    query.bind(1, tile->m_zoom_level);
+    query.bind(2, tile->m_tile_x);
+    query.bind(3, tile->m_tile_y);
 
-    int queryResult = query.tryExecuteStep();
-    if (SQLITE_DONE == queryResult) {
+    if (!query.executeStep()) {
       // The tile has not been found in databse, mark it as "not available" so
       // that we won't try to find it again later
       tile->m_is_available = false;
       return;
     } else {
-      // Get the blob
+      // Get the blob and its length
       SQLite::Column blobColumn = query.getColumn(0);
       const void* blob = blobColumn.getBlob();
-      // Get the length
-      int length = query.getColumn(1);
+      int length = blobColumn.getBytes();
 
-      // Uncompress the tile
-      wxMemoryInputStream blobStream(blob, length);
+      // Uncompress the tile, using the format declared in the metadata if
+      // known. Some files hold tiles of another format, try all handlers
+      // then.
       wxImage blobImage;
-      blobImage = wxImage(blobStream, wxBITMAP_TYPE_ANY);
+      {
+        wxLogNull no_log;
+        wxMemoryInputStream blobStream(blob, length);
+        blobImage.LoadFile(blobStream, m_image_type);
+      }
+      if (!blobImage.IsOk() && m_image_type != wxBITMAP_TYPE_ANY) {
+        wxMemoryInputStream blobStream(blob, length);
+        blobImage.LoadFile(blobStream, wxBITMAP_TYPE_ANY);
+      }
+      query.reset();
       int blobWidth, blobHeight;
       unsigned char* imgdata;
 
@@ -144,6 +171,7 @@ void MbtTilesThread::LoadTile(SharedTilePtr tile) {
       if (!teximage) return;
 
       bool transparent = blobImage.HasAlpha();
+      const unsigned char* alpha = blobImage.GetAlpha();
       //  *(int*)0 = 0;  // test exception
 
       for (int j = 0; j < tex_w * tex_h; j++) {
@@ -157,7 +185,7 @@ void MbtTilesThread::LoadTile(SharedTilePtr tile) {
           teximage[j * stride + 3] = 0;
         } else {
           if (transparent) {
-            teximage[j * stride + 3] = blobImage.GetAlpha(j % tex_w, j / tex_w);
+            teximage[j * stride + 3] = alpha[j];
           } else {
             teximage[j * stride + 3] = 255;
           }
@@ -2,6 +2,8 @@
 #ifndef _MBTILESTHREAD_H_
 #define _MBTILESTHREAD_H_
 
+#include <atomic>
+#include <string>
 #include <thread>
 
 #include <wx/event.h>
@@ -30,18 +32,28 @@ public:
 #endif
 
 /**
- *  MbTiles chart decoder worker thread. Receives requests from
+ *  MbTiles chart decoder worker threads. Receives requests from
  *  the MbTile front-end to load and uncompress tiles from an MbTiles file. Once
  *  done, the tile list in memory is updated and a refresh of the map triggered.
+ *
+ *  Each reader thread runs Run() with its own read-only connection to the
+ *  file and a prepared tile query, so several tiles are loaded at once.
  */
 class MbtTilesThread {
 public:
   /**
    * Create worker thread instance.
-   * @param pDB Pointer to SQL database handler.
+   * @param path UTF-8 path of the MbTiles file.
+   * @param image_type Expected tile image format, or wxBITMAP_TYPE_ANY.
+   * @param reader_count Number of threads which will invoke Run().
    */
-  MbtTilesThread(std::shared_ptr<SQLite::Database> db)
-      : m_exit_thread(false), m_finished(false), m_db(db) {}
+  MbtTilesThread(const std::string& path, wxBitmapType image_type,
+                 int reader_count)
+      : m_exit_thread(false),
+        m_finished(0),
+        m_reader_count(reader_count),
+        m_path(path),
+        m_image_type(image_type) {}
 
   virtual ~MbtTilesThread() {}
 
@@ -49,36 +61,45 @@ public:
    * Request a tile to be loaded by the thread. This method is thread
    * safe.
    * @param tile Pointer to tile to load
+   * @param prefetch If true, tile is loaded after all visible ones.
    */
-  void RequestTile(SharedTilePtr tile);
+  void RequestTile(SharedTilePtr tile, bool prefetch = false);
 
-  /** Request the thread to stop/delete itself. */
+  /** Request all reader threads to stop and wait for them. */
   void RequestStop();
 
   /** Return number of tiles in worker thread queue. */
   size_t GetQueueSize();
 
-  /**  Worker thread main loop. */
+  /** Number of threads which should invoke Run(). */
+  int GetReaderCount() const { return m_reader_count; }
+
+  /**  Worker thread main loop, one for each reader. */
   virtual void Run();
 
 private:
   /// Set to true to tell the main loop to stop execution
-  bool m_exit_thread;
+  std::atomic<bool> m_exit_thread;
+
+  /// Number of readers which have finished
+  std::atomic<int> m_finished;
 
-  /// Set to true when the thread has finished
-  bool m_finished;
+  const int m_reader_count;
 
   /// The queue storing all the tile requests
   TileQueue m_tile_queue;
 
-  /// Pointer to SQL object managing the MbTiles file
-  std::shared_ptr<SQLite::Database> m_db;
+  /// MbTiles file, each reader opens its own connection
+  const std::string m_path;
+
+  const wxBitmapType m_image_type;
 
   /**
    * Load bitmap data of a tile from the MbTiles file to the tile cache
+   * @param query Prepared tile query of the calling reader
    * @param tile Pointer to the tile to be loaded
    */
-  void LoadTile(SharedTilePtr tile);
+  void LoadTile(SQLite::Statement& query, SharedTilePtr tile);
 };
 
 #endif /* _MBTILESTHREAD_H_ */
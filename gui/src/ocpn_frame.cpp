@@ -816,6 +816,14 @@ MyFrame::MyFrame(wxFrame *frame, const wxString &title, const wxPoint &pos,
     assert(alert_dlg_active);
     return alert_dlg_active->Get_Dialog_MMSI();
   };
+  ais_callbacks.target_list_shown = []() {
+    return g_pAISTargetList && g_pAISTargetList->IsShown();
+  };
+  ais_callbacks.get_query_mmsi = []() {
+    if (g_pais_query_dialog_active && g_pais_query_dialog_active->IsShown())
+      return g_pais_query_dialog_active->GetMMSI();
+    return 0;
+  };
 
   g_pAIS = new AisDecoder(ais_callbacks);
 
@@ -30,6 +30,10 @@
 #include "wx/wx.h"
 #endif  // precompiled headers
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
 #include "wx/image.h"  // for some reason, needed for msvc???
 #include "wx/tokenzr.h"
 #include <wx/textfile.h>
@@ -220,6 +224,8 @@ s57chart::s57chart() {
 
   for (int i = 0; i < PRIO_NUM; i++)
     for (int j = 0; j < LUPNAME_NUM; j++) razRules[i][j] = NULL;
+  m_view_index = NULL;
+  m_render_stats = {0, 0, 0, 0, 0};
 
   m_Chart_Scale = 1;  // Will be fetched during Init()
   m_Chart_Skew = 0.0;
@@ -274,6 +280,10 @@ s57chart::s57chart() {
 }
 
 s57chart::~s57chart() {
+  //    The declutter list may refer to texts of this chart, other charts
+  //    of a quilt keep theirs
+  RemoveDeclutterTexts();
+
   FreeObjectsAndRules();
 
   delete pDIB;
@@ -302,7 +312,7 @@ s57chart::~s57chart() {
   for (const auto &it : m_ve_hash) {
     VE_Element *pedge = it.second;
     if (pedge) {
-      free(pedge->pPoints);
+      FreeSencPoints(pedge->pPoints);
       delete pedge;
     }
   }
@@ -311,7 +321,7 @@ s57chart::~s57chart() {
   for (const auto &it : m_vc_hash) {
     VC_Element *pcs = it.second;
     if (pcs) {
-      free(pcs->pPoint);
+      FreeSencPoints(pcs->pPoint);
       delete pcs;
     }
   }
@@ -493,6 +503,24 @@ void s57chart::FreeObjectsAndRules() {
         free(top);
         top = nxx;
       }
+      m_obj_index[i][j].objects.clear();
+      m_obj_index[i][j].stale = true;
+    }
+  }
+  m_view_index = NULL;
+}
+
+void s57chart::RemoveDeclutterTexts() {
+  if (!ps52plib) return;
+  for (int i = 0; i < PRIO_NUM; ++i) {
+    for (int j = 0; j < LUPNAME_NUM; j++) {
+      for (ObjRazRules *top = razRules[i][j]; top; top = top->next) {
+        if (top->obj->FText) ps52plib->RemoveFromTextList(top->obj->FText);
+        for (ObjRazRules *ctop = top->child; ctop; ctop = ctop->next) {
+          if (ctop->obj->FText)
+            ps52plib->RemoveFromTextList(ctop->obj->FText);
+        }
+      }
     }
   }
 }
@@ -505,6 +533,7 @@ void s57chart::ClearRenderedTextCache() {
       while (top != NULL) {
         if (top->obj->bFText_Added) {
           top->obj->bFText_Added = false;
+          if (ps52plib) ps52plib->RemoveFromTextList(top->obj->FText);
           delete top->obj->FText;
           top->obj->FText = NULL;
         }
@@ -514,6 +543,7 @@ void s57chart::ClearRenderedTextCache() {
           while (ctop) {
             if (ctop->obj->bFText_Added) {
               ctop->obj->bFText_Added = false;
+              if (ps52plib) ps52plib->RemoveFromTextList(ctop->obj->FText);
               delete ctop->obj->FText;
               ctop->obj->FText = NULL;
             }
@@ -1359,7 +1389,7 @@ void s57chart::AssembleLineGeometry(void) {
     VE_Element *pedge = it.second;
     if (pedge) {
       m_pve_vector.push_back(pedge);
-      free(pedge->pPoints);
+      FreeSencPoints(pedge->pPoints);
     }
   }
   m_ve_hash.clear();
@@ -1369,7 +1399,7 @@ void s57chart::AssembleLineGeometry(void) {
   // all the points are now in the VBO buffer
   for (const auto &it : m_vc_hash) {
     VC_Element *pcs = it.second;
-    if (pcs) free(pcs->pPoint);
+    if (pcs) FreeSencPoints(pcs->pPoint);
     delete pcs;
   }
   m_vc_hash.clear();
@@ -1706,10 +1736,17 @@ bool s57chart::DoRenderOnGL(const wxGLContext &glc, const ViewPort &VPoint) {
 #ifdef ocpnUSE_GL
 
   int i;
-  ObjRazRules *top;
-  ObjRazRules *crnt;
+  int j;
   ViewPort tvp = VPoint;  // undo const  TODO fix this in PLIB
 
+  //  Benchmark mode, log draw calls and time of each render
+  static const bool b_log_stats = getenv("OCPN_S57_RENDER_STATS") != NULL;
+  auto t0 = std::chrono::steady_clock::now();
+  size_t drawn0 = m_render_stats.drawn;
+
+  ps52plib->ResetSymbolStats();
+  ps52plib->BeginSymbolBatch();
+
 #if 1
 
   //      Render the areas quickly
@@ -1717,15 +1754,13 @@ bool s57chart::DoRenderOnGL(const wxGLContext &glc, const ViewPort &VPoint) {
 
   for (i = 0; i < PRIO_NUM; ++i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
-      top = razRules[i][4];  // Area Symbolized Boundaries
+      j = 4;  // Area Symbolized Boundaries
     else
-      top = razRules[i][3];  // Area Plain Boundaries
+      j = 3;  // Area Plain Boundaries
 
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;  // next object
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderAreaToGL(glc, crnt);
+      if (ps52plib->RenderAreaToGL(glc, crnt)) m_render_stats.drawn++;
     }
   }
 
@@ -1760,25 +1795,22 @@ bool s57chart::DoRenderOnGL(const wxGLContext &glc, const ViewPort &VPoint) {
   //    Render the lines and points
   for (i = 0; i < PRIO_NUM; ++i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
-      top = razRules[i][4];  // Area Symbolized Boundaries
+      j = 4;  // Area Symbolized Boundaries
     else
-      top = razRules[i][3];  // Area Plain Boundaries
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;  // next object
+      j = 3;  // Area Plain Boundaries
+
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToGL(glc, crnt);
+      if (ps52plib->RenderObjectToGL(glc, crnt)) m_render_stats.drawn++;
     }
   }
   // qDebug() << "Done Boundaries" << sw.GetTime();
 
   for (i = 0; i < PRIO_NUM; ++i) {
-    top = razRules[i][2];  // LINES
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;
+    // LINES
+    for (ObjRazRules *crnt : GetViewObjects(i, 2)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToGL(glc, crnt);
+      if (ps52plib->RenderObjectToGL(glc, crnt)) m_render_stats.drawn++;
     }
   }
 
@@ -1786,19 +1818,32 @@ bool s57chart::DoRenderOnGL(const wxGLContext &glc, const ViewPort &VPoint) {
 
   for (i = 0; i < PRIO_NUM; ++i) {
     if (ps52plib->m_nSymbolStyle == SIMPLIFIED)
-      top = razRules[i][0];  // SIMPLIFIED Points
+      j = 0;  // SIMPLIFIED Points
     else
-      top = razRules[i][1];  // Paper Chart Points Points
+      j = 1;  // Paper Chart Points Points
 
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToGL(glc, crnt);
+      if (ps52plib->RenderObjectToGL(glc, crnt)) m_render_stats.drawn++;
     }
   }
   // qDebug() << "Done Points" << sw.GetTime();
 
+  ps52plib->EndSymbolBatch();
+  m_render_stats.symbols += ps52plib->GetSymbolCount();
+  m_render_stats.symbol_draws += ps52plib->GetSymbolDrawCount();
+
+  if (b_log_stats) {
+    glFinish();  // Include the GPU work
+    std::chrono::duration<double, std::milli> ms =
+        std::chrono::steady_clock::now() - t0;
+    wxLogMessage(
+        "S57 render %s: %lu objects, %lu symbols in %lu draw calls, %.2f ms",
+        m_FullPath, (unsigned long)(m_render_stats.drawn - drawn0),
+        (unsigned long)ps52plib->GetSymbolCount(),
+        (unsigned long)ps52plib->GetSymbolDrawCount(), ms.count());
+  }
+
 #endif  // #ifdef ocpnUSE_GL
 
   return true;
@@ -1809,8 +1854,7 @@ bool s57chart::DoRenderOnGLText(const wxGLContext &glc,
 #ifdef ocpnUSE_GL
 
   int i;
-  ObjRazRules *top;
-  ObjRazRules *crnt;
+  int j;
   ViewPort tvp = VPoint;  // undo const  TODO fix this in PLIB
 
 #if 0
@@ -1833,35 +1877,29 @@ bool s57chart::DoRenderOnGLText(const wxGLContext &glc,
   //    Render the lines and points
   for (i = 0; i < PRIO_NUM; ++i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
-      top = razRules[i][4];  // Area Symbolized Boundaries
+      j = 4;  // Area Symbolized Boundaries
     else
-      top = razRules[i][3];  // Area Plain Boundaries
+      j = 3;  // Area Plain Boundaries
 
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;  // next object
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToGLText(glc, crnt);
+      if (ps52plib->RenderObjectToGLText(glc, crnt)) m_render_stats.drawn++;
     }
 
-    top = razRules[i][2];  // LINES
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;
+    // LINES
+    for (ObjRazRules *crnt : GetViewObjects(i, 2)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToGLText(glc, crnt);
+      if (ps52plib->RenderObjectToGLText(glc, crnt)) m_render_stats.drawn++;
     }
 
     if (ps52plib->m_nSymbolStyle == SIMPLIFIED)
-      top = razRules[i][0];  // SIMPLIFIED Points
+      j = 0;  // SIMPLIFIED Points
     else
-      top = razRules[i][1];  // Paper Chart Points Points
+      j = 1;  // Paper Chart Points Points
 
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToGLText(glc, crnt);
+      if (ps52plib->RenderObjectToGLText(glc, crnt)) m_render_stats.drawn++;
     }
   }
 
@@ -2280,8 +2318,7 @@ bool s57chart::DoRenderViewOnDC(wxMemoryDC &dc, const ViewPort &VPoint,
 int s57chart::DCRenderRect(wxMemoryDC &dcinput, const ViewPort &vp,
                            wxRect *rect) {
   int i;
-  ObjRazRules *top;
-  ObjRazRules *crnt;
+  int j;
 
   wxASSERT(rect);
   ViewPort tvp = vp;  // undo const  TODO fix this in PLIB
@@ -2341,15 +2378,14 @@ int s57chart::DCRenderRect(wxMemoryDC &dcinput, const ViewPort &vp,
   //      Render the areas quickly
   for (i = 0; i < PRIO_NUM; ++i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
-      top = razRules[i][4];  // Area Symbolized Boundaries
+      j = 4;  // Area Symbolized Boundaries
     else
-      top = razRules[i][3];  // Area Plain Boundaries
+      j = 3;  // Area Plain Boundaries
 
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;  // next object
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderAreaToDC(&dcinput, crnt, &pb_spec);
+      if (ps52plib->RenderAreaToDC(&dcinput, crnt, &pb_spec))
+        m_render_stats.drawn++;
     }
   }
 
@@ -2393,8 +2429,7 @@ int s57chart::DCRenderRect(wxMemoryDC &dcinput, const ViewPort &vp,
 bool s57chart::DCRenderLPB(wxMemoryDC &dcinput, const ViewPort &vp,
                            wxRect *rect) {
   int i;
-  ObjRazRules *top;
-  ObjRazRules *crnt;
+  int j;
   ViewPort tvp = vp;  // undo const  TODO fix this in PLIB
 
   for (i = 0; i < PRIO_NUM; ++i) {
@@ -2406,34 +2441,29 @@ bool s57chart::DCRenderLPB(wxMemoryDC &dcinput, const ViewPort &vp,
     //      }
 
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
-      top = razRules[i][4];  // Area Symbolized Boundaries
+      j = 4;  // Area Symbolized Boundaries
     else
-      top = razRules[i][3];  // Area Plain Boundaries
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;  // next object
+      j = 3;  // Area Plain Boundaries
+
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToDC(&dcinput, crnt);
+      if (ps52plib->RenderObjectToDC(&dcinput, crnt)) m_render_stats.drawn++;
     }
 
-    top = razRules[i][2];  // LINES
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;
+    // LINES
+    for (ObjRazRules *crnt : GetViewObjects(i, 2)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToDC(&dcinput, crnt);
+      if (ps52plib->RenderObjectToDC(&dcinput, crnt)) m_render_stats.drawn++;
     }
 
     if (ps52plib->m_nSymbolStyle == SIMPLIFIED)
-      top = razRules[i][0];  // SIMPLIFIED Points
+      j = 0;  // SIMPLIFIED Points
     else
-      top = razRules[i][1];  // Paper Chart Points Points
+      j = 1;  // Paper Chart Points Points
 
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToDC(&dcinput, crnt);
+      if (ps52plib->RenderObjectToDC(&dcinput, crnt)) m_render_stats.drawn++;
     }
 
     //      Destroy Clipper
@@ -2452,41 +2482,37 @@ bool s57chart::DCRenderLPB(wxMemoryDC &dcinput, const ViewPort &vp,
 
 bool s57chart::DCRenderText(wxMemoryDC &dcinput, const ViewPort &vp) {
   int i;
-  ObjRazRules *top;
-  ObjRazRules *crnt;
+  int j;
   ViewPort tvp = vp;  // undo const  TODO fix this in PLIB
 
   for (i = 0; i < PRIO_NUM; ++i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
-      top = razRules[i][4];  // Area Symbolized Boundaries
+      j = 4;  // Area Symbolized Boundaries
     else
-      top = razRules[i][3];  // Area Plain Boundaries
+      j = 3;  // Area Plain Boundaries
 
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;  // next object
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToDCText(&dcinput, crnt);
+      if (ps52plib->RenderObjectToDCText(&dcinput, crnt))
+        m_render_stats.drawn++;
     }
 
-    top = razRules[i][2];  // LINES
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;
+    // LINES
+    for (ObjRazRules *crnt : GetViewObjects(i, 2)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToDCText(&dcinput, crnt);
+      if (ps52plib->RenderObjectToDCText(&dcinput, crnt))
+        m_render_stats.drawn++;
     }
 
     if (ps52plib->m_nSymbolStyle == SIMPLIFIED)
-      top = razRules[i][0];  // SIMPLIFIED Points
+      j = 0;  // SIMPLIFIED Points
     else
-      top = razRules[i][1];  // Paper Chart Points Points
+      j = 1;  // Paper Chart Points Points
 
-    while (top != NULL) {
-      crnt = top;
-      top = top->next;
+    for (ObjRazRules *crnt : GetViewObjects(i, j)) {
       crnt->sm_transform_parms = &vp_transform;
-      ps52plib->RenderObjectToDCText(&dcinput, crnt);
+      if (ps52plib->RenderObjectToDCText(&dcinput, crnt))
+        m_render_stats.drawn++;
     }
   }
 
@@ -4091,6 +4117,11 @@ int s57chart::BuildSENCFile(const wxString &FullPath000,
   }
 }
 
+/** Free edge or connected node points unless they are in the SENC file. */
+void s57chart::FreeSencPoints(float *points) {
+  if (!m_senc_map || !m_senc_map->Contains(points)) free(points);
+}
+
 int s57chart::BuildRAZFromSENCFile(const wxString &FullPath) {
   int ret_val = 0;  // default is OK
 
@@ -4105,6 +4136,7 @@ int s57chart::BuildRAZFromSENCFile(const wxString &FullPath) {
   sencfile.setRefLocn(ref_lat, ref_lon);
 
   int srv = sencfile.ingest200(FullPath, &Objects, &VEs, &VCs);
+  m_senc_map = sencfile.getSencMap();
 
   if (srv != SENC_NO_ERROR) {
     wxLogMessage(sencfile.getLastError());
@@ -4420,12 +4452,22 @@ int s57chart::_insertRules(S57Obj *obj, LUPrec *LUP, s57chart *pOwner) {
     rPrevious->next = rzRules;
   else
     razRules[disPrioIdx][LUPtypeIdx] = rzRules;
+  m_obj_index[disPrioIdx][LUPtypeIdx].stale = true;
 
 #endif
 
   return 1;
 }
 
+/** How far the box of object extends outside indexed box, in degrees. */
+static double BoxExcess(const LLRTree<int>::Item &item, ObjRazRules *rules) {
+  const LLBBox &box = rules->obj->BBObj;
+  return std::max(std::max(item.lat_min - box.GetMinLat(),
+                           box.GetMaxLat() - item.lat_max),
+                  std::max(item.lon_min - box.GetMinLon(),
+                           box.GetMaxLon() - item.lon_max));
+}
+
 void s57chart::ResetPointBBoxes(const ViewPort &vp_last,
                                 const ViewPort &vp_this) {
   ObjRazRules *top;
@@ -4438,6 +4480,9 @@ void s57chart::ResetPointBBoxes(const ViewPort &vp_last,
 
   for (int i = 0; i < PRIO_NUM; ++i) {
     for (int j = 0; j < 2; ++j) {
+      ObjListIndex &index = m_obj_index[i][j];
+      index.margin = 0;
+      size_t id = 0;
       top = razRules[i][j];
 
       while (top != NULL) {
@@ -4461,6 +4506,11 @@ void s57chart::ResetPointBBoxes(const ViewPort &vp_last,
             top->obj->BBObj.Invalidate();
           }
         }
+        if (id < index.boxes.size()) {
+          index.margin =
+              std::max(index.margin, BoxExcess(index.boxes[id], top));
+        }
+        id++;
 
         nxx = top->next;
         top = nxx;
@@ -4469,6 +4519,66 @@ void s57chart::ResetPointBBoxes(const ViewPort &vp_last,
   }
 }
 
+void s57chart::BuildObjIndex(ObjListIndex &index, ObjRazRules *list) {
+  index.objects.clear();
+  index.boxes.clear();
+  for (ObjRazRules *top = list; top; top = top->next) {
+    const LLBBox &box = top->obj->BBObj;
+    LLRTree<int>::Item item{static_cast<int>(index.objects.size()),
+                            static_cast<float>(box.GetMinLat()),
+                            static_cast<float>(box.GetMaxLat()),
+                            static_cast<float>(box.GetMinLon()),
+                            static_cast<float>(box.GetMaxLon()), 0};
+    // Never set or bogus boxes, always let s52plib decide
+    if (!(item.lat_min <= item.lat_max && item.lon_min <= item.lon_max)) {
+      item.lat_min = item.lon_min = -1e9;
+      item.lat_max = item.lon_max = 1e9;
+    }
+    index.objects.push_back(top);
+    index.boxes.push_back(item);
+  }
+  index.tree.Build(index.boxes);
+  index.margin = 0;
+  index.stale = false;
+}
+
+void s57chart::UpdateViewMargin() {
+  if (!m_view_index) return;
+  for (int id : m_view_ids) {
+    m_view_index->margin =
+        std::max(m_view_index->margin,
+                 BoxExcess(m_view_index->boxes[id], m_view_index->objects[id]));
+  }
+}
+
+const std::vector<ObjRazRules *> &s57chart::GetViewObjects(int prio,
+                                                           int type) {
+  // Rendering the previous result may have grown the boxes
+  UpdateViewMargin();
+
+  const LLBBox &box = ps52plib->GetBBox();
+  const double span = std::max(box.GetMaxLat() - box.GetMinLat(),
+                               box.GetMaxLon() - box.GetMinLon());
+  ObjListIndex &index = m_obj_index[prio][type];
+  if (index.stale || index.margin > span)
+    BuildObjIndex(index, razRules[prio][type]);
+
+  // Also cover float rounding of the indexed boxes
+  const double margin = index.margin + 1e-4;
+  // Sorted ids keep the list order, also across the antimeridian
+  index.tree.QueryView(box.GetMinLat() - margin, box.GetMaxLat() + margin,
+                       box.GetMinLon() - margin, box.GetMaxLon() + margin,
+                       m_view_ids);
+
+  m_view_objects.clear();
+  for (int id : m_view_ids) m_view_objects.push_back(index.objects[id]);
+  m_view_index = &index;
+
+  m_render_stats.listed += index.objects.size();
+  m_render_stats.visited += m_view_objects.size();
+  return m_view_objects;
+}
+
 //      Traverse the ObjRazRules tree, and fill in
 //      any Lups/rules not linked on initial chart load.
 //      For example, if chart was loaded with PAPER_CHART symbols,
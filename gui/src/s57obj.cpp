@@ -162,6 +162,14 @@ void S57Obj::Init() {
   iOBJL = -1;  // deferred, done by OBJL filtering in the PLIB as needed
   bBBObj_valid = false;
 
+  m_render_key = 0;  // nothing cached, see s52plib::ObjectRenderCheckRules()
+  m_render_lup = NULL;
+  m_render_cat = OTHER;
+  m_render_filter = 0;
+  m_render_dated = true;
+  m_render_cs = NULL;
+  m_render_uses_cs = false;
+
   //        Set default (unity) auxiliary transform coefficients
   x_rate = 1.0;
   y_rate = 1.0;
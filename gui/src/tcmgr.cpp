@@ -29,6 +29,9 @@
 #endif  // precompiled headers
 #include <wx/hashmap.h>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <stdlib.h>
 #include <math.h>
 #include <time.h>
@@ -38,6 +41,7 @@
 #include "navutil.h"
 #include "tcmgr.h"
 #include "model/georef.h"
+#include "model/harmonic_series.h"
 #include "model/logger.h"
 
 //-----------------------------------------------------------------------------------
@@ -79,6 +83,60 @@ double time2atide(time_t t, IDX_entry *pIDX) {
   return BOGUS_amplitude(time2tide(t, pIDX), pIDX) + pIDX->pref_sta_data->DATUM;
 }
 
+/* Calculate the denormalized tide at count times t0, t0 + step, ... into
+ *   out. The constituents are evaluated for all times at once, which is
+ *   many times faster than time2atide() for each time. Returns false and
+ *   leaves out alone if the times are not all in the same year, away from
+ *   the new years blending done by time2dt_tide(). */
+static bool time2atide_series(time_t t0, int step, int count, IDX_entry *pIDX,
+                              double *out) {
+  if (step <= 0 || count <= 0) return false;
+  time_t t1 = t0 + (time_t)step * (count - 1);
+  int year = yearoftimet(t0 - TIDE_BLEND_TIME - 1);
+  if (yearoftimet(t1 + TIDE_BLEND_TIME + 1) != year) return false;
+  if (pIDX->epoch_year != year) happy_new_year(pIDX, year);
+
+  /* Same terms as _time2dt_tide(), with phases at t0. */
+  HarmonicSeries series;
+  double t_rel = (long)(t0 - pIDX->epoch) + pIDX->pref_sta_data->meridian;
+  for (int a = 0; a < pIDX->num_csts; a++) {
+    double phase = pIDX->m_cst_speeds[a] * t_rel +
+                   pIDX->m_cst_epochs[a][pIDX->epoch_year - pIDX->first_year] -
+                   pIDX->pref_sta_data->epoch[a];
+    series.Add(pIDX->m_work_buffer[a], pIDX->m_cst_speeds[a], phase);
+  }
+  series.Evaluate(step, count, out);
+
+  for (int k = 0; k < count; k++)
+    out[k] = BOGUS_amplitude(out[k], pIDX) + pIDX->pref_sta_data->DATUM;
+  return true;
+}
+
+/* Denormalized tide at whole minutes as scanned by next_big_event(),
+ *   computed in batches. */
+struct MinuteTide {
+  static const int kBatch = 120;
+
+  explicit MinuteTide(IDX_entry *p) : pIDX(p), start(0), count(0) {}
+
+  double Get(time_t t) {
+    if (t >= start && t < start + 60 * count && (t - start) % 60 == 0)
+      return values[(t - start) / 60];
+    if (time2atide_series(t, 60, kBatch, pIDX, values)) {
+      start = t;
+      count = kBatch;
+      return values[0];
+    }
+    count = 0;  // Close to new year, no batches
+    return time2atide(t, pIDX);
+  }
+
+  IDX_entry *pIDX;
+  time_t start;
+  int count;
+  double values[kBatch];
+};
+
 /* Next high tide, low tide, transition of the mark level, or some
  *   combination.
  *       Bit      Meaning
@@ -90,9 +148,10 @@ double time2atide(time_t t, IDX_entry *pIDX) {
 int next_big_event(time_t *tm, IDX_entry *pIDX) {
   double p, q;
   int flags = 0, slope = 0;
-  p = time2atide(*tm, pIDX);
+  MinuteTide tide(pIDX);
+  p = tide.Get(*tm);
   *tm += 60;
-  q = time2atide(*tm, pIDX);
+  q = tide.Get(*tm);
   *tm += 60;
   if (p < q) slope = 1;
   while (1) {
@@ -147,7 +206,7 @@ int next_big_event(time_t *tm, IDX_entry *pIDX) {
       return flags;
     }
     p = q;
-    q = time2atide(*tm, pIDX);
+    q = tide.Get(*tm);
     *tm += 60;
   }
 }
@@ -193,8 +252,9 @@ double time2asecondary(time_t t, IDX_entry *pIDX) {
 #define intervalwidth 15
 #define stretchfactor 3
 
-    static time_t lowtime = 0, hightime = 0;
-    static double lowlvl, highlvl; /* Normalized tide levels for MIN, MAX */
+    /* Normalized tide levels for MIN, MAX, kept per station */
+    time_t &lowtime = pIDX->sec_low_time, &hightime = pIDX->sec_high_time;
+    double &lowlvl = pIDX->sec_low_level, &highlvl = pIDX->sec_high_level;
     time_t T;                      /* Adjusted t */
     double S, Z, HI, HS, magicnum;
     time_t interval = 3600 * intervalwidth;
@@ -635,6 +695,8 @@ TCMgr::~TCMgr() { PurgeData(); }
 
 void TCMgr::PurgeData() {
   m_Combined_IDX_array.clear();
+  m_tide_index.Clear();
+  m_current_index.Clear();
 
   //  Delete all the data sources
   m_source_array.Clear();
@@ -685,9 +747,23 @@ TC_Error_Code TCMgr::LoadDataSources(std::vector<std::string> &sources) {
         _("OpenCPN Info"), wxOK | wxCENTER);
 
   ScrubCurrentDepths();
+  BuildStationIndex();
   return TC_NO_ERROR;
 }
 
+void TCMgr::BuildStationIndex() {
+  m_tide_index.Clear();
+  m_current_index.Clear();
+  for (int i = 1; i < Get_max_IDX() + 1; i++) {
+    const IDX_entry *pIDX = m_Combined_IDX_array[i];
+    char type = pIDX->IDX_type;
+    if (type == 't' || type == 'T')
+      m_tide_index.Update(i, pIDX->IDX_lat, pIDX->IDX_lon);
+    else if (type == 'c' || type == 'C')
+      m_current_index.Update(i, pIDX->IDX_lat, pIDX->IDX_lon);
+  }
+}
+
 void TCMgr::ScrubCurrentDepths() {
   //  Process Current stations reporting values at multiple depths
   //  Identify and mark the shallowest record, as being most usable to OCPN
@@ -785,9 +861,14 @@ bool TCMgr::GetTideOrCurrent(time_t t, int idx, float &tcvalue, float &dir) {
 
 extern wxDateTime gTimeSource;
 
+//    Values cached by GetTideOrCurrent15(): one day at 15 minute steps,
+//    starting four hours before the first time asked for.
+#define CURVE15_STEP (15 * 60)
+#define CURVE15_LENGTH 96
+#define CURVE15_LEAD 16
+
 bool TCMgr::GetTideOrCurrent15(time_t t_d, int idx, float &tcvalue, float &dir,
                                bool &bnew_val) {
-  int ret;
   IDX_entry *pIDX = m_Combined_IDX_array[idx];  // point to the index entry
 
   if (!pIDX) {
@@ -818,40 +899,79 @@ bool TCMgr::GetTideOrCurrent15(time_t t_d, int idx, float &tcvalue, float &dir,
   int t_mins = (t_at_station - t_today_00_at_station) / 60;
   int t_15s = t_mins / 15;
 
-  if (pIDX->Valid15)  // valid data available
-  {
-    int tref1 = t_today_00_at_station + t_15s * 15 * 60;
-    if (tref1 == pIDX->Valid15) {
-      tcvalue = pIDX->Value15;
-      dir = pIDX->Dir15;
-      bnew_val = false;
-      return pIDX->Ret15;
-    } else {
-      int tref = t_today_00_at_station + t_15s * 15 * 60;
-      ret = GetTideOrCurrent(tref, idx, tcvalue, dir);
-
-      pIDX->Valid15 = tref;
-      pIDX->Value15 = tcvalue;
-      pIDX->Dir15 = dir;
-      pIDX->Ret15 = !(ret == 0);
-      bnew_val = true;
-
-      return !(ret == 0);
+  time_t tref = t_today_00_at_station + t_15s * 15 * 60;
+
+  //    Look up the value in the cached curve, moving the curve to start a
+  //    few hours before tref if tref is outside it.
+  time_t curve_end = pIDX->curve15_start + CURVE15_LENGTH * CURVE15_STEP;
+  if (!pIDX->curve15 || tref < pIDX->curve15_start || tref >= curve_end ||
+      (tref - pIDX->curve15_start) % CURVE15_STEP) {
+    if (!pIDX->curve15)
+      pIDX->curve15 = (float *)malloc(CURVE15_LENGTH * sizeof(float));
+    pIDX->curve15_start = tref - CURVE15_LEAD * CURVE15_STEP;
+    for (int i = 0; i < CURVE15_LENGTH; i++) pIDX->curve15[i] = NAN;
+  }
+  int slot = (tref - pIDX->curve15_start) / CURVE15_STEP;
+
+  bnew_val = false;
+  if (std::isnan(pIDX->curve15[slot])) {
+    //    Stations without offsets are computed for the whole curve at
+    //    about the cost of a single value, others one value at a time.
+    int first = pIDX->have_offsets ? slot : 0;
+    int count = pIDX->have_offsets ? 1 : CURVE15_LENGTH;
+    float *values = pIDX->curve15 + first;
+    if (!GetTideOrCurrentSeries(pIDX->curve15_start + first * CURVE15_STEP,
+                                CURVE15_STEP, count, idx, values, NULL)) {
+      for (int i = 0; i < count; i++) values[i] = NAN;
+      dir = 0;
+      tcvalue = 0;
+      return false;
     }
+    bnew_val = true;
   }
 
-  else {
-    int tref = t_today_00_at_station + t_15s * 15 * 60;
-    ret = GetTideOrCurrent(tref, idx, tcvalue, dir);
+  tcvalue = pIDX->curve15[slot];
+  dir = tcvalue >= 0 ? pIDX->IDX_flood_dir : pIDX->IDX_ebb_dir;
+  return true;
+}
 
-    pIDX->Valid15 = tref;
-    pIDX->Value15 = tcvalue;
-    pIDX->Dir15 = dir;
-    pIDX->Ret15 = !(ret == 0);
-    bnew_val = true;
+bool TCMgr::GetTideOrCurrentSeries(time_t t, int step, int count, int idx,
+                                   float *tcvalue, float *dir) {
+  IDX_entry *pIDX = m_Combined_IDX_array[idx];  // point to the index entry
+
+  if (pIDX && pIDX->IDX_Useable && !pIDX->have_offsets) {
+    //    Same preparation as GetTideOrCurrent()
+    if (pIDX->pDataSource &&
+        pIDX->pDataSource->LoadHarmonicData(pIDX) != TC_NO_ERROR) {
+      for (int k = 0; k < count; k++) {
+        tcvalue[k] = 0;
+        if (dir) dir[k] = 0;
+      }
+      return false;
+    }
+    pIDX->max_amplitude = 0.0;  // Force multiplier re-compute
+    happy_new_year(pIDX, yearoftimet(t));
+
+    std::vector<double> levels(count);
+    if (time2atide_series(t + pIDX->station_tz_offset, step, count, pIDX,
+                          levels.data())) {
+      for (int k = 0; k < count; k++) {
+        tcvalue[k] = levels[k];
+        if (dir)
+          dir[k] = levels[k] >= 0 ? pIDX->IDX_flood_dir : pIDX->IDX_ebb_dir;
+      }
+      return true;
+    }
   }
 
-  return !(ret == 0);
+  //    Offsets, or close to new year: one value at a time
+  bool ret = true;
+  for (int k = 0; k < count; k++) {
+    float d;
+    ret &= GetTideOrCurrent(t + (time_t)step * k, idx, tcvalue[k], d);
+    if (dir) dir[k] = d;
+  }
+  return ret;
 }
 
 bool TCMgr::GetTideFlowSens(time_t t, int sch_step, int idx, float &tcvalue_now,
@@ -1018,27 +1138,67 @@ std::wstring TCMgr::GetTidalEventStr(int station_id, wxDateTime ref_dt,
   return event_str;
 }
 
-std::map<double, const IDX_entry *> TCMgr::GetStationsForLL(double xlat,
-                                                            double xlon) const {
+std::map<double, const IDX_entry *> TCMgr::GetStationsForLL(
+    double xlat, double xlon, int max_count) const {
   std::map<double, const IDX_entry *> x;
-  const IDX_entry *lpIDX;
-
-  for (int j = 1; j < Get_max_IDX() + 1; j++) {
-    lpIDX = GetIDX_entry(j);
-    char type = lpIDX->IDX_type;
-    wxString locnx(lpIDX->IDX_station_name, wxConvUTF8);
-
-    if (type == 't' || type == 'T') {
+  if (max_count <= 0) return x;
+
+  //    Widen the search until it holds enough stations. Only stations
+  //    within the radius are certain to be the closest ones, the query box
+  //    may hold more distant ones too.
+  std::vector<int> found;
+  for (double radius = 10.; (int)x.size() < max_count; radius *= 4) {
+    bool whole_world = radius > 180. * 60.;
+    found.clear();
+    m_tide_index.Query(xlat, xlon, radius, found);
+    x.clear();
+    for (int j : found) {
+      const IDX_entry *lpIDX = m_Combined_IDX_array[j];
       double brg, dist;
       DistanceBearingMercator(xlat, xlon, lpIDX->IDX_lat, lpIDX->IDX_lon, &brg,
                               &dist);
-      x.emplace(std::make_pair(dist, lpIDX));
+      if (dist <= radius || whole_world) x.emplace(std::make_pair(dist, lpIDX));
     }
+    if (whole_world) break;
   }
 
+  while ((int)x.size() > max_count) x.erase(std::prev(x.end()));
   return x;
 }
 
+std::vector<int> TCMgr::GetStationsInBBox(const LLBBox &bbox, double marge,
+                                          char type) const {
+  std::vector<int> found;
+  const LLGridIndex<int> &index =
+      (type == 'c' || type == 'C') ? m_current_index : m_tide_index;
+
+  //    Candidates from the index, LLBBox longitudes may run past +-180
+  double lon_min = bbox.GetMinLon() - marge;
+  double lon_max = bbox.GetMaxLon() + marge;
+  if (lon_max - lon_min >= 360.) {
+    lon_min = -180.;
+    lon_max = 180.;
+  } else {
+    while (lon_min < -180.) lon_min += 360.;
+    while (lon_min > 180.) lon_min -= 360.;
+    while (lon_max < -180.) lon_max += 360.;
+    while (lon_max > 180.) lon_max -= 360.;
+  }
+  index.QueryBox(bbox.GetMinLat() - marge, bbox.GetMaxLat() + marge, lon_min,
+                 lon_max, found);
+
+  //    Same test as a loop over all stations, in the same order
+  found.erase(std::remove_if(found.begin(), found.end(),
+                             [&](int i) {
+                               const IDX_entry *pIDX = m_Combined_IDX_array[i];
+                               return !bbox.ContainsMarge(
+                                   pIDX->IDX_lat, pIDX->IDX_lon, marge);
+                             }),
+              found.end());
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
 int TCMgr::GetStationIDXbyName(const wxString &prefix, double xlat,
                                double xlon) const {
   const IDX_entry *lpIDX;
@@ -29,26 +29,19 @@
 #include <string.h>
 #include <math.h>
 
-#if defined(__OCPN__ANDROID__)
- //#include <GLES2/gl2.h>
- #include <qopengl.h>
- #include <GL/gl_private.h>  // this is a cut-down version of gl.h
- #include <GLES2/gl2.h>
-#elif defined(__MSVC__)
- #include "glew.h"
- #include <GL/glu.h>
- // typedef void (__stdcall * _GLUfuncptr)(void);
-#elif defined(__WXOSX__)
- #include <OpenGL/gl.h>
- #include <OpenGL/glu.h>
- typedef void (*  _GLUfuncptr)();
- #define GL_COMPRESSED_RGB_FXT1_3DFX       0x86B0
-#elif defined(__WXQT__) || defined(__WXGTK__)
- #include <GL/glew.h>
- #include <GL/glu.h>
-#endif
+#include <algorithm>
+#include <utility>
 
 #include "LLRegion.h"
+#include "poly_clip.h"
+
+// Coordinate rounding, about 1cm on earth's surface at equator
+static const double kRoundingEps = 6e-6;
+
+// Clipping is retried on a grid this much coarser if snap rounding does not
+// settle, up to kClipAttempts times
+static const double kClipRetryScale = 1.1;
+static const int kClipAttempts = 4;
 
 static inline double cross(const contour_pt &v1, const contour_pt &v2) {
   return v1.y * v2.x - v1.x * v2.y;
@@ -95,7 +88,7 @@ bool LLRegion::PointsCCW(size_t n, const double *points) {
 }
 
 void LLRegion::Print() const {
-  for (std::list<poly_contour>::const_iterator i = contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = contours.begin();
        i != contours.end(); i++) {
     printf("[");
     for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
@@ -108,7 +101,7 @@ void LLRegion::plot(const char *fn) const {
   char filename[100] = "/home/sean/";
   strcat(filename, fn);
   FILE *f = fopen(filename, "w");
-  for (std::list<poly_contour>::const_iterator i = contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = contours.begin();
        i != contours.end(); i++) {
     for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
       fprintf(f, "%f %f\n", j->x, j->y);
@@ -127,7 +120,7 @@ LLBBox LLRegion::GetBox() const {
   // there are 3 possible longitude bounds: -180 to 180, 0 to 360, -360 to 0
   double minlat = 90, minlon[3] = {180, 360, 0};
   double maxlat = -90, maxlon[3] = {-180, 0, -360};
-  for (std::list<poly_contour>::const_iterator i = contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = contours.begin();
        i != contours.end(); i++) {
     bool neg = false, pos = false;
     for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
@@ -210,7 +203,7 @@ bool LLRegion::Contains(float lat, float lon) const {
   if (lon > 180) return Contains(lat, lon - 360);
 
   int cnt = 0;
-  for (std::list<poly_contour>::const_iterator i = contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = contours.begin();
        i != contours.end(); i++) {
     contour_pt l = *i->rbegin();
     for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++) {
@@ -238,77 +231,13 @@ bool LLRegion::Contains(float lat, float lon) const {
   return cnt & 1;
 }
 
-struct work {
-  work(LLRegion &r) : region(r) { tobj = gluNewTess(); }
-
-  ~work() {
-    gluDeleteTess(tobj);
-    for (std::list<double *>::iterator i = data.begin(); i != data.end(); i++)
-      delete[] * i;
-    data.clear();
-  }
-
-  double *NewData() {
-    double *d = new double[3];
-    data.push_back(d);
-    return d;
-  }
-
-  void PutVertex(const contour_pt &j) {
-    double *p = NewData();
-    p[0] = j.x, p[1] = j.y, p[2] = 0;
-    gluTessVertex(tobj, p, p);
-  }
-
-  std::list<double *> data;
-  poly_contour contour;
-  GLUtesselator *tobj;
-  LLRegion &region;
-};
-
-static void /*APIENTRY*/ LLvertexCallback(GLvoid *vertex, void *user_data) {
-  work *w = (work *)user_data;
-  const GLdouble *pointer = (GLdouble *)vertex;
-  contour_pt p;
-  p.x = pointer[0], p.y = pointer[1];
-  w->contour.push_back(p);
-}
-
-static void /*APIENTRY*/ LLbeginCallback(GLenum which) {}
-
-static void /*APIENTRY*/ LLendCallback(void *user_data) {
-  work *w = (work *)user_data;
-  if (w->contour.size()) {
-    w->region.contours.push_back(w->contour);
-    w->contour.clear();
-  }
-}
-
-static void /*APIENTRY*/ LLcombineCallback(GLdouble coords[3],
-                                           GLdouble *vertex_data[4],
-                                           GLfloat weight[4],
-                                           GLdouble **dataOut,
-                                           void *user_data) {
-  work *w = (work *)user_data;
-  GLdouble *vertex = w->NewData();
-  memcpy(vertex, coords, 3 * (sizeof *coords));
-  *dataOut = vertex;
-}
-
-static void /*APIENTRY*/ LLerrorCallback(GLenum errorCode) {
-  const GLubyte *estring;
-  estring = gluErrorString(errorCode);
-  //LOG_INFO("Tessellation Error: %s\n", estring);
-  // exit (0);
-}
-
 void LLRegion::Intersect(const LLRegion &region) {
   if (NoIntersection(region)) {
     Clear();
     return;
   }
 
-  Put(region, GLU_TESS_WINDING_ABS_GEQ_TWO, false);
+  Put(region, PolyFillRule::kAbsGeqTwo, false);
 }
 
 void LLRegion::Union(const LLRegion &region) {
@@ -317,36 +246,36 @@ void LLRegion::Union(const LLRegion &region) {
     return;
   }
 
-  Put(region, GLU_TESS_WINDING_POSITIVE, false);
+  Put(region, PolyFillRule::kPositive, false);
 }
 
 void LLRegion::Subtract(const LLRegion &region) {
   if (NoIntersection(region)) return;
 
-  Put(region, GLU_TESS_WINDING_POSITIVE, true);
+  Put(region, PolyFillRule::kPositive, true);
 }
 
 void LLRegion::Reduce(double factor) {
   double factor2 = factor * factor;
 
-  std::list<poly_contour>::iterator i = contours.begin();
+  std::vector<poly_contour>::iterator i = contours.begin();
   while (i != contours.end()) {
     if (i->size() < 3) {
       printf("invalid contour");
+      i = contours.erase(i);
       continue;
     }
 
-    // reduce segments
+    // reduce segments, compacting the kept points in place
     contour_pt l = *i->rbegin();
-    poly_contour::iterator j = i->begin(), k;
-    while (j != i->end()) {
-      k = j;
-      j++;
-      if (dist2(vector(*k, l)) < factor2)
-        i->erase(k);
-      else
-        l = *k;
+    size_t n = 0;
+    for (size_t j = 0; j < i->size(); j++) {
+      if (dist2(vector((*i)[j], l)) >= factor2) {
+        l = (*i)[j];
+        (*i)[n++] = l;
+      }
     }
+    i->resize(n);
 
     // erase zero contours
     if (i->size() < 3)
@@ -368,7 +297,7 @@ bool LLRegion::NoIntersection(const LLBBox &box) const {
         return false;
 
     // test if any segment crosses the box
-    for(std::list<poly_contour>::const_iterator i = contours.begin(); i != contours.end(); i++) {
+    for(std::vector<poly_contour>::const_iterator i = contours.begin(); i != contours.end(); i++) {
         contour_pt l = *i->rbegin();
         int state = ComputeState(box, l), lstate = state;
         if(state == 4) return false;
@@ -452,42 +381,24 @@ bool LLRegion::NoIntersection(const LLRegion &region) const {
          region.NoIntersection(box);
 }
 
-void LLRegion::PutContours(work &w, const LLRegion &region, bool reverse) {
-  for (std::list<poly_contour>::const_iterator i = region.contours.begin();
-       i != region.contours.end(); i++) {
-    gluTessBeginContour(w.tobj);
-    if (reverse)
-      for (poly_contour::const_reverse_iterator j = i->rbegin(); j != i->rend();
-           j++)
-        w.PutVertex(*j);
-    else
-      for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
-        w.PutVertex(*j);
-    gluTessEndContour(w.tobj);
+void LLRegion::Put(const LLRegion &region, PolyFillRule rule, bool reverse) {
+  std::vector<poly_contour> result;
+  double eps = kRoundingEps;
+  for (int attempt = 0;; attempt++) {
+    PolyClipper clipper(eps);
+    clipper.Add(contours);
+    clipper.Add(region.contours, reverse);
+    if (clipper.Execute(rule, result)) break;
+    if (attempt + 1 == kClipAttempts) {
+      wxLogMessage("LLRegion: unresolved crossings, region not clipped");
+      if (rule == PolyFillRule::kPositive && !reverse) Combine(region);
+      return;
+    }
+    // Crossings snapped close to other edges keep creating new ones, a
+    // slightly coarser grid moves all snapped points
+    eps *= kClipRetryScale;
   }
-}
-
-void LLRegion::Put(const LLRegion &region, int winding_rule, bool reverse) {
-  work w(*this);
-
-  gluTessCallback(w.tobj, GLU_TESS_VERTEX_DATA, (_GLUfuncptr)&LLvertexCallback);
-  gluTessCallback(w.tobj, GLU_TESS_BEGIN, (_GLUfuncptr)&LLbeginCallback);
-  gluTessCallback(w.tobj, GLU_TESS_COMBINE_DATA,
-                  (_GLUfuncptr)&LLcombineCallback);
-  gluTessCallback(w.tobj, GLU_TESS_END_DATA, (_GLUfuncptr)&LLendCallback);
-  gluTessCallback(w.tobj, GLU_TESS_ERROR, (_GLUfuncptr)&LLerrorCallback);
-  gluTessProperty(w.tobj, GLU_TESS_WINDING_RULE, winding_rule);
-  gluTessProperty(w.tobj, GLU_TESS_BOUNDARY_ONLY, GL_TRUE);
-  //    gluTessProperty(w.tobj, GLU_TESS_TOLERANCE, 1e-5);
-
-  gluTessNormal(w.tobj, 0, 0, 1);
-
-  gluTessBeginPolygon(w.tobj, &w);
-
-  PutContours(w, *this);
-  PutContours(w, region, reverse);
-  contours.clear();
-  gluTessEndPolygon(w.tobj);
+  contours = std::move(result);
 
   Optimize();
   m_box.Invalidate();
@@ -495,9 +406,8 @@ void LLRegion::Put(const LLRegion &region, int winding_rule, bool reverse) {
 
 // same result as union, but only allowed if there is no intersection
 void LLRegion::Combine(const LLRegion &region) {
-  for (std::list<poly_contour>::const_iterator i = region.contours.begin();
-       i != region.contours.end(); i++)
-    contours.push_back(*i);
+  contours.insert(contours.end(), region.contours.begin(),
+                  region.contours.end());
   m_box.Invalidate();
 }
 
@@ -522,7 +432,8 @@ void LLRegion::InitPoints(size_t n, const double *points) {
     return;
   }
 
-  std::list<contour_pt> pts;
+  poly_contour pts;
+  pts.reserve(n);
   bool adjust = false;
 
   bool ccw = PointsCCW(n, points);
@@ -531,13 +442,11 @@ void LLRegion::InitPoints(size_t n, const double *points) {
     p.y = points[i + 0];
     p.x = points[i + 1];
     if (p.x < -180 || p.x > 180) adjust = true;
-    if (ccw)
-      pts.push_back(p);
-    else
-      pts.push_front(p);
+    pts.push_back(p);
   }
+  if (!ccw) std::reverse(pts.begin(), pts.end());
 
-  contours.push_back(pts);
+  contours.push_back(std::move(pts));
 
   if (adjust) AdjustLongitude();
   Optimize();
@@ -551,7 +460,7 @@ void LLRegion::AdjustLongitude() {
   if (!resolved.Empty()) {
     Intersect(clip);
     // apply longitude offset
-    for (std::list<poly_contour>::iterator i = resolved.contours.begin();
+    for (std::vector<poly_contour>::iterator i = resolved.contours.begin();
          i != resolved.contours.end(); i++)
       for (poly_contour::iterator j = i->begin(); j != i->end(); j++)
         if (j->x > 0)
@@ -565,15 +474,16 @@ void LLRegion::AdjustLongitude() {
 
 void LLRegion::Optimize() {
   // merge parallel segments
-  std::list<poly_contour>::iterator i = contours.begin();
+  std::vector<poly_contour>::iterator i = contours.begin();
   while (i != contours.end()) {
     if (i->size() < 3) {
       printf("invalid contour");
+      i = contours.erase(i);
       continue;
     }
 
     // Round coordinates to avoid numerical errors in region computations
-    const double eps = 6e-6;  // about 1cm on earth's surface at equator
+    const double eps = kRoundingEps;
     for (poly_contour::iterator j = i->begin(); j != i->end(); j++) {
       // j->x -= fmod(j->x, 1e-8);
       j->x = round(j->x / eps) * eps;
@@ -589,22 +499,16 @@ void LLRegion::Optimize() {
 #endif
 
     // eliminiate parallel segments
-    poly_contour::iterator j = i->begin();
-    int s = i->size();
-    for (int c = 0; c < s; c++) {
-      poly_contour::iterator l = j, k = j;
-
-      if (l == i->begin()) l = i->end();
-      l--;
-
-      k++;
-      if (k == i->end()) k = i->begin();
-
-      if (l == k) break;
-      if (fabs(cross(vector(*j, *l), vector(*j, *k))) < 1e-12) {
-        i->erase(j);
-        j = l;
-        c--;
+    poly_contour &c = *i;
+    size_t s = c.size();
+    size_t j = 0;
+    for (size_t count = 0; count < s && c.size() >= 3; count++) {
+      size_t l = j == 0 ? c.size() - 1 : j - 1;
+      size_t k = j + 1 == c.size() ? 0 : j + 1;
+      if (fabs(cross(vector(c[j], c[l]), vector(c[j], c[k]))) < 1e-12) {
+        c.erase(c.begin() + j);
+        j = l < j ? l : l - 1;
+        count--;
       } else
         j = k;
     }
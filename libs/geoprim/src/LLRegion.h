@@ -27,7 +27,7 @@
 #ifndef _LLREGION_H_
 #define _LLREGION_H_
 
-#include <list>
+#include <vector>
 
 #include "bbox.h"
 
@@ -39,10 +39,10 @@ struct contour_pt {
 // LLRegion
 // ----------------------------------------------------------------------------
 
-typedef std::list<contour_pt> poly_contour;
+typedef std::vector<contour_pt> poly_contour;
 class LLBBox;
 
-struct work;
+enum class PolyFillRule;
 class LLRegion {
 public:
   LLRegion() {}
@@ -70,13 +70,12 @@ public:
 
   void Reduce(double factor);
 
-  std::list<poly_contour> contours;
+  std::vector<poly_contour> contours;
 
 private:
   bool NoIntersection(const LLBBox& box) const;
   bool NoIntersection(const LLRegion& region) const;
-  void PutContours(work& w, const LLRegion& region, bool reverse = false);
-  void Put(const LLRegion& region, int winding_rule, bool reverse = false);
+  void Put(const LLRegion& region, PolyFillRule rule, bool reverse = false);
   void Combine(const LLRegion& region);
   void InitBox(float minlat, float minlon, float maxlat, float maxlon);
   void InitPoints(size_t n, const double* points);
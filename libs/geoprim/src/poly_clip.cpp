@@ -0,0 +1,380 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Polygon boolean operations on fixed point coordinates
+ *
+ ***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "poly_clip.h"
+
+/**
+ * Snap rounding intersections may create new crossings close to the
+ * snapped points, splitting is repeated until none remains. Execute()
+ * gives up if crossings remain after this many rounds.
+ */
+static const int kMaxSplitRounds = 8;
+
+static const double kPi = 3.14159265358979323846;
+
+/**
+ * Twice the signed area of triangle a, b, c: positive if c is left of
+ * a -> b. Grid coordinates are within +/- 2^31, so no overflow.
+ */
+template <typename P>
+static inline int64_t Orient(const P& a, const P& b, const P& c) {
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static inline int Sign(int64_t v) { return (v > 0) - (v < 0); }
+
+/** Return true if p, known to be on line a-b, is strictly between them. */
+template <typename P>
+static inline bool StrictlyInside(const P& p, const P& a, const P& b) {
+  return (p.x - a.x) * (b.x - a.x) + (p.y - a.y) * (b.y - a.y) > 0 &&
+         (p.x - b.x) * (a.x - b.x) + (p.y - b.y) * (a.y - b.y) > 0;
+}
+
+void PolyClipper::Add(const std::vector<poly_contour>& contours,
+                      bool reverse) {
+  for (const auto& contour : contours) {
+    if (contour.size() < 3) continue;
+    Point last = {std::llround(contour.back().x / m_resolution),
+                  std::llround(contour.back().y / m_resolution)};
+    for (const auto& pt : contour) {
+      Point p = {std::llround(pt.x / m_resolution),
+                 std::llround(pt.y / m_resolution)};
+      if (p == last) continue;
+      if (reverse)
+        m_segments.push_back({p, last});
+      else
+        m_segments.push_back({last, p});
+      last = p;
+    }
+  }
+}
+
+bool PolyClipper::Execute(PolyFillRule rule,
+                          std::vector<poly_contour>& result) {
+  m_dirty.assign(m_segments.size(), true);
+  bool split_done = false;
+  for (int round = 0; round < kMaxSplitRounds && !split_done; round++) {
+    split_done = !SplitSegments();
+  }
+  if (!split_done) {
+    // Linking edges which still cross would give malformed contours
+    m_segments.clear();
+    return false;
+  }
+
+  std::vector<Edge> edges;
+  edges.reserve(m_segments.size());
+  for (const auto& s : m_segments) {
+    if (s.a < s.b)
+      edges.push_back({s.a, s.b, 1, 0});
+    else
+      edges.push_back({s.b, s.a, -1, 0});
+  }
+  MergeEdges(edges);
+  ComputeWinding(edges);
+
+  auto inside = [rule](int winding) {
+    return rule == PolyFillRule::kPositive ? winding > 0
+                                           : std::abs(winding) >= 2;
+  };
+  std::vector<Segment> boundary;
+  for (const auto& e : edges) {
+    const bool in_right = inside(e.right);
+    const bool in_left = inside(e.right + e.wind);
+    if (in_left == in_right) continue;
+    // Keep inside on the left
+    if (in_left)
+      boundary.push_back({e.lo, e.hi});
+    else
+      boundary.push_back({e.hi, e.lo});
+  }
+  m_segments.clear();
+  result = LinkContours(boundary);
+  return true;
+}
+
+/**
+ * Split all segments where they cross or touch another one. Candidates
+ * are found sweeping over segments sorted on their min x, keeping the
+ * ones overlapping the sweep line active. Pairs of segments not split in
+ * the previous round are known to be clean and skipped. Return true if
+ * any segment was split.
+ */
+bool PolyClipper::SplitSegments() {
+  const size_t n = m_segments.size();
+  std::vector<size_t> order(n);
+  for (size_t i = 0; i < n; i++) order[i] = i;
+  auto min_x = [&](size_t i) {
+    return std::min(m_segments[i].a.x, m_segments[i].b.x);
+  };
+  std::sort(order.begin(), order.end(),
+            [&](size_t i, size_t j) { return min_x(i) < min_x(j); });
+
+  m_splits.clear();
+  auto add_split = [&](size_t i, const Point& p) {
+    m_splits.push_back({i, p});
+  };
+
+  // Extents of active segments, kept compact for the inner loop
+  struct Active {
+    int64_t max_x;
+    int64_t min_y;
+    int64_t max_y;
+    size_t index;
+  };
+  std::vector<Active> active;
+  for (size_t i : order) {
+    const Segment& s = m_segments[i];
+    const int64_t sx0 = min_x(i);
+    const int64_t sy0 = std::min(s.a.y, s.b.y);
+    const int64_t sy1 = std::max(s.a.y, s.b.y);
+    const bool s_dirty = m_dirty[i];
+    size_t kept = 0;
+    for (size_t k = 0; k < active.size(); k++) {
+      const Active act = active[k];
+      if (act.max_x < sx0) continue;  // Left of sweep line
+      active[kept++] = act;
+      if (act.max_y < sy0 || act.min_y > sy1) continue;
+      const size_t j = act.index;
+      if (!s_dirty && !m_dirty[j]) continue;
+
+      const Segment& t = m_segments[j];
+      const int64_t o1 = Orient(s.a, s.b, t.a);
+      const int64_t o2 = Orient(s.a, s.b, t.b);
+      const int64_t o3 = Orient(t.a, t.b, s.a);
+      const int64_t o4 = Orient(t.a, t.b, s.b);
+
+      // Endpoints touching the other segment, also collinear overlaps
+      if (o1 == 0 && StrictlyInside(t.a, s.a, s.b)) add_split(i, t.a);
+      if (o2 == 0 && StrictlyInside(t.b, s.a, s.b)) add_split(i, t.b);
+      if (o3 == 0 && StrictlyInside(s.a, t.a, t.b)) add_split(j, s.a);
+      if (o4 == 0 && StrictlyInside(s.b, t.a, t.b)) add_split(j, s.b);
+
+      // Proper crossing, snap the intersection to the grid
+      if (Sign(o1) * Sign(o2) < 0 && Sign(o3) * Sign(o4) < 0) {
+        const long double r =
+            static_cast<long double>(o3) / (static_cast<long double>(o3) - o4);
+        const Point p = {s.a.x + std::llround(r * (s.b.x - s.a.x)),
+                         s.a.y + std::llround(r * (s.b.y - s.a.y))};
+        if (p != s.a && p != s.b) add_split(i, p);
+        if (p != t.a && p != t.b) add_split(j, p);
+      }
+    }
+    active.resize(kept);
+    active.push_back({std::max(s.a.x, s.b.x), sy0, sy1, i});
+  }
+  if (m_splits.empty()) return false;
+
+  // Replace each split segment by its pieces ordered from a to b.
+  std::sort(m_splits.begin(), m_splits.end(),
+            [&](const Split& l, const Split& r) {
+              if (l.segment != r.segment) return l.segment < r.segment;
+              const Segment& s = m_segments[l.segment];
+              const int64_t dx = s.b.x - s.a.x;
+              const int64_t dy = s.b.y - s.a.y;
+              return (l.point.x - s.a.x) * dx + (l.point.y - s.a.y) * dy <
+                     (r.point.x - s.a.x) * dx + (r.point.y - s.a.y) * dy;
+            });
+  std::vector<Segment> pieces;
+  std::vector<bool> dirty;
+  pieces.reserve(n + m_splits.size());
+  dirty.reserve(n + m_splits.size());
+  size_t k = 0;
+  for (size_t i = 0; i < n; i++) {
+    Point from = m_segments[i].a;
+    const bool split = k < m_splits.size() && m_splits[k].segment == i;
+    for (; k < m_splits.size() && m_splits[k].segment == i; k++) {
+      if (m_splits[k].point == from) continue;
+      pieces.push_back({from, m_splits[k].point});
+      dirty.push_back(true);
+      from = m_splits[k].point;
+    }
+    if (from != m_segments[i].b) {
+      pieces.push_back({from, m_segments[i].b});
+      dirty.push_back(split);
+    }
+  }
+  m_segments.swap(pieces);
+  m_dirty.swap(dirty);
+  return true;
+}
+
+/**
+ * Combine coinciding edges, dropping the ones cancelling each other.
+ * Edges are left sorted on lo, edges starting in the same point bottom
+ * to top.
+ */
+void PolyClipper::MergeEdges(std::vector<Edge>& edges) const {
+  std::sort(edges.begin(), edges.end(), [](const Edge& l, const Edge& r) {
+    if (l.lo != r.lo) return l.lo < r.lo;
+    const int64_t o = Orient(l.lo, l.hi, r.hi);
+    return o != 0 ? o > 0 : l.hi < r.hi;
+  });
+  size_t kept = 0;
+  for (size_t i = 0; i < edges.size();) {
+    Edge e = edges[i];
+    for (i++; i < edges.size() && edges[i].lo == e.lo && edges[i].hi == e.hi;
+         i++) {
+      e.wind += edges[i].wind;
+    }
+    if (e.wind != 0) edges[kept++] = e;
+  }
+  edges.resize(kept);
+}
+
+/**
+ * Sweep from left to right keeping the non-vertical edges crossing the
+ * sweep line sorted bottom to top. Edges only meet at end points, so the
+ * order only changes where edges start or end. The winding number below
+ * a new edge is the one above its neighbour below, for vertical edges
+ * the one above the edge passing below its mid point.
+ */
+void PolyClipper::ComputeWinding(std::vector<Edge>& edges) const {
+  // Edges are sorted on lo, thus on start x. Inserting edges with the
+  // same start bottom to top, each one gets the right neighbour below.
+  std::vector<size_t> ends;
+  ends.reserve(edges.size());
+  for (size_t i = 0; i < edges.size(); i++) {
+    if (edges[i].lo.x != edges[i].hi.x) ends.push_back(i);
+  }
+  std::sort(ends.begin(), ends.end(), [&](size_t l, size_t r) {
+    return edges[l].hi.x < edges[r].hi.x;
+  });
+
+  auto above = [&](size_t e) { return edges[e].right + edges[e].wind; };
+  // True if new edge e, starting at the sweep line, is above edge f
+  auto is_above = [&](const Edge& e, const Edge& f) {
+    int64_t o = Orient(f.lo, f.hi, e.lo);
+    if (o == 0) o = Orient(f.lo, f.hi, e.hi);
+    return o > 0;
+  };
+
+  std::vector<size_t> active;
+  size_t next_start = 0;
+  size_t next_end = 0;
+  while (next_start < edges.size()) {
+    const int64_t x = edges[next_start].lo.x;
+
+    // Remove edges ending at or before x
+    if (next_end < ends.size() && edges[ends[next_end]].hi.x <= x) {
+      while (next_end < ends.size() && edges[ends[next_end]].hi.x <= x) {
+        next_end++;
+      }
+      active.erase(std::remove_if(active.begin(), active.end(),
+                                  [&](size_t e) { return edges[e].hi.x <= x; }),
+                   active.end());
+    }
+
+    // Insert non-vertical edges starting at x
+    size_t first_vertical = edges.size();
+    size_t i = next_start;
+    for (; i < edges.size() && edges[i].lo.x == x; i++) {
+      Edge& e = edges[i];
+      if (e.hi.x == x) {
+        if (first_vertical == edges.size()) first_vertical = i;
+        continue;
+      }
+      auto pos = std::partition_point(
+          active.begin(), active.end(),
+          [&](size_t f) { return is_above(e, edges[f]); });
+      e.right = pos == active.begin() ? 0 : above(*(pos - 1));
+      active.insert(pos, i);
+    }
+
+    // Vertical edges: right side is just right of the sweep line
+    for (size_t v = first_vertical; v < i; v++) {
+      Edge& e = edges[v];
+      if (e.hi.x != x) continue;
+      const Point mid2 = {2 * x, e.lo.y + e.hi.y};
+      auto pos = std::partition_point(
+          active.begin(), active.end(), [&](size_t f) {
+            const Point lo2 = {2 * edges[f].lo.x, 2 * edges[f].lo.y};
+            const Point hi2 = {2 * edges[f].hi.x, 2 * edges[f].hi.y};
+            return Orient(lo2, hi2, mid2) > 0;
+          });
+      e.right = pos == active.begin() ? 0 : above(*(pos - 1));
+    }
+    next_start = i;
+  }
+}
+
+/**
+ * Link directed boundary segments to closed contours. Where several
+ * contours meet in a vertex, continue with the first outgoing segment
+ * clockwise from the incoming one, so touching contours are separated.
+ */
+std::vector<poly_contour> PolyClipper::LinkContours(
+    const std::vector<Segment>& boundary) {
+  std::vector<size_t> by_start(boundary.size());
+  for (size_t i = 0; i < boundary.size(); i++) by_start[i] = i;
+  std::sort(by_start.begin(), by_start.end(), [&](size_t l, size_t r) {
+    return boundary[l].a < boundary[r].a;
+  });
+  std::vector<bool> used(boundary.size(), false);
+
+  auto direction = [](const Point& from, const Point& to) {
+    return std::atan2(static_cast<double>(to.y - from.y),
+                      static_cast<double>(to.x - from.x));
+  };
+
+  std::vector<poly_contour> contours;
+  for (size_t start : by_start) {
+    if (used[start]) continue;
+    poly_contour contour;
+    size_t cur = start;
+    while (true) {
+      used[cur] = true;
+      const Point& from = boundary[cur].a;
+      const Point& to = boundary[cur].b;
+      contour.push_back({from.y * m_resolution, from.x * m_resolution});
+
+      // Candidates: unused segments leaving "to", or the first one
+      auto first = std::partition_point(
+          by_start.begin(), by_start.end(),
+          [&](size_t s) { return boundary[s].a < to; });
+      const double back = direction(to, from);
+      size_t next = boundary.size();
+      double best = 0;
+      for (auto it = first; it != by_start.end() && boundary[*it].a == to;
+           ++it) {
+        if (used[*it] && *it != start) continue;
+        double turn = back - direction(to, boundary[*it].b);
+        while (turn <= 0) turn += 2 * kPi;
+        while (turn > 2 * kPi) turn -= 2 * kPi;
+        if (next == boundary.size() || turn < best) {
+          next = *it;
+          best = turn;
+        }
+      }
+      if (next == boundary.size() || next == start) break;
+      cur = next;
+    }
+    if (contour.size() >= 3) contours.push_back(std::move(contour));
+  }
+  return contours;
+}
@@ -0,0 +1,113 @@
+/***************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose:  Polygon boolean operations on fixed point coordinates
+ *
+ ***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************
+ */
+
+#ifndef _POLY_CLIP_H_
+#define _POLY_CLIP_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "LLRegion.h"
+
+/**
+ * Which parts of the plane are inside given the winding number of the
+ * input contours, as the GLU tessellator winding rules.
+ */
+enum class PolyFillRule {
+  kPositive,  ///< Winding number > 0
+  kAbsGeqTwo  ///< |winding number| >= 2
+};
+
+/**
+ * Boundary of the area covered by a set of contours according to a
+ * PolyFillRule, replacing GLU tessellation with GLU_TESS_BOUNDARY_ONLY.
+ *
+ * Coordinates are snapped to a fixed point grid with given resolution,
+ * all geometric predicates are then exact. Crossing edges are split by a
+ * sweep over the x extent, the winding numbers on both sides of all edges
+ * are computed by a second sweep keeping edges sorted on y. Edges
+ * separating inside from outside are finally linked to contours.
+ *
+ * The result has outer contours counter clockwise and holes clockwise,
+ * contours touching in a vertex are returned separately.
+ */
+class PolyClipper {
+public:
+  /** @param resolution Grid size in input units */
+  explicit PolyClipper(double resolution) : m_resolution(resolution) {}
+
+  /** Add contours, optionally with reversed orientation. */
+  void Add(const std::vector<poly_contour>& contours, bool reverse = false);
+
+  /**
+   * Compute the boundary of the area inside according to rule.
+   * @return false, leaving result untouched, if edges still cross after
+   *         the max number of split rounds.
+   */
+  bool Execute(PolyFillRule rule, std::vector<poly_contour>& result);
+
+  void Clear() { m_segments.clear(); }
+
+private:
+  struct Point {
+    int64_t x;
+    int64_t y;
+    bool operator==(const Point& o) const { return x == o.x && y == o.y; }
+    bool operator!=(const Point& o) const { return !(*this == o); }
+    bool operator<(const Point& o) const {
+      return x < o.x || (x == o.x && y < o.y);
+    }
+  };
+
+  struct Segment {
+    Point a;
+    Point b;
+  };
+
+  /** Undirected edge, lo < hi, with winding numbers of both sides. */
+  struct Edge {
+    Point lo;
+    Point hi;
+    int wind;   ///< Sum of +1 for each input edge lo -> hi, -1 for hi -> lo
+    int right;  ///< Winding number right of lo -> hi i. e., below
+  };
+
+  struct Split {
+    size_t segment;
+    Point point;
+  };
+
+  bool SplitSegments();
+  void MergeEdges(std::vector<Edge>& edges) const;
+  void ComputeWinding(std::vector<Edge>& edges) const;
+  std::vector<poly_contour> LinkContours(const std::vector<Segment>& boundary);
+
+  const double m_resolution;
+  std::vector<Segment> m_segments;
+  std::vector<Split> m_splits;
+  std::vector<bool> m_dirty;  ///< Segment split in last round
+};
+
+#endif  // _POLY_CLIP_H_
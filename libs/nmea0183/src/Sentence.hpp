@@ -33,6 +33,11 @@
 #if ! defined( SENTENCE_CLASS_HEADER )
 #define SENTENCE_CLASS_HEADER
 
+#include <string>
+#include <string_view>
+
+#include "field_tokenizer.hpp"
+
 /*
 ** Author: Samuel R. Blackburn
 ** CI$: 76300,326
@@ -67,7 +72,7 @@ class SENTENCE
       virtual COMMUNICATIONS_MODE CommunicationsMode( int field_number ) const;
       virtual double Double( int field_number ) const;
       virtual EASTWEST EastOrWest( int field_number ) const;
-      virtual const wxString& Field( int field_number ) const;
+      virtual wxString Field( int field_number ) const;
       virtual void Finish( void );
       virtual int GetNumberOfDataFields( void ) const;
       virtual int Integer( int field_number ) const;
@@ -78,6 +83,15 @@ class SENTENCE
       virtual TRANSDUCER_TYPE TransducerType( int field_number ) const;
       virtual SENTENCE& Add ( double value, int precision); // Added to allow precision to be changed
 
+      /**
+       * Return field as Field() does, as a view into a copy of Sentence
+       * which is valid until Sentence changes. The sentence is split
+       * into fields once, on the first access after a change.
+       *
+       * Not thread safe, also not for concurrent const access.
+       */
+      std::string_view FieldView( int field_number ) const;
+
       /*
       ** Operators
       */
@@ -94,6 +108,14 @@ class SENTENCE
       virtual const SENTENCE& operator += ( TRANSDUCER_TYPE transducer );
       virtual const SENTENCE& operator += ( NMEA0183_BOOLEAN boolean );
       virtual const SENTENCE& operator += ( LATLONG& source );
+
+   private:
+
+      const FieldTokenizer& GetFields( void ) const;
+
+      mutable wxString m_split_sentence;  // Sentence when last split
+      mutable std::string m_split_text;   // UTF-8 copy of it
+      mutable FieldTokenizer m_fields;
 };
 
 #endif // SENTENCE_CLASS_HEADER
@@ -0,0 +1,137 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "field_tokenizer.hpp"
+
+/**
+ * Invoke f(field) for all fields of text in order, until f returns false.
+ * A field ends at the first NUL, as the remaining characters up to the
+ * next separator are skipped by SENTENCE::Field().
+ */
+template <typename F>
+static void ForEachField(std::string_view text, F f) {
+  const size_t npos = std::string_view::npos;
+  size_t begin = text.empty() ? 0 : 1;  // Skip the '$'
+  size_t content_end = npos;
+  for (size_t i = begin; i < text.size(); i++) {
+    const char c = text[i];
+    if (c == ',' || c == '*') {
+      const size_t end = content_end == npos ? i : content_end;
+      if (!f(text.substr(begin, end - begin))) return;
+      begin = c == '*' ? i : i + 1;
+      content_end = npos;
+    } else if (c == '\0' && content_end == npos) {
+      content_end = i;
+    }
+  }
+  const size_t end = content_end == npos ? text.size() : content_end;
+  f(text.substr(begin, end - begin));
+}
+
+void FieldTokenizer::Split(std::string_view text) {
+  m_text = text;
+  m_count = 0;
+  m_data_fields = -1;
+  ForEachField(text, [&](std::string_view field) {
+    if (m_count < kMaxFields) m_fields[m_count] = field;
+    if (m_data_fields < 0 && !field.empty() && field[0] == '*') {
+      m_data_fields = m_count - 1;
+    }
+    m_count++;
+    return true;
+  });
+  if (m_data_fields < 0) {
+    m_data_fields = m_count - 1;
+    m_past_end = std::string_view();
+  } else {
+    m_past_end = m_text.substr(m_text.rfind('*'), 1);
+  }
+}
+
+std::string_view FieldTokenizer::Scan(int n) const {
+  if (n < 0) return std::string_view();
+  if (n >= m_count) return m_past_end;
+  std::string_view found;
+  int index = 0;
+  ForEachField(m_text, [&](std::string_view field) {
+    found = field;
+    return index++ < n;
+  });
+  return found;
+}
+
+double FieldTokenizer::ToDouble(std::string_view field) {
+  static const double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                  1e18, 1e19, 1e20, 1e21, 1e22};
+  if (field.empty()) return NAN;
+
+  // [sign] digits [. digits] as an integer mantissa and a power of ten.
+  // If both are exact doubles the quotient is correctly rounded.
+  size_t i = 0;
+  const bool negative = field[0] == '-';
+  if (field[0] == '-' || field[0] == '+') i++;
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int decimals = 0;
+  auto is_digit = [&](size_t j) {
+    return j < field.size() && field[j] >= '0' && field[j] <= '9';
+  };
+  for (; is_digit(i); i++, digits++) mantissa = mantissa * 10 + field[i] - '0';
+  if (i < field.size() && field[i] == '.') {
+    for (i++; is_digit(i); i++, digits++, decimals++) {
+      mantissa = mantissa * 10 + field[i] - '0';
+    }
+  }
+  const std::string_view exponent_or_hex = "eExXpP";
+  const bool plain = i == field.size() ||
+                     exponent_or_hex.find(field[i]) == std::string_view::npos;
+  if (plain && digits > 0 && digits <= 19 && decimals <= 22 &&
+      mantissa <= (uint64_t(1) << 53)) {
+    const double value = static_cast<double>(mantissa) / kPow10[decimals];
+    return negative ? -value : value;
+  }
+  // Exponents, hex, leading blanks, inf, nan and so on.
+  const std::string copy(field);
+  return std::atof(copy.c_str());
+}
+
+int FieldTokenizer::ToInt(std::string_view field) {
+  const std::string_view blanks = " \t\n\v\f\r";
+  size_t i = 0;
+  while (i < field.size() && blanks.find(field[i]) != std::string_view::npos) {
+    i++;
+  }
+  bool negative = false;
+  if (i < field.size() && (field[i] == '-' || field[i] == '+')) {
+    negative = field[i++] == '-';
+  }
+  int64_t value = 0;
+  for (; i < field.size() && field[i] >= '0' && field[i] <= '9'; i++) {
+    value = std::min<int64_t>(value * 10 + field[i] - '0', INT32_MAX);
+  }
+  return static_cast<int>(negative ? -value : value);
+}
@@ -0,0 +1,90 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Single pass splitting of NMEA 0183 sentences into fields.
+ */
+
+#ifndef FIELD_TOKENIZER_HPP
+#define FIELD_TOKENIZER_HPP
+
+#include <array>
+#include <string_view>
+
+/**
+ * Fields of a NMEA 0183 sentence as views into the sentence text, found
+ * in one pass instead of rescanning the sentence for each field.
+ *
+ * Fields are numbered as by SENTENCE::Field(): field 0 is the address
+ * following the leading '$' or '!', fields are separated by ',' and '*'.
+ * The field following a '*' includes it, so the checksum field reads
+ * "*hh". Fields past the last one read as "*" in a sentence having a
+ * checksum, else as empty.
+ *
+ * The views refer to the text given to Split(), which must outlive them.
+ */
+class FieldTokenizer {
+public:
+  /** Fields recorded by Split(), later ones are found by scanning. */
+  static const int kMaxFields = 128;
+
+  FieldTokenizer() { Split(std::string_view()); }
+
+  /** Record field boundaries of given sentence text. */
+  void Split(std::string_view text);
+
+  /** Return the text given to Split(). */
+  std::string_view GetText() const { return m_text; }
+
+  /** Return number of fields, including the checksum field if any. */
+  int GetCount() const { return m_count; }
+
+  /** Return number of ',' separators before the checksum. */
+  int GetNumberOfDataFields() const { return m_data_fields; }
+
+  /** Return given field, see class documentation for fields out of range. */
+  std::string_view Get(int n) const {
+    if (n >= 0 && n < m_count && n < kMaxFields) return m_fields[n];
+    return Scan(n);
+  }
+
+  /**
+   * Convert field as atof(), NAN if the field is empty. Plain decimal
+   * numbers as used in NMEA 0183 are converted without copying and
+   * rounded as strtod() does.
+   */
+  static double ToDouble(std::string_view field);
+
+  /** Convert field as atoi(), without copying it. */
+  static int ToInt(std::string_view field);
+
+private:
+  std::string_view Scan(int n) const;
+
+  std::string_view m_text;
+  std::array<std::string_view, kMaxFields> m_fields;
+  int m_count;
+  int m_data_fields;
+
+  /** Read by fields past the last one, "*" or empty. */
+  std::string_view m_past_end;
+};
+
+#endif  // FIELD_TOKENIZER_HPP
@@ -70,8 +70,27 @@ bool LATITUDE::IsDataValid( void )
 
 void LATITUDE::Parse( int position_field_number, int north_or_south_field_number, const SENTENCE& sentence )
 {
-   wxString n_or_s = sentence.Field( north_or_south_field_number );
-   Set( sentence.Double( position_field_number ), n_or_s );
+   /*
+   ** Same as Set(), without copying the field to a wxString
+   */
+
+   Latitude = sentence.Double( position_field_number );
+
+   std::string_view n_or_s = sentence.FieldView( north_or_south_field_number );
+   size_t first = n_or_s.find_first_not_of( " \t\n\v\f\r" );
+
+   if ( first != std::string_view::npos && n_or_s[ first ] == 'N' )
+   {
+      Northing = North;
+   }
+   else if ( first != std::string_view::npos && n_or_s[ first ] == 'S' )
+   {
+      Northing = South;
+   }
+   else
+   {
+      Northing = NS_Unknown;
+   }
 }
 
 void LATITUDE::Set( double position, const wxString& north_or_south )
@@ -70,8 +70,27 @@ bool LONGITUDE::IsDataValid( void )
 
 void LONGITUDE::Parse( int position_field_number, int east_or_west_field_number, const SENTENCE& sentence )
 {
-   wxString w_or_e = sentence.Field( east_or_west_field_number );
-   Set( sentence.Double( position_field_number ), w_or_e );
+   /*
+   ** Same as Set(), without copying the field to a wxString
+   */
+
+   Longitude = sentence.Double( position_field_number );
+
+   std::string_view w_or_e = sentence.FieldView( east_or_west_field_number );
+   size_t first = w_or_e.find_first_not_of( " \t\n\v\f\r" );
+
+   if ( first != std::string_view::npos && w_or_e[ first ] == 'E' )
+   {
+      Easting = East;
+   }
+   else if ( first != std::string_view::npos && w_or_e[ first ] == 'W' )
+   {
+      Easting = West;
+   }
+   else
+   {
+      Easting = EW_Unknown;
+   }
 }
 
 void LONGITUDE::Set( double position, const wxString& east_or_west )
@@ -192,6 +192,25 @@ void NMEA0183::sort_response_table( void )
 */
 }
 
+/*
+** Sentence type, the last three characters of the address field or "P"
+** for proprietary sentences
+*/
+
+static wxString get_mnemonic( const SENTENCE& sentence )
+{
+   std::string_view address = sentence.FieldView( 0 );
+
+   if ( address.substr( 0, 1 ) == "P" )
+   {
+      return( _T("P") );
+   }
+
+   address = address.substr( address.size() > 3 ? address.size() - 3 : 0 );
+
+   return( wxString::FromUTF8( address.data(), address.size() ) );
+}
+
 /*
 ** Public Interface
 */
@@ -243,20 +262,7 @@ bool NMEA0183::PreParse( void )
 
       if ( IsGood() )
       {
-            wxString mnemonic = sentence.Field( 0 );
-
-      /*
-            ** See if this is a proprietary field
-      */
-
-            if ( mnemonic.Left( 1 ) == 'P' )
-                  mnemonic = _T("P");
-
-            else
-                  mnemonic = mnemonic.Right( 3 );
-
-
-            LastSentenceIDReceived = mnemonic;
+            LastSentenceIDReceived = get_mnemonic( sentence );
 
             return true;
       }
@@ -272,20 +278,7 @@ bool NMEA0183::Parse( void )
    if(PreParse())
    {
 
-      wxString mnemonic = sentence.Field( 0 );
-
-      /*
-      ** See if this is a proprietary field
-      */
-
-      if ( mnemonic.Left( 1 ) == 'P' )
-      {
-          mnemonic = _T("P");
-      }
-      else
-      {
-         mnemonic = mnemonic.Right( 3 );
-      }
+      wxString mnemonic = get_mnemonic( sentence );
 
       /*
       ** Set up our default error message
@@ -324,7 +317,7 @@ bool NMEA0183::Parse( void )
                         {
                            ErrorMessage = _T("No Error");
                            LastSentenceIDParsed = response_p->Mnemonic;
-                           TalkerID = talker_id( sentence );
+                           TalkerID = talker_id( sentence.Sentence );
                            ExpandedTalkerID = expand_talker_id( TalkerID );
                         }
                         else
@@ -32,6 +32,7 @@
 
 #include "nmea0183.h"
 #include <math.h>
+#include <stdlib.h>
 
 #if !defined(NAN)
 
@@ -69,15 +70,13 @@ NMEA0183_BOOLEAN SENTENCE::Boolean( int field_number ) const
 {
 //   ASSERT_VALID( this );
 
-   wxString field_data;
+   std::string_view field_data = FieldView( field_number );
 
-   field_data = Field( field_number );
-
-   if ( field_data.StartsWith(_T("A")) )
+   if ( field_data.substr( 0, 1 ) == "A" )
    {
       return( NTrue );
    }
-   else if ( field_data.StartsWith(_T("V")) )
+   else if ( field_data.substr( 0, 1 ) == "V" )
    {
       return( NFalse );
    }
@@ -91,47 +90,45 @@ COMMUNICATIONS_MODE SENTENCE::CommunicationsMode( int field_number ) const
 {
 //   ASSERT_VALID( this );
 
-   wxString field_data;
-
-   field_data = Field( field_number );
+   std::string_view field_data = FieldView( field_number );
 
-   if ( field_data == _T("d") )
+   if ( field_data == "d" )
    {
       return( F3E_G3E_SimplexTelephone );
    }
-   else if ( field_data == _T("e") )
+   else if ( field_data == "e" )
    {
       return( F3E_G3E_DuplexTelephone );
    }
-   else if ( field_data == _T("m") )
+   else if ( field_data == "m" )
    {
       return( J3E_Telephone );
    }
-   else if ( field_data == _T("o") )
+   else if ( field_data == "o" )
    {
       return( H3E_Telephone );
    }
-   else if ( field_data == _T("q") )
+   else if ( field_data == "q" )
    {
       return( F1B_J2B_FEC_NBDP_TelexTeleprinter );
    }
-   else if ( field_data == _T("s") )
+   else if ( field_data == "s" )
    {
       return( F1B_J2B_ARQ_NBDP_TelexTeleprinter );
    }
-   else if ( field_data == _T("w") )
+   else if ( field_data == "w" )
    {
       return( F1B_J2B_ReceiveOnlyTeleprinterDSC );
    }
-   else if ( field_data == _T("x") )
+   else if ( field_data == "x" )
    {
       return( A1A_MorseTapeRecorder );
    }
-   else if ( field_data == _T("{") )
+   else if ( field_data == "{" )
    {
       return( A1A_MorseKeyHeadset );
    }
-   else if ( field_data == _T("|") )
+   else if ( field_data == "|" )
    {
       return( F1C_F2C_F3C_FaxMachine );
    }
@@ -163,14 +160,7 @@ unsigned char SENTENCE::ComputeChecksum( void ) const
 double SENTENCE::Double( int field_number ) const
 {
  //  ASSERT_VALID( this );
-      if(Field( field_number ).Len() == 0)
-            return (NAN);
-
-      wxCharBuffer abuf = Field( field_number).ToUTF8();
-      if( !abuf.data() )                            // badly formed sentence?
-        return (NAN);
-
-      return( ::atof( abuf.data() ));
+      return( FieldTokenizer::ToDouble( FieldView( field_number ) ) );
 
 }
 
@@ -179,15 +169,13 @@ EASTWEST SENTENCE::EastOrWest( int field_number ) const
 {
 //   ASSERT_VALID( this );
 
-   wxString field_data;
+   std::string_view field_data = FieldView( field_number );
 
-   field_data = Field( field_number );
-
-   if ( field_data == _T("E") )
+   if ( field_data == "E" )
    {
       return( East );
    }
-   else if ( field_data == _T("W") )
+   else if ( field_data == "W" )
    {
       return( West );
    }
@@ -197,73 +185,44 @@ EASTWEST SENTENCE::EastOrWest( int field_number ) const
    }
 }
 
-const wxString& SENTENCE::Field( int desired_field_number ) const
+wxString SENTENCE::Field( int desired_field_number ) const
 {
 //   ASSERT_VALID( this );
 
-   static wxString return_string;
-   return_string.Empty();
-
-   int index                = 1; // Skip over the $ at the begining of the sentence
-   int current_field_number = 0;
-   int string_length        = 0;
+   std::string_view field = FieldView( desired_field_number );
 
-   string_length = Sentence.Len();
+   return( wxString::FromUTF8( field.data(), field.size() ) );
+}
 
-   while( current_field_number < desired_field_number && index < string_length )
-   {
-      if ( Sentence[ index ] == ',' || Sentence[ index ] == '*' )
-      {
-         current_field_number++;
-      }
+std::string_view SENTENCE::FieldView( int desired_field_number ) const
+{
+   return( GetFields().Get( desired_field_number ) );
+}
 
-      if( Sentence[ index ] == '*')
-          return_string += Sentence[ index ];
-      index++;
-   }
+const FieldTokenizer& SENTENCE::GetFields( void ) const
+{
+   /*
+   ** Sentence is public and may be changed anywhere, compare it with the
+   ** last one split. The text check catches copies of a split sentence.
+   */
 
-   if ( current_field_number == desired_field_number )
+   if ( Sentence != m_split_sentence ||
+        m_fields.GetText().data() != m_split_text.data() )
    {
-      while( index < string_length    &&
-             Sentence[ index ] != ',' &&
-             Sentence[ index ] != '*' &&
-             Sentence[ index ] != 0x00 )
-      {
-         return_string += Sentence[ index ];
-         index++;
-      }
+      m_split_sentence = Sentence;
+      wxScopedCharBuffer buf = Sentence.utf8_str();
+      m_split_text.assign( buf.data(), buf.length() );
+      m_fields.Split( m_split_text );
    }
 
-
-   return( return_string );
+   return( m_fields );
 }
 
 int SENTENCE::GetNumberOfDataFields( void ) const
 {
 //   ASSERT_VALID( this );
 
-   int index                = 1; // Skip over the $ at the begining of the sentence
-   int current_field_number = 0;
-   int string_length        = 0;
-
-   string_length = Sentence.Len();
-
-   while( index < string_length )
-   {
-      if ( Sentence[ index ] == '*' )
-      {
-         return( (int) current_field_number );
-      }
-
-      if ( Sentence[ index ] == ',' )
-      {
-         current_field_number++;
-      }
-
-      index++;
-   }
-
-   return( (int) current_field_number );
+   return( GetFields().GetNumberOfDataFields() );
 }
 
 void SENTENCE::Finish( void )
@@ -281,11 +240,7 @@ void SENTENCE::Finish( void )
 int SENTENCE::Integer( int field_number ) const
 {
 //   ASSERT_VALID( this );
-    wxCharBuffer abuf = Field( field_number).ToUTF8();
-    if( !abuf.data() )                            // badly formed sentence?
-        return 0;
-
-    return( ::atoi( abuf.data() ));
+    return( FieldTokenizer::ToInt( FieldView( field_number ) ) );
 }
 
 NMEA0183_BOOLEAN SENTENCE::IsChecksumBad( int checksum_field_number ) const
@@ -296,15 +251,15 @@ NMEA0183_BOOLEAN SENTENCE::IsChecksumBad( int checksum_field_number ) const
    ** Checksums are optional, return TRUE if an existing checksum is known to be bad
    */
 
-   wxString checksum_in_sentence = Field( checksum_field_number );
+   std::string_view checksum_in_sentence = FieldView( checksum_field_number );
 
-   if ( checksum_in_sentence == _T("") )
+   if ( checksum_in_sentence.empty() )
    {
       return( Unknown0183 );
    }
 
-   wxString check = checksum_in_sentence.Mid( 1 );
-   if ( ComputeChecksum() != HexValue( check ) )
+   const std::string check( checksum_in_sentence.substr( 1 ) );
+   if ( ComputeChecksum() != strtoul( check.c_str(), NULL, 16 ) )
    {
       return( NTrue );
    }
@@ -316,15 +271,13 @@ LEFTRIGHT SENTENCE::LeftOrRight( int field_number ) const
 {
 //   ASSERT_VALID( this );
 
-   wxString field_data;
-
-   field_data = Field( field_number );
+   std::string_view field_data = FieldView( field_number );
 
-   if ( field_data == _T("L") )
+   if ( field_data == "L" )
    {
       return( Left );
    }
-   else if ( field_data == _T("R") )
+   else if ( field_data == "R" )
    {
       return( Right );
    }
@@ -338,15 +291,13 @@ NORTHSOUTH SENTENCE::NorthOrSouth( int field_number ) const
 {
 //   ASSERT_VALID( this );
 
-   wxString field_data;
+   std::string_view field_data = FieldView( field_number );
 
-   field_data = Field( field_number );
-
-   if ( field_data == _T("N") )
+   if ( field_data == "N" )
    {
       return( North );
    }
-   else if ( field_data == _T("S") )
+   else if ( field_data == "S" )
    {
       return( South );
    }
@@ -360,27 +311,25 @@ REFERENCE SENTENCE::Reference( int field_number ) const
 {
 //   ASSERT_VALID( this );
 
-   wxString field_data;
-
-   field_data = Field( field_number );
+   std::string_view field_data = FieldView( field_number );
 
-   if ( field_data == _T("B") )
+   if ( field_data == "B" )
    {
       return( BottomTrackingLog );
    }
-   else if ( field_data == _T("M") )
+   else if ( field_data == "M" )
    {
       return( ManuallyEntered );
    }
-   else if ( field_data == _T("W") )
+   else if ( field_data == "W" )
    {
       return( WaterReferenced );
    }
-   else if ( field_data == _T("R") )
+   else if ( field_data == "R" )
    {
       return( RadarTrackingOfFixedTarget );
    }
-   else if ( field_data == _T("P") )
+   else if ( field_data == "P" )
    {
       return( PositioningSystemGroundReference );
    }
@@ -394,47 +343,45 @@ TRANSDUCER_TYPE SENTENCE::TransducerType( int field_number ) const
 {
 //   ASSERT_VALID( this );
 
-   wxString field_data;
-
-   field_data = Field( field_number );
+   std::string_view field_data = FieldView( field_number );
 
-   if ( field_data == _T("A") )
+   if ( field_data == "A" )
    {
       return( AngularDisplacementTransducer );
    }
-   else if ( field_data == _T("D") )
+   else if ( field_data == "D" )
    {
       return( LinearDisplacementTransducer );
    }
-   else if ( field_data == _T("C") )
+   else if ( field_data == "C" )
    {
       return( TemperatureTransducer );
    }
-   else if ( field_data == _T("F") )
+   else if ( field_data == "F" )
    {
       return( FrequencyTransducer );
    }
-   else if ( field_data == _T("N") )
+   else if ( field_data == "N" )
    {
       return( ForceTransducer );
    }
-   else if ( field_data == _T("P") )
+   else if ( field_data == "P" )
    {
       return( PressureTransducer );
    }
-   else if ( field_data == _T("R") )
+   else if ( field_data == "R" )
    {
       return( FlowRateTransducer );
    }
-   else if ( field_data == _T("T") )
+   else if ( field_data == "T" )
    {
       return( TachometerTransducer );
    }
-   else if ( field_data == _T("H") )
+   else if ( field_data == "H" )
    {
       return( HumidityTransducer );
    }
-   else if ( field_data == _T("V") )
+   else if ( field_data == "V" )
    {
       return( VolumeTransducer );
    }
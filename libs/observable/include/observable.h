@@ -24,6 +24,8 @@
 #ifndef OBSERVABLE_H
 #define OBSERVABLE_H
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -50,6 +52,7 @@ std::string ptr_key(const void* ptr);
 
 class Observable;
 class ObservableListener;
+class ObsBatchListener;
 
 /** Interface implemented by classes which listens. */
 class KeyProvider {
@@ -63,6 +66,7 @@ public:
  */
 class ListenersByKey {
   friend class Observable;
+  friend class KeyRegistry;
   friend ListenersByKey& GetInstance(const std::string& key);
 
 public:
@@ -75,11 +79,67 @@ private:
   ListenersByKey& operator=(const ListenersByKey&) = default;
 
   std::vector<std::pair<wxEvtHandler*, wxEventType>> listeners;
+  std::vector<ObsBatchListener*> batch_listeners;
+};
+
+/** Integer handle for a key interned in KeyRegistry. */
+using ObsKeyId = uint32_t;
+
+/**
+ * Singleton registry mapping key strings to small integers. A key is
+ * interned once; afterwards its listeners are found by array index
+ * without string hashing or locking. The string based API is unaffected,
+ * an interned key and its string share the same listeners.
+ */
+class KeyRegistry {
+public:
+  /** Returned when a key cannot be interned, use the string API. */
+  static constexpr ObsKeyId kNoKey = 0;
+
+  /** Max number of interned keys. */
+  static constexpr ObsKeyId kMaxKeys = 4096;
+
+  static KeyRegistry& GetInstance();
+
+  KeyRegistry(const KeyRegistry&) = delete;
+  KeyRegistry& operator=(const KeyRegistry&) = delete;
+
+  /**
+   * Return id for key, registering it on first use. Lookup of known keys
+   * is lock-free, registering a new key takes a lock.
+   * @return Key id or kNoKey if the registry is full.
+   */
+  ObsKeyId Intern(const std::string& key);
+
+  /** Return key string for a valid id. */
+  const std::string& GetKey(ObsKeyId id) const;
+
+private:
+  friend class Observable;
+
+  struct Entry {
+    std::string key;
+    ObsKeyId id;
+    ListenersByKey* listeners;
+  };
+
+  /** Hash table size, kept at most half full. */
+  static constexpr size_t kSlots = 2 * kMaxKeys;
+
+  KeyRegistry();
+
+  const Entry& GetEntry(ObsKeyId id) const;
+
+  std::atomic<const Entry*> m_slots[kSlots];
+  std::atomic<const Entry*> m_entries[kMaxKeys];
+  ObsKeyId m_next_id;
+  std::mutex m_mutex;
 };
 
 /**  The observable notify/listen basic nuts and bolts.  */
 class Observable : public KeyProvider {
   friend class ObservableListener;
+  friend class ObsBatchListener;
 
 public:
   Observable(const std::string& _key)
@@ -87,6 +147,9 @@ public:
 
   Observable(const KeyProvider& kp) : Observable(kp.GetKey()) {}
 
+  /** Create observable for a key interned in KeyRegistry, lock-free. */
+  Observable(ObsKeyId id);
+
   /** Notify all listeners about variable change. */
   virtual const void Notify();
 
@@ -120,6 +183,12 @@ private:
   /** Set object to send ev_type to listener on variable changes. */
   void Listen(wxEvtHandler* listener, wxEventType ev_type);
 
+  /** Add a listener receiving buffered notifications, see ObsBatchListener */
+  void Listen(ObsBatchListener* listener);
+
+  /** Remove a batched listener added by Listen(ObsBatchListener*). */
+  bool Unlisten(ObsBatchListener* listener);
+
   ListenersByKey& m_list;
 
   mutable std::mutex m_mutex;
@@ -0,0 +1,139 @@
+/*************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose: Batched, optionally coalescing, observable listener.
+ *
+ * Copyright (C) 2025 Alec Leamas
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.
+ **************************************************************************/
+
+#ifndef _OBSERVABLE_BATCH_H
+#define _OBSERVABLE_BATCH_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <wx/event.h>
+
+#include "observable.h"
+
+/** How an ObsBatchListener buffers notifications between deliveries. */
+enum class BatchPolicy {
+  /** Keep every notification, up to the buffer limit. */
+  kAll,
+  /** Keep only the latest notification for each key. */
+  kLatestOnly
+};
+
+/** A buffered notification, i. e. the data an ObservedEvt carries. */
+struct ObservedItem {
+  std::string key;
+  std::shared_ptr<const void> ptr;
+  std::string str;
+  int num;
+  void* client_data;
+};
+
+/** ObsBatchListener counters, all counting since creation. */
+struct BatchStats {
+  uint64_t received;   ///< Notifications seen
+  uint64_t delivered;  ///< Items handed to the action
+  uint64_t merged;     ///< Items replaced by a newer one, kLatestOnly
+  uint64_t dropped;    ///< Items discarded because the buffer was full
+  uint64_t batches;    ///< Number of action invocations
+};
+
+/**
+ * Listener which buffers notifications and delivers them as one vector
+ * instead of one ObservedEvt per notification.
+ *
+ * Notify() just appends to the buffer, no event is allocated. The first
+ * item in an empty buffer posts a single wake-up to the main loop; all
+ * items arriving before the main loop handles it are delivered in the
+ * same batch, i. e. at most one batch per UI tick.
+ *
+ * Example, handling all AIS sentences seen since last tick:
+ * \code
+ *
+ *     m_ais_listener.Init(Nmea0183Msg("VDM"),
+ *                         [&](std::vector<ObservedItem>& batch) {
+ *                           for (auto& item : batch) HandleVdm(item.ptr);
+ *                         });
+ * \endcode
+ */
+class ObsBatchListener : public wxEvtHandler {
+  friend class Observable;
+
+public:
+  using Action = std::function<void(std::vector<ObservedItem>& batch)>;
+
+  /** Create an object which does not listen until Init(). */
+  ObsBatchListener();
+
+  /**
+   * Create object which invokes action with buffered notifications
+   * on kp.
+   * @param policy Buffering policy, see BatchPolicy.
+   * @param max_items Buffer limit, further notifications are dropped
+   *        until next delivery.
+   */
+  ObsBatchListener(const KeyProvider& kp, Action action,
+                   BatchPolicy policy = BatchPolicy::kAll,
+                   size_t max_items = 1024);
+
+  ~ObsBatchListener();
+
+  ObsBatchListener(const ObsBatchListener&) = delete;
+  ObsBatchListener& operator=(const ObsBatchListener&) = delete;
+
+  /** Initiate an object yet not listening. */
+  void Init(const KeyProvider& kp, Action action,
+            BatchPolicy policy = BatchPolicy::kAll, size_t max_items = 1024);
+
+  /** Add another key delivered to the same action. */
+  void Listen(const KeyProvider& kp);
+
+  /** Deliver buffered items now, if any. Main thread only. */
+  void Flush();
+
+  BatchStats GetStats() const;
+
+private:
+  /** Invoked by Observable::Notify(), possibly on any thread. */
+  void Push(const std::string& key, std::shared_ptr<const void> ptr,
+            const std::string& s, int num, void* client_data);
+
+  void UnlistenAll();
+
+  Action m_action;
+  BatchPolicy m_policy;
+  size_t m_max_items;
+  std::vector<std::string> m_keys;
+
+  mutable std::mutex m_mutex;
+  std::vector<ObservedItem> m_buffer;
+  std::unordered_map<std::string, size_t> m_index_by_key;
+  bool m_wakeup_pending;
+  BatchStats m_stats;
+};
+
+#endif  // _OBSERVABLE_BATCH_H
@@ -30,6 +30,7 @@
 #include <wx/log.h>
 
 #include "observable.h"
+#include "observable_batch.h"
 
 std::string ptr_key(const void* ptr) {
   std::ostringstream oss;
@@ -50,8 +51,61 @@ ListenersByKey& ListenersByKey::GetInstance(const std::string& key) {
   return instances[key];
 }
 
+/* KeyRegistry implementation. */
+
+KeyRegistry& KeyRegistry::GetInstance() {
+  static KeyRegistry instance;
+  return instance;
+}
+
+KeyRegistry::KeyRegistry() : m_next_id(kNoKey + 1) {
+  for (auto& slot : m_slots) slot.store(nullptr, std::memory_order_relaxed);
+  for (auto& entry : m_entries) entry.store(nullptr, std::memory_order_relaxed);
+}
+
+ObsKeyId KeyRegistry::Intern(const std::string& key) {
+  const size_t hash = std::hash<std::string>()(key);
+
+  // Lock-free lookup: entries are never modified or removed once
+  // published, so a slot is either empty or a complete entry.
+  for (size_t i = 0; i < kSlots; i++) {
+    const Entry* entry =
+        m_slots[(hash + i) & (kSlots - 1)].load(std::memory_order_acquire);
+    if (!entry) break;
+    if (entry->key == key) return entry->id;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t ix = hash & (kSlots - 1);
+  for (const Entry* entry = m_slots[ix].load(std::memory_order_relaxed); entry;
+       entry = m_slots[ix].load(std::memory_order_relaxed)) {
+    if (entry->key == key) return entry->id;  // Added while we were waiting
+    ix = (ix + 1) & (kSlots - 1);
+  }
+  if (m_next_id >= kMaxKeys) return kNoKey;
+  auto entry = new Entry{key, m_next_id++, &ListenersByKey::GetInstance(key)};
+  m_entries[entry->id].store(entry, std::memory_order_release);
+  m_slots[ix].store(entry, std::memory_order_release);
+  return entry->id;
+}
+
+const KeyRegistry::Entry& KeyRegistry::GetEntry(ObsKeyId id) const {
+  assert(id != kNoKey && id < kMaxKeys && "Invalid key id");
+  const Entry* entry = m_entries[id].load(std::memory_order_acquire);
+  assert(entry && "Key id not interned");
+  return *entry;
+}
+
+const std::string& KeyRegistry::GetKey(ObsKeyId id) const {
+  return GetEntry(id).key;
+}
+
 /* Observable implementation. */
 
+Observable::Observable(ObsKeyId id)
+    : key(KeyRegistry::GetInstance().GetEntry(id).key),
+      m_list(*KeyRegistry::GetInstance().GetEntry(id).listeners) {}
+
 using ev_pair = std::pair<wxEvtHandler*, wxEventType>;
 
 void Observable::Listen(wxEvtHandler* listener, wxEventType ev_type) {
@@ -75,6 +129,24 @@ bool Observable::Unlisten(wxEvtHandler* listener, wxEventType ev_type) {
   return true;
 }
 
+void Observable::Listen(ObsBatchListener* listener) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& listeners = m_list.batch_listeners;
+  assert(std::find(listeners.begin(), listeners.end(), listener) ==
+             listeners.end() &&
+         "Duplicate listener");
+  listeners.push_back(listener);
+}
+
+bool Observable::Unlisten(ObsBatchListener* listener) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& listeners = m_list.batch_listeners;
+  auto found = std::find(listeners.begin(), listeners.end(), listener);
+  if (found == listeners.end()) return false;
+  listeners.erase(found);
+  return true;
+}
+
 const void Observable::Notify(std::shared_ptr<const void> ptr,
                               const std::string& s, int num,
                               void* client_data) {
@@ -89,6 +161,9 @@ const void Observable::Notify(std::shared_ptr<const void> ptr,
     evt->SetInt(num);
     wxQueueEvent(l->first, evt);
   }
+  for (auto batch_listener : m_list.batch_listeners) {
+    batch_listener->Push(key, ptr, s, num, client_data);
+  }
 }
 
 const void Observable::Notify() { Notify("", 0); }
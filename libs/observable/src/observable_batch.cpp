@@ -0,0 +1,120 @@
+/*************************************************************************
+ *
+ * Project:  OpenCPN
+ * Purpose: Batched, optionally coalescing, observable listener.
+ *
+ * Copyright (C) 2025 Alec Leamas
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the
+ * Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.
+ **************************************************************************/
+
+#include <utility>
+
+#include "observable_batch.h"
+
+ObsBatchListener::ObsBatchListener()
+    : m_policy(BatchPolicy::kAll),
+      m_max_items(1024),
+      m_wakeup_pending(false),
+      m_stats{0, 0, 0, 0, 0} {}
+
+ObsBatchListener::ObsBatchListener(const KeyProvider& kp, Action action,
+                                   BatchPolicy policy, size_t max_items)
+    : ObsBatchListener() {
+  Init(kp, action, policy, max_items);
+}
+
+ObsBatchListener::~ObsBatchListener() { UnlistenAll(); }
+
+void ObsBatchListener::Init(const KeyProvider& kp, Action action,
+                            BatchPolicy policy, size_t max_items) {
+  UnlistenAll();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_action = std::move(action);
+    m_policy = policy;
+    m_max_items = max_items;
+    m_buffer.clear();
+    m_index_by_key.clear();
+  }
+  Listen(kp);
+}
+
+void ObsBatchListener::Listen(const KeyProvider& kp) {
+  std::string key = kp.GetKey();
+  Observable(key).Listen(this);
+  m_keys.push_back(key);
+}
+
+void ObsBatchListener::UnlistenAll() {
+  for (const auto& key : m_keys) Observable(key).Unlisten(this);
+  m_keys.clear();
+}
+
+void ObsBatchListener::Push(const std::string& key,
+                            std::shared_ptr<const void> ptr,
+                            const std::string& s, int num, void* client_data) {
+  bool post_wakeup = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.received++;
+    if (m_policy == BatchPolicy::kLatestOnly) {
+      auto found = m_index_by_key.find(key);
+      if (found != m_index_by_key.end()) {
+        ObservedItem& item = m_buffer[found->second];
+        item.ptr = std::move(ptr);
+        item.str = s;
+        item.num = num;
+        item.client_data = client_data;
+        m_stats.merged++;
+        return;
+      }
+    }
+    if (m_buffer.size() >= m_max_items) {
+      m_stats.dropped++;
+      return;
+    }
+    if (m_policy == BatchPolicy::kLatestOnly) {
+      m_index_by_key[key] = m_buffer.size();
+    }
+    m_buffer.push_back({key, std::move(ptr), s, num, client_data});
+    if (!m_wakeup_pending) {
+      m_wakeup_pending = true;
+      post_wakeup = true;
+    }
+  }
+  // CallAfter() queues an event on this handler and is thread safe.
+  if (post_wakeup) CallAfter([this] { Flush(); });
+}
+
+void ObsBatchListener::Flush() {
+  std::vector<ObservedItem> batch;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeup_pending = false;
+    if (m_buffer.empty()) return;
+    batch.swap(m_buffer);
+    m_index_by_key.clear();
+    m_stats.delivered += batch.size();
+    m_stats.batches++;
+  }
+  if (m_action) m_action(batch);
+}
+
+BatchStats ObsBatchListener::GetStats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_stats;
+}
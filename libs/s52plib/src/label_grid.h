@@ -0,0 +1,194 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Screen grid of text label rectangles used for text declutter.
+ */
+
+#ifndef _LABEL_GRID_H__
+#define _LABEL_GRID_H__
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/** Screen rectangle in pixels, same semantics as wxRect. */
+struct LabelRect {
+  int x;
+  int y;
+  int width;
+  int height;
+
+  /**
+   * Return true if rectangles share at least one pixel, as
+   * wxRect::Intersects(). Empty rectangles never intersect.
+   */
+  bool Intersects(const LabelRect& r) const {
+    return std::max(x, r.x) <= std::min(x + width - 1, r.x + r.width - 1) &&
+           std::max(y, r.y) <= std::min(y + height - 1, r.y + r.height - 1);
+  }
+};
+
+/**
+ * Rectangles of labels drawn so far, each identified by a Key, typically
+ * a pointer to the text. Rectangles are bucketed in square cells so
+ * checking a new label only looks at the labels close to it instead of
+ * all labels on screen.
+ *
+ * A key has at most one rectangle, Set() replaces it.
+ */
+template <typename Key>
+class LabelGrid {
+public:
+  explicit LabelGrid(int cell_size = 64) : m_cell_size(cell_size) {}
+
+  void Clear() {
+    m_rects.clear();
+    m_cells.clear();
+    m_large.clear();
+  }
+
+  size_t GetCount() const { return m_rects.size(); }
+
+  bool Contains(Key key) const { return m_rects.count(key) > 0; }
+
+  /** Add rectangle for key, or move the existing one. */
+  void Set(Key key, const LabelRect& rect) {
+    auto found = m_rects.find(key);
+    if (found != m_rects.end()) {
+      Unlink(key, found->second);
+      found->second = rect;
+    } else {
+      m_rects.emplace(key, rect);
+    }
+    Link(key, rect);
+  }
+
+  /**
+   * Record the rectangle of a label just rendered, as s52plib::RenderT_All()
+   * does after the Overlaps() check: a listed label follows its new
+   * rectangle, others are added only if add is set.
+   */
+  void Update(Key key, const LabelRect& rect, bool add) {
+    if (add || Contains(key)) Set(key, rect);
+  }
+
+  void Remove(Key key) {
+    auto found = m_rects.find(key);
+    if (found == m_rects.end()) return;
+    Unlink(key, found->second);
+    m_rects.erase(found);
+  }
+
+  /** Return true if rect intersects any rectangle but the one of except. */
+  bool Overlaps(const LabelRect& rect, Key except) const {
+    if (rect.width <= 0 || rect.height <= 0) return false;
+    for (const auto& entry : m_large) {
+      if (entry.key != except && entry.rect.Intersects(rect)) return true;
+    }
+    int x0, y0, x1, y1;
+    CellRange(rect, x0, y0, x1, y1);
+    for (int cx = x0; cx <= x1; cx++) {
+      for (int cy = y0; cy <= y1; cy++) {
+        auto cell = m_cells.find(CellKey(cx, cy));
+        if (cell == m_cells.end()) continue;
+        for (const auto& entry : cell->second) {
+          if (entry.key != except && entry.rect.Intersects(rect)) return true;
+        }
+      }
+    }
+    return false;
+  }
+
+private:
+  /** Rectangles covering more cells are checked linearly. */
+  static const int kMaxCells = 16;
+
+  struct Entry {
+    Key key;
+    LabelRect rect;
+  };
+
+  /** Floor division, pixel coordinates may be negative. */
+  int Cell(int v) const {
+    return v >= 0 ? v / m_cell_size : -((-v - 1) / m_cell_size) - 1;
+  }
+
+  static int64_t CellKey(int cx, int cy) {
+    uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32;
+    return static_cast<int64_t>(key | static_cast<uint32_t>(cy));
+  }
+
+  void CellRange(const LabelRect& r, int& x0, int& y0, int& x1,
+                 int& y1) const {
+    x0 = Cell(r.x);
+    y0 = Cell(r.y);
+    x1 = Cell(r.x + r.width - 1);
+    y1 = Cell(r.y + r.height - 1);
+  }
+
+  bool IsLarge(int x0, int y0, int x1, int y1) const {
+    return static_cast<int64_t>(x1 - x0 + 1) * (y1 - y0 + 1) > kMaxCells;
+  }
+
+  void Link(Key key, const LabelRect& rect) {
+    if (rect.width <= 0 || rect.height <= 0) return;  // Never intersects
+    int x0, y0, x1, y1;
+    CellRange(rect, x0, y0, x1, y1);
+    if (IsLarge(x0, y0, x1, y1)) {
+      m_large.push_back({key, rect});
+      return;
+    }
+    for (int cx = x0; cx <= x1; cx++) {
+      for (int cy = y0; cy <= y1; cy++) {
+        m_cells[CellKey(cx, cy)].push_back({key, rect});
+      }
+    }
+  }
+
+  void Unlink(Key key, const LabelRect& rect) {
+    if (rect.width <= 0 || rect.height <= 0) return;
+    auto is_key = [key](const Entry& e) { return e.key == key; };
+    int x0, y0, x1, y1;
+    CellRange(rect, x0, y0, x1, y1);
+    if (IsLarge(x0, y0, x1, y1)) {
+      m_large.erase(std::remove_if(m_large.begin(), m_large.end(), is_key),
+                    m_large.end());
+      return;
+    }
+    for (int cx = x0; cx <= x1; cx++) {
+      for (int cy = y0; cy <= y1; cy++) {
+        auto cell = m_cells.find(CellKey(cx, cy));
+        if (cell == m_cells.end()) continue;
+        auto& v = cell->second;
+        v.erase(std::remove_if(v.begin(), v.end(), is_key), v.end());
+        if (v.empty()) m_cells.erase(cell);
+      }
+    }
+  }
+
+  int m_cell_size;
+  std::unordered_map<Key, LabelRect> m_rects;
+  std::unordered_map<int64_t, std::vector<Entry>> m_cells;
+  std::vector<Entry> m_large;
+};
+
+#endif  // _LABEL_GRID_H__
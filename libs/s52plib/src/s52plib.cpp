@@ -137,7 +137,6 @@ GLint S52AP_shader_program;
 
 //    Implement all lists
 #include <wx/listimpl.cpp>
-WX_DEFINE_LIST(TextObjList);
 
 //    Implement all arrays
 #include <wx/arrimpl.cpp>
@@ -336,11 +335,19 @@ s52plib::s52plib(const wxString &PLib, bool b_forceLegacy) {
   m_anchorOn = true;
   m_qualityOfDataOn = false;
 
+  m_symbol_batching = false;
+  m_batch_shader = NULL;
+  m_batch_texture = 0;
+  memset(m_batch_color, 0, sizeof(m_batch_color));
+  m_symbol_count = 0;
+  m_symbol_draws = 0;
+
   m_SoundingsScaleFactor = 1.0;
   m_SoundingsFontSizeMM = 0;
   m_soundFontDelta = 0;
 
   GenerateStateHash();
+  UpdateRenderKey();
 
   HPGL = new RenderFromHPGL(this);
 
@@ -727,6 +734,32 @@ void s52plib::GenerateStateHash() {
   m_state_hash = crc32buf(state_buffer, offset);
 }
 
+/*
+ Besides the state hash, object display filters depend on some members
+ set directly by the application, the noshow list and the OBJL viz flags,
+ which are not part of the hash.
+ */
+void s52plib::UpdateRenderKey() {
+  std::vector<unsigned char> buffer(sizeof(m_state_hash) + 4 * sizeof(int));
+  unsigned char *p = buffer.data();
+  memcpy(p, &m_state_hash, sizeof(m_state_hash));
+  p += sizeof(m_state_hash);
+  const int values[] = {m_nDisplayCategory, m_bShowMeta, m_qualityOfDataOn,
+                        m_bShowSoundg};
+  memcpy(p, values, sizeof(values));
+
+  for (unsigned int i = 0; i < m_noshow_array.GetCount(); i++) {
+    buffer.insert(buffer.end(), m_noshow_array[i].obj,
+                  m_noshow_array[i].obj + 6);
+  }
+  for (unsigned int i = 0; i < pOBJLArray->GetCount(); i++) {
+    buffer.push_back(((OBJLElement *)(pOBJLArray->Item(i)))->nViz != 0);
+  }
+
+  m_render_key = crc32buf(buffer.data(), buffer.size());
+  if (m_render_key == 0) m_render_key = 1;  // 0 marks an empty object cache
+}
+
 wxArrayOfLUPrec *s52plib::SelectLUPARRAY(LUPname TNAM) {
   switch (TNAM) {
     case SIMPLIFIED:
@@ -2305,20 +2338,14 @@ bool s52plib::RenderText(wxDC *pdc, S52_TextC *ptext, int x, int y,
 #endif
 }
 
+static LabelRect ToLabelRect(const wxRect &r) {
+  return LabelRect{r.x, r.y, r.width, r.height};
+}
+
 //    Return true if test_rect overlaps any rect in the current text rectangle
 //    list, except itself
 bool s52plib::CheckTextRectList(const wxRect &test_rect, S52_TextC *ptext) {
-  //    Iterate over the current object list, looking at rText
-
-  for (TextObjList::Node *node = m_textObjList.GetFirst(); node;
-       node = node->GetNext()) {
-    wxRect *pcurrent_rect = &(node->GetData()->rText);
-
-    if (pcurrent_rect->Intersects(test_rect)) {
-      if (node->GetData() != ptext) return true;
-    }
-  }
-  return false;
+  return m_textGrid.Overlaps(ToLabelRect(test_rect), ptext);
 }
 
 bool s52plib::TextRenderCheck(ObjRazRules *rzRules) {
@@ -2501,7 +2528,6 @@ int s52plib::RenderT_All(ObjRazRules *rzRules, Rules *rules,
     //  example.  There are others We need to cache only the first text
     //  structure, but should update the render rectangle to reflect all texts
     //  rendered for this object,  in order to process the declutter logic.
-    bool b_dupok = false;
     if (b_free_text) {
       delete text;
 
@@ -2513,30 +2539,15 @@ int s52plib::RenderT_All(ObjRazRules *rzRules, Rules *rules,
         wxRect r0 = text->rText;
         r0 = r0.Union(rect);
         text->rText = r0;
-
-        b_dupok = true;  // OK to add a duplicate text structure to the
-                         // declutter list, just for this case.
       }
     } else
       text->rText = rect;
 
-    //      If this text was actually drawn, add a pointer to its rect to the
-    //      de-clutter list if it doesn't already exist
-    if (m_bDeClutterText) {
-      if (bwas_drawn) {
-        bool b_found = false;
-        for (TextObjList::Node *node = m_textObjList.GetFirst(); node;
-             node = node->GetNext()) {
-          S52_TextC *oc = node->GetData();
-
-          if (oc == text) {
-            if (!b_dupok) b_found = true;
-            break;
-          }
-        }
-        if (!b_found) m_textObjList.Append(text);
-      }
-    }
+    //      If this text was actually drawn, add its rect to the de-clutter
+    //      list if it doesn't already exist. A text already listed follows
+    //      its new rect in any case.
+    m_textGrid.Update(text, ToLabelRect(text->rText),
+                      m_bDeClutterText && bwas_drawn);
 
     //  Update the object Bounding box
     //  so that subsequent drawing operations will redraw the item fully
@@ -2572,6 +2583,8 @@ int s52plib::RenderTE(ObjRazRules *rzRules, Rules *rules) {
 
 bool s52plib::RenderHPGL(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
                          float rot_angle, double uScale) {
+  FlushSymbolBatch();  // keep the draw order
+
   float fsf = 100 / canvas_pix_per_mm;
 
   float xscale = 1.0;
@@ -2827,6 +2840,92 @@ wxImage s52plib::RuleXBMToImage(Rule *prule) {
 //      Symbol is instantiated as a bitmap the first time it is needed
 //      and re-built on color scheme change
 //
+/*
+ Symbols are queued as two triangles each, transformed to screen pixels
+ here instead of by a matrix uniform per symbol. Consecutive symbols from
+ the same texture, typically the symbol atlas or the soundings digits,
+ are then drawn by a single glDrawArrays().
+ */
+void s52plib::AddSymbolQuad(CGLShaderProgram *shader, unsigned int texture,
+                            const float *color, const wxPoint &r, int pivot_x,
+                            int pivot_y, float w, float h, const float *uv,
+                            float angle) {
+  if (shader != m_batch_shader || texture != m_batch_texture ||
+      (color && memcmp(color, m_batch_color, sizeof(m_batch_color)))) {
+    FlushSymbolBatch();
+    m_batch_shader = shader;
+    m_batch_texture = texture;
+    if (color) memcpy(m_batch_color, color, sizeof(m_batch_color));
+  }
+
+  //  Corners in the order of uv, as for a triangle strip
+  const float corner[8] = {0, 0, w, 0, 0, h, w, h};
+  const float c = cosf(angle);
+  const float s = sinf(angle);
+  float xy[8];
+  for (int i = 0; i < 8; i += 2) {
+    float x = corner[i] - pivot_x;
+    float y = corner[i + 1] - pivot_y;
+    xy[i] = r.x + x * c - y * s;
+    xy[i + 1] = r.y + x * s + y * c;
+  }
+  static const int kTriangles[6] = {0, 1, 2, 2, 1, 3};
+  for (int i : kTriangles) {
+    m_batch_coords.push_back(xy[2 * i]);
+    m_batch_coords.push_back(xy[2 * i + 1]);
+    m_batch_uv.push_back(uv[2 * i]);
+    m_batch_uv.push_back(uv[2 * i + 1]);
+  }
+  m_symbol_count++;
+
+  if (!m_symbol_batching) FlushSymbolBatch();
+}
+
+void s52plib::FlushSymbolBatch() {
+  if (m_batch_coords.empty()) return;
+
+#ifdef ocpnUSE_GL
+  glEnable(GL_BLEND);
+  glEnable(GL_TEXTURE_2D);
+  glBindTexture(GL_TEXTURE_2D, m_batch_texture);
+
+  CGLShaderProgram *shader = m_batch_shader;
+  shader->Bind();
+
+  // Select the active texture unit.
+  glActiveTexture(GL_TEXTURE0);
+  shader->SetUniform1i("uTex", 0);
+  if (shader == pCtexture_2D_Color_shader_program[0])
+    shader->SetUniform4fv("color", m_batch_color);
+
+  // Disable VBO's (vertex buffer objects) for attributes.
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  shader->SetAttributePointerf("position", m_batch_coords.data());
+  shader->SetAttributePointerf("aUV", m_batch_uv.data());
+
+  mat4x4 IM;
+  mat4x4_identity(IM);
+  shader->SetUniformMatrix4fv("TransformMatrix", (GLfloat *)IM);
+
+  glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(m_batch_coords.size() / 2));
+
+  shader->UnBind();
+  glDisable(m_TextureFormat);
+  glDisable(GL_BLEND);
+  m_symbol_draws++;
+#endif
+
+  m_batch_coords.clear();
+  m_batch_uv.clear();
+}
+
+void s52plib::EndSymbolBatch() {
+  FlushSymbolBatch();
+  m_symbol_batching = false;
+}
+
 bool s52plib::RenderRasterSymbol(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
                                  float rot_angle) {
 
@@ -3081,13 +3180,7 @@ bool s52plib::RenderRasterSymbol(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
   if (!m_pdc)  // opengl
   {
 #ifdef ocpnUSE_GL
-    glEnable(GL_BLEND);
-
     if (texture) {
-
-      glEnable(GL_TEXTURE_2D);
-      glBindTexture(GL_TEXTURE_2D, texture);
-
       int w = texrect.width, h = texrect.height;
 
       float tx1 = texrect.x, ty1 = texrect.y;
@@ -3107,7 +3200,6 @@ bool s52plib::RenderRasterSymbol(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
       }
 
       float uv[8];
-      float coords[8];
 
       // Note swizzle of points to allow TRIANGLE_STRIP drawing
       // normal uv
@@ -3123,69 +3215,14 @@ bool s52plib::RenderRasterSymbol(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
       w *= scale_factor;
       h *= scale_factor;
 
-      // pixels
-      coords[0] = 0;
-      coords[1] = 0;
-      coords[2] = w;
-      coords[3] = 0;
-      coords[6] = w;
-      coords[7] = h;
-      coords[4] = 0;
-      coords[5] = h;
-
-      if (pCtexture_2D_shader_program[0]){
-        pCtexture_2D_shader_program[0]->Bind();
-
-        // Select the active texture unit.
-        glActiveTexture(GL_TEXTURE0);
-
-        pCtexture_2D_shader_program[0]->SetUniform1i( "uTex", 0);
-
-        // Disable VBO's (vertex buffer objects) for attributes.
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-        pCtexture_2D_shader_program[0]->SetAttributePointerf( "position", coords);
-        pCtexture_2D_shader_program[0]->SetAttributePointerf( "aUV", uv);
-
-        // Rotate
-        mat4x4 I, Q;
-        mat4x4_identity(I);
-
-        mat4x4_translate_in_place(I, r.x, r.y, 0);
-        if (abs(vp_plib.rotation) > 0)
-          mat4x4_rotate_Z(Q, I, -vp_plib.rotation);
-        else
-          mat4x4_dup(Q, I);
-        mat4x4_translate_in_place(Q, -pivot_x, -pivot_y, 0);
-
-        pCtexture_2D_shader_program[0]->SetUniformMatrix4fv( "TransformMatrix", (GLfloat *)Q);
-
-        // Perform the actual drawing.
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-        // Restore the per-object transform to Identity Matrix
-        mat4x4 IM;
-        mat4x4_identity(IM);
-        pCtexture_2D_shader_program[0]->SetUniformMatrix4fv( "TransformMatrix", (GLfloat *)IM);
-
-        // Clean up the GL state
-        pCtexture_2D_shader_program[0]->UnBind();
+      if (pCtexture_2D_shader_program[0]) {
+        float angle = abs(vp_plib.rotation) > 0 ? -vp_plib.rotation : 0;
+        AddSymbolQuad(pCtexture_2D_shader_program[0], texture, NULL, r,
+                      pivot_x, pivot_y, w, h, uv, angle);
       }
 
 #endif  // GLES2
-      glDisable(m_TextureFormat);
-    } else { /* this is only for legacy mode, or systems without NPOT textures
-              */
-      float cr = cosf(vp_plib.rotation);
-      float sr = sinf(vp_plib.rotation);
-      float ddx = pivot_x * cr + pivot_y * sr;
-      float ddy = pivot_y * cr - pivot_x * sr;
-#if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
-#endif
     }
-
-    glDisable(GL_BLEND);
 #endif
   } else {
     if (!(prule->pixelPtr))  // This symbol requires manual alpha blending
@@ -3416,6 +3453,7 @@ bool s52plib::RenderSoundingSymbol(ObjRazRules *rzRules, Rule *prule,
   if (!m_pdc) {  // OpenGL
     if (!m_texSoundings.IsBuilt() ||
         (fabs(m_texSoundings.GetScale() - scale_factor) > 0.05)) {
+      FlushSymbolBatch();  // may use the texture
       m_texSoundings.Delete();
       m_texSoundings.SetContentScaleFactor(m_ContentScaleFactor);
 
@@ -3511,13 +3549,7 @@ bool s52plib::RenderSoundingSymbol(ObjRazRules *rzRules, Rule *prule,
   if (!m_pdc)  // opengl
   {
 #ifdef ocpnUSE_GL
-    glEnable(GL_BLEND);
-
     if (texture) {
-      glEnable(GL_TEXTURE_2D);
-      glEnable(GL_BLEND);
-      glBindTexture(GL_TEXTURE_2D, texture);
-
       int w = texrect.width, h = texrect.height;
 
       float tx1 = texrect.x, ty1 = texrect.y;
@@ -3535,7 +3567,6 @@ bool s52plib::RenderSoundingSymbol(ObjRazRules *rzRules, Rule *prule,
       }
 
       float uv[8];
-      float coords[8];
 
       // Note swizzle of points to allow TRIANGLE_STRIP drawing
       // normal uv
@@ -3548,69 +3579,15 @@ bool s52plib::RenderSoundingSymbol(ObjRazRules *rzRules, Rule *prule,
       uv[4] = tx1;
       uv[5] = ty2;
 
-      // pixels
-      coords[0] = 0;
-      coords[1] = 0;
-      coords[2] = w;
-      coords[3] = 0;
-      coords[6] = w;
-      coords[7] = h;
-      coords[4] = 0;
-      coords[5] = h;
-
       float colorv[4];
       colorv[0] = symColor.Red() / float(256);
       colorv[1] = symColor.Green() / float(256);
       colorv[2] = symColor.Blue() / float(256);
       colorv[3] = 1.0;
 
-      pCtexture_2D_Color_shader_program[0]->Bind();
-
-        // Select the active texture unit.
-      glActiveTexture(GL_TEXTURE0);
-
-      pCtexture_2D_Color_shader_program[0]->SetUniform4fv( "color", colorv);
-
-      pCtexture_2D_Color_shader_program[0]->SetUniform1i( "uTex", 0);
-
-        // Disable VBO's (vertex buffer objects) for attributes.
-      glBindBuffer(GL_ARRAY_BUFFER, 0);
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-      pCtexture_2D_Color_shader_program[0]->SetAttributePointerf( "position", coords);
-      pCtexture_2D_Color_shader_program[0]->SetAttributePointerf( "aUV", uv);
-
-      // Rotate
-       mat4x4 I, Q;
-       mat4x4_identity(I);
-       mat4x4_identity(Q);
-
-      mat4x4_translate_in_place(I, r.x, r.y, 0);
-      mat4x4_rotate_Z(Q, I, -vp_plib.rotation);
-      mat4x4_translate_in_place(Q, -pivot_x, -pivot_y, 0);
-
-      pCtexture_2D_Color_shader_program[0]->SetUniformMatrix4fv( "TransformMatrix", (GLfloat *)Q);
-
-      // Perform the actual drawing.
-      glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-      // Restore the per-object transform to Identity Matrix
-      mat4x4 IM;
-      mat4x4_identity(IM);
-      pCtexture_2D_Color_shader_program[0]->SetUniformMatrix4fv( "TransformMatrix", (GLfloat *)IM);
-      pCtexture_2D_Color_shader_program[0]->UnBind();
-      glDisable(m_TextureFormat);
-    } else { /* this is only for legacy mode, or systems without NPOT textures
-              */
-      float cr = cosf(vp_plib.rotation);
-      float sr = sinf(vp_plib.rotation);
-      float ddx = pivot_x * cr + pivot_y * sr;
-      float ddy = pivot_y * cr - pivot_x * sr;
-#if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
-#endif
+      AddSymbolQuad(pCtexture_2D_Color_shader_program[0], texture, colorv, r,
+                    pivot_x, pivot_y, w, h, uv, -vp_plib.rotation);
     }
-
-    glDisable(GL_BLEND);
 #endif
   } else {
     wxString text;
@@ -6426,6 +6403,93 @@ int s52plib::RenderObjectToGLText(const wxGLContext &glcc, ObjRazRules *rzRules)
   return DoRenderObjectTextOnly(NULL, rzRules);
 }
 
+/*
+ Rules of an object are resolved once for a given display state, including
+ the conditional symbology, and kept as a flat array in the S57Obj. The
+ render loops then only dispatch on the rule type, rule chains are walked
+ and CS procedures evaluated just when the state changes.
+ */
+void s52plib::RenderRule(ObjRazRules *rzRules, Rules *rules) {
+  //  Symbols may be batched, anything else is drawn right away
+  if (RUL_SYM_PT != rules->ruleType && RUL_MUL_SG != rules->ruleType)
+    FlushSymbolBatch();
+
+  switch (rules->ruleType) {
+    case RUL_TXT_TX:
+      RenderTX(rzRules, rules);
+      break;  // TX
+    case RUL_TXT_TE:
+      RenderTE(rzRules, rules);
+      break;  // TE
+    case RUL_SYM_PT:
+      RenderSY(rzRules, rules);
+      break;  // SY
+    case RUL_SIM_LN:
+      if (m_pdc)
+        RenderLS(rzRules, rules);
+      else
+        RenderGLLS(rzRules, rules);
+      break;  // LS
+    case RUL_COM_LN:
+      RenderLC(rzRules, rules);
+      break;  // LC
+    case RUL_MUL_SG:
+      RenderMPS(rzRules, rules);
+      break;  // MultiPoint Sounding
+    case RUL_ARC_2C:
+      RenderCARC(rzRules, rules);
+      break;  // Circular Arc, 2 colors
+    case RUL_NONE:
+    default:
+      break;  // no rule type (init)
+  }
+}
+
+Rules *s52plib::GetCSRules(ObjRazRules *rzRules, Rules *rules) {
+  if (!rzRules->obj->bCS_Added) {
+    rzRules->obj->CSrules = NULL;
+    GetAndAddCSRules(rzRules, rules);
+    if (strncmp(rzRules->obj->FeatureName, "SOUNDG", 6))
+      rzRules->obj->bCS_Added = 1;  // mark the object
+  }
+  return rzRules->obj->CSrules;
+}
+
+/*
+ Return the flat rule array of an object whose display state is cached,
+ compiling it if needed. Return NULL if the CS rules are not yet stable,
+ the caller then walks the rule chain.
+ */
+const std::vector<Rules *> *s52plib::GetCompiledRules(ObjRazRules *rzRules) {
+  S57Obj *obj = rzRules->obj;
+  if (!obj->m_render_rules.empty() && obj->CSrules == obj->m_render_cs &&
+      (obj->bCS_Added || !obj->m_render_uses_cs))
+    return &obj->m_render_rules;
+
+  obj->m_render_rules.clear();
+  obj->m_render_uses_cs = false;
+  for (Rules *rules = rzRules->LUP->ruleList; rules; rules = rules->next) {
+    if (RUL_CND_SY != rules->ruleType) {
+      obj->m_render_rules.push_back(rules);
+      continue;
+    }
+    // SOUNDG CS rules are evaluated for each render, never compiled
+    if (!obj->bCS_Added) {
+      obj->m_render_rules.clear();
+      return NULL;
+    }
+    obj->m_render_uses_cs = true;
+    if (!obj->CSrules) continue;
+    // Like the chain walk, rules following CS rules are not rendered
+    for (Rules *cs = obj->CSrules; cs; cs = cs->next)
+      obj->m_render_rules.push_back(cs);
+    break;
+  }
+  obj->m_render_cs = obj->CSrules;
+  if (obj->m_render_rules.empty()) return NULL;
+  return &obj->m_render_rules;
+}
+
 int s52plib::DoRenderObject(wxDC *pdcin, ObjRazRules *rzRules) {
   // TODO  Debugging
         //if(rzRules->obj->Index == 6775)
@@ -6435,93 +6499,29 @@ int s52plib::DoRenderObject(wxDC *pdcin, ObjRazRules *rzRules) {
   //            int yyp = 0;
 
   //return 0;
+  //  Compile rules only for objects already checked in an earlier render
+  //  with the same state, not for temporary ones like of plugin charts.
+  bool b_cached = IsRenderStateCached(rzRules);
   if (!ObjectRenderCheckRules(rzRules, true)) return 0;
 
   m_pdc = pdcin;  // use this DC
-  Rules *rules = rzRules->LUP->ruleList;
-
-  while (rules != NULL) {
-    switch (rules->ruleType) {
-      case RUL_TXT_TX:
-        RenderTX(rzRules, rules);
-        break;  // TX
-      case RUL_TXT_TE:
-        RenderTE(rzRules, rules);
-        break;  // TE
-      case RUL_SYM_PT:
-        RenderSY(rzRules, rules);
-        break;  // SY
-      case RUL_SIM_LN:
-        if (m_pdc)
-          RenderLS(rzRules, rules);
-        else
-          RenderGLLS(rzRules, rules);
-        break;  // LS
-      case RUL_COM_LN:
-        RenderLC(rzRules, rules);
-        break;  // LC
-      case RUL_MUL_SG:
-        RenderMPS(rzRules, rules);
-        break;  // MultiPoint Sounding
-      case RUL_ARC_2C:
-        RenderCARC(rzRules, rules);
-        break;  // Circular Arc, 2 colors
-
-      case RUL_CND_SY: {
-        if (!rzRules->obj->bCS_Added) {
-          rzRules->obj->CSrules = NULL;
-          GetAndAddCSRules(rzRules, rules);
-          if (strncmp(rzRules->obj->FeatureName, "SOUNDG", 6))
-            rzRules->obj->bCS_Added = 1;  // mark the object
-        }
 
-        Rules *rules_last = rules;
-        rules = rzRules->obj->CSrules;
-
-        while (NULL != rules) {
-          switch (rules->ruleType) {
-            case RUL_TXT_TX:
-              RenderTX(rzRules, rules);
-              break;
-            case RUL_TXT_TE:
-              RenderTE(rzRules, rules);
-              break;
-            case RUL_SYM_PT:
-              RenderSY(rzRules, rules);
-              break;
-            case RUL_SIM_LN:
-              if (m_pdc)
-                RenderLS(rzRules, rules);
-              else
-                RenderGLLS(rzRules, rules);
-              break;  // LS
-            case RUL_COM_LN:
-              RenderLC(rzRules, rules);
-              break;
-            case RUL_MUL_SG:
-              RenderMPS(rzRules, rules);
-              break;  // MultiPoint Sounding
-            case RUL_ARC_2C:
-              RenderCARC(rzRules, rules);
-              break;  // Circular Arc, 2 colors
-            case RUL_NONE:
-            default:
-              break;  // no rule type (init)
-          }
-          rules_last = rules;
-          rules = rules->next;
-        }
-
-        rules = rules_last;
-        break;
-      }
-
-      case RUL_NONE:
-      default:
-        break;  // no rule type (init)
-    }           // switch
+  const std::vector<Rules *> *compiled =
+      b_cached ? GetCompiledRules(rzRules) : NULL;
+  if (compiled) {
+    for (Rules *rules : *compiled) RenderRule(rzRules, rules);
+    return 1;
+  }
 
-    rules = rules->next;
+  for (Rules *rules = rzRules->LUP->ruleList; rules; rules = rules->next) {
+    if (RUL_CND_SY != rules->ruleType) {
+      RenderRule(rzRules, rules);
+      continue;
+    }
+    Rules *cs = GetCSRules(rzRules, rules);
+    if (!cs) continue;
+    for (; cs; cs = cs->next) RenderRule(rzRules, cs);
+    break;  // rules following CS rules are not rendered
   }
 
   return 1;
@@ -6534,55 +6534,32 @@ int s52plib::DoRenderObjectTextOnly(wxDC *pdcin, ObjRazRules *rzRules) {
   //    if(rzRules->obj->Index == 2766)
   //        int yyp = 4;
 
+  bool b_cached = IsRenderStateCached(rzRules);
   if (!ObjectRenderCheckRules(rzRules, true)) return 0;
 
   m_pdc = pdcin;  // use this DC
-  Rules *rules = rzRules->LUP->ruleList;
-
-  while (rules != NULL) {
-    switch (rules->ruleType) {
-      case RUL_TXT_TX:
-        RenderTX(rzRules, rules);
-        break;  // TX
-      case RUL_TXT_TE:
-        RenderTE(rzRules, rules);
-        break;  // TE
-      case RUL_CND_SY: {
-        if (!rzRules->obj->bCS_Added) {
-          rzRules->obj->CSrules = NULL;
-          GetAndAddCSRules(rzRules, rules);
-          if (strncmp(rzRules->obj->FeatureName, "SOUNDG", 6))
-            rzRules->obj->bCS_Added = 1;  // mark the object
-        }
-
-        Rules *rules_last = rules;
-        rules = rzRules->obj->CSrules;
-
-        while (NULL != rules) {
-          switch (rules->ruleType) {
-            case RUL_TXT_TX:
-              RenderTX(rzRules, rules);
-              break;
-            case RUL_TXT_TE:
-              RenderTE(rzRules, rules);
-              break;
-            default:
-              break;  // no rule type (init)
-          }
-          rules_last = rules;
-          rules = rules->next;
-        }
 
-        rules = rules_last;
-        break;
-      }
+  auto render_text = [&](Rules *rules) {
+    if (RUL_TXT_TX == rules->ruleType || RUL_TXT_TE == rules->ruleType)
+      RenderRule(rzRules, rules);
+  };
 
-      case RUL_NONE:
-      default:
-        break;  // no rule type (init)
-    }           // switch
+  const std::vector<Rules *> *compiled =
+      b_cached ? GetCompiledRules(rzRules) : NULL;
+  if (compiled) {
+    for (Rules *rules : *compiled) render_text(rules);
+    return 1;
+  }
 
-    rules = rules->next;
+  for (Rules *rules = rzRules->LUP->ruleList; rules; rules = rules->next) {
+    if (RUL_CND_SY != rules->ruleType) {
+      render_text(rules);
+      continue;
+    }
+    Rules *cs = GetCSRules(rzRules, rules);
+    if (!cs) continue;
+    for (; cs; cs = cs->next) render_text(cs);
+    break;  // rules following CS rules are not rendered
   }
 
   return 1;
@@ -8702,6 +8679,8 @@ int s52plib::RenderToGLAP_GLSL(ObjRazRules *rzRules, Rules *rules) {
 int s52plib::RenderAreaToGL(const wxGLContext &glcc, ObjRazRules *rzRules) {
   if (!ObjectRenderCheckRules(rzRules, true)) return 0;
 
+  FlushSymbolBatch();  // keep the draw order
+
   Rules *rules = rzRules->LUP->ruleList;
 
   while (rules != NULL) {
@@ -9385,7 +9364,18 @@ bool s52plib::ObjectRenderCheckPosReduced(ObjRazRules *rzRules) {
 bool s52plib::ObjectRenderCheckCat(ObjRazRules *rzRules) {
   g_scaminScale = 1.0;
 
-  if (rzRules->obj == NULL) return false;
+  switch (ObjectRenderFilterCat(rzRules)) {
+    case CAT_SHOWN:
+      return true;
+    case CAT_SCAMIN:
+      return ObjectRenderCheckScamin(rzRules);
+    default:
+      return false;
+  }
+}
+
+s52plib::CatFilter s52plib::ObjectRenderFilterCat(ObjRazRules *rzRules) {
+  if (rzRules->obj == NULL) return CAT_HIDDEN;
 
   bool b_catfilter = true;
   bool b_visible = false;
@@ -9400,24 +9390,24 @@ bool s52plib::ObjectRenderCheckCat(ObjRazRules *rzRules) {
     if (OTHER == obj_cat) {
       if (!strncmp(rzRules->LUP->OBCL, "M_", 2)){
         if (!m_bShowMeta)
-          return false;
+          return CAT_HIDDEN;
         else {
           if (!strncmp(rzRules->LUP->OBCL, "M_QUAL", 6) && !m_qualityOfDataOn)
-            return false;
+            return CAT_HIDDEN;
         }
       }
     }
   } else {
     // We want to filter out M_NSYS objects everywhere except "OTHER" category
     if (!strncmp(rzRules->LUP->OBCL, "M_", 2))
-      if (!m_bShowMeta) return false;
+      if (!m_bShowMeta) return CAT_HIDDEN;
   }
 
 #ifdef __OCPN__ANDROID__
   // We want to filter out M_NSYS objects on Android, as they are of limited use
   // on a phone/tablet
   if (!strncmp(rzRules->LUP->OBCL, "M_", 2))
-    if (!m_bShowMeta) return false;
+    if (!m_bShowMeta) return CAT_HIDDEN;
 #endif
 
   if (m_nDisplayCategory == MARINERS_STANDARD) {
@@ -9453,105 +9443,106 @@ bool s52plib::ObjectRenderCheckCat(ObjRazRules *rzRules) {
   //  Soundings override
   if (!strncmp(rzRules->LUP->OBCL, "SOUNDG", 6)) b_catfilter = m_bShowSoundg;
 
-  if (b_catfilter) {
-    b_visible = true;
-
-    //      SCAMIN Filtering
-    //      Implementation note:
-    //      According to S52 specs, SCAMIN must not apply to GROUP1 objects,
-    //      Meta Objects or DisplayCategoryBase objects. Occasionally, an ENC
-    //      will encode a spurious SCAMIN value for one of these objects. see,
-    //      for example, US5VA18M, in OpenCPN SENC as Feature 350(DEPARE), LNAM
-    //      = 022608187ED20ACC. We shall explicitly ignore SCAMIN filtering for
-    //      these types of objects.
-
-    if (m_bUseSCAMIN) {
-      if ((DISPLAYBASE == rzRules->LUP->DISC) ||
-          (PRIO_GROUP1 == rzRules->LUP->DPRI))
-        b_visible = true;
-      else {
-        //                if( vp->chart_scale > rzRules->obj->Scamin ) b_visible
-        //                = false;
+  if (b_catfilter) return CAT_SCAMIN;
+  return b_visible ? CAT_SHOWN : CAT_HIDDEN;
+}
 
-        double zoom_mod = (double)m_chart_zoom_modifier_vector;
+bool s52plib::ObjectRenderCheckScamin(ObjRazRules *rzRules) {
+  bool b_visible = true;
 
-        double modf = zoom_mod / 5.;  // -1->1
-        double mod = pow(8., modf);
-        mod = wxMax(mod, .2);
-        mod = wxMin(mod, 8.0);
+  //      SCAMIN Filtering
+  //      Implementation note:
+  //      According to S52 specs, SCAMIN must not apply to GROUP1 objects,
+  //      Meta Objects or DisplayCategoryBase objects. Occasionally, an ENC
+  //      will encode a spurious SCAMIN value for one of these objects. see,
+  //      for example, US5VA18M, in OpenCPN SENC as Feature 350(DEPARE), LNAM
+  //      = 022608187ED20ACC. We shall explicitly ignore SCAMIN filtering for
+  //      these types of objects.
 
-        if (mod > 1) {
-          if (vp_plib.chart_scale > rzRules->obj->Scamin * mod)
-            b_visible = false;  // definitely invisible
-          else {
-            //  Theoretically invisible, however...
-            //  In the "zoom modified" scale region,
-            //  we render the symbol at reduced size, scaling down to no less
-            //  than half normal size.
-
-            if (vp_plib.chart_scale > rzRules->obj->Scamin) {
-              double xs = vp_plib.chart_scale - rzRules->obj->Scamin;
-              double xl = (rzRules->obj->Scamin * mod) - rzRules->obj->Scamin;
-              g_scaminScale = 1.0 - (0.5 * xs / xl);
-            }
+  if (m_bUseSCAMIN) {
+    if ((DISPLAYBASE == rzRules->LUP->DISC) ||
+        (PRIO_GROUP1 == rzRules->LUP->DPRI))
+      b_visible = true;
+    else {
+      //                if( vp->chart_scale > rzRules->obj->Scamin ) b_visible
+      //                = false;
+
+      double zoom_mod = (double)m_chart_zoom_modifier_vector;
+
+      double modf = zoom_mod / 5.;  // -1->1
+      double mod = pow(8., modf);
+      mod = wxMax(mod, .2);
+      mod = wxMin(mod, 8.0);
+
+      if (mod > 1) {
+        if (vp_plib.chart_scale > rzRules->obj->Scamin * mod)
+          b_visible = false;  // definitely invisible
+        else {
+          //  Theoretically invisible, however...
+          //  In the "zoom modified" scale region,
+          //  we render the symbol at reduced size, scaling down to no less
+          //  than half normal size.
+
+          if (vp_plib.chart_scale > rzRules->obj->Scamin) {
+            double xs = vp_plib.chart_scale - rzRules->obj->Scamin;
+            double xl = (rzRules->obj->Scamin * mod) - rzRules->obj->Scamin;
+            g_scaminScale = 1.0 - (0.5 * xs / xl);
           }
-        } else {
-          if (vp_plib.chart_scale > rzRules->obj->Scamin) b_visible = false;
         }
+      } else {
+        if (vp_plib.chart_scale > rzRules->obj->Scamin) b_visible = false;
       }
+    }
 
-      // Check for SUPER_SCAMIN, apply if enabled
-      if (m_bUseSUPER_SCAMIN){
-        if (rzRules->obj->SuperScamin < 0){
-          if ( (strncmp(rzRules->obj->FeatureName, "LNDARE", 6) &&
-                strncmp(rzRules->obj->FeatureName, "DEPARE", 6) &&
-                strncmp(rzRules->obj->FeatureName, "SWPARE", 6) &&
-                strncmp(rzRules->obj->FeatureName, "RECTRK", 6) &&
-                strncmp(rzRules->obj->FeatureName, "TSS",    3) &&
-                strncmp(rzRules->obj->FeatureName, "TSEZNE", 6) &&
-                strncmp(rzRules->obj->FeatureName, "DRGARE", 6) &&
-                strncmp(rzRules->obj->FeatureName, "COALNE", 6)) ||
-              (!strncmp(rzRules->obj->FeatureName, "LNDARE", 6) && (rzRules->LUP->ruleList->ruleType != RUL_ARE_CO))) {
-
-            double chart_ref_scale = rzRules->obj->m_chart_context->chart_scale;
-
-            // Is the ENC cell SCAMIN for this object un-defined?
-            if (rzRules->obj->Scamin > 1e8) {   // undefined default value is 1e8+2
-              // Get the scale of the ENC, and establish SUPERSCAMIN
-              double super_scamin = chart_ref_scale * 4;
-              rzRules->obj->SuperScamin = super_scamin;
-            }
-            if (rzRules->obj->Scamin > 9e6) {   // Presumed undefined value for Greek ENC Lights
-              // Get the scale of the ENC, and establish SUPERSCAMIN
-              double super_scamin = chart_ref_scale * 2;
-              rzRules->obj->SuperScamin = super_scamin;
-            }
-            if (!strncmp(rzRules->obj->FeatureName, "SOUNDG", 6)){
-                if (rzRules->obj->Scamin > 4e6) {   // Presumed undefined value for Greek ENC soundings
-                  // Get the scale of the ENC, and establish SUPERSCAMIN
-                  double super_scamin = chart_ref_scale * 2;
-                  rzRules->obj->SuperScamin = super_scamin;
-              }
+    // Check for SUPER_SCAMIN, apply if enabled
+    if (m_bUseSUPER_SCAMIN){
+      if (rzRules->obj->SuperScamin < 0){
+        if ( (strncmp(rzRules->obj->FeatureName, "LNDARE", 6) &&
+              strncmp(rzRules->obj->FeatureName, "DEPARE", 6) &&
+              strncmp(rzRules->obj->FeatureName, "SWPARE", 6) &&
+              strncmp(rzRules->obj->FeatureName, "RECTRK", 6) &&
+              strncmp(rzRules->obj->FeatureName, "TSS",    3) &&
+              strncmp(rzRules->obj->FeatureName, "TSEZNE", 6) &&
+              strncmp(rzRules->obj->FeatureName, "DRGARE", 6) &&
+              strncmp(rzRules->obj->FeatureName, "COALNE", 6)) ||
+            (!strncmp(rzRules->obj->FeatureName, "LNDARE", 6) && (rzRules->LUP->ruleList->ruleType != RUL_ARE_CO))) {
+
+          double chart_ref_scale = rzRules->obj->m_chart_context->chart_scale;
+
+          // Is the ENC cell SCAMIN for this object un-defined?
+          if (rzRules->obj->Scamin > 1e8) {   // undefined default value is 1e8+2
+            // Get the scale of the ENC, and establish SUPERSCAMIN
+            double super_scamin = chart_ref_scale * 4;
+            rzRules->obj->SuperScamin = super_scamin;
+          }
+          if (rzRules->obj->Scamin > 9e6) {   // Presumed undefined value for Greek ENC Lights
+            // Get the scale of the ENC, and establish SUPERSCAMIN
+            double super_scamin = chart_ref_scale * 2;
+            rzRules->obj->SuperScamin = super_scamin;
+          }
+          if (!strncmp(rzRules->obj->FeatureName, "SOUNDG", 6)){
+              if (rzRules->obj->Scamin > 4e6) {   // Presumed undefined value for Greek ENC soundings
+                // Get the scale of the ENC, and establish SUPERSCAMIN
+                double super_scamin = chart_ref_scale * 2;
+                rzRules->obj->SuperScamin = super_scamin;
             }
           }
         }
-
-        // Make the test
-        if ((rzRules->obj->SuperScamin > 0) &&
-             (vp_plib.chart_scale > rzRules->obj->SuperScamin))
-            b_visible = false;
-
       }
 
+      // Make the test
+      if ((rzRules->obj->SuperScamin > 0) &&
+           (vp_plib.chart_scale > rzRules->obj->SuperScamin))
+          b_visible = false;
 
-      //      On the other hand, $TEXTS features need not really be displayed at
-      //      all scales, always To do so makes a very cluttered display
-      if ((!strncmp(rzRules->LUP->OBCL, "$TEXTS", 6)) &&
-          (vp_plib.chart_scale > rzRules->obj->Scamin))
-        b_visible = false;
     }
 
-    return b_visible;
+
+    //      On the other hand, $TEXTS features need not really be displayed at
+    //      all scales, always To do so makes a very cluttered display
+    if ((!strncmp(rzRules->LUP->OBCL, "$TEXTS", 6)) &&
+        (vp_plib.chart_scale > rzRules->obj->Scamin))
+      b_visible = false;
   }
 
   return b_visible;
@@ -9627,27 +9618,85 @@ bool s52plib::ObjectRenderCheckDates(ObjRazRules *rzRules) {
   return true;
 }
 
+bool s52plib::IsRenderStateCached(ObjRazRules *rzRules) {
+  S57Obj *obj = rzRules->obj;
+  if (!obj || obj->m_render_key != m_render_key ||
+      obj->m_render_lup != rzRules->LUP ||
+      obj->m_render_cat != obj->m_DisplayCat)
+    return false;
+
+  //  A hidden object may still be promoted by its CS procedure once the
+  //  CS rules are evaluated again
+  return CAT_HIDDEN != obj->m_render_filter || obj->bCS_Added ||
+         !obj->m_bcategory_mutable;
+}
+
 bool s52plib::ObjectRenderCheckRules(ObjRazRules *rzRules, bool check_noshow) {
   if (!ObjectRenderCheckPos(rzRules)) return false;
 
+  //  Filters not depending on the viewport are cached in the object, for
+  //  the noshow checking renderers.
+  S57Obj *obj = rzRules->obj;
+  CatFilter filter;
+  bool b_dated = true;
+  if (check_noshow && IsRenderStateCached(rzRules)) {
+    filter = (CatFilter)obj->m_render_filter;
+    b_dated = obj->m_render_dated;
+  } else {
+    filter = ObjectRenderFilter(rzRules, check_noshow);
+    if (check_noshow) {
+      obj->m_render_key = m_render_key;
+      obj->m_render_lup = rzRules->LUP;
+      obj->m_render_cat = obj->m_DisplayCat;
+      obj->m_render_filter = filter;
+      obj->m_render_dated = obj->GetAttributeIndex("DATSTA") >= 0 ||
+                            obj->GetAttributeIndex("DATEND") >= 0 ||
+                            obj->GetAttributeIndex("PEREND") >= 0;
+      obj->m_render_rules.clear();
+    }
+  }
+
+  g_scaminScale = 1.0;
+  if (CAT_HIDDEN == filter) return false;
+  if (CAT_SCAMIN == filter && !ObjectRenderCheckScamin(rzRules)) {
+    //  Culled by SCAMIN, unless the CS procedure moves it to DISPLAYBASE
+    if (!ObjectRenderPromoteCS(rzRules)) return false;
+    filter = ObjectRenderFilterCat(rzRules);
+    if (check_noshow) obj->m_render_filter = filter;
+    if (CAT_HIDDEN == filter) return false;
+    if (CAT_SCAMIN == filter && !ObjectRenderCheckScamin(rzRules))
+      return false;
+  }
+
+  return !b_dated || ObjectRenderCheckDates(rzRules);
+}
+
+s52plib::CatFilter s52plib::ObjectRenderFilter(ObjRazRules *rzRules,
+                                               bool check_noshow) {
   // The Feature M_QUAL, in MARINERS_STANDARD catagory, is a special case,
   // since it is also controlled by a global hotkey in display category ALL and
   // MARINERS_STANDARD
   if (m_nDisplayCategory == MARINERS_STANDARD) {
     if (strncmp(rzRules->obj->FeatureName, "M_QUAL",
                 6)) {  // Anything other than M_QUAL
-      if (check_noshow && IsObjNoshow(rzRules->LUP->OBCL)) return 0;
+      if (check_noshow && IsObjNoshow(rzRules->LUP->OBCL)) return CAT_HIDDEN;
     } else {
-      if (!m_qualityOfDataOn) return 0;
+      if (!m_qualityOfDataOn) return CAT_HIDDEN;
     }
   } else {
-    if (check_noshow && IsObjNoshow(rzRules->LUP->OBCL)) return false;
+    if (check_noshow && IsObjNoshow(rzRules->LUP->OBCL)) return CAT_HIDDEN;
   }
 
-  if (ObjectRenderCheckCat(rzRules)) {
-    return ObjectRenderCheckDates(rzRules);
-  }
+  //  Objects passing the category filter get their CS evaluated when they
+  //  pass the SCAMIN check too, and are rendered
+  CatFilter filter = ObjectRenderFilterCat(rzRules);
+  if (CAT_HIDDEN != filter) return filter;
+
+  if (!ObjectRenderPromoteCS(rzRules)) return filter;
+  return ObjectRenderFilterCat(rzRules);
+}
 
+bool s52plib::ObjectRenderPromoteCS(ObjRazRules *rzRules) {
   //  If this object cannot be moved to a higher category by CS procedures,
   //  then we are done here
   if (!rzRules->obj->m_bcategory_mutable) return false;
@@ -9666,15 +9715,11 @@ bool s52plib::ObjectRenderCheckRules(ObjRazRules *rzRules, bool check_noshow) {
     if (RUL_CND_SY == rules->ruleType) {
       GetAndAddCSRules(rzRules, rules);
       rzRules->obj->bCS_Added = 1;  // mark the object
-      break;
+      return true;
     }
     rules = rules->next;
   }
-
-  // still not displayable
-  if (!ObjectRenderCheckCat(rzRules)) return false;
-
-  return ObjectRenderCheckDates(rzRules);
+  return false;
 }
 
 void s52plib::SetDisplayCategory(enum _DisCat cat) {
@@ -9963,6 +10008,8 @@ void s52plib::PrepareForRender(VPointCompat *vp) {
   // Precalulate the ENC scale factors
   m_SoundingsScaleFactor = (m_nSoundingFactor * .1) + 1; //exp(m_nSoundingFactor * (log(2.0) / 5.0));
   m_TextScaleFactor = exp(m_nTextFactor * (log(2.0) / 5.0));
+
+  UpdateRenderKey();
 }
 
 void s52plib::SetAnchorOn(bool val) {
@@ -10014,9 +10061,11 @@ void s52plib::SetQualityOfData(bool val) {
 
 void s52plib::ClearTextList(void) {
   //      Clear the current text rectangle list
-  m_textObjList.Clear();
+  m_textGrid.Clear();
 }
 
+void s52plib::RemoveFromTextList(S52_TextC *text) { m_textGrid.Remove(text); }
+
 bool s52plib::EnableGLLS(bool b_enable) {
   bool return_val = m_benableGLLS;
   m_benableGLLS = b_enable;
@@ -10024,24 +10073,10 @@ bool s52plib::EnableGLLS(bool b_enable) {
 }
 
 void s52plib::AdjustTextList(int dx, int dy, int screenw, int screenh) {
+  //    The text rectangles are not moved on pans. In a DC quilt each chart
+  //    asks for the same shift of the one shared list, and the texts the
+  //    list refers to are owned by the charts.
   return;
-  wxRect rScreen(0, 0, screenw, screenh);
-  //    Iterate over the text rectangle list
-  //        1.  Apply the specified offset to the list elements
-  //        2.. Remove any list elements that are off screen after applied
-  //        offset
-
-  TextObjList::Node *node = m_textObjList.GetFirst();
-  TextObjList::Node *next;
-  while (node) {
-    next = node->GetNext();
-    wxRect *pcurrent = &(node->GetData()->rText);
-    pcurrent->Offset(dx, dy);
-    if (!pcurrent->Intersects(rScreen)) {
-      m_textObjList.DeleteNode(node);
-    }
-    node = next;
-  }
 }
 
 bool s52plib::GetPointPixArray(ObjRazRules *rzRules, wxPoint2DDouble *pd,
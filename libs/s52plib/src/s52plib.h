@@ -35,6 +35,7 @@ class wxGLContext;
 #include "DepthFont.h"
 #include "chartsymbols.h"
 #include "TexFont.h"
+#include "label_grid.h"
 
 #include <wx/dcgraph.h>  // supplemental, for Mac
 #include <unordered_map>
@@ -107,8 +108,6 @@ WX_DECLARE_HASH_MAP(wxString, Rule *, wxStringHash, wxStringEqual, RuleHash);
 
 WX_DEFINE_SORTED_ARRAY(LUPrec *, wxArrayOfLUPrec);
 
-WX_DECLARE_LIST(S52_TextC, TextObjList);
-
 struct CARC_Buffer {
   unsigned char color[3][4];
   float line_width[3];
@@ -124,6 +123,7 @@ class PixelCache;
 
 class RenderFromHPGL;
 class TexFont;
+class CGLShaderProgram;
 class wxFileConfig;
 
 class noshow_element {
@@ -212,6 +212,12 @@ public:
   void GenerateStateHash();
   long GetStateHash() { return m_state_hash; }
 
+  /**
+   * Key of the state object display filters depend on besides position
+   * and scale, updated by PrepareForRender(). Never 0.
+   */
+  unsigned int GetRenderKey() { return m_render_key; }
+
   void SetPLIBColorScheme(wxString scheme, const ChartCtx& ctx);
   void SetPLIBColorScheme(ColorScheme cs, const ChartCtx& ctx);
   wxString GetPLIBColorScheme(void) { return m_ColorScheme; }
@@ -233,6 +239,13 @@ public:
   bool ObjectRenderCheckCS(ObjRazRules *rzRules);
   bool ObjectRenderCheckDates(ObjRazRules *rzRules);
 
+  /** Outcome of the display filters which do not depend on the viewport. */
+  enum CatFilter {
+    CAT_HIDDEN,  ///< Not displayed
+    CAT_SHOWN,   ///< Displayed at all scales
+    CAT_SCAMIN   ///< Displayed subject to SCAMIN filtering
+  };
+
   static void DestroyLUP(LUPrec *pLUP);
   static void ClearRulesCache(Rule *pR);
   DisCat findLUPDisCat(const char *objectName, LUPname TNAM);
@@ -247,6 +260,8 @@ public:
   void PrepareForRender(void);
   void AdjustTextList(int dx, int dy, int screenw, int screenh);
   void ClearTextList(void);
+  /** Drop text from the declutter list, before it is deleted. */
+  void RemoveFromTextList(S52_TextC *text);
   int SetLineFeaturePriority(ObjRazRules *rzRules, int npriority);
   void FlushSymbolCaches(const ChartCtx& ctx);
 
@@ -316,6 +331,22 @@ public:
   int RenderAreaToGL(const wxGLContext &glcc, ObjRazRules *rzRules);
   int RenderObjectToGLText(const wxGLContext &glcc, ObjRazRules *rzRules);
 
+  /**
+   * Start collecting OpenGL raster symbols and soundings, drawing all
+   * consecutive ones sharing texture, shader and colour with one call.
+   * Any other drawing by the library first draws the collected symbols,
+   * keeping the render order.
+   */
+  void BeginSymbolBatch() { m_symbol_batching = true; }
+  /** Draw collected symbols and stop collecting. */
+  void EndSymbolBatch();
+
+  /** OpenGL raster symbols drawn since ResetSymbolStats(). */
+  size_t GetSymbolCount() const { return m_symbol_count; }
+  /** OpenGL draw calls used for the raster symbols. */
+  size_t GetSymbolDrawCount() const { return m_symbol_draws; }
+  void ResetSymbolStats() { m_symbol_count = m_symbol_draws = 0; }
+
   bool EnableGLLS(bool benable);
 
   bool IsObjNoshow(const char *objcl);
@@ -415,6 +446,16 @@ private:
 
   int DoRenderObject(wxDC *pdcin, ObjRazRules *rzRules);
   int DoRenderObjectTextOnly(wxDC *pdcin, ObjRazRules *rzRules);
+  void RenderRule(ObjRazRules *rzRules, Rules *rules);
+  Rules *GetCSRules(ObjRazRules *rzRules, Rules *rules);
+  const std::vector<Rules *> *GetCompiledRules(ObjRazRules *rzRules);
+
+  bool IsRenderStateCached(ObjRazRules *rzRules);
+  CatFilter ObjectRenderFilter(ObjRazRules *rzRules, bool check_noshow);
+  CatFilter ObjectRenderFilterCat(ObjRazRules *rzRules);
+  bool ObjectRenderPromoteCS(ObjRazRules *rzRules);
+  bool ObjectRenderCheckScamin(ObjRazRules *rzRules);
+  void UpdateRenderKey();
 
   //    Area Renderers
   int RenderToBufferAC(ObjRazRules *rzRules, Rules *rules,
@@ -479,6 +520,11 @@ private:
   bool RenderSoundingSymbol(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
                             wxColor symColor,
                             float rot_angle = 0.);
+  void AddSymbolQuad(CGLShaderProgram *shader, unsigned int texture,
+                     const float *color, const wxPoint &r, int pivot_x,
+                     int pivot_y, float w, float h, const float *uv,
+                     float angle);
+  void FlushSymbolBatch();
   wxImage RuleXBMToImage(Rule *prule);
 
   bool RenderText(wxDC *pdc, S52_TextC *ptext, int x, int y, wxRect *pRectDrawn,
@@ -560,7 +606,8 @@ private:
   int m_colortable_index;
   int m_colortable_index_save;
 
-  TextObjList m_textObjList;
+  /** Rectangles of texts drawn so far, for declutter. */
+  LabelGrid<S52_TextC *> m_textGrid;
 
   wxString m_ColorScheme;
 
@@ -569,6 +616,17 @@ private:
   bool m_qualityOfDataOn;
 
   long m_state_hash;
+  unsigned int m_render_key;
+
+  //  Pending symbol quads as triangles, see BeginSymbolBatch()
+  bool m_symbol_batching;
+  CGLShaderProgram *m_batch_shader;
+  unsigned int m_batch_texture;
+  float m_batch_color[4];
+  std::vector<float> m_batch_coords;
+  std::vector<float> m_batch_uv;
+  size_t m_symbol_count;
+  size_t m_symbol_draws;
 
   bool m_txf_ready;
   int m_txf_avg_char_width;
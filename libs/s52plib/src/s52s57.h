@@ -435,6 +435,17 @@ public:
                              //  category. Used as a hint to rendering filter
                              //  logic
 
+  // Render state cached by s52plib, valid while m_render_key matches
+  // s52plib::GetRenderKey(), see s52plib::ObjectRenderCheckRules()
+  unsigned int m_render_key;  // 0 if nothing cached
+  LUPrec *m_render_lup;       // LUP the state was computed for
+  DisCat m_render_cat;        // m_DisplayCat the state was computed for
+  int m_render_filter;        // Display filter outcome, s52plib::CatFilter
+  bool m_render_dated;        // Has DATSTA, DATEND or PEREND attribute
+  std::vector<Rules *> m_render_rules;  // Rules with CS expanded, flat
+  Rules *m_render_cs;         // CSrules m_render_rules were compiled with
+  bool m_render_uses_cs;      // m_render_rules include CS rules
+
   // This transform converts from object geometry
   // to SM coordinates.
   double x_rate;    // These auxiliary transform coefficients are
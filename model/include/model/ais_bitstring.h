@@ -25,10 +25,19 @@
 #ifndef _AIS_BITSTRING_H__
 #define _AIS_BITSTRING_H__
 
+#include <cstdint>
+
 #define AIS_MAX_MESSAGE_LEN \
   (10 * 82)  // AIS Spec allows up to 9 sentences per message, 82 bytes each
+
+/**
+ * Bit accessible AIS payload. The armoured payload is unpacked to 64-bit
+ * words, most significant bit first, so fields are extracted using a
+ * shift and a mask. No heap allocation.
+ */
 class AisBitstring {
 public:
+  AisBitstring() : bitwords(), byte_length(0) {}
   AisBitstring(const char *str);
   unsigned char to_6bit(const char c);
 
@@ -38,7 +47,13 @@ public:
   int GetBitCount();
 
 private:
-  unsigned char bitbytes[AIS_MAX_MESSAGE_LEN];
+  /** Words used by a max size message, plus one for reads across end. */
+  static const int kWords = (AIS_MAX_MESSAGE_LEN * 6 + 63) / 64 + 1;
+
+  /** Return len <= 64 bits starting at 0-based bit pos, right aligned. */
+  uint64_t GetBits(int pos, int len) const;
+
+  uint64_t bitwords[kWords];
   int byte_length;
 };
 
@@ -25,8 +25,10 @@
 #ifndef _AIS_DECODER_H__
 #define _AIS_DECODER_H__
 
+#include <chrono>
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <vector>
 
@@ -38,10 +40,13 @@
 #include "model/ais_bitstring.h"
 #include "model/ais_defs.h"
 #include "model/ais_target_data.h"
+#include "model/ais_vdx_worker.h"
 #include "model/comm_navmsg.h"
+#include "model/ll_grid_index.h"
 #include "model/ocpn_types.h"
 #include "model/select.h"
 #include "model/track.h"
+#include "observable_batch.h"
 #include "observable_evtvar.h"
 
 class AisDecoder;             // forward
@@ -92,9 +97,15 @@ WX_DEFINE_ARRAY_PTR(MmsiProperties *, ArrayOfMmsiProperties);
 struct AisDecoderCallbacks {
   std::function<bool()> confirm_stop_track;
   std::function<int()> get_target_mmsi;
+  /** True if a list displaying all targets' range and CPA is visible. */
+  std::function<bool()> target_list_shown;
+  /** MMSI of target displayed in a query dialog, 0 if none. */
+  std::function<int()> get_query_mmsi;
   AisDecoderCallbacks()
       : confirm_stop_track([]() { return true; }),
-        get_target_mmsi([]() { return 0; }) {}
+        get_target_mmsi([]() { return 0; }),
+        target_list_shown([]() { return false; }),
+        get_query_mmsi([]() { return 0; }) {}
 };
 
 class AisDecoder : public wxEvtHandler {
@@ -123,6 +134,13 @@ public:
   std::map<int, Track *> m_persistent_tracks;
   bool AIS_AlertPlaying(void) { return m_bAIS_AlertPlaying; };
 
+  /**
+   * Update range, bearing and CPA of targets, invoked each timer tick.
+   * Targets which could raise an alarm or are displayed are updated each
+   * time, others round-robin within a few seconds.
+   */
+  void UpdateAllCPA(void);
+
   /**
    * Notified when AIS user dialogs should update. Event contains a
    * AIS_Target_data pointer.
@@ -150,11 +168,14 @@ private:
   void OnTimerDSC(wxTimerEvent &event);
 
   bool NMEACheckSumOK(const wxString &str);
+  AisError DecodeVdx(const wxString &str, AisBitstring &strbit);
+  void HandleVdxBatch(void);
   bool Parse_VDXBitstring(AisBitstring *bstr,
                           std::shared_ptr<AisTargetData> ptd);
-  void UpdateAllCPA(void);
   void UpdateOneCPA(AisTargetData *ptarget);
   void UpdateAllAlarms(void);
+  void UpdateOneAlarm(AisTargetData *td);
+  double GetCpaCandidateRadius(void) const;
   void UpdateAllTracks(void);
   void UpdateOneTrack(AisTargetData *ptarget);
   void BuildERIShipTypeHash(void);
@@ -192,23 +213,9 @@ private:
   AIS_Target_Name_Hash *AISTargetNamesC;
   AIS_Target_Name_Hash *AISTargetNamesNC;
 
-  ObservableListener listener_N0183_VDM;
-  ObservableListener listener_N0183_FRPOS;
-  ObservableListener listener_N0183_CDDSC;
-  ObservableListener listener_N0183_CDDSE;
-  ObservableListener listener_N0183_TLL;
-  ObservableListener listener_N0183_TTM;
-  ObservableListener listener_N0183_OSD;
-  ObservableListener listener_N0183_WPL;
+  ObsBatchListener listener_N0183_AIS;
   ObservableListener listener_SignalK;
-
-  ObservableListener listener_N2K_129038;
-  ObservableListener listener_N2K_129039;
-  ObservableListener listener_N2K_129041;
-  ObservableListener listener_N2K_129794;
-  ObservableListener listener_N2K_129809;
-  ObservableListener listener_N2K_129810;
-  ObservableListener listener_N2K_129793;
+  ObsBatchListener listener_N2K_AIS;
 
   bool m_busy;
   wxTimer TimerAIS;
@@ -232,6 +239,22 @@ private:
   wxString m_dsc_last_string;
   std::vector<int> m_MMSI_MismatchVec;
 
+  /** Positions of all targets with a valid position, keyed by MMSI. */
+  LLGridIndex<int> m_target_grid;
+  /** Targets which may raise a CPA alarm, refreshed each timer tick. */
+  std::vector<int> m_cpa_candidates;
+  /** Targets alarming, in ack timeout or SART/DSC, whatever the range. */
+  std::unordered_set<int> m_alarm_targets;
+  /** Targets waiting for their periodic, round-robin CPA refresh. */
+  std::vector<int> m_cpa_refresh_queue;
+  /** Time when all targets in m_cpa_refresh_queue should be refreshed. */
+  std::chrono::steady_clock::time_point m_cpa_refresh_deadline;
+
+  /** Decodes VDM/VDO sentences off the main thread. */
+  std::unique_ptr<AisVdxWorker> m_vdx_worker;
+  /** Decoded messages being handled, reused between batches. */
+  std::vector<AisVdxMessage> m_vdx_batch;
+
   bool m_bAIS_AlertPlaying;
   DECLARE_EVENT_TABLE()
 };
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Worker thread decoding AIS VDM/VDO sentences off the main thread.
+ */
+
+#ifndef _AIS_VDX_WORKER_H__
+#define _AIS_VDX_WORKER_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "model/ais_bitstring.h"
+#include "model/ring_buffer.h"
+
+/** A complete, checksum verified AIS message as decoded by AisVdxWorker. */
+struct AisVdxMessage {
+  std::string sentence;  ///< Last or only sentence of the message
+  AisBitstring bits;     ///< Reassembled and de-armoured payload
+  int mmsi;
+  int message_id;
+};
+
+/** AisVdxWorker counters, all counting since creation. */
+struct AisVdxStats {
+  uint64_t sentences;  ///< Sentences handed to Push()
+  uint64_t messages;   ///< Complete messages decoded
+  uint64_t bad;        ///< Sentences with bad checksum or format
+  uint64_t dropped;    ///< Sentences and messages lost on full queues
+};
+
+/**
+ * Pure C++ decode stage for AIS VDM/VDO sentences.
+ *
+ * Push() queues raw sentences without any parsing. A worker thread
+ * verifies checksums, splits fields, reassembles multipart messages
+ * per channel and sequence id and converts the payload to an
+ * AisBitstring. When the first message is available after the last
+ * Drain() the ready callback is invoked on the worker thread; the
+ * consumer is then supposed to fetch all messages available using
+ * Drain(), typically in the main thread.
+ *
+ * Mapping messages onto targets depends on the target list and
+ * settings and is left to the consumer.
+ */
+class AisVdxWorker {
+public:
+  /**
+   * Start the worker thread.
+   * @param ready Invoked on worker thread when messages becomes
+   *        available, at most once between Drain() calls.
+   * @param queue_size Max number of queued sentences and messages
+   *        respectively, further items are dropped.
+   */
+  AisVdxWorker(std::function<void()> ready, size_t queue_size = 1024);
+
+  ~AisVdxWorker();
+
+  AisVdxWorker(const AisVdxWorker&) = delete;
+  AisVdxWorker& operator=(const AisVdxWorker&) = delete;
+
+  /**
+   * Queue a VDM or VDO sentence for decoding, thread safe.
+   * @return false if the queue is full and sentence is dropped.
+   */
+  bool Push(std::string sentence);
+
+  /**
+   * Move all decoded messages to out, consumer thread only.
+   * @return Number of messages appended to out.
+   */
+  size_t Drain(std::vector<AisVdxMessage>& out);
+
+  /** Stop and join the worker thread. Pending sentences are dropped. */
+  void Stop();
+
+  AisVdxStats GetStats() const;
+
+  /** Return true if the NMEA0183 checksum of sentence is correct. */
+  static bool ChecksumOk(const std::string& sentence);
+
+private:
+  /** Multipart message being reassembled. */
+  struct Partial {
+    int count;
+    int next;
+    std::string payload;
+  };
+
+  void Worker();
+  void Decode(const std::string& sentence);
+  void Deliver(const std::string& sentence, const std::string& payload);
+  void SplitFields(const std::string& sentence);
+
+  std::function<void()> m_ready;
+  MpscRingBuffer<std::string> m_input;
+  SpscRingBuffer<AisVdxMessage> m_output;
+  std::atomic<bool> m_ready_pending;
+
+  /** Worker thread only, keyed by channel and sequence id. */
+  std::unordered_map<int, Partial> m_partials;
+  std::vector<std::string> m_fields;
+
+  std::atomic<uint64_t> m_sentences;
+  std::atomic<uint64_t> m_messages;
+  std::atomic<uint64_t> m_bad;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond_var;
+  std::atomic<bool> m_idle;
+  std::atomic<bool> m_running;
+  std::thread m_thread;
+};
+
+#endif  // _AIS_VDX_WORKER_H__
@@ -38,6 +38,7 @@
 #include "model/comm_decoder.h"
 #include "model/comm_navmsg.h"
 #include "model/nmea_log.h"
+#include "observable_batch.h"
 
 typedef struct {
   std::string pcclass;
@@ -110,6 +111,12 @@ public:
 
   bool HandleSignalK(std::shared_ptr<const SignalkMsg> sK_msg);
 
+  /** Dispatch a batched message to the HandleN2K_xxx() for its PGN. */
+  void HandleN2KBatchItem(const ObservedItem& item);
+
+  /** Dispatch a batched message to the HandleN0183_xxx() for its type. */
+  void HandleN0183BatchItem(const ObservedItem& item);
+
   void OnDriverStateChange();
 
   void OnWatchdogTimer(wxTimerEvent &event);
@@ -129,21 +136,8 @@ public:
   wxTimer m_watchdog_timer;
 
   //  comm event listeners
-  ObservableListener listener_N2K_129029;
-  ObservableListener listener_N2K_129025;
-  ObservableListener listener_N2K_129026;
-  ObservableListener listener_N2K_127250;
-  ObservableListener listener_N2K_129540;
-
-  ObservableListener listener_N0183_RMC;
-  ObservableListener listener_N0183_HDT;
-  ObservableListener listener_N0183_HDG;
-  ObservableListener listener_N0183_HDM;
-  ObservableListener listener_N0183_VTG;
-  ObservableListener listener_N0183_GSV;
-  ObservableListener listener_N0183_GGA;
-  ObservableListener listener_N0183_GLL;
-  ObservableListener listener_N0183_AIVDO;
+  ObsBatchListener listener_N2K;
+  ObsBatchListener listener_N0183;
 
   ObservableListener listener_SignalK;
 
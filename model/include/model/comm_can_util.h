@@ -26,8 +26,13 @@
 #ifndef _COMMCANUTIL_H
 #define _COMMCANUTIL_H
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <wx/datetime.h>
 
@@ -75,18 +80,36 @@ public:
   int pgn;
 };
 
-/** Track fast message fragments eventually forming complete messages. */
+/**
+ * Return message in the format used by the N2K drivers: Actisense style
+ * header, length bytes of data and a dummy CRC.
+ */
+std::vector<unsigned char> MakeN2kDriverMsg(const CanHeader& header,
+                                            const unsigned char* data,
+                                            unsigned length);
+
+/**
+ * Track fast message fragments eventually forming complete messages.
+ *
+ * Entries are slots reused after Remove(), so an index stays valid until
+ * the entry is removed. Messages in progress are found by a hash on
+ * PGN, source, destination and sequence id.
+ */
 class FastMessageMap {
 public:
+  /**
+   * Largest reassembled size including padding: six bytes in the first
+   * frame and seven in each of the following ones, the frame counter
+   * being five bits.
+   */
+  static const unsigned kMaxDataLength = 6 + 31 * 7;
+
   class Entry {
   public:
-    Entry()
-        : time_arrived(wxDateTime::Now()),
-          sid(0),
-          expected_length(0),
-          cursor(0) {}
+    Entry() : sid(0), expected_length(0), cursor(0) {}
 
-    wxDateTime time_arrived;  ///< time of last fragment.
+    /// Time of last fragment.
+    std::chrono::steady_clock::time_point time_arrived;
 
     /// Can header, used to "map" the incoming fast message fragments
     CanHeader header;
@@ -97,10 +120,11 @@ public:
 
     unsigned int expected_length;  ///< total data length from first frame
     unsigned int cursor;  ///< cursor into the current position in data.
-    std::vector<unsigned char> data;  ///< Received data
+    std::array<unsigned char, kMaxDataLength> data;  ///< Received data
   };
 
-  FastMessageMap() : dropped_frames(0), last_gc_run(wxDateTime::Now()) {}
+  FastMessageMap()
+      : dropped_frames(0), last_gc_run(std::chrono::steady_clock::now()) {}
 
   Entry operator[](int i) const { return entries[i]; }  /// Getter
   Entry& operator[](int i) { return entries[i]; }       /// Setter
@@ -111,7 +135,10 @@ public:
   /** Allocate a new, fresh entry and return index to it. */
   int AddNewEntry(void);
 
-  /** Insert a new entry, first part of a multipart message. */
+  /**
+   * Insert a new entry, first part of a multipart message. The entry is
+   * removed if data is not a first frame.
+   */
   bool InsertEntry(const CanHeader header, const unsigned char* data,
                    int index);
 
@@ -121,16 +148,34 @@ public:
   /** Remove entry at pos. */
   void Remove(int pos);
 
+  /** Number of messages in progress. */
+  size_t GetCount() const { return m_index.size(); }
+
+  /** All slots, including free ones. */
   std::vector<Entry> entries;
 
 private:
+  static uint64_t Key(const CanHeader& header, unsigned char sid);
+
   bool IsEntryExpired(unsigned int i);
   int GarbageCollector(void);
   void CheckGc();
 
+  /** Key of message in progress -> index in entries. */
+  std::unordered_map<uint64_t, int> m_index;
+
+  /** Unused slots in entries. */
+  std::vector<int> m_free;
+
+  /** In use flags for entries. */
+  std::vector<bool> m_used;
+
+  /** Key of each entry in m_index, kNoKey if none. */
+  std::vector<uint64_t> m_keys;
+
   int dropped_frames;
-  wxDateTime last_gc_run;
-  wxDateTime dropped_frame_time;
+  std::chrono::steady_clock::time_point last_gc_run;
+  std::chrono::steady_clock::time_point dropped_frame_time;
 };
 
 #endif  // guard
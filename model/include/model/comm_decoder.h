@@ -58,17 +58,23 @@ public:
   ~CommDecoder() {};
 
   // NMEA0183 decoding, by sentence.
-  bool DecodeRMC(std::string s, NavData& temp_data);
-  bool DecodeHDM(std::string s, NavData& temp_data);
-  bool DecodeHDT(std::string s, NavData& temp_data);
-  bool DecodeHDG(std::string s, NavData& temp_data);
-  bool DecodeVTG(std::string s, NavData& temp_data);
-  bool DecodeGSV(std::string s, NavData& temp_data);
-  bool DecodeGGA(std::string s, NavData& temp_data);
-  bool DecodeGLL(std::string s, NavData& temp_data);
+  bool DecodeRMC(const std::string& s, NavData& temp_data);
+  bool DecodeHDM(const std::string& s, NavData& temp_data);
+  bool DecodeHDT(const std::string& s, NavData& temp_data);
+  bool DecodeHDG(const std::string& s, NavData& temp_data);
+  bool DecodeVTG(const std::string& s, NavData& temp_data);
+  bool DecodeGSV(const std::string& s, NavData& temp_data);
+  bool DecodeGGA(const std::string& s, NavData& temp_data);
+  bool DecodeGLL(const std::string& s, NavData& temp_data);
 
   bool ParsePosition(const LATLONG& Position, double& lat, double& lon);
 
+  /**
+   * Load NMEA 0183 sentence s with any NMEA 4 tag block removed into
+   * m_NMEA0183 and parse it.
+   */
+  bool ParseN0183(const std::string& s);
+
   NMEA0183 m_NMEA0183;  // Used to parse messages from NMEA threads
 
   // NMEA2000 decoding, by PGN
@@ -79,7 +85,7 @@ public:
   bool DecodePGN129540(std::vector<unsigned char> v, NavData& temp_data);
 
   // SignalK
-  bool DecodeSignalK(std::string s, NavData& temp_data);
+  bool DecodeSignalK(const std::string& s, NavData& temp_data);
   void handleUpdate(const rapidjson::Value& update, NavData& temp_data);
   void updateItem(const rapidjson::Value& item, wxString& sfixtime,
                   NavData& temp_data);
@@ -83,6 +83,7 @@ private:
 
   ConnectionParams m_params;
   DriverListener& m_listener;
+  NavMsgKeyCache m_key_cache;
   void handle_N0183_MSG(CommDriverN0183AndroidIntEvent& event);
 };
 
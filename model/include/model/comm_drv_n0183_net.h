@@ -117,6 +117,7 @@ private:
 
   const ConnectionParams m_params;
   DriverListener& m_listener;
+  NavMsgKeyCache m_key_cache;
   N0183Buffer n0183_buffer;
   wxIPV4address m_addr;
   wxSocketBase* m_sock;
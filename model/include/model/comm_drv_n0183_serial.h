@@ -71,6 +71,7 @@ private:
 
   ConnectionParams m_params;
   DriverListener& m_listener;
+  NavMsgKeyCache m_key_cache;
 
   StatsTimer m_stats_timer;
 
@@ -36,6 +36,7 @@
 #include "model/comm_drv_n2k.h"
 #include "model/comm_drv_stats.h"
 #include "model/conn_params.h"
+#include "model/ring_buffer.h"
 
 #include <wx/datetime.h>
 
@@ -83,26 +84,6 @@ class CommDriverN2KNetEvent;  // Internal
 class MrqContainer;
 class FastMessageMap;
 
-class circular_buffer {
-public:
-  circular_buffer(size_t size);
-  void reset();
-  size_t capacity() const;
-  size_t size() const;
-  bool empty() const;
-  bool full() const;
-  void put(unsigned char item);
-  unsigned char get();
-
-private:
-  std::mutex mutex_;
-  std::unique_ptr<unsigned char[]> buf_;
-  size_t head_ = 0;
-  size_t tail_ = 0;
-  const size_t max_size_;
-  bool full_ = 0;
-};
-
 class CommDriverN2KNet : public CommDriverN2K,
                          public wxEvtHandler,
                          public DriverStatsProvider {
@@ -138,6 +119,7 @@ public:
 private:
   ConnectionParams m_params;
   DriverListener& m_listener;
+  NavMsgKeyCache m_key_cache;
 
   void handle_N2K_MSG(CommDriverN2KNetEvent& event);
   wxString GetNetPort() const { return m_net_port; }
@@ -229,7 +211,7 @@ private:
   int m_ib;
   bool m_bInMsg, m_bGotESC, m_bGotSOT;
 
-  circular_buffer* m_circle;
+  SpscRingBuffer<unsigned char>* m_circle;
   unsigned char* rx_buffer;
   std::string m_sentence;
 
@@ -117,6 +117,7 @@ private:
   bool m_bsec_thread_active;
 
   DriverListener& m_listener;
+  NavMsgKeyCache m_key_cache;
 
   bool m_bmg47_resp;
   bool m_bmg01_resp;
@@ -28,6 +28,7 @@
 #include <chrono>
 #include <memory>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -244,6 +245,12 @@ public:
   /** Alias for key(). */
   std::string GetKey() const { return key(); }
 
+  /**
+   * Return key() interned in KeyRegistry, or KeyRegistry::kNoKey if the
+   * creator did not supply it, see NavMsgKeyCache.
+   */
+  ObsKeyId GetKeyId() const { return key_id; }
+
   const NavAddr::Bus bus;
 
   /**
@@ -256,7 +263,16 @@ public:
 
 protected:
   NavMsg(const NavAddr::Bus& _bus, std::shared_ptr<const NavAddr> src)
-      : bus(_bus), source(src), created_at(NavmsgClock::now()) {};
+      : bus(_bus),
+        source(src),
+        created_at(NavmsgClock::now()),
+        key_id(KeyRegistry::kNoKey) {};
+
+  NavMsg(ObsKeyId id, const NavAddr::Bus& _bus,
+         std::shared_ptr<const NavAddr> src)
+      : bus(_bus), source(src), created_at(NavmsgClock::now()), key_id(id) {};
+
+  const ObsKeyId key_id;
 };
 
 /**
@@ -274,6 +290,23 @@ public:
               std::shared_ptr<const NavAddr2000> src)
       : NavMsg(NavAddr::Bus::N2000, src), PGN(_pgn), payload(_payload) {}
 
+  Nmea2000Msg(const uint64_t _pgn, std::vector<unsigned char>&& _payload,
+              std::shared_ptr<const NavAddr2000> src)
+      : NavMsg(NavAddr::Bus::N2000, src),
+        PGN(_pgn),
+        payload(std::move(_payload)) {}
+
+  /**
+   * Create a received message, key_id is the interned key() as returned by
+   * NavMsgKeyCache::N2000(_pgn).
+   */
+  Nmea2000Msg(ObsKeyId key_id, const uint64_t _pgn,
+              std::vector<unsigned char> _payload,
+              std::shared_ptr<const NavAddr2000> src)
+      : NavMsg(key_id, NavAddr::Bus::N2000, src),
+        PGN(_pgn),
+        payload(std::move(_payload)) {}
+
   Nmea2000Msg(const uint64_t _pgn, const std::vector<unsigned char>& _payload,
               std::shared_ptr<const NavAddr2000> src, int _priority)
       : NavMsg(NavAddr::Bus::N2000, src),
@@ -307,6 +340,17 @@ public:
         type(id.substr(2)),
         payload(_payload) {}
 
+  /**
+   * Create a received message, key_id is the interned key() as returned by
+   * NavMsgKeyCache::N0183(id).
+   */
+  Nmea0183Msg(ObsKeyId key_id, const std::string& id,
+              const std::string& _payload, std::shared_ptr<const NavAddr> src)
+      : NavMsg(key_id, NavAddr::Bus::N0183, src),
+        talker(id.substr(0, 2)),
+        type(id.substr(2)),
+        payload(_payload) {}
+
   Nmea0183Msg()
       : NavMsg(NavAddr::Bus::Undef, std::make_shared<const NavAddr>()) {}
 
@@ -320,6 +364,13 @@ public:
         type(t),
         payload(other.payload) {}
 
+  /** Copy other as type t, key_id is the interned key() for t. */
+  Nmea0183Msg(ObsKeyId key_id, const Nmea0183Msg& other, const std::string& t)
+      : NavMsg(key_id, NavAddr::Bus::N0183, other.source),
+        talker(other.talker),
+        type(t),
+        payload(other.payload) {}
+
   virtual ~Nmea0183Msg() = default;
 
   std::string key() const override {
@@ -377,7 +428,7 @@ public:
 
   SignalkMsg(std::string _context_self, std::string _context,
              std::string _raw_message, std::string _iface)
-      : NavMsg(NavAddr::Bus::Signalk,
+      : NavMsg(KeyId(), NavAddr::Bus::Signalk,
                std::make_shared<const NavAddr>(NavAddr::Bus::Signalk, _iface)),
         context_self(_context_self),
         context(_context),
@@ -387,6 +438,12 @@ public:
 
   std::string key() const { return std::string("signalK"); };
 
+  /** Return key() interned in KeyRegistry, interned once. */
+  static ObsKeyId KeyId() {
+    static const ObsKeyId id = KeyRegistry::GetInstance().Intern("signalK");
+    return id;
+  }
+
   std::string to_string() const { return raw_message; }
 
   struct in_addr dest;
@@ -407,4 +464,29 @@ public:
   std::string key() const { return "navmsg-undef"; }
 };
 
+/**
+ * Interned keys for received messages, kept by drivers so that the key()
+ * string is built and interned once per message type rather than once
+ * per message. Not thread safe, an instance must only be used by one
+ * thread at a time.
+ */
+class NavMsgKeyCache {
+public:
+  /** Return interned key for an Nmea0183Msg with given id like "GPGGA". */
+  ObsKeyId N0183(const std::string& id);
+
+  /** Return interned key for an Nmea0183Msg copied as "ALL". */
+  ObsKeyId N0183All();
+
+  /** Return interned key for an Nmea2000Msg with given PGN. */
+  ObsKeyId N2000(uint64_t pgn);
+
+private:
+  /** Bound for the caches which are keyed by data from the wire. */
+  static constexpr size_t kMaxEntries = 512;
+
+  std::unordered_map<std::string, ObsKeyId> m_n0183_ids;
+  std::unordered_map<uint64_t, ObsKeyId> m_n2000_ids;
+};
+
 #endif  // DRIVER_NAVMSG_H
@@ -28,6 +28,9 @@
 #ifndef _NAVMSG_BUS_H__
 #define _NAVMSG_BUS_H__
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -69,6 +72,9 @@ private:
   NavMsgBus() = default;
 
   std::set<std::string> m_active_messages;
+
+  /** Bitmask of NavAddr::Bus values registered, indexed by interned key. */
+  std::array<std::atomic<uint8_t>, KeyRegistry::kMaxKeys> m_registered_buses{};
 };
 
 #endif  // NAVMSG_BUS_H
@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Sums of cosines sampled at regular intervals, as in harmonic tide
+ * prediction.
+ */
+
+#ifndef _HARMONIC_SERIES_H__
+#define _HARMONIC_SERIES_H__
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * Sum of harmonic constituents
+ *
+ *     f(k) = sum amplitude[a] * cos(phase[a] + speed[a] * k * step)
+ *
+ * evaluated for many consecutive samples k at once. Instead of a cos() for
+ * each constituent and sample, each constituent is rotated by its speed
+ * times step from one sample to the next. Constituents are kept as
+ * separate arrays so the inner loop over them vectorizes. The rotation is
+ * restarted from exact values at regular intervals, bounding the rounding
+ * error to some 1e-14 relative to the sum of the amplitudes.
+ */
+class HarmonicSeries {
+public:
+  void Clear();
+
+  /** Add constituent, phase is at sample 0, speed in radians per time. */
+  void Add(double amplitude, double speed, double phase);
+
+  size_t GetCount() const { return m_amplitude.size(); }
+
+  /**
+   * Write f(k) for k in [0, count) to out. If deriv > 0, write the
+   * derivative of that order with respect to time instead.
+   */
+  void Evaluate(double step, size_t count, double* out, int deriv = 0) const;
+
+private:
+  std::vector<double> m_amplitude;
+  std::vector<double> m_speed;
+  std::vector<double> m_phase;
+};
+
+#endif  // _HARMONIC_SERIES_H__
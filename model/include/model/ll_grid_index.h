@@ -0,0 +1,216 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Uniform lat/lon grid spatial index for point objects.
+ */
+
+#ifndef _LL_GRID_INDEX_H__
+#define _LL_GRID_INDEX_H__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Spatial index of point objects identified by an Id, typically an
+ * MMSI or a pointer. Objects are bucketed in cells of cell_deg x cell_deg
+ * degrees, a lookup only visits the cells overlapping the search area.
+ *
+ * Updating or removing an object is O(1).
+ * Longitudes wrap at the antimeridian. Not thread safe.
+ */
+template <typename Id>
+class LLGridIndex {
+public:
+  struct Item {
+    Id id;
+    double lat;
+    double lon;
+  };
+
+  explicit LLGridIndex(double cell_deg = 0.25)
+      : m_cell_deg(cell_deg),
+        m_cols(static_cast<int>(std::ceil(360.0 / cell_deg))) {}
+
+  /** Insert object or move it to a new position. */
+  void Update(Id id, double lat, double lon) {
+    const int64_t key = CellKey(lat, lon);
+    auto found = m_location_by_id.find(id);
+    if (found != m_location_by_id.end()) {
+      Location& where = found->second;
+      if (where.key == key) {
+        Item& item = m_cells[key][where.index];
+        item.lat = lat;
+        item.lon = lon;
+        return;
+      }
+      EraseFromCell(where);
+      Insert(id, lat, lon, key, where);
+    } else {
+      Insert(id, lat, lon, key, m_location_by_id[id]);
+    }
+  }
+
+  /** Remove object, no-op if not indexed. */
+  void Remove(Id id) {
+    auto found = m_location_by_id.find(id);
+    if (found == m_location_by_id.end()) return;
+    EraseFromCell(found->second);
+    m_location_by_id.erase(found);
+  }
+
+  void Clear() {
+    m_cells.clear();
+    m_location_by_id.clear();
+  }
+
+  size_t size() const { return m_location_by_id.size(); }
+
+  bool Contains(Id id) const {
+    return m_location_by_id.find(id) != m_location_by_id.end();
+  }
+
+  /**
+   * Append ids of all objects within the lat/lon box to out. The box may
+   * cross the antimeridian i. e., lon_min > lon_max.
+   */
+  void QueryBox(double lat_min, double lat_max, double lon_min,
+                double lon_max, std::vector<Id>& out) const {
+    const bool wraps = lon_min > lon_max;
+    auto inside = [&](const Item& item) {
+      if (item.lat < lat_min || item.lat > lat_max) return false;
+      if (wraps) return item.lon >= lon_min || item.lon <= lon_max;
+      return item.lon >= lon_min && item.lon <= lon_max;
+    };
+    const int row0 = Row(lat_min);
+    const int row1 = Row(lat_max);
+    int col0 = Col(lon_min);
+    const int col1 = Col(lon_max);
+    int ncols =
+        wraps ? (col1 - col0 + m_cols) % m_cols + 1 : col1 - col0 + 1;
+    if (lon_max - lon_min >= 360.0 || ncols > m_cols) {
+      col0 = 0;
+      ncols = m_cols;
+    }
+
+    // A large area is cheaper to handle by visiting all non-empty cells.
+    if (static_cast<size_t>(row1 - row0 + 1) * ncols > m_cells.size()) {
+      for (const auto& cell : m_cells) {
+        for (const auto& item : cell.second) {
+          if (inside(item)) out.push_back(item.id);
+        }
+      }
+      return;
+    }
+    for (int row = row0; row <= row1; row++) {
+      for (int i = 0; i < ncols; i++) {
+        auto cell = m_cells.find(Key(row, (col0 + i) % m_cols));
+        if (cell == m_cells.end()) continue;
+        for (const auto& item : cell->second) {
+          if (inside(item)) out.push_back(item.id);
+        }
+      }
+    }
+  }
+
+  /**
+   * Append ids of objects within the lat/lon box enclosing a circle with
+   * given radius to out. The result is a superset of the objects within
+   * the circle; callers needing an exact range check must do it.
+   */
+  void Query(double lat, double lon, double radius_nm,
+             std::vector<Id>& out) const {
+    const double dlat = radius_nm / 60.0;
+    const double lat_min = std::max(-90.0, lat - dlat);
+    const double lat_max = std::min(90.0, lat + dlat);
+    const double max_abs_lat =
+        std::max(std::fabs(lat_min), std::fabs(lat_max));
+    const double coslat = std::cos(max_abs_lat * kDegToRad);
+    if (coslat < 1e-3 || dlat / coslat >= 180.0) {
+      QueryBox(lat_min, lat_max, -180.0, 180.0, out);
+      return;
+    }
+    const double dlon = dlat / coslat;
+    QueryBox(lat_min, lat_max, Normalize(lon - dlon), Normalize(lon + dlon),
+             out);
+  }
+
+private:
+  struct Location {
+    int64_t key;   ///< Cell key
+    size_t index;  ///< Position in cell's item vector
+  };
+
+  static constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+
+  static double Normalize(double lon) {
+    while (lon < -180.0) lon += 360.0;
+    while (lon > 180.0) lon -= 360.0;
+    return lon;
+  }
+
+  int Row(double lat) const {
+    return static_cast<int>(std::floor((lat + 90.0) / m_cell_deg));
+  }
+
+  int Col(double lon) const {
+    int col =
+        static_cast<int>(std::floor((Normalize(lon) + 180.0) / m_cell_deg));
+    return col >= m_cols ? col - m_cols : col;
+  }
+
+  static int64_t Key(int row, int col) {
+    return (static_cast<int64_t>(row) << 32) | static_cast<uint32_t>(col);
+  }
+
+  int64_t CellKey(double lat, double lon) const {
+    return Key(Row(lat), Col(lon));
+  }
+
+  void Insert(Id id, double lat, double lon, int64_t key, Location& where) {
+    auto& items = m_cells[key];
+    where.key = key;
+    where.index = items.size();
+    items.push_back({id, lat, lon});
+  }
+
+  /** Remove item at where, moving the last item in cell into its slot. */
+  void EraseFromCell(const Location& where) {
+    auto cell = m_cells.find(where.key);
+    if (cell == m_cells.end()) return;
+    auto& items = cell->second;
+    if (where.index + 1 < items.size()) {
+      items[where.index] = items.back();
+      m_location_by_id[items[where.index].id].index = where.index;
+    }
+    items.pop_back();
+    if (items.empty()) m_cells.erase(cell);
+  }
+
+  const double m_cell_deg;
+  const int m_cols;
+  std::unordered_map<int64_t, std::vector<Item>> m_cells;
+  std::unordered_map<Id, Location> m_location_by_id;
+};
+
+#endif  // _LL_GRID_INDEX_H__
@@ -0,0 +1,404 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * R-tree spatial index for lat/lon boxes with a scale attribute.
+ */
+
+#ifndef _LL_RTREE_H__
+#define _LL_RTREE_H__
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <vector>
+
+/**
+ * R-tree of lat/lon boxes identified by an Id, typically a chart
+ * database index. Each box also carries a scale, nodes keep the scale
+ * range of their subtree so a query can be limited to a scale band.
+ *
+ * Build() creates a Sort-Tile-Recursive packed tree, Insert() and
+ * Remove() update it incrementally. Removing items never merges nodes,
+ * a tree with many removals is rebalanced by the next Build().
+ *
+ * Longitudes are not normalized: a box matches if it overlaps the query
+ * box shifted -360, 0 or +360 degrees, so boxes in 0..360 and -180..180
+ * conventions can be mixed. Not thread safe.
+ */
+template <typename Id>
+class LLRTree {
+public:
+  struct Item {
+    Id id;
+    float lat_min;
+    float lat_max;
+    float lon_min;
+    float lon_max;
+    int scale;
+  };
+
+  explicit LLRTree(size_t max_entries = 16)
+      : m_max_entries(std::max(max_entries, size_t(4))), m_root(-1),
+        m_size(0) {}
+
+  /** Replace all contents with items, bulk loading the tree. */
+  void Build(std::vector<Item> items) {
+    Clear();
+    if (items.empty()) return;
+    m_size = items.size();
+
+    // Leaf level: tile items in vertical slices sorted on longitude, each
+    // slice sorted on latitude and cut into full leaves.
+    std::vector<int> level;
+    Tile(items, [&](typename std::vector<Item>::iterator first,
+                    typename std::vector<Item>::iterator last) {
+      Node leaf;
+      leaf.leaf = true;
+      leaf.items.assign(first, last);
+      level.push_back(NewNode(std::move(leaf)));
+    });
+
+    // Pack each level the same way until one root remains.
+    while (level.size() > 1) {
+      std::vector<int> upper;
+      Tile(level, [&](std::vector<int>::iterator first,
+                      std::vector<int>::iterator last) {
+        Node node;
+        node.leaf = false;
+        node.children.assign(first, last);
+        upper.push_back(NewNode(std::move(node)));
+      });
+      level.swap(upper);
+    }
+    m_root = level[0];
+  }
+
+  /** Add an item, splitting full nodes as required. */
+  void Insert(const Item& item) {
+    m_size++;
+    if (m_root < 0) {
+      Node leaf;
+      leaf.leaf = true;
+      leaf.items.push_back(item);
+      m_root = NewNode(std::move(leaf));
+      return;
+    }
+    int split = InsertAt(m_root, item);
+    if (split >= 0) {
+      Node root;
+      root.leaf = false;
+      root.children = {m_root, split};
+      m_root = NewNode(std::move(root));
+    }
+  }
+
+  /** Remove item with given id, return false if not found. */
+  bool Remove(Id id) {
+    if (m_root < 0 || !RemoveAt(m_root, id)) return false;
+    m_size--;
+    return true;
+  }
+
+  /** Replace each item's id with map(id), boxes are unchanged. */
+  template <typename F>
+  void RenumberIds(F map) {
+    for (auto& node : m_nodes) {
+      for (auto& item : node.items) item.id = map(item.id);
+    }
+  }
+
+  void Clear() {
+    m_nodes.clear();
+    m_root = -1;
+    m_size = 0;
+  }
+
+  size_t size() const { return m_size; }
+
+  /**
+   * Append ids of all items overlapping the lat/lon box with a scale in
+   * the [scale_min, scale_max] band to out. Order is unspecified.
+   */
+  void Query(double lat_min, double lat_max, double lon_min, double lon_max,
+             std::vector<Id>& out, int scale_min = 0,
+             int scale_max = INT_MAX) const {
+    if (m_root < 0) return;
+    const Box query{static_cast<float>(lat_min), static_cast<float>(lat_max),
+                    static_cast<float>(lon_min), static_cast<float>(lon_max),
+                    scale_min, scale_max};
+    std::vector<int> stack{m_root};
+    while (!stack.empty()) {
+      const Node& node = m_nodes[stack.back()];
+      stack.pop_back();
+      if (!Overlaps(node.box, query)) continue;
+      if (node.leaf) {
+        for (const auto& item : node.items) {
+          if (Overlaps(ItemBox(item), query)) out.push_back(item.id);
+        }
+      } else {
+        stack.insert(stack.end(), node.children.begin(), node.children.end());
+      }
+    }
+  }
+
+  /** Append ids of items containing the point, see Query(). */
+  void QueryPoint(double lat, double lon, std::vector<Id>& out,
+                  int scale_min = 0, int scale_max = INT_MAX) const {
+    Query(lat, lat, lon, lon, out, scale_min, scale_max);
+  }
+
+  /**
+   * Replace out with the sorted ids of items overlapping a view box which
+   * may extend past +/-180, as s52plib::ObjectRenderCheckPos() accepts.
+   * The parts past the antimeridian are also queried shifted back by 360
+   * degrees, ids found more than once are kept once.
+   */
+  void QueryView(double lat_min, double lat_max, double lon_min,
+                 double lon_max, std::vector<Id>& out) const {
+    out.clear();
+    Query(lat_min, lat_max, lon_min, lon_max, out);
+    if (lon_max > 180) {
+      Query(lat_min, lat_max, lon_min - 360, lon_max - 360, out);
+    }
+    if (lon_min < -180) {
+      Query(lat_min, lat_max, lon_min + 360, lon_max + 360, out);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+  }
+
+private:
+  /** Bounding box and scale range, empty if lat_min > lat_max. */
+  struct Box {
+    float lat_min;
+    float lat_max;
+    float lon_min;
+    float lon_max;
+    int scale_min;
+    int scale_max;
+  };
+
+  struct Node {
+    Box box = EmptyBox();
+    bool leaf = true;
+    std::vector<Item> items;    ///< Leaf nodes only
+    std::vector<int> children;  ///< Inner nodes only, indexes in m_nodes
+  };
+
+  static Box EmptyBox() { return {1.f, -1.f, 0.f, 0.f, INT_MAX, 0}; }
+
+  static Box ItemBox(const Item& item) {
+    return {item.lat_min, item.lat_max, item.lon_min,
+            item.lon_max, item.scale,   item.scale};
+  }
+
+  static void Extend(Box& box, const Box& other) {
+    if (other.lat_min > other.lat_max) return;
+    if (box.lat_min > box.lat_max) {
+      box = other;
+      return;
+    }
+    box.lat_min = std::min(box.lat_min, other.lat_min);
+    box.lat_max = std::max(box.lat_max, other.lat_max);
+    box.lon_min = std::min(box.lon_min, other.lon_min);
+    box.lon_max = std::max(box.lon_max, other.lon_max);
+    box.scale_min = std::min(box.scale_min, other.scale_min);
+    box.scale_max = std::max(box.scale_max, other.scale_max);
+  }
+
+  static bool Overlaps(const Box& box, const Box& query) {
+    if (box.lat_min > box.lat_max) return false;
+    if (box.lat_max < query.lat_min || box.lat_min > query.lat_max) {
+      return false;
+    }
+    if (box.scale_max < query.scale_min || box.scale_min > query.scale_max) {
+      return false;
+    }
+    for (float shift : {0.f, 360.f, -360.f}) {
+      if (box.lon_max >= query.lon_min + shift &&
+          box.lon_min <= query.lon_max + shift) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static double Area(const Box& box) {
+    if (box.lat_min > box.lat_max) return 0.0;
+    return double(box.lat_max - box.lat_min) * (box.lon_max - box.lon_min);
+  }
+
+  static float LatCenter(const Box& box) {
+    return (box.lat_min + box.lat_max) / 2;
+  }
+
+  static float LonCenter(const Box& box) {
+    return (box.lon_min + box.lon_max) / 2;
+  }
+
+  Box EntryBox(const Item& item) const { return ItemBox(item); }
+  Box EntryBox(int node) const { return m_nodes[node].box; }
+
+  int NewNode(Node node) {
+    UpdateBox(node);
+    m_nodes.push_back(std::move(node));
+    return static_cast<int>(m_nodes.size()) - 1;
+  }
+
+  void UpdateBox(Node& node) const {
+    node.box = EmptyBox();
+    for (const auto& item : node.items) Extend(node.box, ItemBox(item));
+    for (int child : node.children) Extend(node.box, m_nodes[child].box);
+  }
+
+  /**
+   * Sort-Tile-Recursive packing: cut entries into vertical slices on
+   * longitude, sort each slice on latitude and hand runs of at most
+   * m_max_entries to make_node.
+   */
+  template <typename T, typename F>
+  void Tile(std::vector<T>& entries, F make_node) {
+    const size_t n_nodes = (entries.size() + m_max_entries - 1) / m_max_entries;
+    const size_t n_slices =
+        static_cast<size_t>(std::ceil(std::sqrt(double(n_nodes))));
+    const size_t slice_size = n_slices * m_max_entries;
+    auto lon_less = [&](const T& a, const T& b) {
+      return LonCenter(EntryBox(a)) < LonCenter(EntryBox(b));
+    };
+    auto lat_less = [&](const T& a, const T& b) {
+      return LatCenter(EntryBox(a)) < LatCenter(EntryBox(b));
+    };
+    std::sort(entries.begin(), entries.end(), lon_less);
+    for (size_t s = 0; s < entries.size(); s += slice_size) {
+      auto slice_end =
+          entries.begin() + std::min(entries.size(), s + slice_size);
+      std::sort(entries.begin() + s, slice_end, lat_less);
+      for (auto it = entries.begin() + s; it < slice_end;) {
+        auto last = it + std::min<size_t>(m_max_entries, slice_end - it);
+        make_node(it, last);
+        it = last;
+      }
+    }
+  }
+
+  /** Split full entries into two halves along the widest axis. */
+  template <typename T>
+  std::vector<T> SplitEntries(std::vector<T>& entries) const {
+    Box centers = EmptyBox();
+    for (const auto& entry : entries) {
+      const Box box = EntryBox(entry);
+      const float lat = LatCenter(box);
+      const float lon = LonCenter(box);
+      Extend(centers, {lat, lat, lon, lon, 0, 0});
+    }
+    const bool by_lon = centers.lon_max - centers.lon_min >
+                        centers.lat_max - centers.lat_min;
+    std::sort(entries.begin(), entries.end(), [&](const T& a, const T& b) {
+      return by_lon ? LonCenter(EntryBox(a)) < LonCenter(EntryBox(b))
+                    : LatCenter(EntryBox(a)) < LatCenter(EntryBox(b));
+    });
+    const auto middle = entries.begin() + entries.size() / 2;
+    std::vector<T> upper(middle, entries.end());
+    entries.erase(middle, entries.end());
+    return upper;
+  }
+
+  /**
+   * Insert item in subtree at index, return index of a new sibling if
+   * the node was split, else -1.
+   */
+  int InsertAt(int index, const Item& item) {
+    if (m_nodes[index].leaf) {
+      m_nodes[index].items.push_back(item);
+      if (m_nodes[index].items.size() <= m_max_entries) {
+        Extend(m_nodes[index].box, ItemBox(item));
+        return -1;
+      }
+      Node sibling;
+      sibling.leaf = true;
+      sibling.items = SplitEntries(m_nodes[index].items);
+      UpdateBox(m_nodes[index]);
+      return NewNode(std::move(sibling));
+    }
+
+    // Descend into the child needing least enlargement, smallest on ties.
+    const Box box = ItemBox(item);
+    int best = -1;
+    double best_growth = 0;
+    double best_area = 0;
+    for (int child : m_nodes[index].children) {
+      Box grown = m_nodes[child].box;
+      Extend(grown, box);
+      const double area = Area(m_nodes[child].box);
+      const double growth = Area(grown) - area;
+      if (best < 0 || growth < best_growth ||
+          (growth == best_growth && area < best_area)) {
+        best = child;
+        best_growth = growth;
+        best_area = area;
+      }
+    }
+    const int split = InsertAt(best, item);
+    // m_nodes may have been reallocated, no references kept above.
+    if (split >= 0) m_nodes[index].children.push_back(split);
+    if (m_nodes[index].children.size() <= m_max_entries) {
+      if (split >= 0) {
+        UpdateBox(m_nodes[index]);
+      } else {
+        Extend(m_nodes[index].box, box);
+      }
+      return -1;
+    }
+    Node sibling;
+    sibling.leaf = false;
+    sibling.children = SplitEntries(m_nodes[index].children);
+    UpdateBox(m_nodes[index]);
+    return NewNode(std::move(sibling));
+  }
+
+  /** Remove item from subtree at index, shrinking boxes on the way up. */
+  bool RemoveAt(int index, Id id) {
+    Node& node = m_nodes[index];
+    if (node.leaf) {
+      auto found =
+          std::find_if(node.items.begin(), node.items.end(),
+                       [&](const Item& item) { return item.id == id; });
+      if (found == node.items.end()) return false;
+      node.items.erase(found);
+      UpdateBox(node);
+      return true;
+    }
+    for (int child : node.children) {
+      if (RemoveAt(child, id)) {
+        UpdateBox(node);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const size_t m_max_entries;
+  std::vector<Node> m_nodes;
+  int m_root;
+  size_t m_size;
+};
+
+#endif  // _LL_RTREE_H__
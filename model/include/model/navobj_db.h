@@ -25,12 +25,18 @@
 #ifndef _NAVOBJ_DB_H__
 #define _NAVOBJ_DB_H__
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
 #include <wx/timer.h>
 #include "notification.h"
 #include "observable_evtvar.h"
 #include "comm_appmsg.h"
 #include <sqlite3.h>
 #include "track.h"
+#include "track_point_writer.h"
 
 /** The navobj SQLite container object, a singleton. */
 class NavObj_dB {
@@ -40,13 +46,20 @@ public:
   NavObj_dB(const NavObj_dB &) = delete;
   NavObj_dB &operator=(const NavObj_dB &) = delete;
 
+  /** Write queued track points and close the database. */
   void Close();
   void LoadNavObjects();
 
   // Tracks
   bool LoadAllTracks();
   bool InsertTrack(Track *track);
+  /**
+   * Queue point for writing by a background thread, which commits points
+   * in batches. Returns false if the track is not in the database.
+   */
   bool AddTrackPoint(Track *track, TrackPoint *point);
+  /** Return when all points queued by AddTrackPoint() are written. */
+  void FlushTrackPoints();
   bool UpdateDBTrackAttributes(Track *track);
   bool DeleteTrack(Track *track);
 
@@ -79,6 +92,14 @@ private:
   bool ImportLegacyPoints();
   void CountImportNavObjects();
 
+  /**
+   * Return statement prepared from sql, reset and kept until Close(). sql
+   * must be a string literal, it is used as a key.
+   */
+  sqlite3_stmt *GetStatement(const char *sql);
+  void FinalizeStatements();
+  void ReportWriterErrors();
+
   int m_open_result;
   sqlite3 *m_db;
   bool m_importing;
@@ -88,6 +109,11 @@ private:
   int m_nImportObjects;
   int m_import_progesscount;
   wxProgressDialog *m_pImportProgress;
+
+  std::unordered_map<const char *, sqlite3_stmt *> m_statements;
+  std::unique_ptr<TrackPointWriter> m_point_writer;
+  /** Guids of tracks known to be in the database. */
+  std::unordered_set<std::string> m_known_tracks;
 };
 
 #endif
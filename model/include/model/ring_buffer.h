@@ -0,0 +1,328 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Bounded, lock-free ring buffers used to hand data between driver
+ * threads and the main thread.
+ *
+ * Two variants are provided:
+ *   - SpscRingBuffer: exactly one producer and one consumer thread.
+ *   - MpscRingBuffer: any number of producer threads, one consumer.
+ *
+ * Both are bounded: a push to a full buffer fails and is counted as an
+ * overflow instead of blocking or growing, except for
+ * SpscRingBuffer::push_n_overwrite() which drops the oldest items. The
+ * capacity is rounded up to the next power of two.
+ */
+
+#ifndef _RING_BUFFER_H__
+#define _RING_BUFFER_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ring_buffer_detail {
+
+/** Assumed cache line size, used to keep producer and consumer apart. */
+static constexpr size_t kCacheLine = 64;
+
+static inline size_t RoundUpPow2(size_t n) {
+  size_t v = 2;
+  while (v < n) v <<= 1;
+  return v;
+}
+
+}  // namespace ring_buffer_detail
+
+/**
+ * Single producer, single consumer bounded queue. The producer only
+ * writes m_tail, the consumer only writes m_head, so neither side ever
+ * waits for the other.
+ */
+template <typename T>
+class SpscRingBuffer {
+public:
+  explicit SpscRingBuffer(size_t capacity)
+      : m_slots(ring_buffer_detail::RoundUpPow2(capacity)),
+        m_mask(m_slots.size() - 1),
+        m_head(0),
+        m_tail(0),
+        m_overflows(0) {}
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  /**
+   * Insert a copy of value, producer thread only.
+   * @return false if the buffer is full, in which case the overflow
+   *         counter is incremented and value is dropped.
+   */
+  bool try_push(const T& value) {
+    T copy(value);
+    return try_push(std::move(copy));
+  }
+
+  /** Like try_push(const T&), but moves value into the buffer. */
+  bool try_push(T&& value) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) > m_mask) {
+      m_overflows.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    m_slots[tail & m_mask] = std::move(value);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Insert up to count items from values, producer thread only.
+   * @return Number of inserted items. Items which do not fit are
+   *         dropped and counted as overflows.
+   */
+  size_t try_push_n(const T* values, size_t count) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t used = tail - m_head.load(std::memory_order_acquire);
+    const size_t room = m_mask + 1 - used;
+    const size_t n = count < room ? count : room;
+    for (size_t i = 0; i < n; i++) m_slots[(tail + i) & m_mask] = values[i];
+    m_tail.store(tail + n, std::memory_order_release);
+    if (n < count) {
+      m_overflows.fetch_add(count - n, std::memory_order_relaxed);
+    }
+    return n;
+  }
+
+  /**
+   * Insert count items from values, dropping the oldest items to make
+   * room, like a classic overwriting circular buffer. Only usable when the
+   * producer and the consumer are the same thread. Dropped items are
+   * counted as overflows.
+   * @return Number of dropped items, buffered or from values.
+   */
+  size_t push_n_overwrite(const T* values, size_t count) {
+    const size_t cap = m_mask + 1;
+    size_t dropped = 0;
+    if (count > cap) {
+      dropped = count - cap;
+      values += dropped;
+      count = cap;
+    }
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t room = cap - (tail - head);
+    if (count > room) {
+      dropped += count - room;
+      m_head.store(head + count - room, std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < count; i++) {
+      m_slots[(tail + i) & m_mask] = values[i];
+    }
+    m_tail.store(tail + count, std::memory_order_release);
+    if (dropped > 0) m_overflows.fetch_add(dropped, std::memory_order_relaxed);
+    return dropped;
+  }
+
+  /**
+   * Remove oldest item, consumer thread only.
+   * @return false if the buffer is empty, else true and value is set.
+   */
+  bool try_pop(T& value) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_tail.load(std::memory_order_acquire)) return false;
+    value = std::move(m_slots[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Remove up to max_count items, appending them to out. Consumer
+   * thread only. Synchronizes with the producer once per batch rather
+   * than once per item.
+   * @return Number of items appended to out.
+   */
+  size_t try_pop_n(std::vector<T>& out, size_t max_count) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t avail = m_tail.load(std::memory_order_acquire) - head;
+    const size_t n = avail < max_count ? avail : max_count;
+    for (size_t i = 0; i < n; i++) {
+      out.push_back(std::move(m_slots[(head + i) & m_mask]));
+    }
+    m_head.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  /** Return true if empty. Exact only when called from the consumer. */
+  bool empty() const {
+    return m_head.load(std::memory_order_acquire) ==
+           m_tail.load(std::memory_order_acquire);
+  }
+
+  /** Return approximate number of items in buffer. */
+  size_t size() const {
+    return m_tail.load(std::memory_order_acquire) -
+           m_head.load(std::memory_order_acquire);
+  }
+
+  size_t capacity() const { return m_mask + 1; }
+
+  /** Return number of items dropped since creation because of full buffer. */
+  uint64_t overflows() const {
+    return m_overflows.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::vector<T> m_slots;
+  const size_t m_mask;
+  alignas(ring_buffer_detail::kCacheLine) std::atomic<size_t> m_head;
+  alignas(ring_buffer_detail::kCacheLine) std::atomic<size_t> m_tail;
+  alignas(ring_buffer_detail::kCacheLine) std::atomic<uint64_t> m_overflows;
+};
+
+/**
+ * Multiple producers, single consumer bounded queue. Each slot carries a
+ * sequence number telling whether it is free for the producer holding a
+ * given ticket or filled for the consumer (D. Vyukov's bounded queue).
+ * Producers only contend on one atomic increment per push.
+ */
+template <typename T>
+class MpscRingBuffer {
+public:
+  explicit MpscRingBuffer(size_t capacity)
+      : m_cells(ring_buffer_detail::RoundUpPow2(capacity)),
+        m_mask(m_cells.size() - 1),
+        m_head(0),
+        m_tail(0),
+        m_overflows(0) {
+    for (size_t i = 0; i < m_cells.size(); i++) {
+      m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscRingBuffer(const MpscRingBuffer&) = delete;
+  MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+  /**
+   * Insert a copy of value, safe from any thread.
+   * @return false if the buffer is full, in which case the overflow
+   *         counter is incremented and value is dropped.
+   */
+  bool try_push(const T& value) {
+    T copy(value);
+    return try_push(std::move(copy));
+  }
+
+  /** Like try_push(const T&), but moves value into the buffer. */
+  bool try_push(T&& value) {
+    size_t pos = m_tail.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &m_cells[pos & m_mask];
+      const size_t seq = cell->seq.load(std::memory_order_acquire);
+      const intptr_t diff = static_cast<intptr_t>(seq - pos);
+      if (diff == 0) {
+        if (m_tail.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        m_overflows.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Remove oldest item, consumer thread only.
+   * @return false if the buffer is empty, else true and value is set.
+   */
+  bool try_pop(T& value) {
+    const size_t pos = m_head.load(std::memory_order_relaxed);
+    Cell& cell = m_cells[pos & m_mask];
+    if (cell.seq.load(std::memory_order_acquire) != pos + 1) return false;
+    value = std::move(cell.value);
+    cell.seq.store(pos + m_mask + 1, std::memory_order_release);
+    m_head.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * Remove up to max_count items, appending them to out. Consumer
+   * thread only. Stops at the first slot not yet completely written
+   * by its producer.
+   * @return Number of items appended to out.
+   */
+  size_t try_pop_n(std::vector<T>& out, size_t max_count) {
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    size_t n = 0;
+    while (n < max_count) {
+      Cell& cell = m_cells[pos & m_mask];
+      if (cell.seq.load(std::memory_order_acquire) != pos + 1) break;
+      out.push_back(std::move(cell.value));
+      cell.seq.store(pos + m_mask + 1, std::memory_order_release);
+      pos++;
+      n++;
+    }
+    m_head.store(pos, std::memory_order_relaxed);
+    return n;
+  }
+
+  /** Return true if empty. Exact only when called from the consumer. */
+  bool empty() const {
+    const size_t pos = m_head.load(std::memory_order_relaxed);
+    return m_cells[pos & m_mask].seq.load(std::memory_order_acquire) !=
+           pos + 1;
+  }
+
+  /** Return approximate number of items in buffer. */
+  size_t size() const {
+    const size_t tail = m_tail.load(std::memory_order_acquire);
+    const size_t head = m_head.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  size_t capacity() const { return m_mask + 1; }
+
+  /** Return number of items dropped since creation because of full buffer. */
+  uint64_t overflows() const {
+    return m_overflows.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Cell {
+    std::atomic<size_t> seq;
+    T value;
+  };
+
+  std::vector<Cell> m_cells;
+  const size_t m_mask;
+  alignas(ring_buffer_detail::kCacheLine) std::atomic<size_t> m_head;
+  alignas(ring_buffer_detail::kCacheLine) std::atomic<size_t> m_tail;
+  alignas(ring_buffer_detail::kCacheLine) std::atomic<uint64_t> m_overflows;
+};
+
+#endif  // _RING_BUFFER_H__
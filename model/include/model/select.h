@@ -24,8 +24,14 @@
 #ifndef _SELECT_H__
 #define _SELECT_H__
 
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "select_item.h"
 
+#include "model/ll_grid_index.h"
 #include "model/track.h"
 #include "model/route.h"
 
@@ -109,9 +115,42 @@ private:
   // FIXME (leamas?) this is not model stuff.
   void CalcSelectRadius(SelectCtx &ctx);
 
+  bool IsHit(SelectCtx &ctx, SelectItem *pFindSel, int fseltype, float slat,
+             float slon);
+  bool IsListHit(SelectCtx &ctx, SelectItem *pFindSel, int fseltype,
+                 float slat, float slon);
+
+  /** Add item to m_grid or m_large, or move it there after a change. */
+  void IndexItem(SelectItem *item, bool at_front);
+  void UnindexItem(SelectItem *item);
+
+  /**
+   * Return indexed items of fseltype which may be within selectRadius of
+   * slat, slon, in no particular order.
+   */
+  std::vector<SelectItem *> FindCandidates(float slat, float slon,
+                                           int fseltype) const;
+
   SelectableItemList *pSelectList;
   int pixelRadius;
   float selectRadius;
+
+  /**
+   * Spatial index of segments, tide/current points and AIS targets. Route
+   * points are left out since other code moves them by updating the
+   * SelectItem directly. Short segments are kept at their center, the
+   * other ones are checked linearly in m_large.
+   */
+  LLGridIndex<SelectItem *> m_grid;
+  std::unordered_set<SelectItem *> m_large;
+
+  /**
+   * Position of indexed items in pSelectList order, Insert() counts down
+   * and Append() counts up.
+   */
+  std::unordered_map<const SelectItem *, int64_t> m_list_order;
+  int64_t m_front_order;
+  int64_t m_back_order;
 };
 
 #endif  // _SELECT_H__
@@ -0,0 +1,153 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Work stealing thread pool shared by background jobs.
+ */
+
+#ifndef _THREAD_POOL_H__
+#define _THREAD_POOL_H__
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads running queued tasks, replacing a thread
+ * created for each job.
+ *
+ * Tasks are queued in one of three priority lanes, a worker always picks
+ * a task from the most urgent lane having any. Tasks submitted by a
+ * worker thread are queued on that worker's own deque and run LIFO by
+ * it, idle workers steal the oldest tasks from other workers. Tasks
+ * submitted from other threads go to a shared queue run FIFO.
+ *
+ * There is no ordering guarantee beyond this, in particular tasks in
+ * the same lane may run in parallel.
+ */
+class ThreadPool {
+public:
+  /** Priority lane, most urgent first. */
+  enum class Lane {
+    kVisible,    ///< Needed to render what is on screen now
+    kPrefetch,   ///< Likely needed soon e. g., improving what is shown
+    kBackground  ///< Batch work like building caches for all charts
+  };
+
+  /** Handle for a submitted task. */
+  class Job {
+  public:
+    /**
+     * Cancel job. A job which has not started is dropped and its task
+     * is never run. A running task continues, it may poll IsCancelled().
+     * @return true if the job was dropped, the task will never run.
+     */
+    bool Cancel();
+
+    /** Return true if Cancel() has been invoked. */
+    bool IsCancelled() const { return m_cancelled; }
+
+    /** Return true if the task has completed or was dropped. */
+    bool IsDone() const { return m_state == State::kDone; }
+
+  private:
+    friend class ThreadPool;
+    enum class State { kPending, kRunning, kDone };
+
+    explicit Job(std::function<void()> task) : m_task(std::move(task)) {}
+
+    std::function<void()> m_task;
+    std::atomic<State> m_state{State::kPending};
+    std::atomic<bool> m_cancelled{false};
+  };
+
+  /** Pool shared by the application, one thread per CPU. */
+  static ThreadPool& GetInstance();
+
+  /** Start given number of worker threads, at least one. */
+  explicit ThreadPool(unsigned thread_count);
+
+  /**
+   * Stop and join all workers. Running tasks complete, tasks which have
+   * not started are dropped.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * Queue task to be run in given lane, thread safe. The task must not
+   * throw.
+   */
+  std::shared_ptr<Job> Submit(std::function<void()> task,
+                              Lane lane = Lane::kBackground);
+
+  /**
+   * Run fn(i) for each i in [0, count), on the calling thread and on
+   * workers picking up helper tasks queued in given lane. Returns when all
+   * calls are done. Helpers which have not started when the caller runs
+   * out of work are cancelled rather than waited for, so this is safe to
+   * use from a worker thread. fn must not throw.
+   */
+  void ParallelFor(size_t count, const std::function<void(size_t)>& fn,
+                   Lane lane = Lane::kVisible);
+
+  unsigned GetThreadCount() const { return m_workers.size(); }
+
+  /** Number of tasks queued but not yet started. */
+  size_t GetQueuedCount() const { return m_queued; }
+
+private:
+  static const size_t kLaneCount = 3;
+  using Lanes = std::array<std::deque<std::shared_ptr<Job>>, kLaneCount>;
+
+  /** Queues of a worker, only locked briefly to push or pop a job. */
+  struct Worker {
+    std::mutex mutex;
+    Lanes lanes;
+    std::thread thread;
+  };
+
+  void Run(size_t index);
+  std::shared_ptr<Job> FindJob(size_t index);
+  std::shared_ptr<Job> PopShared(size_t lane);
+  std::shared_ptr<Job> Steal(size_t index, size_t lane);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+
+  /** Shared queue for tasks submitted by non worker threads. */
+  std::mutex m_shared_mutex;
+  Lanes m_shared;
+
+  /** Guards m_queued and m_stop updates for the idle workers wait. */
+  std::mutex m_mutex;
+  std::condition_variable m_cond_var;
+  std::atomic<size_t> m_queued;
+  std::atomic<bool> m_stop;
+};
+
+#endif  // _THREAD_POOL_H__
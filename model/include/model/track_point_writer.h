@@ -0,0 +1,139 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Write-behind queue storing track points in the navobj database.
+ */
+
+#ifndef _TRACK_POINT_WRITER_H__
+#define _TRACK_POINT_WRITER_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sqlite3.h>
+
+class TrackPoint;  // forward
+
+/**
+ * Stores track points in the trk_points table from a background thread.
+ *
+ * Points are written on a separate database connection using one
+ * prepared statement, and committed as one transaction per batch. A
+ * batch is written when it holds batch_size points, or max_delay after
+ * its first point was added.
+ *
+ * A batch is kept and retried if its transaction cannot be started, for
+ * example while another connection holds the database lock for too long.
+ *
+ * Points not yet committed are lost if the process crashes. Flush()
+ * and the destructor write all queued points.
+ */
+class TrackPointWriter {
+public:
+  struct Point {
+    std::string track_guid;
+    double lat;
+    double lon;
+    std::string timestamp;
+    int point_order;
+  };
+
+  /** SQL statement to insert a track point, see Insert(). */
+  static const char* GetInsertSql();
+
+  /** Bind point to statement prepared from GetInsertSql() and run it. */
+  static bool Insert(sqlite3_stmt* stmt, const Point& point);
+
+  /**
+   * Insert all points of a track being imported, numbered from 0, using
+   * stmt prepared from GetInsertSql(). The caller runs the transaction.
+   * Returns the number of points which could not be inserted.
+   */
+  static int InsertTrackPoints(sqlite3_stmt* stmt,
+                               const std::string& track_guid,
+                               const std::vector<TrackPoint*>& points);
+
+  /**
+   * Open the database at path and start the writer thread. The database
+   * must have the trk_points table.
+   */
+  explicit TrackPointWriter(
+      const std::string& path,
+      std::chrono::milliseconds max_delay = std::chrono::milliseconds(2000),
+      size_t batch_size = 1000);
+
+  /** Write all queued points and stop the writer thread. */
+  ~TrackPointWriter();
+
+  TrackPointWriter(const TrackPointWriter&) = delete;
+  TrackPointWriter& operator=(const TrackPointWriter&) = delete;
+
+  /** Return false if the database could not be opened. */
+  bool IsOk() const { return m_db != nullptr; }
+
+  /** Queue point for writing, thread safe. */
+  void Add(Point point);
+
+  /** Return when all points added so far are committed or failed. */
+  void Flush();
+
+  /** Number of points committed so far. */
+  uint64_t GetWrittenCount() const { return m_written; }
+
+  /**
+   * Return and clear messages for errors in the writer thread, to be
+   * reported by the caller's thread.
+   */
+  std::vector<std::string> TakeErrors();
+
+private:
+  void Run();
+  /**
+   * Write points in one transaction. Return false, writing nothing, if the
+   * transaction cannot be started.
+   */
+  bool Write(const std::vector<Point>& points);
+
+  sqlite3* m_db;
+  sqlite3_stmt* m_insert;
+  const std::chrono::milliseconds m_max_delay;
+  const size_t m_batch_size;
+
+  std::mutex m_mutex;
+  std::condition_variable m_queued_cond;  ///< Points added or stop request
+  std::condition_variable m_done_cond;    ///< A batch has been written
+  std::vector<Point> m_queue;
+  bool m_writing;
+  int m_flush_requests;
+  bool m_stop;
+  std::vector<std::string> m_errors;
+  std::atomic<uint64_t> m_written;
+
+  std::thread m_thread;
+};
+
+#endif  // _TRACK_POINT_WRITER_H__
@@ -26,11 +26,59 @@
 
 #include "model/ais_bitstring.h"
 
+namespace {
+
+/** 6-bit value for all characters as computed by AisBitstring::to_6bit. */
+struct SixBitTable {
+  unsigned char value[256];
+  constexpr SixBitTable() : value() {
+    for (int c = 0; c < 256; c++) {
+      // Invalid characters have always decoded as all ones.
+      value[c] = 0x3f;
+      if (c >= 0x30 && c <= 0x77 && !(c > 0x57 && c < 0x60)) {
+        int cp = c + 0x28;
+        cp += cp > 0x80 ? 0x20 : 0x28;
+        value[c] = cp & 0x3f;
+      }
+    }
+  }
+};
+
+constexpr SixBitTable kSixBit;
+
+}  // namespace
+
 AisBitstring::AisBitstring(const char *str) {
   byte_length = strlen(str);
-
-  for (int i = 0; i < byte_length; i++) {
-    bitbytes[i] = to_6bit(str[i]);
+  if (byte_length > AIS_MAX_MESSAGE_LEN) byte_length = AIS_MAX_MESSAGE_LEN;
+  // Clear words used plus the one read by GetBits() across the end.
+  const int used_words = (byte_length * 6 + 63) / 64;
+  memset(bitwords, 0, (used_words + 1) * sizeof(bitwords[0]));
+
+  //  Unpack 8 characters to 48 bits at a time. The lookups are independent
+  //  of each other and the word is written once per group.
+  const unsigned char *src = reinterpret_cast<const unsigned char *>(str);
+  int pos = 0;
+  for (int i = 0; i < byte_length; i += 8, pos += 48) {
+    uint64_t group = 0;
+    if (i + 8 <= byte_length) {
+      for (int j = 0; j < 8; j++) {
+        group = (group << 6) | kSixBit.value[src[i + j]];
+      }
+    } else {
+      for (int j = 0; j < 8; j++) {
+        group <<= 6;
+        if (i + j < byte_length) group |= kSixBit.value[src[i + j]];
+      }
+    }
+    const int w = pos >> 6;
+    const int off = pos & 63;
+    if (off <= 16) {
+      bitwords[w] |= group << (16 - off);
+    } else {
+      bitwords[w] |= group >> (off - 16);
+      bitwords[w + 1] |= group << (80 - off);
+    }
   }
 }
 
@@ -54,56 +102,36 @@ unsigned char AisBitstring::to_6bit(const char c) {
   return (unsigned char)(cp & 0x3f);
 }
 
-int AisBitstring::GetInt(int sp, int len, bool signed_flag) {
-  int acc = 0;
-  int s0p = sp - 1;  // to zero base
-
-  int cp, cx, c0;
-
-  for (int i = 0; i < len; i++) {
-    acc = acc << 1;
-    cp = (s0p + i) / 6;
-    cx = bitbytes[cp];  // what if cp >= byte_length?
-    c0 = (cx >> (5 - ((s0p + i) % 6))) & 1;
-    if (i == 0 && signed_flag &&
-        c0)  // if signed value and first bit is 1, pad with 1's
-      acc = ~acc;
-    acc |= c0;
+uint64_t AisBitstring::GetBits(int pos, int len) const {
+  if (len > 64) {  // Only the last 64 bits fits
+    pos += len - 64;
+    len = 64;
   }
+  //  Bits after the payload reads as zeros.
+  if (len <= 0 || pos < 0 || pos >= byte_length * 6) return 0;
+  const int w = pos >> 6;
+  const int off = pos & 63;
+  uint64_t bits = bitwords[w] << off;
+  if (off) bits |= bitwords[w + 1] >> (64 - off);
+  return bits >> (64 - len);
+}
 
-  return acc;
+int AisBitstring::GetInt(int sp, int len, bool signed_flag) {
+  uint64_t acc = GetBits(sp - 1, len);
+  if (signed_flag && len > 0 && len < 64 && ((acc >> (len - 1)) & 1)) {
+    acc |= ~static_cast<uint64_t>(0) << len;  // pad with 1's
+  }
+  return static_cast<int>(acc);
 }
 
 int AisBitstring::GetStr(int sp, int bit_len, char *dest, int max_len) {
-  // char temp_str[85];
-  char *temp_str = dest;
-
-  char acc = 0;
-  int s0p = sp - 1;  // to zero base
-
   int k = 0;
-  int cp, cx, c0, cs;
-
-  int i = 0;
-  while (i < bit_len && k < max_len) {
-    acc = 0;
-    for (int j = 0; j < 6; j++) {
-      acc = acc << 1;
-      cp = (s0p + i) / 6;
-      cx = bitbytes[cp];  // what if cp >= byte_length?
-      cs = 5 - ((s0p + i) % 6);
-      c0 = (cx >> cs) & 1;
-      acc |= c0;
-
-      i++;
-    }
-    temp_str[k] = (char)(acc & 0x3f);
-
-    if (acc < 32) temp_str[k] += 0x40;
-    k++;
+  for (int i = 0; i < bit_len && k < max_len; i += 6) {
+    char acc = static_cast<char>(GetBits(sp - 1 + i, 6));
+    if (acc < 32) acc += 0x40;
+    dest[k++] = acc;
   }
-
-  temp_str[k] = 0;
+  dest[k] = 0;
 
   return k;
 }
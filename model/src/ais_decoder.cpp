@@ -30,6 +30,7 @@
 #endif  // precompiled headers
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <fstream>
 
@@ -88,22 +89,7 @@ extern Multiplexer *g_pMUX;
 int g_OwnShipmmsi;
 
 wxDEFINE_EVENT(EVT_N0183_VDO, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_VDM, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_FRPOS, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_CDDSC, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_CDDSE, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_TLL, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_TTM, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_OSD, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_WPL, ObservedEvt);
 wxDEFINE_EVENT(EVT_SIGNALK, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129038, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129039, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129041, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129794, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129809, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129810, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129793, ObservedEvt);
 
 BEGIN_EVENT_TABLE(AisDecoder, wxEvtHandler)
 EVT_TIMER(TIMER_AIS1, AisDecoder::OnTimerAIS)
@@ -112,6 +98,18 @@ END_EVENT_TABLE()
 
 static const double ms_to_knot_factor = 1.9438444924406;
 
+/** Buffer limit for AIS messages arriving between two main loop turns. */
+static const size_t kMaxAisBatch = 8192;
+
+/** Max time between CPA updates of targets neither near nor displayed. */
+static const std::chrono::milliseconds kCpaMaxAge(3000);
+
+/** Added to the CPA alarm search radius, covers position report lag. */
+static const double kCpaRadiusMarginNm = 1.0;
+
+/** Highest speed an AIS position report can express, knots. */
+static const double kMaxAisSog = 102.2;
+
 static int n_msgs;
 static int n_msg1;
 static int n_msg5;
@@ -181,6 +179,10 @@ AisDecoder::AisDecoder(AisDecoderCallbacks callbacks)
   m_ptentative_dsctarget = NULL;
   m_dsc_timer.SetOwner(this, TIMER_DSC);
 
+  //  Decoded VDM/VDO messages are handled in batches on the main thread
+  m_vdx_worker = std::make_unique<AisVdxWorker>(
+      [&] { CallAfter([&] { HandleVdxBatch(); }); });
+
   //  Create/connect a dynamic event handler slot for wxEVT_OCPN_DATASTREAM(s)
   // FIXME delete Connect(wxEVT_OCPN_DATASTREAM,
   //        (wxObjectEventFunction)(wxEventFunction)&AisDecoder::OnEvtAIS);
@@ -190,6 +192,8 @@ AisDecoder::AisDecoder(AisDecoderCallbacks callbacks)
 }
 
 AisDecoder::~AisDecoder(void) {
+  m_vdx_worker.reset();  // No more batches posted after this point
+
   //   for (const auto &it : GetTargetList()) {
   //     AisTargetData *td = it.second;
   //
@@ -255,80 +259,19 @@ void AisDecoder::InitCommListeners(void) {
 
   auto &msgbus = NavMsgBus::GetInstance();
 
-  // NMEA0183
-  // VDM
-  Nmea0183Msg n0183_msg_VDM("VDM");
-  listener_N0183_VDM.Listen(n0183_msg_VDM, this, EVT_N0183_VDM);
-  Bind(EVT_N0183_VDM, [&](ObservedEvt ev) {
-    auto ptr = ev.GetSharedPtr();
-    auto n0183_msg = std::static_pointer_cast<const Nmea0183Msg>(ptr);
-    HandleN0183_AIS(n0183_msg);
-  });
-
-  // FRPOS
-  Nmea0183Msg n0183_msg_FRPOS("FRPOS");
-  listener_N0183_FRPOS.Listen(n0183_msg_FRPOS, this, EVT_N0183_FRPOS);
-
-  Bind(EVT_N0183_FRPOS, [&](ObservedEvt ev) {
-    auto ptr = ev.GetSharedPtr();
-    auto n0183_msg = std::static_pointer_cast<const Nmea0183Msg>(ptr);
-    HandleN0183_AIS(n0183_msg);
-  });
-
-  // CDDSC
-  Nmea0183Msg n0183_msg_CDDSC("CDDSC");
-  listener_N0183_CDDSC.Listen(n0183_msg_CDDSC, this, EVT_N0183_CDDSC);
-  Bind(EVT_N0183_CDDSC, [&](ObservedEvt ev) {
-    auto ptr = ev.GetSharedPtr();
-    auto n0183_msg = std::static_pointer_cast<const Nmea0183Msg>(ptr);
-    HandleN0183_AIS(n0183_msg);
-  });
-
-  // CDDSE
-  Nmea0183Msg n0183_msg_CDDSE("CDDSE");
-  listener_N0183_CDDSE.Listen(n0183_msg_CDDSE, this, EVT_N0183_CDDSE);
-  Bind(EVT_N0183_CDDSE, [&](ObservedEvt ev) {
-    auto ptr = ev.GetSharedPtr();
-    auto n0183_msg = std::static_pointer_cast<const Nmea0183Msg>(ptr);
-    HandleN0183_AIS(n0183_msg);
-  });
-
-  // TLL
-  Nmea0183Msg n0183_msg_TLL("TLL");
-  listener_N0183_TLL.Listen(n0183_msg_TLL, this, EVT_N0183_TLL);
-
-  Bind(EVT_N0183_TLL, [&](ObservedEvt ev) {
-    auto ptr = ev.GetSharedPtr();
-    auto n0183_msg = std::static_pointer_cast<const Nmea0183Msg>(ptr);
-    HandleN0183_AIS(n0183_msg);
-  });
-
-  // TTM
-  Nmea0183Msg n0183_msg_ttm("TTM");
-  listener_N0183_TTM.Listen(n0183_msg_ttm, this, EVT_N0183_TTM);
-  Bind(EVT_N0183_TTM, [&](ObservedEvt ev) {
-    auto ptr = ev.GetSharedPtr();
-    auto n0183_msg = std::static_pointer_cast<const Nmea0183Msg>(ptr);
-    HandleN0183_AIS(n0183_msg);
-  });
-
-  // OSD
-  Nmea0183Msg n0183_msg_OSD("OSD");
-  listener_N0183_OSD.Listen(n0183_msg_OSD, this, EVT_N0183_OSD);
-  Bind(EVT_N0183_OSD, [&](ObservedEvt ev) {
-    auto ptr = ev.GetSharedPtr();
-    auto n0183_msg = std::static_pointer_cast<const Nmea0183Msg>(ptr);
-    HandleN0183_AIS(n0183_msg);
-  });
-
-  // WPL
-  Nmea0183Msg n0183_msg_WPL("WPL");
-  listener_N0183_WPL.Listen(n0183_msg_WPL, this, EVT_N0183_WPL);
-  Bind(EVT_N0183_WPL, [&](ObservedEvt ev) {
-    auto ptr = ev.GetSharedPtr();
-    auto n0183_msg = std::static_pointer_cast<const Nmea0183Msg>(ptr);
-    HandleN0183_AIS(n0183_msg);
-  });
+  // NMEA0183 VDM, FRPOS, CDDSC, CDDSE, TLL, TTM, OSD and WPL, delivered in
+  // arrival order as one batch per main loop turn.
+  listener_N0183_AIS.Init(
+      Nmea0183Msg("VDM"),
+      [&](std::vector<ObservedItem> &batch) {
+        for (auto &item : batch) {
+          auto msg = std::static_pointer_cast<const Nmea0183Msg>(item.ptr);
+          HandleN0183_AIS(msg);
+        }
+      },
+      BatchPolicy::kAll, kMaxAisBatch);
+  for (auto id : {"FRPOS", "CDDSC", "CDDSE", "TLL", "TTM", "OSD", "WPL"})
+    listener_N0183_AIS.Listen(Nmea0183Msg(id));
 
   // SignalK
   SignalkMsg sk_msg;
@@ -337,71 +280,71 @@ void AisDecoder::InitCommListeners(void) {
     HandleSignalK(UnpackEvtPointer<SignalkMsg>(ev));
   });
 
-  // AIS Class A   PGN 129038
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129038(static_cast<uint64_t>(129038));
-  listener_N2K_129038.Listen(n2k_msg_129038, this, EVT_N2K_129038);
-  Bind(EVT_N2K_129038, [&](ObservedEvt ev) {
-    HandleN2K_129038(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // AIS Class B   PGN 129039
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129039(static_cast<uint64_t>(129039));
-  listener_N2K_129039.Listen(n2k_msg_129039, this, EVT_N2K_129039);
-  Bind(EVT_N2K_129039, [&](ObservedEvt ev) {
-    HandleN2K_129039(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // AIS ATON   PGN 129041
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129041(static_cast<uint64_t>(129041));
-  listener_N2K_129041.Listen(n2k_msg_129041, this, EVT_N2K_129041);
-  Bind(EVT_N2K_129041, [&](ObservedEvt ev) {
-    HandleN2K_129041(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // AIS static data class A PGN 129794
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129794(static_cast<uint64_t>(129794));
-  listener_N2K_129794.Listen(n2k_msg_129794, this, EVT_N2K_129794);
-  Bind(EVT_N2K_129794, [&](ObservedEvt ev) {
-    HandleN2K_129794(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // AIS static data class B part A PGN 129809
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129809(static_cast<uint64_t>(129809));
-  listener_N2K_129809.Listen(n2k_msg_129809, this, EVT_N2K_129809);
-  Bind(EVT_N2K_129809, [&](ObservedEvt ev) {
-    HandleN2K_129809(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // AIS static data class B part B PGN 129810
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129810(static_cast<uint64_t>(129810));
-  listener_N2K_129810.Listen(n2k_msg_129810, this, EVT_N2K_129810);
-  Bind(EVT_N2K_129810, [&](ObservedEvt ev) {
-    HandleN2K_129810(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // AIS Base Station report PGN 129793
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129793(static_cast<uint64_t>(129793));
-  listener_N2K_129793.Listen(n2k_msg_129793, this, EVT_N2K_129793);
-  Bind(EVT_N2K_129793, [&](ObservedEvt ev) {
-    HandleN2K_129793(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
+  // NMEA2000 AIS PGNs:
+  //   129038  Class A position report
+  //   129039  Class B position report
+  //   129041  ATON report
+  //   129794  Class A static data
+  //   129809  Class B static data part A
+  //   129810  Class B static data part B
+  //   129793  Base station report
+  listener_N2K_AIS.Init(
+      Nmea2000Msg(static_cast<uint64_t>(129038)),
+      [&](std::vector<ObservedItem> &batch) {
+        for (auto &item : batch) {
+          auto msg = std::static_pointer_cast<const Nmea2000Msg>(item.ptr);
+          switch (msg->PGN.pgn) {
+            case 129038:
+              HandleN2K_129038(msg);
+              break;
+            case 129039:
+              HandleN2K_129039(msg);
+              break;
+            case 129041:
+              HandleN2K_129041(msg);
+              break;
+            case 129794:
+              HandleN2K_129794(msg);
+              break;
+            case 129809:
+              HandleN2K_129809(msg);
+              break;
+            case 129810:
+              HandleN2K_129810(msg);
+              break;
+            case 129793:
+              HandleN2K_129793(msg);
+              break;
+          }
+        }
+      },
+      BatchPolicy::kAll, kMaxAisBatch);
+  for (uint64_t pgn : {129039, 129041, 129794, 129809, 129810, 129793})
+    listener_N2K_AIS.Listen(Nmea2000Msg(pgn));
 }
 
 bool AisDecoder::HandleN0183_AIS(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
   std::string str = n0183_msg->payload;
+  if (str.size() > 5 && str.compare(3, 2, "VD") == 0) {
+    //  Decoded by worker, handled in HandleVdxBatch()
+    return m_vdx_worker->Push(std::move(str));
+  }
   wxString sentence(str.c_str());
   DecodeN0183(sentence);
   touch_state.Notify();
   return true;
 }
 
+void AisDecoder::HandleVdxBatch(void) {
+  m_vdx_batch.clear();
+  if (m_vdx_worker->Drain(m_vdx_batch) == 0) return;
+  for (auto &msg : m_vdx_batch) {
+    DecodeVdx(wxString(msg.sentence.c_str()), msg.bits);
+  }
+  m_vdx_batch.clear();
+  touch_state.Notify();
+}
+
 bool AisDecoder::HandleN2K_129038(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
   std::vector<unsigned char> v = n2k_msg->payload;
 
@@ -1669,7 +1612,6 @@ AisError AisDecoder::DecodeSingleVDO(const wxString &str, GenericPosDatEx *pos,
 //----------------------------------------------------------------------------------------
 
 AisError AisDecoder::DecodeN0183(const wxString &str) {
-  AisError ret = AIS_GENERIC_ERROR;
   wxString string_to_parse;
 
   double gpsg_lat, gpsg_lon, gpsg_mins, gpsg_degs;
@@ -2000,331 +1942,388 @@ AisError AisDecoder::DecodeN0183(const wxString &str) {
     return AIS_NMEAVDX_BAD;
   }
 
-  //  OK, looks like the sentence is OK
+  if (!mmsi) {
+    //  OSD and WPL marks are done, plain AIS remains
+    if (!str.Mid(3, 2).IsSameAs(_T("VD"))) return AIS_NoError;
 
-  //  Use a tokenizer to pull out the first 4 fields
-  wxString string(str);
-  wxStringTokenizer tkz(string, _T(","));
+    //  OK, looks like the sentence is OK
 
-  wxString token;
-  token = tkz.GetNextToken();  // !xxVDx
+    //  Use a tokenizer to pull out the first 4 fields
+    wxString string(str);
+    wxStringTokenizer tkz(string, _T(","));
 
-  token = tkz.GetNextToken();
-  nsentences = atoi(token.mb_str());
+    wxString token;
+    token = tkz.GetNextToken();  // !xxVDx
 
-  token = tkz.GetNextToken();
-  isentence = atoi(token.mb_str());
+    token = tkz.GetNextToken();
+    nsentences = atoi(token.mb_str());
 
-  token = tkz.GetNextToken();
-  long lsequence_id = 0;
-  token.ToLong(&lsequence_id);
+    token = tkz.GetNextToken();
+    isentence = atoi(token.mb_str());
 
-  token = tkz.GetNextToken();
-  long lchannel;
-  token.ToLong(&lchannel);
-  //  Now, some decisions
+    token = tkz.GetNextToken();
+    long lsequence_id = 0;
+    token.ToLong(&lsequence_id);
 
-  string_to_parse.Clear();
+    token = tkz.GetNextToken();
+    long lchannel;
+    token.ToLong(&lchannel);
+    //  Now, some decisions
 
-  //  Simple case first
-  //  First and only part of a one-part sentence
-  if ((1 == nsentences) && (1 == isentence)) {
-    string_to_parse = tkz.GetNextToken();  // the encapsulated data
-  }
+    string_to_parse.Clear();
 
-  else if (nsentences > 1) {
-    if (1 == isentence) {
-      sentence_accumulator = tkz.GetNextToken();  // the encapsulated data
+    //  Simple case first
+    //  First and only part of a one-part sentence
+    if ((1 == nsentences) && (1 == isentence)) {
+      string_to_parse = tkz.GetNextToken();  // the encapsulated data
     }
 
-    else {
-      sentence_accumulator += tkz.GetNextToken();
-    }
+    else if (nsentences > 1) {
+      if (1 == isentence) {
+        sentence_accumulator = tkz.GetNextToken();  // the encapsulated data
+      }
+
+      else {
+        sentence_accumulator += tkz.GetNextToken();
+      }
 
-    if (isentence == nsentences) {
-      string_to_parse = sentence_accumulator;
+      if (isentence == nsentences) {
+        string_to_parse = sentence_accumulator;
+      }
     }
-  }
 
-  if (mmsi || (!string_to_parse.IsEmpty() &&
-               (string_to_parse.Len() < AIS_MAX_MESSAGE_LEN))) {
+    if (string_to_parse.IsEmpty() ||
+        string_to_parse.Len() >= AIS_MAX_MESSAGE_LEN)
+      return AIS_Partial;  // accumulating parts of a multi-sentence message
+
     //  Create the bit accessible string
     wxCharBuffer abuf = string_to_parse.ToUTF8();
     if (!abuf.data())  // badly formed sentence?
       return AIS_GENERIC_ERROR;
 
     AisBitstring strbit(abuf.data());
+    return DecodeVdx(str, strbit);
+  }
 
-    //  Extract the MMSI
-    if (!mmsi) mmsi = strbit.GetInt(9, 30);
-    long mmsi_long = mmsi;
+  //  A GpsGate buddy, ARPA or APRS target
+  if (mmsi == g_OwnShipmmsi) return AIS_GENERIC_ERROR;
+  long mmsi_long = mmsi;
 
-    // Ais8_001_31 || ais8_367_33 (class AIS_METEO) test for a new mmsi ID
-    int origin_mmsi = 0;
-    int messID = strbit.GetInt(1, 6);
-    int dac = strbit.GetInt(41, 10);
-    int fi = strbit.GetInt(51, 6);
-    if (messID == 8) {
-      int met_lon, met_lat;
-      if (dac == 001 && fi == 31) {
-        origin_mmsi = mmsi;
-        met_lon = strbit.GetInt(57, 25);
-        met_lat = strbit.GetInt(82, 24);
-        mmsi = AisMeteoNewMmsi(mmsi, met_lat, met_lon, 25, 0);
-        mmsi_long = mmsi;
-
-      } else if (dac == 367 && fi == 33) {  // ais8_367_33
-        // Check for a valid message size before further handling
-        const int size = strbit.GetBitCount();
-        if (size < 168) return AIS_GENERIC_ERROR;
-        const int startb = 56;
-        const int slot_size = 112;
-        const int extra_bits = (size - startb) % slot_size;
-        if (extra_bits > 0) return AIS_GENERIC_ERROR;
-
-        int mes_type = strbit.GetInt(57, 4);
-        int site_ID = strbit.GetInt(77, 7);
-        if (mes_type == 0) {  // Location
-          origin_mmsi = mmsi;
-          met_lon = strbit.GetInt(90, 28);
-          met_lat = strbit.GetInt(118, 27);
-          mmsi = AisMeteoNewMmsi(mmsi, met_lat, met_lon, 28, site_ID);
-          mmsi_long = mmsi;
-        } else {  // Other messsage types without position.
-          // We need a previously received type 0, position message
-          // to get use of any sensor report.
-          int x_mmsi = AisMeteoNewMmsi(mmsi, 91, 181, 0, site_ID);
-          if (x_mmsi) {
-            origin_mmsi = mmsi;
-            mmsi = x_mmsi;
-            mmsi_long = mmsi;
-          } else  // So far no use for this report.
-            return AIS_GENERIC_ERROR;
-        }
+  //  Search the current AISTargetList for an MMSI match
+  auto it = AISTargetList.find(mmsi);
+  if (it == AISTargetList.end()) {  // not found
+    pTargetData = AisTargetDataMaker::GetInstance().GetTargetData();
+    bnewtarget = true;
+    m_n_targets++;
+  } else {
+    pTargetData = it->second;    // find current entry
+    pStaleTarget = pTargetData;  // save a pointer to stale data
+  }
+  for (unsigned int i = 0; i < g_MMSI_Props_Array.GetCount(); i++) {
+    MmsiProperties *props = g_MMSI_Props_Array[i];
+    if (mmsi == props->MMSI) {
+      // Check if this target has a dedicated tracktype
+      if (TRACKTYPE_NEVER == props->TrackType) {
+        pTargetData->b_show_track = false;
+      } else if (TRACKTYPE_ALWAYS == props->TrackType) {
+        pTargetData->b_show_track = true;
       }
+      // Ignored, or VDM to VDO translation which only applies to AIS
+      if (props->m_bignore || props->m_bVDM) return AIS_NoError;
+      break;
     }
+  }
 
-    // Check for own ship mmsi. It's not a valid AIS target.
-    if (mmsi == g_OwnShipmmsi) return AIS_GENERIC_ERROR;
+  //  Grab the stale targets's last report time
+  wxDateTime now = wxDateTime::Now();
+  now.MakeGMT();
 
-    //  Search the current AISTargetList for an MMSI match
-    auto it = AISTargetList.find(mmsi);
-    if (it == AISTargetList.end())  // not found
-    {
-      pTargetData = AisTargetDataMaker::GetInstance().GetTargetData();
-      bnewtarget = true;
-      m_n_targets++;
+  if (pStaleTarget)
+    last_report_ticks = pStaleTarget->PositionReportTicks;
+  else
+    last_report_ticks = now.GetTicks();
 
-      if (origin_mmsi) {  // New mmsi allocated for a Meteo station
-        pTargetData->MMSI = mmsi;
-        pTargetData->met_data.original_mmsi = origin_mmsi;
-      }
-    } else {
-      pTargetData = it->second;  // find current entry
+  // Delete the stale AIS Target selectable point
+  if (pStaleTarget)
+    pSelectAIS->DeleteSelectablePoint((void *)mmsi_long, SELTYPE_AISTARGET);
 
-      if (!bnewtarget)
-        pStaleTarget = pTargetData;  // save a pointer to stale data
-      if (origin_mmsi) {             // Meteo point
-        pTargetData->MMSI = mmsi;
-        pTargetData->met_data.original_mmsi = origin_mmsi;
+  if (gpsg_mmsi) {
+    pTargetData->LastPositionReportTicks = pTargetData->PositionReportTicks;
+    pTargetData->PositionReportTicks = now.GetTicks();
+    pTargetData->StaticReportTicks = now.GetTicks();
+    pTargetData->m_utc_hour = gpsg_utc_hour;
+    pTargetData->m_utc_min = gpsg_utc_min;
+    pTargetData->m_utc_sec = gpsg_utc_sec;
+    pTargetData->m_date_string = gpsg_date;
+    pTargetData->MMSI = gpsg_mmsi;
+    pTargetData->NavStatus = 0;  // underway
+    pTargetData->Lat = gpsg_lat;
+    pTargetData->Lon = gpsg_lon;
+    pTargetData->b_positionOnceValid = true;
+    pTargetData->COG = gpsg_cog;
+    pTargetData->SOG = gpsg_sog;
+    pTargetData->ShipType = 52;  // buddy
+    pTargetData->Class = AIS_GPSG_BUDDY;
+    memcpy(pTargetData->ShipName, gpsg_name_str, sizeof(gpsg_name_str));
+    pTargetData->b_nameValid = true;
+    pTargetData->b_active = true;
+    pTargetData->b_lost = false;
+
+    bdecode_result = true;
+  } else if (arpa_mmsi) {
+    pTargetData->m_utc_hour = arpa_utc_hour;
+    pTargetData->m_utc_min = arpa_utc_min;
+    pTargetData->m_utc_sec = arpa_utc_sec;
+    pTargetData->MMSI = arpa_mmsi;
+    pTargetData->NavStatus = 15;  // undefined
+    if (str.Mid(3, 3).IsSameAs(_T("TLL"))) {
+      if (!bnewtarget) {
+        int age_of_last =
+            (now.GetTicks() - pTargetData->PositionReportTicks);
+        if (age_of_last > 0) {
+          ll_gc_ll_reverse(pTargetData->Lat, pTargetData->Lon, arpa_lat,
+                           arpa_lon, &pTargetData->COG, &pTargetData->SOG);
+          pTargetData->SOG = pTargetData->SOG * 3600 / age_of_last;
+        }
       }
+      pTargetData->Lat = arpa_lat;
+      pTargetData->Lon = arpa_lon;
+    } else if (str.Mid(3, 3).IsSameAs(_T("TTM"))) {
+      if (arpa_dist != 0.)  // Not a new or turned off target
+        ll_gc_ll(gLat, gLon, arpa_brg, arpa_dist, &pTargetData->Lat,
+                 &pTargetData->Lon);
+      else
+        arpa_lost = true;
+      pTargetData->COG = arpa_cog;
+      pTargetData->SOG = arpa_sog;
     }
-    for (unsigned int i = 0; i < g_MMSI_Props_Array.GetCount(); i++) {
-      MmsiProperties *props = g_MMSI_Props_Array[i];
-      if (mmsi == props->MMSI) {
-        // Check if this target has a dedicated tracktype
-        if (TRACKTYPE_NEVER == props->TrackType) {
-          pTargetData->b_show_track = false;
-        } else if (TRACKTYPE_ALWAYS == props->TrackType) {
-          pTargetData->b_show_track = true;
-        }
+    pTargetData->LastPositionReportTicks = pTargetData->PositionReportTicks;
+    pTargetData->PositionReportTicks = now.GetTicks();
+    pTargetData->StaticReportTicks = now.GetTicks();
+    pTargetData->b_positionOnceValid = true;
+    pTargetData->ShipType = 55;  // arpa
+    pTargetData->Class = AIS_ARPA;
 
-        // Check to see if this MMSI has been configured to be ignored
-        // completely...
-        if (props->m_bignore) return AIS_NoError;
-        // Check to see if this MMSI wants VDM translated to VDO or whether we
-        // want to persist it's track...
-        else if (props->m_bVDM) {
-          // Only single line VDM messages to be translated
-          if (str.Mid(3, 9).IsSameAs(wxT("VDM,1,1,,"))) {
-            int message_ID = strbit.GetInt(1, 6);  // Parse on message ID
-            // Only translate the dynamic positionreport messages (1, 2, 3 or
-            // 18)
-            if ((message_ID <= 3) || (message_ID == 18)) {
-              // set OwnShip to prevent target from being drawn
-              pTargetData->b_OwnShip = true;
-              // Rename nmea sentence to AIVDO and calc a new checksum
-              wxString aivdostr = str;
-              aivdostr.replace(1, 5, "AIVDO");
-              unsigned char calculated_checksum = 0;
-              wxString::iterator i;
-              for (i = aivdostr.begin() + 1; i != aivdostr.end() && *i != '*';
-                   ++i)
-                calculated_checksum ^= static_cast<unsigned char>(*i);
-              // if i is not at least 3 positons befoere end, there is no
-              // checksum added so also no need to add one now.
-              if (i <= aivdostr.end() - 3)
-                aivdostr.replace(
-                    i + 1, i + 3,
-                    wxString::Format(_("%02X"), calculated_checksum));
-
-              gps_watchdog_timeout_ticks =
-                  60;  // increase watchdog time up to 1 minute
-              // add the changed sentence into nmea message system
-              std::string full_sentence = aivdostr.ToStdString();
-              std::string identifier("AIVDO");
-              // We notify based on full message, including the Talker ID
-              // notify message listener and also "ALL" N0183 messages, to
-              // support plugin API using original talker id
-              auto address = std::make_shared<NavAddr0183>("virtual");
-              auto msg = std::make_shared<const Nmea0183Msg>(
-                  identifier, full_sentence, address);
-              auto msg_all = std::make_shared<const Nmea0183Msg>(*msg, "ALL");
-
-              auto &msgbus = NavMsgBus::GetInstance();
-
-              msgbus.Notify(std::move(msg));
-              msgbus.Notify(std::move(msg_all));
-            }
-          }
-          return AIS_NoError;
-        } else
-          break;
+    memcpy(pTargetData->ShipName, arpa_name_str, sizeof(arpa_name_str));
+    if (arpa_status != _T("Q"))
+      pTargetData->b_nameValid = true;
+    else
+      pTargetData->b_nameValid = false;
+    pTargetData->b_active = !arpa_lost;
+    pTargetData->b_lost = arpa_nottracked;
+
+    bdecode_result = true;
+  } else if (aprs_mmsi) {
+    pTargetData->m_utc_hour = now.GetHour();
+    pTargetData->m_utc_min = now.GetMinute();
+    pTargetData->m_utc_sec = now.GetSecond();
+    pTargetData->MMSI = aprs_mmsi;
+    pTargetData->NavStatus = 15;  // undefined
+    if (!bnewtarget) {
+      int age_of_last = (now.GetTicks() - pTargetData->PositionReportTicks);
+      if (age_of_last > 0) {
+        ll_gc_ll_reverse(pTargetData->Lat, pTargetData->Lon, aprs_lat,
+                         aprs_lon, &pTargetData->COG, &pTargetData->SOG);
+        pTargetData->SOG = pTargetData->SOG * 3600 / age_of_last;
       }
     }
+    pTargetData->LastPositionReportTicks = pTargetData->PositionReportTicks;
+    pTargetData->PositionReportTicks = now.GetTicks();
+    pTargetData->StaticReportTicks = now.GetTicks();
+    pTargetData->Lat = aprs_lat;
+    pTargetData->Lon = aprs_lon;
+    pTargetData->b_positionOnceValid = true;
+    pTargetData->ShipType = 56;  // aprs
+    pTargetData->Class = AIS_APRS;
+    memcpy(pTargetData->ShipName, aprs_name_str, sizeof(aprs_name_str));
+    pTargetData->b_nameValid = true;
+    pTargetData->b_active = true;
+    pTargetData->b_lost = false;
 
-    //  Grab the stale targets's last report time
-    wxDateTime now = wxDateTime::Now();
-    now.MakeGMT();
+    bdecode_result = true;
+  }
 
-    if (pStaleTarget)
-      last_report_ticks = pStaleTarget->PositionReportTicks;
-    else
-      last_report_ticks = now.GetTicks();
+  // Catch mmsi properties like track, persistent track, follower.
+  getMmsiProperties(pTargetData);
 
-    // Delete the stale AIS Target selectable point
-    if (pStaleTarget)
-      pSelectAIS->DeleteSelectablePoint((void *)mmsi_long, SELTYPE_AISTARGET);
+  //     Update the most recent report period
+  pTargetData->RecentPeriod =
+      pTargetData->PositionReportTicks - last_report_ticks;
 
-    if (pTargetData) {
-      if (gpsg_mmsi) {
-        pTargetData->LastPositionReportTicks = pTargetData->PositionReportTicks;
-        pTargetData->PositionReportTicks = now.GetTicks();
-        pTargetData->StaticReportTicks = now.GetTicks();
-        pTargetData->m_utc_hour = gpsg_utc_hour;
-        pTargetData->m_utc_min = gpsg_utc_min;
-        pTargetData->m_utc_sec = gpsg_utc_sec;
-        pTargetData->m_date_string = gpsg_date;
-        pTargetData->MMSI = gpsg_mmsi;
-        pTargetData->NavStatus = 0;  // underway
-        pTargetData->Lat = gpsg_lat;
-        pTargetData->Lon = gpsg_lon;
-        pTargetData->b_positionOnceValid = true;
-        pTargetData->COG = gpsg_cog;
-        pTargetData->SOG = gpsg_sog;
-        pTargetData->ShipType = 52;  // buddy
-        pTargetData->Class = AIS_GPSG_BUDDY;
-        memcpy(pTargetData->ShipName, gpsg_name_str, sizeof(gpsg_name_str));
-        pTargetData->b_nameValid = true;
-        pTargetData->b_active = true;
-        pTargetData->b_lost = false;
-
-        bdecode_result = true;
-      } else if (arpa_mmsi) {
-        pTargetData->m_utc_hour = arpa_utc_hour;
-        pTargetData->m_utc_min = arpa_utc_min;
-        pTargetData->m_utc_sec = arpa_utc_sec;
-        pTargetData->MMSI = arpa_mmsi;
-        pTargetData->NavStatus = 15;  // undefined
-        if (str.Mid(3, 3).IsSameAs(_T("TLL"))) {
-          if (!bnewtarget) {
-            int age_of_last =
-                (now.GetTicks() - pTargetData->PositionReportTicks);
-            if (age_of_last > 0) {
-              ll_gc_ll_reverse(pTargetData->Lat, pTargetData->Lon, arpa_lat,
-                               arpa_lon, &pTargetData->COG, &pTargetData->SOG);
-              pTargetData->SOG = pTargetData->SOG * 3600 / age_of_last;
-            }
-          }
-          pTargetData->Lat = arpa_lat;
-          pTargetData->Lon = arpa_lon;
-        } else if (str.Mid(3, 3).IsSameAs(_T("TTM"))) {
-          if (arpa_dist != 0.)  // Not a new or turned off target
-            ll_gc_ll(gLat, gLon, arpa_brg, arpa_dist, &pTargetData->Lat,
-                     &pTargetData->Lon);
-          else
-            arpa_lost = true;
-          pTargetData->COG = arpa_cog;
-          pTargetData->SOG = arpa_sog;
-        }
-        pTargetData->LastPositionReportTicks = pTargetData->PositionReportTicks;
-        pTargetData->PositionReportTicks = now.GetTicks();
-        pTargetData->StaticReportTicks = now.GetTicks();
-        pTargetData->b_positionOnceValid = true;
-        pTargetData->ShipType = 55;  // arpa
-        pTargetData->Class = AIS_ARPA;
+  CommitAISTarget(pTargetData, str, bdecode_result, bnewtarget);
+  return AIS_NoError;
+}
 
-        memcpy(pTargetData->ShipName, arpa_name_str, sizeof(arpa_name_str));
-        if (arpa_status != _T("Q"))
-          pTargetData->b_nameValid = true;
-        else
-          pTargetData->b_nameValid = false;
-        pTargetData->b_active = !arpa_lost;
-        pTargetData->b_lost = arpa_nottracked;
-
-        bdecode_result = true;
-      } else if (aprs_mmsi) {
-        pTargetData->m_utc_hour = now.GetHour();
-        pTargetData->m_utc_min = now.GetMinute();
-        pTargetData->m_utc_sec = now.GetSecond();
-        pTargetData->MMSI = aprs_mmsi;
-        pTargetData->NavStatus = 15;  // undefined
-        if (!bnewtarget) {
-          int age_of_last = (now.GetTicks() - pTargetData->PositionReportTicks);
-          if (age_of_last > 0) {
-            ll_gc_ll_reverse(pTargetData->Lat, pTargetData->Lon, aprs_lat,
-                             aprs_lon, &pTargetData->COG, &pTargetData->SOG);
-            pTargetData->SOG = pTargetData->SOG * 3600 / age_of_last;
-          }
-        }
-        pTargetData->LastPositionReportTicks = pTargetData->PositionReportTicks;
-        pTargetData->PositionReportTicks = now.GetTicks();
-        pTargetData->StaticReportTicks = now.GetTicks();
-        pTargetData->Lat = aprs_lat;
-        pTargetData->Lon = aprs_lon;
-        pTargetData->b_positionOnceValid = true;
-        pTargetData->ShipType = 56;  // aprs
-        pTargetData->Class = AIS_APRS;
-        memcpy(pTargetData->ShipName, aprs_name_str, sizeof(aprs_name_str));
-        pTargetData->b_nameValid = true;
-        pTargetData->b_active = true;
-        pTargetData->b_lost = false;
+AisError AisDecoder::DecodeVdx(const wxString &str, AisBitstring &strbit) {
+  std::shared_ptr<AisTargetData> pTargetData = 0;
+  std::shared_ptr<AisTargetData> pStaleTarget = NULL;
+  bool bnewtarget = false;
+  int last_report_ticks;
 
-        bdecode_result = true;
-      } else {
-        // The normal Plain-Old AIS target code path....
-        bdecode_result =
-            Parse_VDXBitstring(&strbit, pTargetData);  // Parse the new data
+  //  Extract the MMSI
+  int mmsi = strbit.GetInt(9, 30);
+  long mmsi_long = mmsi;
+
+  // Ais8_001_31 || ais8_367_33 (class AIS_METEO) test for a new mmsi ID
+  int origin_mmsi = 0;
+  int messID = strbit.GetInt(1, 6);
+  int dac = strbit.GetInt(41, 10);
+  int fi = strbit.GetInt(51, 6);
+  if (messID == 8) {
+    int met_lon, met_lat;
+    if (dac == 001 && fi == 31) {
+      origin_mmsi = mmsi;
+      met_lon = strbit.GetInt(57, 25);
+      met_lat = strbit.GetInt(82, 24);
+      mmsi = AisMeteoNewMmsi(mmsi, met_lat, met_lon, 25, 0);
+      mmsi_long = mmsi;
+
+    } else if (dac == 367 && fi == 33) {  // ais8_367_33
+      // Check for a valid message size before further handling
+      const int size = strbit.GetBitCount();
+      if (size < 168) return AIS_GENERIC_ERROR;
+      const int startb = 56;
+      const int slot_size = 112;
+      const int extra_bits = (size - startb) % slot_size;
+      if (extra_bits > 0) return AIS_GENERIC_ERROR;
+
+      int mes_type = strbit.GetInt(57, 4);
+      int site_ID = strbit.GetInt(77, 7);
+      if (mes_type == 0) {  // Location
+        origin_mmsi = mmsi;
+        met_lon = strbit.GetInt(90, 28);
+        met_lat = strbit.GetInt(118, 27);
+        mmsi = AisMeteoNewMmsi(mmsi, met_lat, met_lon, 28, site_ID);
+        mmsi_long = mmsi;
+      } else {  // Other messsage types without position.
+        // We need a previously received type 0, position message
+        // to get use of any sensor report.
+        int x_mmsi = AisMeteoNewMmsi(mmsi, 91, 181, 0, site_ID);
+        if (x_mmsi) {
+          origin_mmsi = mmsi;
+          mmsi = x_mmsi;
+          mmsi_long = mmsi;
+        } else  // So far no use for this report.
+          return AIS_GENERIC_ERROR;
       }
+    }
+  }
 
-      // Catch mmsi properties like track, persistent track, follower.
-      getMmsiProperties(pTargetData);
+  // Check for own ship mmsi. It's not a valid AIS target.
+  if (mmsi == g_OwnShipmmsi) return AIS_GENERIC_ERROR;
 
-      //     Update the most recent report period
-      pTargetData->RecentPeriod =
-          pTargetData->PositionReportTicks - last_report_ticks;
+  //  Search the current AISTargetList for an MMSI match
+  auto it = AISTargetList.find(mmsi);
+  if (it == AISTargetList.end())  // not found
+  {
+    pTargetData = AisTargetDataMaker::GetInstance().GetTargetData();
+    bnewtarget = true;
+    m_n_targets++;
+
+    if (origin_mmsi) {  // New mmsi allocated for a Meteo station
+      pTargetData->MMSI = mmsi;
+      pTargetData->met_data.original_mmsi = origin_mmsi;
     }
-    ret = AIS_NoError;
   } else {
-    ret = AIS_Partial;  // accumulating parts of a multi-sentence message
-    pTargetData = 0;
+    pTargetData = it->second;  // find current entry
+
+    if (!bnewtarget)
+      pStaleTarget = pTargetData;  // save a pointer to stale data
+    if (origin_mmsi) {             // Meteo point
+      pTargetData->MMSI = mmsi;
+      pTargetData->met_data.original_mmsi = origin_mmsi;
+    }
   }
+  for (unsigned int i = 0; i < g_MMSI_Props_Array.GetCount(); i++) {
+    MmsiProperties *props = g_MMSI_Props_Array[i];
+    if (mmsi == props->MMSI) {
+      // Check if this target has a dedicated tracktype
+      if (TRACKTYPE_NEVER == props->TrackType) {
+        pTargetData->b_show_track = false;
+      } else if (TRACKTYPE_ALWAYS == props->TrackType) {
+        pTargetData->b_show_track = true;
+      }
 
-  if (pTargetData) {
-    //  pTargetData is valid, either new or existing. Commit to GUI
-    CommitAISTarget(pTargetData, str, bdecode_result, bnewtarget);
+      // Check to see if this MMSI has been configured to be ignored
+      // completely...
+      if (props->m_bignore) return AIS_NoError;
+      // Check to see if this MMSI wants VDM translated to VDO or whether we
+      // want to persist it's track...
+      else if (props->m_bVDM) {
+        // Only single line VDM messages to be translated
+        if (str.Mid(3, 9).IsSameAs(wxT("VDM,1,1,,"))) {
+          int message_ID = strbit.GetInt(1, 6);  // Parse on message ID
+          // Only translate the dynamic positionreport messages (1, 2, 3 or
+          // 18)
+          if ((message_ID <= 3) || (message_ID == 18)) {
+            // set OwnShip to prevent target from being drawn
+            pTargetData->b_OwnShip = true;
+            // Rename nmea sentence to AIVDO and calc a new checksum
+            wxString aivdostr = str;
+            aivdostr.replace(1, 5, "AIVDO");
+            unsigned char calculated_checksum = 0;
+            wxString::iterator i;
+            for (i = aivdostr.begin() + 1; i != aivdostr.end() && *i != '*';
+                 ++i)
+              calculated_checksum ^= static_cast<unsigned char>(*i);
+            // if i is not at least 3 positons befoere end, there is no
+            // checksum added so also no need to add one now.
+            if (i <= aivdostr.end() - 3)
+              aivdostr.replace(
+                  i + 1, i + 3,
+                  wxString::Format(_("%02X"), calculated_checksum));
+
+            gps_watchdog_timeout_ticks =
+                60;  // increase watchdog time up to 1 minute
+            // add the changed sentence into nmea message system
+            std::string full_sentence = aivdostr.ToStdString();
+            std::string identifier("AIVDO");
+            // We notify based on full message, including the Talker ID
+            // notify message listener and also "ALL" N0183 messages, to
+            // support plugin API using original talker id
+            auto address = std::make_shared<NavAddr0183>("virtual");
+            auto msg = std::make_shared<const Nmea0183Msg>(
+                identifier, full_sentence, address);
+            auto msg_all = std::make_shared<const Nmea0183Msg>(*msg, "ALL");
+
+            auto &msgbus = NavMsgBus::GetInstance();
+
+            msgbus.Notify(std::move(msg));
+            msgbus.Notify(std::move(msg_all));
+          }
+        }
+        return AIS_NoError;
+      } else
+        break;
+    }
   }
 
+  //  Grab the stale targets's last report time
+  wxDateTime now = wxDateTime::Now();
+  now.MakeGMT();
+
+  if (pStaleTarget)
+    last_report_ticks = pStaleTarget->PositionReportTicks;
+  else
+    last_report_ticks = now.GetTicks();
+
+  // Delete the stale AIS Target selectable point
+  if (pStaleTarget)
+    pSelectAIS->DeleteSelectablePoint((void *)mmsi_long, SELTYPE_AISTARGET);
+
+  bool bdecode_result =
+      Parse_VDXBitstring(&strbit, pTargetData);  // Parse the new data
+
+  // Catch mmsi properties like track, persistent track, follower.
+  getMmsiProperties(pTargetData);
+
+  //     Update the most recent report period
+  pTargetData->RecentPeriod =
+      pTargetData->PositionReportTicks - last_report_ticks;
+
+  //  pTargetData is valid, either new or existing. Commit to GUI
+  CommitAISTarget(pTargetData, str, bdecode_result, bnewtarget);
+
   n_msgs++;
 #ifdef AIS_DEBUG
   if ((n_msgs % 10000) == 0)
@@ -2332,7 +2331,7 @@ AisError AisDecoder::DecodeN0183(const wxString &str) {
            n_msgs, m_n_targets, n_msg1, n_msg5 + n_msg24);
 #endif
 
-  return ret;
+  return AIS_NoError;
 }
 
 void AisDecoder::CommitAISTarget(std::shared_ptr<AisTargetData> pTargetData,
@@ -3784,12 +3783,70 @@ bool AisDecoder::NMEACheckSumOK(const wxString &str_in) {
   return false;
 }
 
+/**
+ * Return radius around ownship outside which no target can raise a CPA
+ * alarm given current options, or -1 if there is no such limit.
+ */
+double AisDecoder::GetCpaCandidateRadius(void) const {
+  double radius = -1.0;
+  if (g_bCPAMax) radius = g_CPAMax_NM;
+  if (g_bTCPA_Max) {
+    //  Farthest target which can come within CPA warning range in time
+    double sog = std::isnan(gSog) ? 0.0 : gSog;
+    double reach = g_CPAWarn_NM + (sog + kMaxAisSog) * g_TCPA_Max / 60.;
+    radius = radius < 0 ? reach : std::min(radius, reach);
+  }
+  return radius < 0 ? radius : radius + kCpaRadiusMarginNm;
+}
+
 void AisDecoder::UpdateAllCPA(void) {
-  //    Iterate thru all the targets
-  for (const auto &it : GetTargetList()) {
-    std::shared_ptr<AisTargetData> td = it.second;
+  auto &targets = GetTargetList();
+  m_cpa_candidates.clear();
+
+  double radius = GetCpaCandidateRadius();
+  if (radius < 0 || m_callbacks.target_list_shown()) {
+    //    No range limit: any target could alarm, iterate thru all of them.
+    //    Same thing if all targets are displayed in a list.
+    for (const auto &it : targets) {
+      std::shared_ptr<AisTargetData> td = it.second;
+
+      if (NULL != td) UpdateOneCPA(td.get());
+    }
+    m_cpa_refresh_queue.clear();
+    return;
+  }
 
-    if (NULL != td) UpdateOneCPA(td.get());
+  //    Targets which could raise an alarm are updated on each tick
+  m_target_grid.Query(gLat, gLon, radius, m_cpa_candidates);
+  for (int mmsi : m_cpa_candidates) {
+    auto it = targets.find(mmsi);
+    if (it != targets.end() && it->second) UpdateOneCPA(it->second.get());
+  }
+
+  //    Target in the query dialog is displayed, keep it current
+  int query_mmsi = m_callbacks.get_query_mmsi();
+  if (query_mmsi) {
+    auto it = targets.find(query_mmsi);
+    if (it != targets.end() && it->second) UpdateOneCPA(it->second.get());
+  }
+
+  //    Update range/bearing and CPA for a slice of the other targets, all
+  //    are refreshed within kCpaMaxAge, also if ticks are late. Updated
+  //    targets have their CPA computed when the report arrives.
+  static const size_t kMaxAgeTicks =
+      kCpaMaxAge / std::chrono::milliseconds(TIMER_AIS_MSEC);
+  auto now = std::chrono::steady_clock::now();
+  if (m_cpa_refresh_queue.empty()) {
+    m_cpa_refresh_queue.reserve(targets.size());
+    for (const auto &it : targets) m_cpa_refresh_queue.push_back(it.first);
+    m_cpa_refresh_deadline = now + kCpaMaxAge;
+  }
+  size_t slice = targets.size() / kMaxAgeTicks + 1;
+  if (now >= m_cpa_refresh_deadline) slice = m_cpa_refresh_queue.size();
+  while (slice-- > 0 && !m_cpa_refresh_queue.empty()) {
+    auto it = targets.find(m_cpa_refresh_queue.back());
+    m_cpa_refresh_queue.pop_back();
+    if (it != targets.end() && it->second) UpdateOneCPA(it->second.get());
   }
 }
 
@@ -3908,121 +3965,154 @@ void AisDecoder::DeletePersistentTrack(Track *track) {
 
 void AisDecoder::UpdateAllAlarms(void) {
   m_bGeneralAlert = false;  // no alerts yet
+  auto &targets = GetTargetList();
 
-  //    Iterate thru all the targets
-  for (const auto &it : GetTargetList()) {
-    std::shared_ptr<AisTargetData> td = it.second;
+  if (GetCpaCandidateRadius() < 0) {
+    //    Iterate thru all the targets
+    for (const auto &it : targets) {
+      std::shared_ptr<AisTargetData> td = it.second;
 
-    if (NULL != td) {
-      //  Maintain General Alert
-      if (!m_bGeneralAlert) {
-        //    Quick check on basic condition
-        if ((td->CPA < g_CPAWarn_NM) && (td->TCPA > 0) &&
-            (td->Class != AIS_ATON) && (td->Class != AIS_BASE))
-          m_bGeneralAlert = true;
-
-        //    Some options can suppress general alerts
-        if (g_bAIS_CPA_Alert_Suppress_Moored && (td->SOG <= g_ShowMoored_Kts))
-          m_bGeneralAlert = false;
-
-        //    Skip distant targets if requested
-        if ((g_bCPAMax) && (td->Range_NM > g_CPAMax_NM))
-          m_bGeneralAlert = false;
-
-        //    Skip if TCPA is too long
-        if ((g_bTCPA_Max) && (td->TCPA > g_TCPA_Max)) m_bGeneralAlert = false;
-
-        //  SART targets always alert if "Active"
-        if (td->Class == AIS_SART && td->NavStatus == 14)
-          m_bGeneralAlert = true;
-
-        //  DSC Distress targets always alert
-        if ((td->Class == AIS_DSC) &&
-            ((td->ShipType == 12) || (td->ShipType == 16)))
-          m_bGeneralAlert = true;
-      }
+      if (NULL != td) UpdateOneAlarm(td.get());
+    }
+    return;
+  }
 
-      ais_alert_type this_alarm = AIS_NO_ALERT;
+  //    Targets outside the candidate radius cannot raise a CPA alarm and
+  //    are left in AIS_NO_ALERT state. Besides the candidates, check the
+  //    ones which are in alarm, in ack timeout or are SART/DSC.
+  std::vector<int> mmsis(m_cpa_candidates);
+  mmsis.insert(mmsis.end(), m_alarm_targets.begin(), m_alarm_targets.end());
+  std::sort(mmsis.begin(), mmsis.end());
+  mmsis.erase(std::unique(mmsis.begin(), mmsis.end()), mmsis.end());
+
+  m_alarm_targets.clear();
+  for (int mmsi : mmsis) {
+    auto it = targets.find(mmsi);
+    if (it == targets.end() || !it->second) continue;
+    AisTargetData *td = it->second.get();
+    UpdateOneAlarm(td);
+    if (td->n_alert_state != AIS_NO_ALERT || td->b_in_ack_timeout ||
+        td->Class == AIS_SART || td->Class == AIS_DSC)
+      m_alarm_targets.insert(mmsi);
+  }
+}
 
-      //  SART targets always alert if "Active"
-      if (td->Class == AIS_SART && td->NavStatus == 14)
-        this_alarm = AIS_ALERT_SET;
+void AisDecoder::UpdateOneAlarm(AisTargetData *td) {
+  //  Maintain General Alert
+  if (!m_bGeneralAlert) {
+    //    Quick check on basic condition
+    if ((td->CPA < g_CPAWarn_NM) && (td->TCPA > 0) &&
+        (td->Class != AIS_ATON) && (td->Class != AIS_BASE))
+      m_bGeneralAlert = true;
+
+    //    Some options can suppress general alerts
+    if (g_bAIS_CPA_Alert_Suppress_Moored && (td->SOG <= g_ShowMoored_Kts))
+      m_bGeneralAlert = false;
+
+    //    Skip distant targets if requested
+    if ((g_bCPAMax) && (td->Range_NM > g_CPAMax_NM))
+      m_bGeneralAlert = false;
+
+    //    Skip if TCPA is too long
+    if ((g_bTCPA_Max) && (td->TCPA > g_TCPA_Max)) m_bGeneralAlert = false;
+
+    //  SART targets always alert if "Active"
+    if (td->Class == AIS_SART && td->NavStatus == 14)
+      m_bGeneralAlert = true;
+
+    //  DSC Distress targets always alert
+    if ((td->Class == AIS_DSC) &&
+        ((td->ShipType == 12) || (td->ShipType == 16)))
+      m_bGeneralAlert = true;
+  }
 
-      //  DSC Distress targets always alert
-      if ((td->Class == AIS_DSC) &&
-          ((td->ShipType == 12) || (td->ShipType == 16)))
-        this_alarm = AIS_ALERT_SET;
+  ais_alert_type this_alarm = AIS_NO_ALERT;
 
-      if (g_bCPAWarn && td->b_active && td->b_positionOnceValid &&
-          (td->Class != AIS_SART) && (td->Class != AIS_DSC)) {
-        //      Skip anchored/moored(interpreted as low speed) targets if
-        //      requested
-        if ((g_bHideMoored) && (td->SOG <= g_ShowMoored_Kts)) {  // dsr
-          td->n_alert_state = AIS_NO_ALERT;
-          continue;
-        }
+  //  SART targets always alert if "Active"
+  if (td->Class == AIS_SART && td->NavStatus == 14)
+    this_alarm = AIS_ALERT_SET;
 
-        //    No Alert on moored(interpreted as low speed) targets if so
-        //    requested
-        if (g_bAIS_CPA_Alert_Suppress_Moored &&
-            (td->SOG <= g_ShowMoored_Kts)) {  // dsr
-          td->n_alert_state = AIS_NO_ALERT;
-          continue;
-        }
+  //  DSC Distress targets always alert
+  if ((td->Class == AIS_DSC) &&
+      ((td->ShipType == 12) || (td->ShipType == 16)))
+    this_alarm = AIS_ALERT_SET;
 
-        //    Skip distant targets if requested
-        if (g_bCPAMax) {
-          if (td->Range_NM > g_CPAMax_NM) {
-            td->n_alert_state = AIS_NO_ALERT;
-            continue;
-          }
-        }
+  if (g_bCPAWarn && td->b_active && td->b_positionOnceValid &&
+      (td->Class != AIS_SART) && (td->Class != AIS_DSC)) {
+    //      Skip anchored/moored(interpreted as low speed) targets if
+    //      requested
+    if ((g_bHideMoored) && (td->SOG <= g_ShowMoored_Kts)) {  // dsr
+      td->n_alert_state = AIS_NO_ALERT;
+      return;
+    }
 
-        if ((td->CPA < g_CPAWarn_NM) && (td->TCPA > 0) &&
-            (td->Class != AIS_ATON) && (td->Class != AIS_BASE) &&
-            (td->Class != AIS_METEO)) {
-          if (g_bTCPA_Max) {
-            if (td->TCPA < g_TCPA_Max) {
-              if (td->b_isFollower)
-                this_alarm = AIS_ALERT_NO_DIALOG_SET;
-              else
-                this_alarm = AIS_ALERT_SET;
-            }
-          } else {
-            if (td->b_isFollower)
-              this_alarm = AIS_ALERT_NO_DIALOG_SET;
-            else
-              this_alarm = AIS_ALERT_SET;
-          }
-        }
-      }
+    //    No Alert on moored(interpreted as low speed) targets if so
+    //    requested
+    if (g_bAIS_CPA_Alert_Suppress_Moored &&
+        (td->SOG <= g_ShowMoored_Kts)) {  // dsr
+      td->n_alert_state = AIS_NO_ALERT;
+      return;
+    }
 
-      //    Maintain the timer for in_ack flag
-      //  SART and DSC targets always maintain ack timeout
+    //    Skip distant targets if requested
+    if (g_bCPAMax) {
+      if (td->Range_NM > g_CPAMax_NM) {
+        td->n_alert_state = AIS_NO_ALERT;
+        return;
+      }
+    }
 
-      if (g_bAIS_ACK_Timeout || (td->Class == AIS_SART) ||
-          ((td->Class == AIS_DSC) &&
-           ((td->ShipType == 12) || (td->ShipType == 16)))) {
-        if (td->b_in_ack_timeout) {
-          wxTimeSpan delta = wxDateTime::Now() - td->m_ack_time;
-          if (delta.GetMinutes() > g_AckTimeout_Mins)
-            td->b_in_ack_timeout = false;
+    if ((td->CPA < g_CPAWarn_NM) && (td->TCPA > 0) &&
+        (td->Class != AIS_ATON) && (td->Class != AIS_BASE) &&
+        (td->Class != AIS_METEO)) {
+      if (g_bTCPA_Max) {
+        if (td->TCPA < g_TCPA_Max) {
+          if (td->b_isFollower)
+            this_alarm = AIS_ALERT_NO_DIALOG_SET;
+          else
+            this_alarm = AIS_ALERT_SET;
         }
       } else {
-        //  Not using ack timeouts.
-        //  If a target has been acknowledged, leave it ack'ed until it goes out
-        //  of AIS_ALARM_SET state
-        if (td->b_in_ack_timeout) {
-          if (this_alarm == AIS_NO_ALERT) td->b_in_ack_timeout = false;
-        }
+        if (td->b_isFollower)
+          this_alarm = AIS_ALERT_NO_DIALOG_SET;
+        else
+          this_alarm = AIS_ALERT_SET;
       }
+    }
+  }
 
-      td->n_alert_state = this_alarm;
+  //    Maintain the timer for in_ack flag
+  //  SART and DSC targets always maintain ack timeout
+
+  if (g_bAIS_ACK_Timeout || (td->Class == AIS_SART) ||
+      ((td->Class == AIS_DSC) &&
+       ((td->ShipType == 12) || (td->ShipType == 16)))) {
+    if (td->b_in_ack_timeout) {
+      wxTimeSpan delta = wxDateTime::Now() - td->m_ack_time;
+      if (delta.GetMinutes() > g_AckTimeout_Mins)
+        td->b_in_ack_timeout = false;
+    }
+  } else {
+    //  Not using ack timeouts.
+    //  If a target has been acknowledged, leave it ack'ed until it goes out
+    //  of AIS_ALARM_SET state
+    if (td->b_in_ack_timeout) {
+      if (this_alarm == AIS_NO_ALERT) td->b_in_ack_timeout = false;
     }
   }
+
+  td->n_alert_state = this_alarm;
 }
 
 void AisDecoder::UpdateOneCPA(AisTargetData *ptarget) {
+  //    Maintain the spatial index used to find alarm candidates
+  if (ptarget->b_positionOnceValid && !ptarget->b_OwnShip)
+    m_target_grid.Update(ptarget->MMSI, ptarget->Lat, ptarget->Lon);
+  else
+    m_target_grid.Remove(ptarget->MMSI);
+  if (ptarget->Class == AIS_SART || ptarget->Class == AIS_DSC)
+    m_alarm_targets.insert(ptarget->MMSI);
+
   ptarget->Range_NM = -1.;  // Defaults
   ptarget->Brg = -1.;
 
@@ -4183,9 +4273,20 @@ void AisDecoder::OnTimerAIS(wxTimerEvent &event) {
   auto it = current_targets.begin();
   std::vector<int> remove_array;  // collector for MMSI of targets to be removed
 
+  //  MMSI properties are checked for each target, look them up just once.
+  //  The first entry for a MMSI is the one which counts.
+  std::unordered_set<int> ignored_mmsis;
+  std::unordered_set<int> seen_mmsis;
+  for (unsigned int i = 0; i < g_MMSI_Props_Array.GetCount(); i++) {
+    MmsiProperties *props = g_MMSI_Props_Array[i];
+    if (seen_mmsis.insert(props->MMSI).second && props->m_bignore)
+      ignored_mmsis.insert(props->MMSI);
+  }
+
   while (it != current_targets.end()) {
     if (it->second == NULL)  // This should never happen, but I saw it once....
     {
+      m_target_grid.Remove(it->first);
       current_targets.erase(it);
       break;  // leave the loop
     }
@@ -4265,6 +4366,7 @@ void AisDecoder::OnTimerAIS(wxTimerEvent &event) {
 
         long mmsi_long = xtd->MMSI;
         pSelectAIS->DeleteSelectablePoint((void *)mmsi_long, SELTYPE_AISTARGET);
+        m_target_grid.Remove(xtd->MMSI);
 
         //      If we have not seen a static report in 3 times the removal spec,
         //      then remove the target from all lists
@@ -4279,16 +4381,10 @@ void AisDecoder::OnTimerAIS(wxTimerEvent &event) {
 
     // Remove any targets specified as to be "ignored", so that they won't
     // trigger phantom alerts (e.g. SARTs)
-    for (unsigned int i = 0; i < g_MMSI_Props_Array.GetCount(); i++) {
-      MmsiProperties *props = g_MMSI_Props_Array[i];
-      if (xtd->MMSI == props->MMSI) {
-        if (props->m_bignore) {
-          remove_array.push_back(xtd->MMSI);  // Add this target to removal list
-          xtd->b_removed = true;
-          plugin_msg.Notify(xtd, "");
-        }
-        break;
-      }
+    if (ignored_mmsis.find(xtd->MMSI) != ignored_mmsis.end()) {
+      remove_array.push_back(xtd->MMSI);  // Add this target to removal list
+      xtd->b_removed = true;
+      plugin_msg.Notify(xtd, "");
     }
 
     // Check if the target has recently been set as own MMSI
@@ -4306,6 +4402,8 @@ void AisDecoder::OnTimerAIS(wxTimerEvent &event) {
     auto itd = current_targets.find(remove_array[i]);
     if (itd != current_targets.end()) {
       std::shared_ptr<AisTargetData> td = itd->second;
+      m_target_grid.Remove(itd->first);
+      m_alarm_targets.erase(itd->first);
       current_targets.erase(itd);
       // delete td;
     }
@@ -0,0 +1,207 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Implement ais_vdx_worker.h
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+#include "model/ais_vdx_worker.h"
+
+using namespace std::chrono_literals;
+
+/** Same limit as AisDecoder::DecodeN0183(). */
+static const size_t kMaxSentenceLen = 128;
+
+/** Max sentences decoded before checking for a ready notification. */
+static const int kBatchSize = 64;
+
+/** Max time before worker checks input even without being notified. */
+static const auto kIdleWait = 100ms;
+
+static int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+AisVdxWorker::AisVdxWorker(std::function<void()> ready, size_t queue_size)
+    : m_ready(std::move(ready)),
+      m_input(queue_size),
+      m_output(queue_size),
+      m_ready_pending(false),
+      m_sentences(0),
+      m_messages(0),
+      m_bad(0),
+      m_idle(false),
+      m_running(true),
+      m_thread([&] { Worker(); }) {}
+
+AisVdxWorker::~AisVdxWorker() { Stop(); }
+
+void AisVdxWorker::Stop() {
+  m_running = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cond_var.notify_all();
+  }
+  if (m_thread.joinable()) m_thread.join();
+}
+
+bool AisVdxWorker::Push(std::string sentence) {
+  m_sentences++;
+  if (!m_input.try_push(std::move(sentence))) return false;
+
+  // Pairs with the fence in Worker(): either the worker sees the new
+  // sentence before going idle, or we see it idle and wake it up.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_idle) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cond_var.notify_one();
+  }
+  return true;
+}
+
+size_t AisVdxWorker::Drain(std::vector<AisVdxMessage>& out) {
+  m_ready_pending = false;
+  return m_output.try_pop_n(out, std::numeric_limits<size_t>::max());
+}
+
+AisVdxStats AisVdxWorker::GetStats() const {
+  return {m_sentences.load(), m_messages.load(), m_bad.load(),
+          m_input.overflows() + m_output.overflows()};
+}
+
+bool AisVdxWorker::ChecksumOk(const std::string& sentence) {
+  auto star = sentence.find('*');
+  if (star == std::string::npos || star + 2 >= sentence.size()) return false;
+  unsigned char checksum = 0;
+  for (size_t i = 1; i < star; i++) {
+    checksum ^= static_cast<unsigned char>(sentence[i]);
+  }
+  int high = HexValue(sentence[star + 1]);
+  int low = HexValue(sentence[star + 2]);
+  if (high < 0 || low < 0) return false;
+  return checksum == high * 16 + low;
+}
+
+void AisVdxWorker::Worker() {
+  std::string sentence;
+  while (m_running) {
+    int count = 0;
+    while (count < kBatchSize && m_input.try_pop(sentence)) {
+      Decode(sentence);
+      count++;
+    }
+    if (!m_output.empty() && !m_ready_pending.exchange(true)) m_ready();
+    if (count == kBatchSize) continue;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_cond_var.wait_for(lock, kIdleWait,
+                        [&] { return !m_running || !m_input.empty(); });
+    m_idle = false;
+  }
+}
+
+void AisVdxWorker::SplitFields(const std::string& sentence) {
+  size_t end = sentence.find('*');
+  if (end == std::string::npos) end = sentence.size();
+  size_t field = 0;
+  size_t start = 0;
+  while (start <= end) {
+    size_t comma = sentence.find(',', start);
+    if (comma == std::string::npos || comma > end) comma = end;
+    if (field == m_fields.size()) m_fields.emplace_back();
+    m_fields[field++].assign(sentence, start, comma - start);
+    start = comma + 1;
+  }
+  m_fields.resize(field);
+}
+
+void AisVdxWorker::Decode(const std::string& sentence) {
+  //  !xxVDx,count,index,sequence id,channel,payload,fill bits*hh
+  if (sentence.size() > kMaxSentenceLen || !ChecksumOk(sentence)) {
+    m_bad++;
+    return;
+  }
+  SplitFields(sentence);
+  if (m_fields.size() < 6 || m_fields[0].size() < 6 ||
+      m_fields[0].compare(3, 2, "VD") != 0) {
+    m_bad++;
+    return;
+  }
+  const int count = std::atoi(m_fields[1].c_str());
+  const int index = std::atoi(m_fields[2].c_str());
+  if (count < 1 || index < 1 || index > count) {
+    m_bad++;
+    return;
+  }
+  const std::string& payload = m_fields[5];
+  if (count == 1) {
+    Deliver(sentence, payload);
+    return;
+  }
+
+  //  Parts of messages on different channels or with different sequence
+  //  ids may be interleaved, assemble each one separately.
+  const int channel = m_fields[4].empty() ? 0 : m_fields[4][0];
+  const int sequence = m_fields[3].empty() ? 0 : m_fields[3][0];
+  const int key = (channel << 8) | sequence;
+  if (index == 1) {
+    m_partials[key] = {count, 2, payload};
+    return;
+  }
+  auto found = m_partials.find(key);
+  if (found == m_partials.end()) {
+    m_bad++;  // Lost the first part(s)
+    return;
+  }
+  Partial& partial = found->second;
+  if (partial.count != count || partial.next != index) {
+    m_partials.erase(found);
+    m_bad++;
+    return;
+  }
+  partial.payload += payload;
+  partial.next++;
+  if (index == count) {
+    Deliver(sentence, partial.payload);
+    m_partials.erase(found);
+  }
+}
+
+void AisVdxWorker::Deliver(const std::string& sentence,
+                           const std::string& payload) {
+  if (payload.empty() || payload.size() >= AIS_MAX_MESSAGE_LEN) {
+    m_bad++;
+    return;
+  }
+  AisVdxMessage msg{sentence, AisBitstring(payload.c_str()), 0, 0};
+  msg.mmsi = msg.bits.GetInt(9, 30);
+  msg.message_id = msg.bits.GetInt(1, 6);
+  if (m_output.try_push(std::move(msg))) m_messages++;
+}
@@ -51,22 +51,6 @@
 #include "model/notification_manager.h"
 
 //  comm event definitions
-wxDEFINE_EVENT(EVT_N2K_129029, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129025, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129026, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_127250, ObservedEvt);
-wxDEFINE_EVENT(EVT_N2K_129540, ObservedEvt);
-
-wxDEFINE_EVENT(EVT_N0183_RMC, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_HDT, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_HDG, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_HDM, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_VTG, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_GSV, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_GGA, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_GLL, ObservedEvt);
-wxDEFINE_EVENT(EVT_N0183_AIVDO, ObservedEvt);
-
 wxDEFINE_EVENT(EVT_DRIVER_CHANGE, wxCommandEvent);
 
 wxDEFINE_EVENT(EVT_SIGNALK, ObservedEvt);
@@ -344,119 +328,27 @@ void CommBridge::InitCommListeners() {
   // Initialize the comm listeners
   auto& msgbus = NavMsgBus::GetInstance();
 
-  // GNSS Position Data PGN  129029
-  //----------------------------------
-  Nmea2000Msg n2k_msg_129029(static_cast<uint64_t>(129029));
-  listener_N2K_129029.Listen(n2k_msg_129029, this, EVT_N2K_129029);
-
-  Bind(EVT_N2K_129029, [&](ObservedEvt ev) {
-    HandleN2K_129029(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // Position rapid   PGN 129025
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129025(static_cast<uint64_t>(129025));
-  listener_N2K_129025.Listen(n2k_msg_129025, this, EVT_N2K_129025);
-  Bind(EVT_N2K_129025, [&](ObservedEvt ev) {
-    HandleN2K_129025(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // COG SOG rapid   PGN 129026
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129026(static_cast<uint64_t>(129026));
-  listener_N2K_129026.Listen(n2k_msg_129026, this, EVT_N2K_129026);
-  Bind(EVT_N2K_129026, [&](ObservedEvt ev) {
-    HandleN2K_129026(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // Heading rapid   PGN 127250
-  //-----------------------------
-  Nmea2000Msg n2k_msg_127250(static_cast<uint64_t>(127250));
-  listener_N2K_127250.Listen(n2k_msg_127250, this, EVT_N2K_127250);
-  Bind(EVT_N2K_127250, [&](ObservedEvt ev) {
-    HandleN2K_127250(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // GNSS Satellites in View   PGN 129540
-  //-----------------------------
-  Nmea2000Msg n2k_msg_129540(static_cast<uint64_t>(129540));
-  listener_N2K_129540.Listen(n2k_msg_129540, this, EVT_N2K_129540);
-  Bind(EVT_N2K_129540, [&](ObservedEvt ev) {
-    HandleN2K_129540(UnpackEvtPointer<Nmea2000Msg>(ev));
-  });
-
-  // NMEA0183
-  // RMC
-  Nmea0183Msg n0183_msg_RMC("RMC");
-  listener_N0183_RMC.Listen(n0183_msg_RMC, this, EVT_N0183_RMC);
-
-  Bind(EVT_N0183_RMC, [&](ObservedEvt ev) {
-    HandleN0183_RMC(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
-
-  // HDT
-  Nmea0183Msg n0183_msg_HDT("HDT");
-  listener_N0183_HDT.Listen(n0183_msg_HDT, this, EVT_N0183_HDT);
-
-  Bind(EVT_N0183_HDT, [&](ObservedEvt ev) {
-    HandleN0183_HDT(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
-
-  // HDG
-  Nmea0183Msg n0183_msg_HDG("HDG");
-  listener_N0183_HDG.Listen(n0183_msg_HDG, this, EVT_N0183_HDG);
-
-  Bind(EVT_N0183_HDG, [&](ObservedEvt ev) {
-    HandleN0183_HDG(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
-
-  // HDM
-  Nmea0183Msg n0183_msg_HDM("HDM");
-  listener_N0183_HDM.Listen(n0183_msg_HDM, this, EVT_N0183_HDM);
-
-  Bind(EVT_N0183_HDM, [&](ObservedEvt ev) {
-    HandleN0183_HDM(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
-
-  // VTG
-  Nmea0183Msg n0183_msg_VTG("VTG");
-  listener_N0183_VTG.Listen(n0183_msg_VTG, this, EVT_N0183_VTG);
-
-  Bind(EVT_N0183_VTG, [&](ObservedEvt ev) {
-    HandleN0183_VTG(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
-
-  // GSV
-  Nmea0183Msg n0183_msg_GSV("GSV");
-  listener_N0183_GSV.Listen(n0183_msg_GSV, this, EVT_N0183_GSV);
-
-  Bind(EVT_N0183_GSV, [&](ObservedEvt ev) {
-    HandleN0183_GSV(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
-
-  // GGA
-  Nmea0183Msg n0183_msg_GGA("GGA");
-  listener_N0183_GGA.Listen(n0183_msg_GGA, this, EVT_N0183_GGA);
-
-  Bind(EVT_N0183_GGA, [&](ObservedEvt ev) {
-    HandleN0183_GGA(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
-
-  // GLL
-  Nmea0183Msg n0183_msg_GLL("GLL");
-  listener_N0183_GLL.Listen(n0183_msg_GLL, this, EVT_N0183_GLL);
-
-  Bind(EVT_N0183_GLL, [&](ObservedEvt ev) {
-    HandleN0183_GLL(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
-
-  // AIVDO
-  Nmea0183Msg n0183_msg_AIVDO("AIVDO");
-  listener_N0183_AIVDO.Listen(n0183_msg_AIVDO, this, EVT_N0183_AIVDO);
-
-  Bind(EVT_N0183_AIVDO, [&](ObservedEvt ev) {
-    HandleN0183_AIVDO(UnpackEvtPointer<Nmea0183Msg>(ev));
-  });
+  // NMEA2000 PGNs, delivered in arrival order as one batch per main loop
+  // turn:
+  //   129029  GNSS position data
+  //   129025  Position rapid
+  //   129026  COG SOG rapid
+  //   127250  Heading rapid
+  //   129540  GNSS satellites in view
+  listener_N2K.Init(Nmea2000Msg(static_cast<uint64_t>(129029)),
+                    [&](std::vector<ObservedItem>& batch) {
+                      for (auto& item : batch) HandleN2KBatchItem(item);
+                    });
+  for (uint64_t pgn : {129025, 129026, 127250, 129540})
+    listener_N2K.Listen(Nmea2000Msg(pgn));
+
+  // NMEA0183, as above.
+  listener_N0183.Init(Nmea0183Msg("RMC"),
+                      [&](std::vector<ObservedItem>& batch) {
+                        for (auto& item : batch) HandleN0183BatchItem(item);
+                      });
+  for (auto id : {"HDT", "HDG", "HDM", "VTG", "GSV", "GGA", "GLL", "AIVDO"})
+    listener_N0183.Listen(Nmea0183Msg(id));
 
   // SignalK
   SignalkMsg sk_msg;
@@ -467,6 +359,50 @@ void CommBridge::InitCommListeners() {
   });
 }
 
+void CommBridge::HandleN2KBatchItem(const ObservedItem& item) {
+  auto msg = std::static_pointer_cast<const Nmea2000Msg>(item.ptr);
+  switch (msg->PGN.pgn) {
+    case 129029:
+      HandleN2K_129029(msg);
+      break;
+    case 129025:
+      HandleN2K_129025(msg);
+      break;
+    case 129026:
+      HandleN2K_129026(msg);
+      break;
+    case 127250:
+      HandleN2K_127250(msg);
+      break;
+    case 129540:
+      HandleN2K_129540(msg);
+      break;
+  }
+}
+
+void CommBridge::HandleN0183BatchItem(const ObservedItem& item) {
+  auto msg = std::static_pointer_cast<const Nmea0183Msg>(item.ptr);
+  const std::string& type = msg->type;
+  if (type == "RMC")
+    HandleN0183_RMC(msg);
+  else if (type == "HDT")
+    HandleN0183_HDT(msg);
+  else if (type == "HDG")
+    HandleN0183_HDG(msg);
+  else if (type == "HDM")
+    HandleN0183_HDM(msg);
+  else if (type == "VTG")
+    HandleN0183_VTG(msg);
+  else if (type == "GSV")
+    HandleN0183_GSV(msg);
+  else if (type == "GGA")
+    HandleN0183_GGA(msg);
+  else if (type == "GLL")
+    HandleN0183_GLL(msg);
+  else if (type == "VDO")
+    HandleN0183_AIVDO(msg);
+}
+
 void CommBridge::OnDriverStateChange() {
   // Reset all active priority states
   PresetPriorityContainers();
@@ -734,7 +670,7 @@ bool CommBridge::HandleN2K_129540(std::shared_ptr<const Nmea2000Msg> n2k_msg) {
 }
 
 bool CommBridge::HandleN0183_RMC(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
 
   NavData temp_data;
   ClearNavData(temp_data);
@@ -784,7 +720,7 @@ bool CommBridge::HandleN0183_RMC(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_HDT(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -802,7 +738,7 @@ bool CommBridge::HandleN0183_HDT(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_HDG(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -833,7 +769,7 @@ bool CommBridge::HandleN0183_HDG(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_HDM(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -852,7 +788,7 @@ bool CommBridge::HandleN0183_HDM(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_VTG(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -873,7 +809,7 @@ bool CommBridge::HandleN0183_VTG(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_GSV(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -895,7 +831,7 @@ bool CommBridge::HandleN0183_GSV(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_GGA(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -934,7 +870,7 @@ bool CommBridge::HandleN0183_GGA(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_GLL(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -962,7 +898,7 @@ bool CommBridge::HandleN0183_GLL(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
 
 bool CommBridge::HandleN0183_AIVDO(
     std::shared_ptr<const Nmea0183Msg> n0183_msg) {
-  std::string str = n0183_msg->payload;
+  const std::string& str = n0183_msg->payload;
 
   GenericPosDatEx gpd;
   wxString sentence(str.c_str());
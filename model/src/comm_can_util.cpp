@@ -24,6 +24,7 @@
  **************************************************************************/
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
 
 #include "model/comm_can_util.h"
@@ -43,17 +44,14 @@ typedef struct can_frame CanFrame;
 
 bool IsFastMessagePGN(unsigned pgn) {
   static const std::vector<unsigned> haystack = {
-      // All known multiframe fast messages
+      // All known multiframe fast messages, sorted
       65240u,  126208u, 126464u, 126996u, 126998u, 127233u, 127237u, 127489u,
       127496u, 127506u, 128275u, 129029u, 129038u, 129039u, 129040u, 129041u,
       129284u, 129285u, 129540u, 129793u, 129794u, 129795u, 129797u, 129798u,
       129801u, 129802u, 129808u, 129809u, 129810u, 130065u, 130074u, 130323u,
       130577u, 130820u, 130822u, 130824u};
 
-  unsigned needle = static_cast<unsigned>(pgn);
-  auto found = std::find_if(haystack.begin(), haystack.end(),
-                            [needle](unsigned i) { return i == needle; });
-  return found != haystack.end();
+  return std::binary_search(haystack.begin(), haystack.end(), pgn);
 }
 
 unsigned long BuildCanID(int priority, int source, int destination, int pgn) {
@@ -103,56 +101,81 @@ bool CanHeader::IsFastMessage() const {
 #endif
 }
 
+std::vector<unsigned char> MakeN2kDriverMsg(const CanHeader& header,
+                                            const unsigned char* data,
+                                            unsigned length) {
+  std::vector<unsigned char> msg(13 + length + 1);
+  msg[0] = 0x93;
+  msg[1] = length + 11;
+  msg[2] = header.priority;
+  msg[3] = header.pgn & 0xFF;
+  msg[4] = (header.pgn >> 8) & 0xFF;
+  msg[5] = (header.pgn >> 16) & 0xFF;
+  msg[6] = header.destination;
+  msg[7] = header.source;
+  msg[8] = 0xFF;  // FIXME (dave) Could generate the time fields
+  msg[9] = 0xFF;
+  msg[10] = 0xFF;
+  msg[11] = 0xFF;
+  msg[12] = length;
+  memcpy(&msg[13], data, length);
+  msg[13 + length] = 0x55;  // CRC dummy, not checked
+  return msg;
+}
+
 //  FastMessage implementation
 
+static const uint64_t kNoKey = UINT64_MAX;
+
+uint64_t FastMessageMap::Key(const CanHeader& header, unsigned char sid) {
+  return static_cast<uint64_t>(header.pgn) << 24 | header.source << 16 |
+         header.destination << 8 | (sid & 0xE0);
+}
+
 bool FastMessageMap::IsEntryExpired(unsigned int i) {
-  return (wxDateTime::Now() - entries[i].time_arrived >
-          wxTimeSpan(0, 0, kEntryMaxAgeSecs));
+  return std::chrono::steady_clock::now() - entries[i].time_arrived >
+         std::chrono::seconds(kEntryMaxAgeSecs);
 }
 
 void FastMessageMap::CheckGc() {
+  auto now = std::chrono::steady_clock::now();
   bool last_run_over_age =
-      (wxDateTime::Now() - last_gc_run) > wxTimeSpan(0, 0, kGcIntervalSecs);
-  if (last_run_over_age || entries.size() > kGcThreshold) {
+      now - last_gc_run > std::chrono::seconds(kGcIntervalSecs);
+  if (last_run_over_age || GetCount() > static_cast<size_t>(kGcThreshold)) {
     GarbageCollector();
-    last_gc_run = wxDateTime::Now();
+    last_gc_run = now;
   }
 }
 
 int FastMessageMap::FindMatchingEntry(const CanHeader header,
                                       const unsigned char sid) {
-  for (unsigned i = 0; i < entries.size(); i++) {
-    if (((sid & 0xE0) == (entries[i].sid & 0xE0)) &&
-        (entries[i].header.pgn == header.pgn) &&
-        (entries[i].header.source == header.source) &&
-        (entries[i].header.destination == header.destination)) {
-      return i;
-    }
-  }
-  return kNotFound;
+  auto found = m_index.find(Key(header, sid));
+  return found == m_index.end() ? kNotFound : found->second;
 }
 
 int FastMessageMap::AddNewEntry(void) {
-  entries.push_back(Entry());
-  return entries.size() - 1;
+  if (m_free.empty()) {
+    entries.emplace_back();
+    entries.back().time_arrived = std::chrono::steady_clock::now();
+    m_used.push_back(true);
+    m_keys.push_back(kNoKey);
+    return entries.size() - 1;
+  }
+  int index = m_free.back();
+  m_free.pop_back();
+  m_used[index] = true;
+  entries[index].time_arrived = std::chrono::steady_clock::now();
+  return index;
 }
 
 int FastMessageMap::GarbageCollector(void) {
-  std::vector<unsigned> stale_entries;
-  bool bremoved;
   int nremoved = 0;
-  do {
-    bremoved = false;
-    for (unsigned i = 0; i < entries.size(); i++) {
-      if (IsEntryExpired(i)) {
-        Remove(i);
-        nremoved++;
-        bremoved = true;
-        break;
-      }
+  for (unsigned i = 0; i < entries.size(); i++) {
+    if (m_used[i] && IsEntryExpired(i)) {
+      Remove(i);
+      nremoved++;
     }
-  } while (bremoved);
-
+  }
   return nremoved;
 }
 
@@ -163,53 +186,57 @@ bool FastMessageMap::InsertEntry(const CanHeader header,
   // data[1] Length of data bytes
   // data[2..7] 6 data bytes
 
+  entries[index].time_arrived = std::chrono::steady_clock::now();
   CheckGc();
   // Ensure that this is indeed the first frame of a fast message
   if ((data[0] & 0x1F) == 0) {
-    int total_data_len;  // will also include padding as we memcpy all of the
-                         // frame, because I'm lazy
-    total_data_len = static_cast<unsigned int>(data[1]);
-    total_data_len += 7 - ((total_data_len - 6) % 7);
-
-    entries[index].sid = static_cast<unsigned int>(data[0]);
-    entries[index].expected_length = static_cast<unsigned int>(data[1]);
-    entries[index].header = header;
-    entries[index].time_arrived = wxDateTime::Now();
-
-    entries[index].data.resize(total_data_len);
-    memcpy(&entries[index].data[0], &data[2], 6);
+    Entry& entry = entries[index];
+    entry.sid = static_cast<unsigned int>(data[0]);
+    entry.expected_length = static_cast<unsigned int>(data[1]);
+    entry.header = header;
+
+    // Padding is copied as well, the slot is large enough for it.
+    memcpy(&entry.data[0], &data[2], 6);
     // First frame of a multi-frame Fast Message contains six data bytes.
     // Position the cursor ready for next message
-    entries[index].cursor = 6;
+    entry.cursor = 6;
+
+    const uint64_t key = Key(header, data[0]);
+    if (m_keys[index] != key) {
+      if (m_keys[index] != kNoKey) m_index.erase(m_keys[index]);
+      auto old = m_index.find(key);
+      if (old != m_index.end() && old->second != index) Remove(old->second);
+      m_index[key] = index;
+      m_keys[index] = key;
+    }
 
     // Fusion, using fast messages to sends frames less than eight bytes
-    return entries[index].expected_length <= 6;
+    return entry.expected_length <= 6;
   }
-  return false;
   // No further processing is performed if this is not a start frame.
   // A start frame may have been dropped and we received a subsequent frame
+  Remove(index);
+  return false;
 }
 
 bool FastMessageMap::AppendEntry(const CanHeader header,
                                  const unsigned char* data, int position) {
+  Entry& entry = entries[position];
   // Check that this is the next message in the sequence
-  if ((entries[position].sid + 1) == data[0]) {
-    memcpy(&entries[position].data[entries[position].cursor], &data[1], 7);
-    entries[position].sid = data[0];
+  if ((entry.sid + 1) == data[0]) {
+    memcpy(&entry.data[entry.cursor], &data[1], 7);
+    entry.sid = data[0];
+    entry.time_arrived = std::chrono::steady_clock::now();
     // Subsequent messages contains seven data bytes (last message may be padded
     // with 0xFF)
-    entries[position].cursor += 7;
+    entry.cursor += 7;
     // Is this the last message ?
-    return entries[position].cursor >= entries[position].expected_length;
+    return entry.cursor >= entry.expected_length;
   } else if ((data[0] & 0x1F) == 0) {
     // We've found a matching entry, however this is a start frame, therefore
     // we've missed an end frame, and now we have a start frame with the same id
-    // (top 3 bits). The id has obviously rolled over. Should really double
-    // check that (data[0] & 0xE0) Clear the entry as we don't want to leak
-    // memory, prior to inserting a start frame
-    entries.erase(entries.begin() + position);
-    position = AddNewEntry();
-    // And now insert it
+    // (top 3 bits). The id has obviously rolled over. Restart the entry with
+    // the start frame.
     InsertEntry(header, data, position);
     // FIXME (dave) Should update the dropped frame stats
     return false;
@@ -217,10 +244,10 @@ bool FastMessageMap::AppendEntry(const CanHeader header,
     // This is not the next frame in the sequence and not a start frame
     // We've dropped an intermedite frame, so free the slot and do no further
     // processing
-    entries.erase(entries.begin() + position);
+    Remove(position);
     // Dropped Frame Statistics
     if (dropped_frames == 0) {
-      dropped_frame_time = wxDateTime::Now();
+      dropped_frame_time = std::chrono::steady_clock::now();
       dropped_frames += 1;
     } else {
       dropped_frames += 1;
@@ -239,6 +266,11 @@ bool FastMessageMap::AppendEntry(const CanHeader header,
 }
 
 void FastMessageMap::Remove(int pos) {
-  if ((unsigned int)(pos + 1) <= entries.size())
-    entries.erase(entries.begin() + pos);
+  if (pos < 0 || static_cast<size_t>(pos) >= entries.size() || !m_used[pos]) {
+    return;
+  }
+  if (m_keys[pos] != kNoKey) m_index.erase(m_keys[pos]);
+  m_keys[pos] = kNoKey;
+  m_used[pos] = false;
+  m_free.push_back(pos);
 }
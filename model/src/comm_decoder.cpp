@@ -70,13 +70,14 @@ bool CommDecoder::ParsePosition(const LATLONG& Position, double& lat,
   return ll_valid;
 }
 
-bool CommDecoder::DecodeRMC(std::string s, NavData& temp_data) {
+bool CommDecoder::ParseN0183(const std::string& s) {
   wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
+  m_NMEA0183 << ProcessNMEA4Tags(sentence);
+  return m_NMEA0183.Parse();  // Includes PreParse()
+}
 
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeRMC(const std::string& s, NavData& temp_data) {
+  if (!ParseN0183(s)) return false;
 
   if (m_NMEA0183.Rmc.IsDataValid == NTrue) {
     double tlat, tlon;
@@ -118,39 +119,24 @@ bool CommDecoder::DecodeRMC(std::string s, NavData& temp_data) {
   return true;
 }
 
-bool CommDecoder::DecodeHDM(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeHDM(const std::string& s, NavData& temp_data) {
+  if (!ParseN0183(s)) return false;
 
   temp_data.gHdm = m_NMEA0183.Hdm.DegreesMagnetic;
 
   return true;
 }
 
-bool CommDecoder::DecodeHDT(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeHDT(const std::string& s, NavData& temp_data) {
+  if (!ParseN0183(s)) return false;
 
   temp_data.gHdt = m_NMEA0183.Hdt.DegreesTrue;
 
   return true;
 }
 
-bool CommDecoder::DecodeHDG(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeHDG(const std::string& s, NavData& temp_data) {
+  if (!ParseN0183(s)) return false;
 
   temp_data.gHdm = m_NMEA0183.Hdg.MagneticSensorHeadingDegrees;
 
@@ -170,13 +156,8 @@ bool CommDecoder::DecodeHDG(std::string s, NavData& temp_data) {
   return true;
 }
 
-bool CommDecoder::DecodeVTG(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeVTG(const std::string& s, NavData& temp_data) {
+  if (!ParseN0183(s)) return false;
 
   // FIXME (dave)if (g_own_ship_sog_cog_calc) return false;
 
@@ -207,13 +188,8 @@ bool CommDecoder::DecodeVTG(std::string s, NavData& temp_data) {
   return true;
 }
 
-bool CommDecoder::DecodeGLL(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeGLL(const std::string& s, NavData& temp_data) {
+  if (!ParseN0183(s)) return false;
 
   if (m_NMEA0183.Gll.IsDataValid == NTrue) {
     double tlat, tlon;
@@ -228,13 +204,8 @@ bool CommDecoder::DecodeGLL(std::string s, NavData& temp_data) {
   return true;
 }
 
-bool CommDecoder::DecodeGSV(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeGSV(const std::string& s, NavData& temp_data) {
+  if (!ParseN0183(s)) return false;
 
   if (m_NMEA0183.Gsv.MessageNumber == 1)
     temp_data.n_satellites = m_NMEA0183.Gsv.SatsInView;
@@ -242,13 +213,8 @@ bool CommDecoder::DecodeGSV(std::string s, NavData& temp_data) {
   return true;
 }
 
-bool CommDecoder::DecodeGGA(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeGGA(const std::string& s, NavData& temp_data) {
+  if (!ParseN0183(s)) return false;
 
   if (m_NMEA0183.Gga.GPSQuality > 0) {
     double tlat, tlon;
@@ -376,7 +342,7 @@ bool CommDecoder::DecodePGN129540(std::vector<unsigned char> v,
   return false;
 }
 
-bool CommDecoder::DecodeSignalK(std::string s, NavData& temp_data) {
+bool CommDecoder::DecodeSignalK(const std::string& s, NavData& temp_data) {
   rapidjson::Document root;
 
   root.Parse(s);
@@ -159,9 +159,10 @@ void CommDriverN0183Net::HandleN0183Msg(const std::string& sentence) {
 
     // notify message listener and also "ALL" N0183 messages, to support plugin
     // API using original talker id
-    auto msg =
-        std::make_shared<const Nmea0183Msg>(identifier, sentence, GetAddress());
-    auto msg_all = std::make_shared<const Nmea0183Msg>(*msg, "ALL");
+    auto msg = std::make_shared<const Nmea0183Msg>(
+        m_key_cache.N0183(identifier), identifier, sentence, GetAddress());
+    auto msg_all = std::make_shared<const Nmea0183Msg>(m_key_cache.N0183All(),
+                                                       *msg, "ALL");
 
     if (m_params.SentencePassesFilter(sentence, FILTER_INPUT))
       m_listener.Notify(std::move(msg));
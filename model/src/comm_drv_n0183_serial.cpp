@@ -172,9 +172,10 @@ void CommDriverN0183Serial::SendMessage(const std::vector<unsigned char>& msg) {
   // notify msg listener and also "ALL" N0183 messages, to support plugin
   // API using original talker id
   std::string payload(msg.begin(), msg.end());
-  auto message =
-      std::make_shared<const Nmea0183Msg>(identifier, payload, GetAddress());
-  auto message_all = std::make_shared<const Nmea0183Msg>(*message, "ALL");
+  auto message = std::make_shared<const Nmea0183Msg>(
+      m_key_cache.N0183(identifier), identifier, payload, GetAddress());
+  auto message_all = std::make_shared<const Nmea0183Msg>(
+      m_key_cache.N0183All(), *message, "ALL");
 
   if (m_params.SentencePassesFilter(payload, FILTER_INPUT))
     m_listener.Notify(std::move(message));
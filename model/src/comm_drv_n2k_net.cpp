@@ -86,54 +86,6 @@ class MrqContainer {
   }
 };
 
-// circular_buffer implementation
-
-circular_buffer::circular_buffer(size_t size)
-    : buf_(std::unique_ptr<unsigned char[]>(new unsigned char[size])),
-      max_size_(size) {}
-
-// void circular_buffer::reset()
-//{}
-
-// size_t circular_buffer::capacity() const
-//{}
-
-// size_t circular_buffer::size() const
-//{}
-
-bool circular_buffer::empty() const {
-  // if head and tail are equal, we are empty
-  return (!full_ && (head_ == tail_));
-}
-
-bool circular_buffer::full() const {
-  // If tail is ahead the head by 1, we are full
-  return full_;
-}
-
-void circular_buffer::put(unsigned char item) {
-  std::lock_guard<std::mutex> lock(mutex_);
-  buf_[head_] = item;
-  if (full_) tail_ = (tail_ + 1) % max_size_;
-
-  head_ = (head_ + 1) % max_size_;
-
-  full_ = head_ == tail_;
-}
-
-unsigned char circular_buffer::get() {
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  if (empty()) return 0;
-
-  // Read data and advance the tail (we now have a free space)
-  auto val = buf_[tail_];
-  full_ = false;
-  tail_ = (tail_ + 1) % max_size_;
-
-  return val;
-}
-
 /// CAN v2.0 29 bit header as used by NMEA 2000
 CanHeader::CanHeader()
     : priority('\0'), source('\0'), destination('\0'), pgn(-1) {};
@@ -233,7 +185,7 @@ CommDriverN2KNet::CommDriverN2KNet(const ConnectionParams* params,
   m_bGotESC = false;
   m_bGotSOT = false;
   rx_buffer = new unsigned char[RX_BUFFER_SIZE_NET + 1];
-  m_circle = new circular_buffer(RX_BUFFER_SIZE_NET);
+  m_circle = new SpscRingBuffer<unsigned char>(RX_BUFFER_SIZE_NET);
 
   fast_messages = new FastMessageMap();
   m_order = 0;  // initialize the fast message order bits, for TX
@@ -325,11 +277,12 @@ void CommDriverN2KNet::handle_N2K_MSG(CommDriverN2KNetEvent& event) {
   // printf("          %ld\n", pgn);
 
   auto name = PayloadToName(*payload);
-  auto msg =
-      std::make_shared<const Nmea2000Msg>(pgn, *payload, GetAddress(name));
-  auto msg_all =
-      std::make_shared<const Nmea2000Msg>(1, *payload, GetAddress(name));
   m_driver_stats.rx_count += payload->size();
+  auto msg_all = std::make_shared<const Nmea2000Msg>(
+      m_key_cache.N2000(1), 1, *payload, GetAddress(name));
+  // The event is not used after this, its payload is moved to the message.
+  auto msg = std::make_shared<const Nmea2000Msg>(
+      m_key_cache.N2000(pgn), pgn, std::move(*payload), GetAddress(name));
   m_listener.Notify(std::move(msg));
   m_listener.Notify(std::move(msg_all));
 }
@@ -529,44 +482,14 @@ std::vector<unsigned char> CommDriverN2KNet::PrepareLogPayload(
 
 std::vector<unsigned char> CommDriverN2KNet::PushCompleteMsg(
     const CanHeader header, int position, const can_frame frame) {
-  std::vector<unsigned char> data;
-  data.push_back(0x93);
-  data.push_back(0x13);
-  data.push_back(header.priority);
-  data.push_back(header.pgn & 0xFF);
-  data.push_back((header.pgn >> 8) & 0xFF);
-  data.push_back((header.pgn >> 16) & 0xFF);
-  data.push_back(header.destination);
-  data.push_back(header.source);
-  data.push_back(0xFF);  // FIXME (dave) generate the time fields
-  data.push_back(0xFF);
-  data.push_back(0xFF);
-  data.push_back(0xFF);
-  data.push_back(CAN_MAX_DLEN);  // nominally 8
-  for (size_t n = 0; n < CAN_MAX_DLEN; n++) data.push_back(frame.data[n]);
-  data.push_back(0x55);  // CRC dummy, not checked
-  return data;
+  return MakeN2kDriverMsg(header, frame.data, CAN_MAX_DLEN);  // nominally 8
 }
 
 std::vector<unsigned char> CommDriverN2KNet::PushFastMsgFragment(
     const CanHeader& header, int position) {
-  std::vector<unsigned char> data;
-  data.push_back(0x93);
-  data.push_back(fast_messages->entries[position].expected_length + 11);
-  data.push_back(header.priority);
-  data.push_back(header.pgn & 0xFF);
-  data.push_back((header.pgn >> 8) & 0xFF);
-  data.push_back((header.pgn >> 16) & 0xFF);
-  data.push_back(header.destination);
-  data.push_back(header.source);
-  data.push_back(0xFF);  // FIXME (dave) Could generate the time fields
-  data.push_back(0xFF);
-  data.push_back(0xFF);
-  data.push_back(0xFF);
-  data.push_back(fast_messages->entries[position].expected_length);
-  for (size_t n = 0; n < fast_messages->entries[position].expected_length; n++)
-    data.push_back(fast_messages->entries[position].data[n]);
-  data.push_back(0x55);  // CRC dummy
+  const auto& entry = (*fast_messages)[position];
+  auto data =
+      MakeN2kDriverMsg(header, entry.data.data(), entry.expected_length);
   fast_messages->Remove(position);
   return data;
 }
@@ -616,7 +539,7 @@ void CommDriverN2KNet::HandleCanFrameInput(can_frame frame) {
 
     // Message is ready
     CommDriverN2KNetEvent Nevent(wxEVT_COMMDRIVER_N2K_NET, 0);
-    auto payload = std::make_shared<std::vector<uint8_t>>(vec);
+    auto payload = std::make_shared<std::vector<uint8_t>>(std::move(vec));
     Nevent.SetPayload(payload);
     AddPendingEvent(Nevent);
   }
@@ -667,9 +590,8 @@ bool CommDriverN2KNet::ProcessActisense_N2K(std::vector<unsigned char> packet) {
   bool bGotESC = false;
   bool bGotSOT = false;
 
-  while (!m_circle->empty()) {
-    uint8_t next_byte = m_circle->get();
-
+  uint8_t next_byte;
+  while (m_circle->try_pop(next_byte)) {
     if (bInMsg) {
       if (bGotESC) {
         if (next_byte == ESCAPE) {
@@ -781,9 +703,8 @@ bool CommDriverN2KNet::ProcessActisense_RAW(std::vector<unsigned char> packet) {
   bool bGotESC = false;
   bool bGotSOT = false;
 
-  while (!m_circle->empty()) {
-    uint8_t next_byte = m_circle->get();
-
+  uint8_t next_byte;
+  while (m_circle->try_pop(next_byte)) {
     if (bInMsg) {
       if (bGotESC) {
         if (next_byte == ESCAPE) {
@@ -856,9 +777,8 @@ bool CommDriverN2KNet::ProcessActisense_NGT(std::vector<unsigned char> packet) {
   bool bGotESC = false;
   bool bGotSOT = false;
 
-  while (!m_circle->empty()) {
-    uint8_t next_byte = m_circle->get();
-
+  uint8_t next_byte;
+  while (m_circle->try_pop(next_byte)) {
     if (bInMsg) {
       if (bGotESC) {
         if (next_byte == ESCAPE) {
@@ -917,8 +837,8 @@ bool CommDriverN2KNet::ProcessActisense_ASCII_RAW(
     std::vector<unsigned char> packet) {
   can_frame frame;
 
-  while (!m_circle->empty()) {
-    char b = m_circle->get();
+  unsigned char b;
+  while (m_circle->try_pop(b)) {
     if ((b != 0x0a) && (b != 0x0d)) {
       m_sentence += b;
     }
@@ -967,8 +887,8 @@ bool CommDriverN2KNet::ProcessActisense_ASCII_N2K(
   // A001001.732 04FF6 1FA03 C8FBA80329026400
   std::string sentence;
 
-  while (!m_circle->empty()) {
-    char b = m_circle->get();
+  unsigned char b;
+  while (m_circle->try_pop(b)) {
     if ((b != 0x0a) && (b != 0x0d)) {
       sentence += b;
     }
@@ -1038,8 +958,8 @@ bool CommDriverN2KNet::ProcessActisense_ASCII_N2K(
 }
 
 bool CommDriverN2KNet::ProcessSeaSmart(std::vector<unsigned char> packet) {
-  while (!m_circle->empty()) {
-    char b = m_circle->get();
+  unsigned char b;
+  while (m_circle->try_pop(b)) {
     if ((b != 0x0a) && (b != 0x0d)) {
       m_sentence += b;
     }
@@ -1203,8 +1123,8 @@ bool CommDriverN2KNet::ProcessMiniPlex(std::vector<unsigned char> packet) {
   $MXPGN,01F200,2816,FFFF7FFFFF43F800*10\r\n
   $MXPGN,01F205,2816,FF050D3A1D4CFC00*19\r\n"
   */
-  while (!m_circle->empty()) {
-    char b = m_circle->get();
+  unsigned char b;
+  while (m_circle->try_pop(b)) {
     if ((b != 0x0a) && (b != 0x0d)) {
       m_sentence += b;
     }
@@ -1303,9 +1223,12 @@ void CommDriverN2KNet::OnSocketEvent(wxSocketEvent& event) {
 
       bool done = false;
       if (newdata > 0) {
-        for (int i = 0; i < newdata; i++) {
-          m_circle->put(data[i]);
-          // printf("%c", data.at(i));
+        // Socket events and parsing both run here, so old data can be
+        // overwritten. A sentence which lost its start is discarded.
+        if (m_circle->push_n_overwrite(&data.front(), newdata) > 0) {
+          m_sentence.clear();
+          m_bInMsg = m_bGotESC = m_bGotSOT = false;
+          m_ib = 0;
         }
       }
 
@@ -32,7 +32,6 @@
 
 #include <vector>
 #include <mutex>  // std::mutex
-#include <queue>  // std::queue
 
 #include <wx/log.h>
 
@@ -41,6 +40,7 @@
 #include "model/comm_drv_registry.h"
 #include "model/logger.h"
 #include "model/comm_drv_stats.h"
+#include "model/ring_buffer.h"
 
 #include <N2kMsg.h>
 
@@ -59,39 +59,6 @@ static unsigned char NGT_STARTUP_SEQ[] = {
 
 std::vector<unsigned char> BufferToActisenseFormat(tN2kMsg& msg);
 
-template <typename T>
-class n2k_atomic_queue {
-public:
-  size_t size() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_queque.size();
-  }
-
-  bool empty() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_queque.empty();
-  }
-
-  const T& front() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_queque.front();
-  }
-
-  void push(const T& value) {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_queque.push(value);
-  }
-
-  void pop() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_queque.pop();
-  }
-
-private:
-  std::queue<T> m_queque;
-  mutable std::mutex m_mutex;
-};
-
 template <class T>
 class circular_buffer {
 public:
@@ -181,7 +148,7 @@ class CommDriverN2KSerialThread : public wxThread {
   int m_baud;
   int m_n_timeout;
 
-  n2k_atomic_queue<std::vector<unsigned char>> out_que;
+  MpscRingBuffer<std::vector<unsigned char>> out_que;
   DriverStats m_driver_stats;
   mutable std::mutex m_stats_mutex;
 #ifdef __WXMSW__
@@ -481,10 +448,10 @@ void CommDriverN2KSerial::handle_N2K_SERIAL_RAW(
   // printf("          %ld\n", pgn);
 
   auto name = PayloadToName(*payload);
-  auto msg =
-      std::make_shared<const Nmea2000Msg>(pgn, *payload, GetAddress(name));
-  auto msg_all =
-      std::make_shared<const Nmea2000Msg>(1, *payload, GetAddress(name));
+  auto msg = std::make_shared<const Nmea2000Msg>(
+      m_key_cache.N2000(pgn), pgn, *payload, GetAddress(name));
+  auto msg_all = std::make_shared<const Nmea2000Msg>(
+      m_key_cache.N2000(1), 1, *payload, GetAddress(name));
 
   m_listener.Notify(std::move(msg));
   m_listener.Notify(std::move(msg_all));
@@ -670,7 +637,8 @@ void CommDriverN2KSerial::AddTxPGN(int pgn) {
 
 CommDriverN2KSerialThread::CommDriverN2KSerialThread(
     CommDriverN2KSerial* Launcher, const wxString& PortName,
-    const wxString& strBaudRate) {
+    const wxString& strBaudRate)
+    : out_que(OUT_QUEUE_LENGTH) {
   m_pParentDriver = Launcher;  // This thread's immediate "parent"
 
   m_PortName = PortName;
@@ -770,11 +738,7 @@ size_t CommDriverN2KSerialThread::WriteComPortPhysical(unsigned char* msg,
 
 bool CommDriverN2KSerialThread::SetOutMsg(
     const std::vector<unsigned char>& msg) {
-  if (out_que.size() < OUT_QUEUE_LENGTH) {
-    out_que.push(msg);
-    return true;
-  }
-  return false;
+  return out_que.try_push(msg);
 }
 
 #ifndef __WXMSW__
@@ -929,13 +893,8 @@ void* CommDriverN2KSerialThread::Entry() {
 
     //      Check for any pending output message
 #if 1
-    bool b_qdata = !out_que.empty();
-
-    while (b_qdata) {
-      //  Take a copy of message
-      std::vector<unsigned char> qmsg = out_que.front();
-      out_que.pop();
-
+    std::vector<unsigned char> qmsg;
+    while (out_que.try_pop(qmsg)) {
       if (static_cast<size_t>(-1) == WriteComPortPhysical(qmsg) &&
           10 < retries++) {
         // We failed to write the port 10 times, let's close the port so that
@@ -943,9 +902,7 @@ void* CommDriverN2KSerialThread::Entry() {
         retries = 0;
         CloseComPortPhysical();
       }
-
-      b_qdata = !out_que.empty();
-    }  // while b_qdata
+    }
 
 #endif
   }  // while ((not_done)
@@ -1109,13 +1066,8 @@ void* CommDriverN2KSerialThread::Entry() {
     }  // while
 
     //      Check for any pending output message
-    bool b_qdata = !out_que.empty();
-
-    while (b_qdata) {
-      //  Take a copy of message
-      std::vector<unsigned char> qmsg = out_que.front();
-      out_que.pop();
-
+    std::vector<unsigned char> qmsg;
+    while (out_que.try_pop(qmsg)) {
       if (static_cast<size_t>(-1) == WriteComPortPhysical(qmsg) &&
           10 < retries++) {
         // We failed to write the port 10 times, let's close the port so that
@@ -1123,9 +1075,7 @@ void* CommDriverN2KSerialThread::Entry() {
         retries = 0;
         CloseComPortPhysical();
       }
-
-      b_qdata = !out_que.empty();
-    }  // while b_qdata
+    }
   }  // while ((not_done)
 
   // thread_exit:
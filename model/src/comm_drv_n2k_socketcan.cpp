@@ -120,6 +120,7 @@ class Worker {
   const wxString m_port_name;
   std::atomic<int> m_run_flag;
   FastMessageMap fast_messages;
+  NavMsgKeyCache key_cache;
   int m_socket;
 };
 
@@ -412,44 +413,14 @@ Worker::Worker(CommDriverN2KSocketCAN* parent, const wxString& port_name)
 std::vector<unsigned char> Worker::PushCompleteMsg(const CanHeader header,
                                                    int position,
                                                    const CanFrame frame) {
-  std::vector<unsigned char> data;
-  data.push_back(0x93);
-  data.push_back(0x13);
-  data.push_back(header.priority);
-  data.push_back(header.pgn & 0xFF);
-  data.push_back((header.pgn >> 8) & 0xFF);
-  data.push_back((header.pgn >> 16) & 0xFF);
-  data.push_back(header.destination);
-  data.push_back(header.source);
-  data.push_back(0xFF);  // FIXME (dave) generate the time fields
-  data.push_back(0xFF);
-  data.push_back(0xFF);
-  data.push_back(0xFF);
-  data.push_back(CAN_MAX_DLEN);  // nominally 8
-  for (size_t n = 0; n < CAN_MAX_DLEN; n++) data.push_back(frame.data[n]);
-  data.push_back(0x55);  // CRC dummy, not checked
-  return data;
+  return MakeN2kDriverMsg(header, frame.data, CAN_MAX_DLEN);  // nominally 8
 }
 
 std::vector<unsigned char> Worker::PushFastMsgFragment(const CanHeader& header,
                                                        int position) {
-  std::vector<unsigned char> data;
-  data.push_back(0x93);
-  data.push_back(fast_messages[position].expected_length + 11);
-  data.push_back(header.priority);
-  data.push_back(header.pgn & 0xFF);
-  data.push_back((header.pgn >> 8) & 0xFF);
-  data.push_back((header.pgn >> 16) & 0xFF);
-  data.push_back(header.destination);
-  data.push_back(header.source);
-  data.push_back(0xFF);  // FIXME (dave) Could generate the time fields
-  data.push_back(0xFF);
-  data.push_back(0xFF);
-  data.push_back(0xFF);
-  data.push_back(fast_messages[position].expected_length);
-  for (size_t n = 0; n < fast_messages[position].expected_length; n++)
-    data.push_back(fast_messages[position].data[n]);
-  data.push_back(0x55);  // CRC dummy
+  const auto& entry = fast_messages[position];
+  auto data =
+      MakeN2kDriverMsg(header, entry.data.data(), entry.expected_length);
   fast_messages.Remove(position);
   return data;
 }
@@ -558,15 +529,18 @@ void Worker::HandleInput(CanFrame frame) {
     }
     // auto name = N2kName(static_cast<uint64_t>(header.pgn));
     auto src_addr = m_parent_driver->GetAddress(m_parent_driver->node_name);
-    auto msg = std::make_shared<const Nmea2000Msg>(header.pgn, vec, src_addr);
-    auto msg_all = std::make_shared<const Nmea2000Msg>(1, vec, src_addr);
+    const size_t size = vec.size();
+    auto msg_all = std::make_shared<const Nmea2000Msg>(key_cache.N2000(1), 1,
+                                                       vec, src_addr);
+    auto msg = std::make_shared<const Nmea2000Msg>(
+        key_cache.N2000(header.pgn), header.pgn, std::move(vec), src_addr);
 
     ProcessRxMessages(msg);
     m_parent_driver->m_listener.Notify(std::move(msg));
     m_parent_driver->m_listener.Notify(std::move(msg_all));
 
     DriverStats stats = m_parent_driver->GetDriverStats();
-    stats.rx_count += vec.size();
+    stats.rx_count += size;
     m_parent_driver->SetDriverStats(stats);
   }
 }
@@ -152,3 +152,29 @@ std::string PluginMsg::to_string() const {
   }
   return name + ": " + ss.str();
 }
+
+ObsKeyId NavMsgKeyCache::N0183(const std::string& id) {
+  auto found = m_n0183_ids.find(id);
+  if (found != m_n0183_ids.end()) return found->second;
+  if (m_n0183_ids.size() >= kMaxEntries) m_n0183_ids.clear();
+  std::string key = Nmea0183Msg::MessageKey(id.substr(2).c_str());
+  ObsKeyId key_id = KeyRegistry::GetInstance().Intern(key);
+  m_n0183_ids[id] = key_id;
+  return key_id;
+}
+
+ObsKeyId NavMsgKeyCache::N0183All() {
+  static const ObsKeyId key_id =
+      KeyRegistry::GetInstance().Intern(Nmea0183Msg::MessageKey("ALL"));
+  return key_id;
+}
+
+ObsKeyId NavMsgKeyCache::N2000(uint64_t pgn) {
+  auto found = m_n2000_ids.find(pgn);
+  if (found != m_n2000_ids.end()) return found->second;
+  if (m_n2000_ids.size() >= kMaxEntries) m_n2000_ids.clear();
+  ObsKeyId key_id =
+      KeyRegistry::GetInstance().Intern(Nmea2000Msg(pgn).key());
+  m_n2000_ids[pgn] = key_id;
+  return key_id;
+}
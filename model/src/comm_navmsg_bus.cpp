@@ -26,9 +26,21 @@
 #include "model/comm_navmsg_bus.h"
 
 void NavMsgBus::Notify(std::shared_ptr<const NavMsg> msg) {
-  std::string key = NavAddr::BusToString(msg->bus) + "::" + msg->GetKey();
-  RegisterKey(key);
-  Observable(*msg).Notify(msg);
+  ObsKeyId key_id = msg->GetKeyId();
+  if (key_id == KeyRegistry::kNoKey) {
+    std::string key = NavAddr::BusToString(msg->bus) + "::" + msg->GetKey();
+    RegisterKey(key);
+    Observable(*msg).Notify(msg);
+    return;
+  }
+  // Fast path: no string handling or locking once a key is known.
+  auto bus_bit = static_cast<uint8_t>(1u << static_cast<unsigned>(msg->bus));
+  if ((m_registered_buses[key_id].load(std::memory_order_relaxed) &
+       bus_bit) == 0) {
+    m_registered_buses[key_id].fetch_or(bus_bit, std::memory_order_relaxed);
+    RegisterKey(NavAddr::BusToString(msg->bus) + "::" + msg->GetKey());
+  }
+  Observable(key_id).Notify(msg);
 }
 
 void NavMsgBus::RegisterKey(const std::string& key) {
@@ -0,0 +1,76 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Implement harmonic_series.h
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "model/harmonic_series.h"
+
+/** Samples between restarts of the rotation from exact values. */
+static const size_t kRestart = 64;
+
+void HarmonicSeries::Clear() {
+  m_amplitude.clear();
+  m_speed.clear();
+  m_phase.clear();
+}
+
+void HarmonicSeries::Add(double amplitude, double speed, double phase) {
+  m_amplitude.push_back(amplitude);
+  m_speed.push_back(speed);
+  m_phase.push_back(phase);
+}
+
+void HarmonicSeries::Evaluate(double step, size_t count, double* out,
+                              int deriv) const {
+  const size_t n = m_amplitude.size();
+  // d^n/dt^n cos(x) is speed^n * cos(x + n * pi/2)
+  std::vector<double> amp(n), phase(n), rot_re(n), rot_im(n);
+  for (size_t a = 0; a < n; a++) {
+    amp[a] = m_amplitude[a] * std::pow(m_speed[a], deriv);
+    phase[a] = m_phase[a] + M_PI / 2 * deriv;
+    rot_re[a] = cos(m_speed[a] * step);
+    rot_im[a] = sin(m_speed[a] * step);
+  }
+
+  std::vector<double> re(n), im(n);
+  for (size_t k0 = 0; k0 < count; k0 += kRestart) {
+    for (size_t a = 0; a < n; a++) {
+      const double x = phase[a] + m_speed[a] * step * k0;
+      re[a] = amp[a] * cos(x);
+      im[a] = amp[a] * sin(x);
+    }
+    const size_t k1 = std::min(count, k0 + kRestart);
+    for (size_t k = k0; k < k1; k++) {
+      double sum = 0;
+      for (size_t a = 0; a < n; a++) {
+        sum += re[a];
+        const double r = re[a] * rot_re[a] - im[a] * rot_im[a];
+        im[a] = re[a] * rot_im[a] + im[a] * rot_re[a];
+        re[a] = r;
+      }
+      out[k] = sum;
+    }
+  }
+}
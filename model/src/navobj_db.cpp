@@ -234,32 +234,6 @@ bool DeleteAllCommentsForTrack(sqlite3* db, const std::string& track_guid) {
   return true;
 }
 
-bool InsertTrackPoint(sqlite3* db, const std::string& track_guid, double lat,
-                      double lon, const std::string& timestamp, int i_point) {
-  const char* sql = R"(
-        INSERT INTO trk_points (track_guid, latitude, longitude, timestamp, point_order)
-        VALUES (?, ?, ?, ?, ?)
-    )";
-  sqlite3_stmt* stmt;
-
-  if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK) {
-    sqlite3_bind_text(stmt, 1, track_guid.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_double(stmt, 2, lat);
-    sqlite3_bind_double(stmt, 3, lon);
-    sqlite3_bind_text(stmt, 4, timestamp.c_str(), -1, SQLITE_TRANSIENT);
-    sqlite3_bind_int(stmt, 5, i_point);
-    if (sqlite3_step(stmt) != SQLITE_DONE) {
-      ReportError("InsertTrackPoint:step");
-      sqlite3_finalize(stmt);
-      return false;
-    }
-    sqlite3_finalize(stmt);
-  } else {
-    return false;
-  }
-  return true;
-}
-
 bool InsertTrackHTML(sqlite3* db, const std::string& track_guid,
                      const std::string& link_guid, const std::string& descrText,
                      const std::string& link, const std::string& ltype) {
@@ -604,17 +578,64 @@ NavObj_dB::NavObj_dB() {
                                   SQLITE_OPEN_READWRITE, NULL);
   sqlite3_exec(m_db, "PRAGMA foreign_keys = ON;", nullptr, nullptr, nullptr);
 
+  // Write ahead logging lets the track point writer commit without
+  // blocking readers, and needs far fewer fsync() than a rollback journal.
+  // It survives a crash, at worst losing the last commits.
+  sqlite3_exec(m_db, "PRAGMA journal_mode = WAL;", nullptr, nullptr, nullptr);
+  sqlite3_exec(m_db, "PRAGMA synchronous = NORMAL;", nullptr, nullptr,
+               nullptr);
+  sqlite3_busy_timeout(m_db, 10000);
+
+  m_point_writer =
+      std::make_unique<TrackPointWriter>(db_filename.ToStdString());
+  if (!m_point_writer->IsOk()) {
+    wxLogMessage("Cannot open navobj.db for track points, writing directly");
+    m_point_writer.reset();
+  }
+
   // Init class members
   m_importing = false;
 }
 
-NavObj_dB::~NavObj_dB() { sqlite3_close_v2(m_db); }
+NavObj_dB::~NavObj_dB() { Close(); }
 
 void NavObj_dB::Close() {
+  m_point_writer.reset();  // Writes all queued points
+  FinalizeStatements();
   sqlite3_close_v2(m_db);
   m_db = nullptr;
 }
 
+sqlite3_stmt* NavObj_dB::GetStatement(const char* sql) {
+  auto found = m_statements.find(sql);
+  if (found != m_statements.end()) {
+    sqlite3_reset(found->second);
+    sqlite3_clear_bindings(found->second);
+    return found->second;
+  }
+  sqlite3_stmt* stmt;
+  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) != SQLITE_OK)
+    return nullptr;
+  m_statements[sql] = stmt;
+  return stmt;
+}
+
+void NavObj_dB::FinalizeStatements() {
+  for (auto& kv : m_statements) sqlite3_finalize(kv.second);
+  m_statements.clear();
+}
+
+void NavObj_dB::ReportWriterErrors() {
+  if (!m_point_writer) return;
+  for (const auto& error : m_point_writer->TakeErrors()) ReportError(error);
+}
+
+void NavObj_dB::FlushTrackPoints() {
+  if (!m_point_writer) return;
+  m_point_writer->Flush();
+  ReportWriterErrors();
+}
+
 bool NavObj_dB::ImportLegacyNavobj(wxFrame* frame) {
   wxString navobj_filename = g_BasePlatform->GetPrivateDataDir() +
                              wxFileName::GetPathSeparator() + "navobj.xml";
@@ -787,7 +808,13 @@ bool NavObj_dB::InsertTrack(Track* track) {
 
   bool rv = false;
   char* errMsg = 0;
-  sqlite3_exec(m_db, "BEGIN TRANSACTION", 0, 0, &errMsg);
+  //  Take the write lock up front, a deferred transaction fails to upgrade
+  //  its read lock while the track point writer commits.
+  sqlite3_exec(m_db, "BEGIN IMMEDIATE", 0, 0, &errMsg);
+  if (errMsg) {
+    ReportError("InsertTrack:transaction");
+    return false;
+  }
 
   // Insert a new track
   wxString sql = wxString::Format("INSERT INTO tracks (guid) VALUES ('%s')",
@@ -800,12 +827,15 @@ bool NavObj_dB::InsertTrack(Track* track) {
   UpdateDBTrackAttributes(track);
 
   //  Add any existing trkpoints
-  for (int i = 0; i < track->GetnPoints(); i++) {
-    auto point = track->GetPoint(i);
-    //  Add the bare trkpoint
-    InsertTrackPoint(m_db, track->m_GUID.ToStdString(), point->m_lat,
-                     point->m_lon, point->GetTimeString(), i);
-  }
+  std::vector<TrackPoint*> points;
+  points.reserve(track->GetnPoints());
+  for (int i = 0; i < track->GetnPoints(); i++)
+    points.push_back(track->GetPoint(i));
+  sqlite3_stmt* insert_point = GetStatement(TrackPointWriter::GetInsertSql());
+  if (!insert_point ||
+      TrackPointWriter::InsertTrackPoints(
+          insert_point, track->m_GUID.ToStdString(), points) > 0)
+    ReportError("InsertTrackPoint:step");
 
   //  Add HTML links to track
   int NbrOfLinks = track->m_TrackHyperlinkList->GetCount();
@@ -825,6 +855,7 @@ bool NavObj_dB::InsertTrack(Track* track) {
   sqlite3_exec(m_db, "COMMIT", 0, 0, &errMsg);
   rv = true;
   if (errMsg) rv = false;
+  if (rv) m_known_tracks.insert(track->m_GUID.ToStdString());
 
   return rv;
 };
@@ -842,8 +873,8 @@ bool NavObj_dB::UpdateDBTrackAttributes(Track* track) {
       "color = ? "
       "WHERE guid = ?";
 
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+  sqlite3_stmt* stmt = GetStatement(sql);
+  if (stmt) {
     sqlite3_bind_text(stmt, 1, track->GetName().ToStdString().c_str(), -1,
                       SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 2, track->m_TrackDescription.ToStdString().c_str(),
@@ -866,11 +897,11 @@ bool NavObj_dB::UpdateDBTrackAttributes(Track* track) {
 
   if (sqlite3_step(stmt) != SQLITE_DONE) {
     ReportError("UpdateDBTrackAttributesA:step");
-    sqlite3_finalize(stmt);
+    sqlite3_reset(stmt);
     return false;
   }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   // Update the HTML links
   // The list of links is freshly rebuilt when this method is called
@@ -921,22 +952,37 @@ bool NavObj_dB::UpdateDBTrackAttributes(Track* track) {
 }
 
 bool NavObj_dB::AddTrackPoint(Track* track, TrackPoint* point) {
+  std::string track_guid = track->m_GUID.ToStdString();
+
   //  If track does not yet exist in dB, return
-  if (!TrackExists(m_db, track->m_GUID.ToStdString())) return false;
+  if (m_known_tracks.find(track_guid) == m_known_tracks.end()) {
+    if (!TrackExists(m_db, track_guid)) return false;
+    m_known_tracks.insert(track_guid);
+  }
 
   // Get next point order
   int this_point_index = track->GetnPoints();
 
+  TrackPointWriter::Point db_point{track_guid, point->m_lat, point->m_lon,
+                                   point->GetTimeString(),
+                                   this_point_index - 1};
+  if (m_point_writer) {
+    ReportWriterErrors();
+    m_point_writer->Add(std::move(db_point));
+    return true;
+  }
+
   // Add the linked point to the dB
-  if (!InsertTrackPoint(m_db, track->m_GUID.ToStdString(), point->m_lat,
-                        point->m_lon, point->GetTimeString(),
-                        this_point_index - 1))
+  sqlite3_stmt* stmt = GetStatement(TrackPointWriter::GetInsertSql());
+  if (!stmt || !TrackPointWriter::Insert(stmt, db_point)) {
+    ReportError("InsertTrackPoint:step");
     return false;
-
+  }
   return true;
 }
 
 bool NavObj_dB::LoadAllTracks() {
+  FlushTrackPoints();
   const char* sql = R"(
         SELECT guid, name,
         description, visibility, start_string, end_string,
@@ -1072,6 +1118,10 @@ bool NavObj_dB::LoadAllTracks() {
 bool NavObj_dB::DeleteTrack(Track* track) {
   if (!track) return false;
   std::string track_guid = track->m_GUID.ToStdString();
+
+  //  Queued points must not be written after the track is gone
+  FlushTrackPoints();
+  m_known_tracks.erase(track_guid);
   const char* sql = "DELETE FROM tracks WHERE guid = ?";
   sqlite3_stmt* stmt;
 
@@ -1106,7 +1156,8 @@ bool NavObj_dB::InsertRoute(Route* route) {
     UpdateDBRouteAttributes(route);
   }
 
-  sqlite3_exec(m_db, "BEGIN TRANSACTION", 0, 0, &errMsg);
+  //  Take the write lock up front, see InsertTrack()
+  sqlite3_exec(m_db, "BEGIN IMMEDIATE", 0, 0, &errMsg);
   if (errMsg) {
     ReportError("InsertRoute:transaction");
     return false;
@@ -1261,8 +1312,8 @@ bool NavObj_dB::UpdateDBRouteAttributes(Route* route) {
       "color = ? "
       "WHERE guid = ?";
 
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+  sqlite3_stmt* stmt = GetStatement(sql);
+  if (stmt) {
     sqlite3_bind_text(stmt, 1, route->GetName().ToStdString().c_str(), -1,
                       SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 2, route->m_RouteDescription.ToStdString().c_str(),
@@ -1290,11 +1341,11 @@ bool NavObj_dB::UpdateDBRouteAttributes(Route* route) {
 
   if (sqlite3_step(stmt) != SQLITE_DONE) {
     ReportError("UpdateDBRouteAttributesA:step");
-    sqlite3_finalize(stmt);
+    sqlite3_reset(stmt);
     return false;
   }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   // Update the HTML links
   // The list of links is freshly rebuilt when this method is called
@@ -1374,8 +1425,8 @@ bool NavObj_dB::UpdateDBRoutePointAttributes(RoutePoint* point) {
       "isolated = ? "
       "WHERE guid = ?";
 
-  sqlite3_stmt* stmt;
-  if (sqlite3_prepare_v2(m_db, sql, -1, &stmt, nullptr) == SQLITE_OK) {
+  sqlite3_stmt* stmt = GetStatement(sql);
+  if (stmt) {
     sqlite3_bind_double(stmt, 1, point->GetLatitude());
     sqlite3_bind_double(stmt, 2, point->GetLongitude());
     sqlite3_bind_text(stmt, 3, point->GetIconName().ToStdString().c_str(), -1,
@@ -1425,11 +1476,11 @@ bool NavObj_dB::UpdateDBRoutePointAttributes(RoutePoint* point) {
 
   if (sqlite3_step(stmt) != SQLITE_DONE) {
     ReportError("UpdateDBRoutePointAttributesA:step");
-    sqlite3_finalize(stmt);
+    sqlite3_reset(stmt);
     return false;
   }
 
-  sqlite3_finalize(stmt);
+  sqlite3_reset(stmt);
 
   // Update the HTML links
   // The list of links is freshly rebuilt when this method is called
@@ -22,6 +22,9 @@
  ***************************************************************************
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include <wx/list.h>
 #include <wx/gdicmn.h>
 
@@ -36,7 +39,63 @@
 
 Select *pSelect;
 
-Select::Select() {
+/** Grid cell size, degrees. */
+static const double kGridCellDeg = 0.1;
+
+/** Segments with larger lat or lon extent go to the m_large list. */
+static const double kMaxGridSegmentDeg = 0.1;
+
+/**
+ * Largest selectRadius searched in the grid, larger ones cover so much
+ * of the index a linear search is as fast.
+ */
+static const double kMaxGridRadiusDeg = 1.0;
+
+static bool IsIndexedType(int seltype) {
+  switch (seltype) {
+    case SELTYPE_ROUTESEGMENT:
+    case SELTYPE_TRACKSEGMENT:
+    case SELTYPE_TIDEPOINT:
+    case SELTYPE_CURRENTPOINT:
+    case SELTYPE_AISTARGET:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static double NormalizeLon(double lon) {
+  while (lon < -180.) lon += 360.;
+  while (lon > 180.) lon -= 360.;
+  return lon;
+}
+
+/**
+ * Return position to keep item at in the grid, or false if the item must
+ * be checked linearly. Segments crossing the prime meridian or the IDL are
+ * given special handling by IsSegmentSelected() and are never in the grid.
+ */
+static bool GetGridPosition(const SelectItem *item, double &lat, double &lon) {
+  if (item->m_seltype != SELTYPE_ROUTESEGMENT &&
+      item->m_seltype != SELTYPE_TRACKSEGMENT) {
+    lat = item->m_slat;
+    lon = NormalizeLon(item->m_slon);
+    return true;
+  }
+  double a = item->m_slat, b = item->m_slat2;
+  double c = item->m_slon, d = item->m_slon2;
+  if (c > 180.0) c -= 360.0;
+  if (d > 180.0) d -= 360.0;
+  if (fabs(a) > 90. || fabs(b) > 90. || c < -180. || d < -180. || c * d < 0.)
+    return false;
+  if (fabs(a - b) > kMaxGridSegmentDeg || fabs(c - d) > kMaxGridSegmentDeg)
+    return false;
+  lat = (a + b) / 2;
+  lon = (c + d) / 2;
+  return true;
+}
+
+Select::Select() : m_grid(kGridCellDeg), m_front_order(0), m_back_order(0) {
   pSelectList = new SelectableItemList;
   pixelRadius = g_BasePlatform->GetSelectRadiusPix();
 }
@@ -103,6 +162,7 @@ bool Select::AddSelectableRouteSegment(float slat1, float slon1, float slat2,
     pSelectList->Append(pSelItem);
   else
     pSelectList->Insert(pSelItem);
+  IndexItem(pSelItem, !pRoute->m_bIsInLayer);
 
   return true;
 }
@@ -117,6 +177,7 @@ bool Select::DeleteAllSelectableRouteSegments(Route *pr) {
     pFindSel = node->GetData();
     if (pFindSel->m_seltype == SELTYPE_ROUTESEGMENT &&
         (Route *)pFindSel->m_pData3 == pr) {
+      UnindexItem(pFindSel);
       delete pFindSel;
       wxSelectableItemListNode *d = node;
       node = node->GetNext();
@@ -247,6 +308,7 @@ bool Select::UpdateSelectableRouteSegments(RoutePoint *prp) {
       if (pFindSel->m_pData1 == prp) {
         pFindSel->m_slat = prp->m_lat;
         pFindSel->m_slon = prp->m_lon;
+        IndexItem(pFindSel, false);
         ret = true;
         ;
       }
@@ -254,6 +316,7 @@ bool Select::UpdateSelectableRouteSegments(RoutePoint *prp) {
       else if (pFindSel->m_pData2 == prp) {
         pFindSel->m_slat2 = prp->m_lat;
         pFindSel->m_slon2 = prp->m_lon;
+        IndexItem(pFindSel, false);
         ret = true;
       }
     }
@@ -274,6 +337,7 @@ SelectItem *Select::AddSelectablePoint(float slat, float slon,
     pSelItem->m_pData1 = pdata;
 
     pSelectList->Append(pSelItem);
+    IndexItem(pSelItem, false);
   }
 
   return pSelItem;
@@ -299,6 +363,7 @@ bool Select::DeleteSelectablePoint(void *pdata, int SeltypeToDelete) {
       pFindSel = node->GetData();
       if (pFindSel->m_seltype == SeltypeToDelete) {
         if (pdata == pFindSel->m_pData1) {
+          UnindexItem(pFindSel);
           delete pFindSel;
           delete node;
 
@@ -331,6 +396,7 @@ bool Select::DeleteAllSelectableTypePoints(int SeltypeToDelete) {
         RoutePoint *prp = (RoutePoint *)pFindSel->m_pData1;
         prp->SetSelectNode(NULL);
       }
+      UnindexItem(pFindSel);
       delete pFindSel;
 
       node = pSelectList->GetFirst();
@@ -375,6 +441,7 @@ bool Select::ModifySelectablePoint(float lat, float lon, void *data,
       if (data == pFindSel->m_pData1) {
         pFindSel->m_slat = lat;
         pFindSel->m_slon = lon;
+        IndexItem(pFindSel, false);
         return true;
       }
     }
@@ -403,6 +470,7 @@ bool Select::AddSelectableTrackSegment(float slat1, float slon1, float slat2,
     pSelectList->Append(pSelItem);
   else
     pSelectList->Insert(pSelItem);
+  IndexItem(pSelItem, !pTrack->m_bIsInLayer);
 
   return true;
 }
@@ -417,6 +485,7 @@ bool Select::DeleteAllSelectableTrackSegments(Track *pt) {
     pFindSel = node->GetData();
     if (pFindSel->m_seltype == SELTYPE_TRACKSEGMENT &&
         (Track *)pFindSel->m_pData3 == pt) {
+      UnindexItem(pFindSel);
       delete pFindSel;
       wxSelectableItemListNode *d = node;
       node = node->GetNext();
@@ -438,6 +507,7 @@ bool Select::DeletePointSelectableTrackSegments(TrackPoint *pt) {
     if (pFindSel->m_seltype == SELTYPE_TRACKSEGMENT &&
         ((TrackPoint *)pFindSel->m_pData1 == pt ||
          (TrackPoint *)pFindSel->m_pData2 == pt)) {
+      UnindexItem(pFindSel);
       delete pFindSel;
       wxSelectableItemListNode *d = node;
       node = node->GetNext();
@@ -513,72 +583,113 @@ void Select::CalcSelectRadius(SelectCtx &ctx) {
   selectRadius = pixelRadius / (ctx.scale * 1852 * 60);
 }
 
+void Select::IndexItem(SelectItem *item, bool at_front) {
+  if (!IsIndexedType(item->m_seltype)) return;
+  auto inserted = m_list_order.emplace(item, 0);
+  if (inserted.second)
+    inserted.first->second = at_front ? --m_front_order : m_back_order++;
+
+  double lat, lon;
+  if (GetGridPosition(item, lat, lon)) {
+    m_large.erase(item);
+    m_grid.Update(item, lat, lon);
+  } else {
+    m_grid.Remove(item);
+    m_large.insert(item);
+  }
+}
+
+void Select::UnindexItem(SelectItem *item) {
+  if (!m_list_order.erase(item)) return;
+  m_grid.Remove(item);
+  m_large.erase(item);
+}
+
+std::vector<SelectItem *> Select::FindCandidates(float slat, float slon,
+                                                 int fseltype) const {
+  std::vector<SelectItem *> found;
+  //  Segments are kept at their center, widen the search by their extent.
+  //  The small extra margin covers float rounding.
+  double margin = selectRadius + kMaxGridSegmentDeg / 2 + 1e-4;
+  double lon_min = -180., lon_max = 180.;
+  if (margin < 180.) {
+    lon_min = NormalizeLon(slon - margin);
+    lon_max = NormalizeLon(slon + margin);
+  }
+  m_grid.QueryBox(slat - margin, slat + margin, lon_min, lon_max, found);
+  found.insert(found.end(), m_large.begin(), m_large.end());
+  found.erase(std::remove_if(found.begin(), found.end(),
+                             [fseltype](const SelectItem *item) {
+                               return item->m_seltype != fseltype;
+                             }),
+              found.end());
+  return found;
+}
+
+bool Select::IsHit(SelectCtx &ctx, SelectItem *pFindSel, int fseltype,
+                   float slat, float slon) {
+  switch (fseltype) {
+    case SELTYPE_ROUTEPOINT:
+    case SELTYPE_TIDEPOINT:
+    case SELTYPE_CURRENTPOINT:
+    case SELTYPE_AISTARGET:
+      if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
+          (fabs(slon - pFindSel->m_slon) < selectRadius)) {
+        if (fseltype == SELTYPE_ROUTEPOINT)
+          return ((RoutePoint *)pFindSel->m_pData1)
+              ->IsVisibleSelectable(ctx.chart_scale);
+        return true;
+      }
+      return false;
+    case SELTYPE_ROUTESEGMENT:
+    case SELTYPE_TRACKSEGMENT: {
+      float a = pFindSel->m_slat;
+      float b = pFindSel->m_slat2;
+      float c = pFindSel->m_slon;
+      float d = pFindSel->m_slon2;
+
+      return IsSegmentSelected(a, b, c, d, slat, slon);
+    }
+    default:
+      return false;
+  }
+}
+
 SelectItem *Select::FindSelection(SelectCtx &ctx, float slat, float slon,
                                   int fseltype) {
-  float a, b, c, d;
   SelectItem *pFindSel;
 
   CalcSelectRadius(ctx);
 
+  if (IsIndexedType(fseltype) && selectRadius < kMaxGridRadiusDeg) {
+    //  First hit in list order
+    SelectItem *first = NULL;
+    for (SelectItem *item : FindCandidates(slat, slon, fseltype)) {
+      if (first && m_list_order[item] > m_list_order[first]) continue;
+      if (IsHit(ctx, item, fseltype, slat, slon)) first = item;
+    }
+    return first;
+  }
+
   //    Iterate on the list
   wxSelectableItemListNode *node = pSelectList->GetFirst();
 
   while (node) {
     pFindSel = node->GetData();
-    if (pFindSel->m_seltype == fseltype) {
-      switch (fseltype) {
-        case SELTYPE_ROUTEPOINT:
-        case SELTYPE_TIDEPOINT:
-        case SELTYPE_CURRENTPOINT:
-        case SELTYPE_AISTARGET:
-          if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
-              (fabs(slon - pFindSel->m_slon) < selectRadius)) {
-            if (fseltype == SELTYPE_ROUTEPOINT) {
-              if (((RoutePoint *)pFindSel->m_pData1)
-                      ->IsVisibleSelectable(ctx.chart_scale))
-                goto find_ok;
-            } else {
-              goto find_ok;
-            }
-          }
-          break;
-        case SELTYPE_ROUTESEGMENT:
-        case SELTYPE_TRACKSEGMENT: {
-          a = pFindSel->m_slat;
-          b = pFindSel->m_slat2;
-          c = pFindSel->m_slon;
-          d = pFindSel->m_slon2;
-
-          if (IsSegmentSelected(a, b, c, d, slat, slon)) goto find_ok;
-          break;
-        }
-        default:
-          break;
-      }
-    }
+    if (pFindSel->m_seltype == fseltype &&
+        IsHit(ctx, pFindSel, fseltype, slat, slon))
+      return pFindSel;
 
     node = node->GetNext();
   }
 
   return NULL;
-find_ok:
-  return pFindSel;
 }
 
 bool Select::IsSelectableSegmentSelected(SelectCtx &ctx, float slat, float slon,
                                          SelectItem *pFindSel) {
-  bool valid = false;
-  wxSelectableItemListNode *node = pSelectList->GetFirst();
-
-  while (node) {
-    if (pFindSel == node->GetData()) {
-      valid = true;
-      break;
-    }
-    node = node->GetNext();
-  }
-
-  if (valid == false) {
+  //  Segments are always indexed
+  if (m_list_order.find(pFindSel) == m_list_order.end()) {
     // not in the list anymore
     return false;
   }
@@ -604,60 +715,68 @@ static bool is_selectable_wp(SelectCtx ctx, RoutePoint *wp) {
   return false;
 }
 
+bool Select::IsListHit(SelectCtx &ctx, SelectItem *pFindSel, int fseltype,
+                       float slat, float slon) {
+  switch (fseltype) {
+    case SELTYPE_ROUTEPOINT:
+      return (fabs(slat - pFindSel->m_slat) < selectRadius) &&
+             (fabs(slon - pFindSel->m_slon) < selectRadius) &&
+             is_selectable_wp(ctx, (RoutePoint *)pFindSel->m_pData1) &&
+             ((RoutePoint *)pFindSel->m_pData1)
+                 ->IsVisibleSelectable(ctx.chart_scale);
+    case SELTYPE_TIDEPOINT:
+    case SELTYPE_CURRENTPOINT:
+    case SELTYPE_AISTARGET:
+    case SELTYPE_DRAGHANDLE:
+      return (fabs(slat - pFindSel->m_slat) < selectRadius) &&
+             (fabs(slon - pFindSel->m_slon) < selectRadius) &&
+             is_selectable_wp(ctx, (RoutePoint *)pFindSel->m_pData1);
+    case SELTYPE_ROUTESEGMENT:
+    case SELTYPE_TRACKSEGMENT: {
+      float a = pFindSel->m_slat;
+      float b = pFindSel->m_slat2;
+      float c = pFindSel->m_slon;
+      float d = pFindSel->m_slon2;
+
+      return IsSegmentSelected(a, b, c, d, slat, slon) &&
+             (ctx.show_nav_objects ||
+              (fseltype == SELTYPE_ROUTESEGMENT &&
+               ((Route *)pFindSel->m_pData3)->m_bRtIsActive));
+    }
+    default:
+      return false;
+  }
+}
+
 SelectableItemList Select::FindSelectionList(SelectCtx &ctx, float slat,
                                              float slon, int fseltype) {
-  float a, b, c, d;
   SelectItem *pFindSel;
   SelectableItemList ret_list;
 
   CalcSelectRadius(ctx);
 
+  if (IsIndexedType(fseltype) && selectRadius < kMaxGridRadiusDeg) {
+    std::vector<SelectItem *> hits;
+    for (SelectItem *item : FindCandidates(slat, slon, fseltype)) {
+      if (IsListHit(ctx, item, fseltype, slat, slon)) hits.push_back(item);
+    }
+    //  Same order as the list
+    std::sort(hits.begin(), hits.end(),
+              [this](const SelectItem *a, const SelectItem *b) {
+                return m_list_order[a] < m_list_order[b];
+              });
+    for (SelectItem *item : hits) ret_list.Append(item);
+    return ret_list;
+  }
+
   //    Iterate on the list
   wxSelectableItemListNode *node = pSelectList->GetFirst();
 
   while (node) {
     pFindSel = node->GetData();
-    if (pFindSel->m_seltype == fseltype) {
-      switch (fseltype) {
-        case SELTYPE_ROUTEPOINT:
-          if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
-              (fabs(slon - pFindSel->m_slon) < selectRadius))
-            if (is_selectable_wp(ctx, (RoutePoint *)pFindSel->m_pData1))
-              if (((RoutePoint *)pFindSel->m_pData1)
-                      ->IsVisibleSelectable(ctx.chart_scale))
-                ret_list.Append(pFindSel);
-          break;
-        case SELTYPE_TIDEPOINT:
-        case SELTYPE_CURRENTPOINT:
-        case SELTYPE_AISTARGET:
-        case SELTYPE_DRAGHANDLE:
-          if ((fabs(slat - pFindSel->m_slat) < selectRadius) &&
-              (fabs(slon - pFindSel->m_slon) < selectRadius)) {
-            if (is_selectable_wp(ctx, (RoutePoint *)pFindSel->m_pData1))
-              ret_list.Append(pFindSel);
-          }
-          break;
-        case SELTYPE_ROUTESEGMENT:
-        case SELTYPE_TRACKSEGMENT: {
-          a = pFindSel->m_slat;
-          b = pFindSel->m_slat2;
-          c = pFindSel->m_slon;
-          d = pFindSel->m_slon2;
-
-          if (IsSegmentSelected(a, b, c, d, slat, slon)) {
-            if (ctx.show_nav_objects ||
-                (fseltype == SELTYPE_ROUTESEGMENT &&
-                 ((Route *)pFindSel->m_pData3)->m_bRtIsActive)) {
-              ret_list.Append(pFindSel);
-            }
-          }
-
-          break;
-        }
-        default:
-          break;
-      }
-    }
+    if (pFindSel->m_seltype == fseltype &&
+        IsListHit(ctx, pFindSel, fseltype, slat, slon))
+      ret_list.Append(pFindSel);
 
     node = node->GetNext();
   }
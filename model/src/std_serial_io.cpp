@@ -35,7 +35,6 @@
 #endif
 
 #include <mutex>  // std::mutex
-#include <queue>  // std::queue
 #include <thread>
 #include <vector>
 
@@ -46,14 +45,18 @@
 #include "model/comm_buffers.h"
 #include "model/comm_drv_registry.h"
 #include "model/logger.h"
+#include "model/ring_buffer.h"
 #include "model/serial_io.h"
 #include "serial/serial.h"
 
+/** Max number of pending output sentences, further ones are dropped. */
+static const size_t kOutQueueSize = 128;
+
 /** SerialIo implementation based on serial/serial.h.*/
 class StdSerialIo : public SerialIo {
 public:
   StdSerialIo(SendMsgFunc send_func, const std::string& port, unsigned baud)
-      : SerialIo(send_func, port, baud) {}
+      : SerialIo(send_func, port, baud), m_out_que(kOutQueueSize) {}
 
   bool SetOutMsg(const wxString& msg) override;
   void Start() override;
@@ -61,7 +64,7 @@ class StdSerialIo : public SerialIo {
 
 private:
   serial::Serial m_serial;
-  OutputBuffer m_out_que;
+  MpscRingBuffer<std::string> m_out_que;
   void* Entry();
   void Reconnect();
 
@@ -133,7 +136,7 @@ void* StdSerialIo::Entry() {
 
     //  Handle pending output messages
     std::string qmsg;
-    while (KeepGoing() && m_out_que.Get(qmsg)) {
+    while (KeepGoing() && m_out_que.try_pop(qmsg)) {
       qmsg += "\r\n";
       bool failed_write = WriteComPortPhysical(qmsg.c_str()) == -1;
       if (!failed_write) {
@@ -160,8 +163,7 @@ void StdSerialIo::Start() {
 
 bool StdSerialIo::SetOutMsg(const wxString& msg) {
   if (msg.size() < 6 || (msg[0] != '$' && msg[0] != '!')) return false;
-  m_out_que.Put(msg.ToStdString());
-  return true;
+  return m_out_que.try_push(msg.ToStdString());
 }
 
 DriverStats StdSerialIo::GetStats() const {
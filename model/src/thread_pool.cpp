@@ -0,0 +1,190 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Implement thread_pool.h
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "model/thread_pool.h"
+
+/** Pool and worker index of current thread, null if not a worker. */
+static thread_local ThreadPool* t_pool = nullptr;
+static thread_local size_t t_index = 0;
+
+bool ThreadPool::Job::Cancel() {
+  m_cancelled = true;
+  State expected = State::kPending;
+  if (!m_state.compare_exchange_strong(expected, State::kDone)) return false;
+  m_task = nullptr;  // Release captured resources early, never run.
+  return true;
+}
+
+ThreadPool& ThreadPool::GetInstance() {
+  // Never destroyed: exiting should not wait for long running tasks.
+  static ThreadPool* instance =
+      new ThreadPool(std::max(1u, std::thread::hardware_concurrency()));
+  return *instance;
+}
+
+ThreadPool::ThreadPool(unsigned thread_count) : m_queued(0), m_stop(false) {
+  thread_count = std::max(1u, thread_count);
+  for (unsigned i = 0; i < thread_count; i++) {
+    m_workers.push_back(std::make_unique<Worker>());
+  }
+  // Start threads when all workers exists, they steal from each other.
+  for (size_t i = 0; i < m_workers.size(); i++) {
+    m_workers[i]->thread = std::thread([this, i] { Run(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cond_var.notify_all();
+  for (auto& worker : m_workers) worker->thread.join();
+
+  auto drop = [](Lanes& lanes) {
+    for (auto& lane : lanes) {
+      for (auto& job : lane) job->Cancel();
+    }
+  };
+  drop(m_shared);
+  for (auto& worker : m_workers) drop(worker->lanes);
+}
+
+std::shared_ptr<ThreadPool::Job> ThreadPool::Submit(std::function<void()> task,
+                                                    Lane lane) {
+  std::shared_ptr<Job> job(new Job(std::move(task)));
+  const auto l = static_cast<size_t>(lane);
+  if (t_pool == this) {
+    Worker& worker = *m_workers[t_index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.lanes[l].push_back(job);
+  } else {
+    std::lock_guard<std::mutex> lock(m_shared_mutex);
+    m_shared[l].push_back(job);
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queued++;
+  }
+  m_cond_var.notify_one();
+  return job;
+}
+
+void ThreadPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)>& fn,
+                             Lane lane) {
+  if (count == 0) return;
+  std::atomic<size_t> next(0);
+  std::mutex mutex;
+  std::condition_variable done_cond;
+  size_t done = 0;
+  auto run = [&] {
+    for (size_t i = next++; i < count; i = next++) fn(i);
+  };
+
+  std::vector<std::shared_ptr<Job>> helpers;
+  const size_t helper_count = std::min(count, m_workers.size()) - 1;
+  for (size_t i = 0; i < helper_count; i++) {
+    helpers.push_back(Submit(
+        [&] {
+          run();
+          std::lock_guard<std::mutex> lock(mutex);
+          done++;
+          done_cond.notify_one();
+        },
+        lane));
+  }
+  run();
+
+  size_t started = 0;
+  for (auto& helper : helpers) {
+    if (!helper->Cancel()) started++;
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  done_cond.wait(lock, [&] { return done == started; });
+}
+
+std::shared_ptr<ThreadPool::Job> ThreadPool::PopShared(size_t lane) {
+  std::lock_guard<std::mutex> lock(m_shared_mutex);
+  auto& queue = m_shared[lane];
+  if (queue.empty()) return nullptr;
+  auto job = std::move(queue.front());
+  queue.pop_front();
+  return job;
+}
+
+std::shared_ptr<ThreadPool::Job> ThreadPool::Steal(size_t index,
+                                                   size_t lane) {
+  for (size_t i = 1; i < m_workers.size(); i++) {
+    Worker& victim = *m_workers[(index + i) % m_workers.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    auto& queue = victim.lanes[lane];
+    if (queue.empty()) continue;
+    auto job = std::move(queue.front());
+    queue.pop_front();
+    return job;
+  }
+  return nullptr;
+}
+
+std::shared_ptr<ThreadPool::Job> ThreadPool::FindJob(size_t index) {
+  Worker& self = *m_workers[index];
+  for (size_t lane = 0; lane < kLaneCount; lane++) {
+    {
+      std::lock_guard<std::mutex> lock(self.mutex);
+      auto& queue = self.lanes[lane];
+      if (!queue.empty()) {
+        auto job = std::move(queue.back());
+        queue.pop_back();
+        return job;
+      }
+    }
+    if (auto job = PopShared(lane)) return job;
+    if (auto job = Steal(index, lane)) return job;
+  }
+  return nullptr;
+}
+
+void ThreadPool::Run(size_t index) {
+  t_pool = this;
+  t_index = index;
+  while (!m_stop) {
+    std::shared_ptr<Job> job = FindJob(index);
+    if (!job) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cond_var.wait(lock, [&] { return m_stop || m_queued > 0; });
+      continue;
+    }
+    m_queued--;
+    Job::State expected = Job::State::kPending;
+    if (!job->m_state.compare_exchange_strong(expected, Job::State::kRunning))
+      continue;  // Cancelled
+    job->m_task();
+    job->m_task = nullptr;
+    job->m_state = Job::State::kDone;
+  }
+}
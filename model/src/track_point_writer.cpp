@@ -0,0 +1,207 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+
+/**
+ * \file
+ * Implement track_point_writer.h
+ */
+
+#include <iterator>
+
+#include "model/track.h"
+#include "model/track_point_writer.h"
+
+/** Time to wait for the database lock held by another connection. */
+static const int kBusyTimeoutMs = 10000;
+
+/** Attempts to start the transaction of a batch before dropping it. */
+static const int kMaxBeginAttempts = 5;
+
+/** Delay between attempts to start the transaction of a batch. */
+static const std::chrono::milliseconds kRetryDelay(1000);
+
+const char* TrackPointWriter::GetInsertSql() {
+  return R"(
+        INSERT INTO trk_points (track_guid, latitude, longitude, timestamp, point_order)
+        VALUES (?, ?, ?, ?, ?)
+    )";
+}
+
+bool TrackPointWriter::Insert(sqlite3_stmt* stmt, const Point& point) {
+  sqlite3_reset(stmt);
+  sqlite3_bind_text(stmt, 1, point.track_guid.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_double(stmt, 2, point.lat);
+  sqlite3_bind_double(stmt, 3, point.lon);
+  sqlite3_bind_text(stmt, 4, point.timestamp.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(stmt, 5, point.point_order);
+  bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+  sqlite3_reset(stmt);
+  return ok;
+}
+
+int TrackPointWriter::InsertTrackPoints(
+    sqlite3_stmt* stmt, const std::string& track_guid,
+    const std::vector<TrackPoint*>& points) {
+  int failed = 0;
+  Point db_point;
+  db_point.track_guid = track_guid;
+  for (size_t i = 0; i < points.size(); i++) {
+    db_point.lat = points[i]->m_lat;
+    db_point.lon = points[i]->m_lon;
+    db_point.timestamp = points[i]->GetTimeString();
+    db_point.point_order = static_cast<int>(i);
+    if (!Insert(stmt, db_point)) failed++;
+  }
+  return failed;
+}
+
+TrackPointWriter::TrackPointWriter(const std::string& path,
+                                   std::chrono::milliseconds max_delay,
+                                   size_t batch_size)
+    : m_db(nullptr),
+      m_insert(nullptr),
+      m_max_delay(max_delay),
+      m_batch_size(batch_size),
+      m_writing(false),
+      m_flush_requests(0),
+      m_stop(false),
+      m_written(0) {
+  if (sqlite3_open_v2(path.c_str(), &m_db, SQLITE_OPEN_READWRITE, nullptr) !=
+      SQLITE_OK) {
+    sqlite3_close_v2(m_db);
+    m_db = nullptr;
+    return;
+  }
+  sqlite3_busy_timeout(m_db, kBusyTimeoutMs);
+  sqlite3_exec(m_db, "PRAGMA foreign_keys = ON;", nullptr, nullptr, nullptr);
+  if (sqlite3_prepare_v2(m_db, GetInsertSql(), -1, &m_insert, nullptr) !=
+      SQLITE_OK) {
+    sqlite3_close_v2(m_db);
+    m_db = nullptr;
+    return;
+  }
+  m_thread = std::thread([&] { Run(); });
+}
+
+TrackPointWriter::~TrackPointWriter() {
+  if (m_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_queued_cond.notify_all();
+    m_thread.join();
+  }
+  sqlite3_finalize(m_insert);
+  sqlite3_close_v2(m_db);
+}
+
+void TrackPointWriter::Add(Point point) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(std::move(point));
+  }
+  m_queued_cond.notify_one();
+}
+
+void TrackPointWriter::Flush() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (!m_thread.joinable()) return;
+  m_flush_requests++;
+  m_queued_cond.notify_one();
+  m_done_cond.wait(lock, [&] { return m_queue.empty() && !m_writing; });
+  m_flush_requests--;
+}
+
+std::vector<std::string> TrackPointWriter::TakeErrors() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  std::vector<std::string> errors;
+  errors.swap(m_errors);
+  return errors;
+}
+
+void TrackPointWriter::Run() {
+  std::vector<Point> batch;
+  int attempts = 0;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_queued_cond.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) break;  // Stopped with nothing left to write
+
+    //  Let the batch fill up, unless someone is waiting for it
+    auto deadline = std::chrono::steady_clock::now() + m_max_delay;
+    m_queued_cond.wait_until(lock, deadline, [&] {
+      return m_stop || m_flush_requests > 0 ||
+             m_queue.size() >= m_batch_size;
+    });
+
+    batch.swap(m_queue);
+    m_writing = true;
+    lock.unlock();
+    bool written = Write(batch);
+    lock.lock();
+    m_writing = false;
+    if (!written && ++attempts < kMaxBeginAttempts) {
+      //  Keep the batch ahead of points added meanwhile, and retry
+      batch.insert(batch.end(), std::make_move_iterator(m_queue.begin()),
+                   std::make_move_iterator(m_queue.end()));
+      m_queue.swap(batch);
+      batch.clear();
+      m_queued_cond.wait_for(lock, kRetryDelay, [&] { return m_stop; });
+      continue;
+    }
+    if (!written) {
+      m_errors.push_back("TrackPointWriter:begin " +
+                         std::string(sqlite3_errmsg(m_db)) + ", " +
+                         std::to_string(batch.size()) + " points dropped");
+    }
+    attempts = 0;
+    batch.clear();
+    m_done_cond.notify_all();
+  }
+  m_done_cond.notify_all();
+}
+
+bool TrackPointWriter::Write(const std::vector<Point>& points) {
+  //  Take the write lock up front, a deferred transaction could fail to
+  //  upgrade its read lock while another connection writes.
+  if (sqlite3_exec(m_db, "BEGIN IMMEDIATE", nullptr, nullptr, nullptr) !=
+      SQLITE_OK)
+    return false;
+
+  std::string error;
+  uint64_t count = 0;
+  for (const auto& point : points) {
+    if (Insert(m_insert, point))
+      count++;
+    else if (error.empty())
+      error = std::string("TrackPointWriter:step ") + sqlite3_errmsg(m_db);
+  }
+  if (sqlite3_exec(m_db, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK) {
+    m_written += count;
+  } else {
+    error = std::string("TrackPointWriter:commit ") + sqlite3_errmsg(m_db);
+    sqlite3_exec(m_db, "ROLLBACK", nullptr, nullptr, nullptr);
+  }
+  if (!error.empty()) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_errors.push_back(error);
+  }
+  return true;
+}
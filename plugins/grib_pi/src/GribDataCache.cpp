@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+/**
+ * \file
+ * \implements \ref GribDataCache.h
+ */
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+#include "wx/wx.h"
+#endif  // precompiled headers
+
+#include <algorithm>
+
+#include "GribDataCache.h"
+#include "GribRecord.h"
+#include "GribThreadPool.h"
+
+//------------------------------------------------------------------------------
+GribDataFile::GribDataFile(const std::string &fname,
+                           std::shared_ptr<GribDataCache> cache)
+    : fileName(fname), file(nullptr), cache(cache) {}
+
+GribDataFile::~GribDataFile() {
+  if (file != nullptr) zu_close(file);
+}
+
+bool GribDataFile::read(long offset, long size,
+                        std::vector<unsigned char> &buf) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (file == nullptr) {
+    file = zu_open(fileName.c_str(), "rb", ZU_COMPRESS_NONE);
+    if (file == nullptr) {
+      erreur("Can't open file: %s", fileName.c_str());
+      return false;
+    }
+  }
+  buf.resize(size);
+  if (zu_seek(file, offset, SEEK_SET) != 0) return false;
+  return zu_read(file, buf.data(), size) == size;
+}
+
+//------------------------------------------------------------------------------
+double *GribPackedData::decode(const GribRecord &rec) const {
+  std::vector<unsigned char> buf;
+  if (!file->read(offset, size, buf)) return nullptr;
+  // Unpackers read whole words past the last value
+  buf.resize(size + 4, 0);
+  return unpack(rec, buf);
+}
+
+//------------------------------------------------------------------------------
+size_t GribDataCache::getBytes() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return bytes;
+}
+
+size_t GribDataCache::getCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return lru.size();
+}
+
+void GribDataCache::insert(GribRecord *rec, double *values) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (rec->data != nullptr) {
+    delete[] values;
+    return;
+  }
+  rec->data = values;
+  index[rec] = lru.insert(lru.end(), rec);
+  bytes += rec->Ni * rec->Nj * sizeof(double);
+}
+
+void GribDataCache::load(const std::vector<GribRecord *> &records) {
+  std::vector<GribRecord *> pending;
+  for (auto rec : records) {
+    if (rec && rec->data == nullptr && rec->m_packed) pending.push_back(rec);
+  }
+  std::sort(pending.begin(), pending.end());
+  pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+  if (pending.empty()) return;
+
+  // Readers hold no reference to the pool, so it is never released by
+  // a worker deleting the last record of a file
+  auto pool = GribThreadPool::GetShared();
+  pool->ParallelFor(pending.size(),
+                    [&pending](size_t i) { pending[i]->loadData(); });
+}
+
+void GribDataCache::touch(const GribRecord *rec) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(rec);
+  if (it != index.end()) lru.splice(lru.end(), lru, it->second);
+}
+
+void GribDataCache::remove(const GribRecord *rec) {
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(rec);
+  if (it == index.end()) return;
+  lru.erase(it->second);
+  index.erase(it);
+  bytes -= rec->Ni * rec->Nj * sizeof(double);
+}
+
+void GribDataCache::trim() {
+  std::lock_guard<std::mutex> lock(mutex);
+  while (bytes > maxBytes && !lru.empty()) {
+    GribRecord *rec = lru.front();
+    lru.pop_front();
+    index.erase(rec);
+    bytes -= rec->Ni * rec->Nj * sizeof(double);
+    delete[] rec->data;
+    rec->data = nullptr;
+    // Values filled by GRIBOverlayFactory::FillGrid() are gone too
+    rec->m_bfilled = false;
+  }
+}
@@ -0,0 +1,155 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+/**
+ * \file
+ * Lazily decoded GRIB record data.
+ *
+ * Uncompressed GRIB files are read in a first pass which only indexes the
+ * record headers. Each record keeps a GribPackedData describing where its
+ * packed values are in the file, the values are decoded the first time
+ * they are used. Decoded grids are kept in a GribDataCache bounded by a
+ * memory limit, the least recently used ones are dropped and decoded
+ * again when needed.
+ */
+#ifndef GRIBDATACACHE_H
+#define GRIBDATACACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "zuFile.h"
+
+class GribRecord;
+class GribDataCache;
+
+/**
+ * GRIB file records are decoded from. The file is opened on first use and
+ * kept open as long as any record refers to it.
+ */
+class GribDataFile {
+public:
+  GribDataFile(const std::string &fname,
+               std::shared_ptr<GribDataCache> cache);
+  ~GribDataFile();
+
+  GribDataFile(const GribDataFile &) = delete;
+  GribDataFile &operator=(const GribDataFile &) = delete;
+
+  /** Read size bytes at offset into buf, thread safe. */
+  bool read(long offset, long size, std::vector<unsigned char> &buf);
+
+  GribDataCache &getCache() { return *cache; }
+
+private:
+  std::mutex mutex;
+  std::string fileName;
+  ZUFILE *file;
+  std::shared_ptr<GribDataCache> cache;
+};
+
+/**
+ * Location and packing of the values of a record in a GribDataFile.
+ * Subclassed by the GRIB edition specific readers.
+ */
+class GribPackedData {
+public:
+  GribPackedData(std::shared_ptr<GribDataFile> file, long offset, long size)
+      : file(file), offset(offset), size(size) {}
+  virtual ~GribPackedData() {}
+
+  /**
+   * Read and unpack the values of rec, thread safe.
+   * @return Array of rec.getNi() * rec.getNj() values owned by the caller,
+   *   nullptr on errors.
+   */
+  double *decode(const GribRecord &rec) const;
+
+  GribDataCache &getCache() const { return file->getCache(); }
+
+protected:
+  /**
+   * Unpack values from the size bytes read at offset, followed by 4 zero
+   * bytes.
+   */
+  virtual double *unpack(const GribRecord &rec,
+                         const std::vector<unsigned char> &buf) const = 0;
+
+private:
+  std::shared_ptr<GribDataFile> file;
+  long offset;
+  long size;
+};
+
+/**
+ * Decoded values of the records of a GribReader, in least recently used
+ * order.
+ *
+ * Values are only dropped by trim(), which must be invoked from the thread
+ * using the records and never while another thread reads record values:
+ * GribRecord::getValue() and friends read the data without locking.
+ */
+class GribDataCache {
+public:
+  static const size_t DEFAULT_MAX_BYTES = 512 * 1024 * 1024;
+
+  explicit GribDataCache(size_t maxBytes = DEFAULT_MAX_BYTES)
+      : maxBytes(maxBytes), bytes(0) {}
+
+  void setMaxBytes(size_t max) { maxBytes = max; }
+  size_t getMaxBytes() const { return maxBytes; }
+  /** Total size of the decoded values. */
+  size_t getBytes() const;
+  /** Number of records with decoded values. */
+  size_t getCount() const;
+
+  /**
+   * Make values the data of rec, thread safe. If another thread has
+   * published data for rec first, values is deleted.
+   */
+  void insert(GribRecord *rec, double *values);
+
+  /**
+   * Decode the values of the lazy records not decoded yet, one record per
+   * task on the shared GribThreadPool, and return when all are done.
+   */
+  void load(const std::vector<GribRecord *> &records);
+
+  /** Mark rec as most recently used, if its data is cached. */
+  void touch(const GribRecord *rec);
+
+  /** Forget rec, its data becomes owned by rec. */
+  void remove(const GribRecord *rec);
+
+  /** Drop least recently used data until the limit is met. */
+  void trim();
+
+private:
+  mutable std::mutex mutex;
+  size_t maxBytes;
+  size_t bytes;
+  std::list<GribRecord *> lru;
+  std::unordered_map<const GribRecord *, std::list<GribRecord *>::iterator>
+      index;
+};
+
+#endif
@@ -238,6 +238,11 @@ GRIBOverlayFactory::GRIBOverlayFactory(GRIBUICtrlBar &dlg)
       nullptr, this);
   m_bUpdateParticles = false;
 
+  m_tIsoLineTimer.Connect(
+      wxEVT_TIMER, wxTimerEventHandler(GRIBOverlayFactory::OnIsoLineTimer),
+      nullptr, this);
+  m_Workers = GribThreadPool::GetShared();
+
   // Generate the wind arrow cache
 
   if (m_pixelMM < 0.2) {
@@ -548,7 +553,7 @@ bool GRIBOverlayFactory::DoRenderGribOverlay(PlugIn_ViewPort *vp) {
 
   //     render each type of record
   GribRecord **pGR = m_pGribTimelineRecordSet->m_GribRecordPtrArray;
-  wxArrayPtrVoid **pIA = m_pGribTimelineRecordSet->m_IsobarArray;
+  std::shared_ptr<IsoLineSet> *pIA = m_pGribTimelineRecordSet->m_IsoLines;
 
   for (int overlay = 1; overlay >= 0; overlay--) {
     for (int i = 0; i < GribOverlaySettings::SETTINGS_COUNT; i++) {
@@ -1414,9 +1419,9 @@ void GRIBOverlayFactory::RenderGribBarbedArrows(int settings, GribRecord **pGR,
 #endif
 }
 
-void GRIBOverlayFactory::RenderGribIsobar(int settings, GribRecord **pGR,
-                                          wxArrayPtrVoid **pIsobarArray,
-                                          PlugIn_ViewPort *vp) {
+void GRIBOverlayFactory::RenderGribIsobar(
+    int settings, GribRecord **pGR, std::shared_ptr<IsoLineSet> *pIsoLines,
+    PlugIn_ViewPort *vp) {
   if (!m_Settings.Settings[settings].m_bIsoBars) return;
 
   //  Need magnitude to draw isobars
@@ -1433,7 +1438,7 @@ void GRIBOverlayFactory::RenderGribIsobar(int settings, GribRecord **pGR,
   GetGlobalColor(_T ( "DILG1" ), &back_color);
 
   //    Initialize the array of Isobars if necessary
-  if (!pIsobarArray[idx]) {
+  if (!pIsoLines[idx]) {
     // build magnitude from multiple record types like wind and current
     if (idy >= 0 && !polar && pGR[idy]) {
       pGRM = GribRecord::MagnitudeRecord(*pGR[idx], *pGR[idy]);
@@ -1445,12 +1450,6 @@ void GRIBOverlayFactory::RenderGribIsobar(int settings, GribRecord **pGR,
       pGRA = pGRM;
     }
 
-    pIsobarArray[idx] = new wxArrayPtrVoid;
-    IsoLine *piso;
-
-    wxGenericProgressDialog *progressdialog = nullptr;
-    wxDateTime start = wxDateTime::Now();
-
     double min = m_Settings.GetMin(settings);
     double max = m_Settings.GetMax(settings);
 
@@ -1460,33 +1459,29 @@ void GRIBOverlayFactory::RenderGribIsobar(int settings, GribRecord **pGR,
                         ? 0.03
                         : 1.;  // divide spacing by 1/33 for PRESURRE & inHG
 
+    std::vector<double> values, coeffs;
     for (double press = min; press <= max;
          press += (m_Settings.Settings[settings].m_iIsoBarSpacing * factor)) {
-      if (progressdialog)
-        progressdialog->Update(press - min);
-      else {
-        wxDateTime now = wxDateTime::Now();
-        if ((now - start).GetSeconds() > 3 && press - min < (max - min) / 2) {
-          progressdialog = new wxGenericProgressDialog(
-              _("Building Isobar map"), _("Wind"), max - min + 1, nullptr,
-              wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME);
-        }
-      }
-
-      piso = new IsoLine(press,
-                         m_Settings.CalibrationFactor(settings, press, true),
-                         m_Settings.CalibrationOffset(settings), pGRA);
-
-      pIsobarArray[idx]->Add(piso);
+      values.push_back(press);
+      coeffs.push_back(m_Settings.CalibrationFactor(settings, press, true));
     }
-    delete progressdialog;
+
+    pIsoLines[idx] = GetIsoLines(settings, *pGRA, values, coeffs,
+                                 m_Settings.CalibrationOffset(settings));
 
     delete pGRM;
   }
 
+  // Still being extracted, draw once done
+  if (!pIsoLines[idx]->IsReady()) {
+    if (!m_tIsoLineTimer.IsRunning())
+      m_tIsoLineTimer.Start(100, wxTIMER_ONE_SHOT);
+    return;
+  }
+
   //    Draw the Isobars
-  for (unsigned int i = 0; i < pIsobarArray[idx]->GetCount(); i++) {
-    IsoLine *piso = (IsoLine *)pIsobarArray[idx]->Item(i);
+  for (size_t i = 0; i < pIsoLines[idx]->GetCount(); i++) {
+    IsoLine *piso = pIsoLines[idx]->Item(i);
     piso->drawIsoLine(this, m_pdc, vp, true);  // g_bGRIBUseHiDef
 
     // Draw Isobar labels
@@ -1503,6 +1498,85 @@ void GRIBOverlayFactory::RenderGribIsobar(int settings, GribRecord **pGR,
   }
 }
 
+std::shared_ptr<IsoLineSet> GRIBOverlayFactory::GetIsoLines(
+    int settings, const GribRecord &rec, const std::vector<double> &values,
+    const std::vector<double> &coeffs, double offset) {
+  // Key the isolines by what they are extracted from, interpolated records
+  // are rebuilt for each timeline position and can't be matched by address.
+  int ni = rec.getNi(), nj = rec.getNj();
+  std::vector<double> params = {double(ni),      double(nj),  rec.getLonMin(),
+                                rec.getLatMin(), rec.getDi(), rec.getDj(),
+                                offset};
+  for (size_t i = 0; i < values.size(); i++)
+    params.push_back(values[i]), params.push_back(coeffs[i]);
+
+  unsigned long long key = 14695981039346656037ULL;
+  auto mix = [&key](double v) {
+    unsigned long long bits;
+    memcpy(&bits, &v, sizeof bits);
+    key = (key ^ bits) * 1099511628211ULL;
+    key ^= key >> 32;
+  };
+  for (double v : params) mix(v);
+  rec.loadData();
+  for (int j = 0; j < nj; j++)
+    for (int i = 0; i < ni; i++) mix(rec.getValue(i, j));
+
+  // bitwise, so NaN and GRIB_NOTDEF values match themselves
+  auto same = [](double a, double b) { return !memcmp(&a, &b, sizeof a); };
+  for (auto it = m_IsoLineCache.begin(); it != m_IsoLineCache.end(); it++) {
+    if (it->settings != settings || it->key != key) continue;
+    if (it->params.size() != params.size() ||
+        memcmp(it->params.data(), params.data(),
+               params.size() * sizeof(double)))
+      continue;
+    bool match = true;
+    for (int j = 0; j < nj && match; j++)
+      for (int i = 0; i < ni && match; i++)
+        match = same(it->grid[j * ni + i], rec.getValue(i, j));
+    if (!match) continue;
+    m_IsoLineCache.splice(m_IsoLineCache.end(), m_IsoLineCache, it);
+    return m_IsoLineCache.back().isoLines;
+  }
+
+  // workers use their own copy, rec may be dropped or changed meanwhile
+  auto isoLines = std::make_shared<IsoLineSet>(new GribRecord(rec), values,
+                                               coeffs, offset);
+  IsoLineSet::Extract(isoLines, *m_Workers);
+
+  std::vector<double> grid(size_t(ni) * nj);
+  for (int j = 0; j < nj; j++)
+    for (int i = 0; i < ni; i++) grid[j * ni + i] = rec.getValue(i, j);
+  m_IsoLineCache.push_back(
+      {settings, key, std::move(params), std::move(grid), isoLines});
+
+  // a few forecast steps of each displayed type, at most 64 MB of values
+  const size_t max_entries = 32;
+  const size_t max_values = 8 * 1024 * 1024;
+  size_t kept = 0;
+  for (auto &entry : m_IsoLineCache) kept += entry.grid.size();
+  while (m_IsoLineCache.size() > 1 &&
+         (m_IsoLineCache.size() > max_entries || kept > max_values)) {
+    kept -= m_IsoLineCache.front().grid.size();
+    m_IsoLineCache.pop_front();
+  }
+  return isoLines;
+}
+
+void GRIBOverlayFactory::OnIsoLineTimer(wxTimerEvent &event) {
+  if (!m_pGribTimelineRecordSet) return;
+
+  for (int i = 0; i < Idx_COUNT; i++) {
+    std::shared_ptr<IsoLineSet> &isoLines =
+        m_pGribTimelineRecordSet->m_IsoLines[i];
+    if (isoLines && !isoLines->IsReady()) {
+      m_tIsoLineTimer.Start(100, wxTIMER_ONE_SHOT);
+      return;
+    }
+  }
+  RefreshCanvas();
+}
+
 void GRIBOverlayFactory::FillGrid(GribRecord *pGR) {
   //    Get the the grid
   int imax = pGR->getNi();  // Longitude
@@ -2075,6 +2149,11 @@ void GRIBOverlayFactory::DrawNumbers(wxPoint p, double value, int settings,
   }
 }
 
+namespace {
+// particles advanced by each parallel task
+const size_t PARTICLE_CHUNK = 1024;
+}  // namespace
+
 void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
                                              PlugIn_ViewPort *vp) {
   if (!m_Settings.Settings[settings].m_bParticles) return;
@@ -2098,10 +2177,7 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
 
   if (!m_ParticleMap) m_ParticleMap = new ParticleMap(settings);
 
-  std::vector<Particle> &particles = m_ParticleMap->m_Particles;
-
-  const int max_duration = 50;
-  const int run_count = 6;
+  ParticleMap &particles = *m_ParticleMap;
 
   double density = m_Settings.Settings[settings].m_dParticleDensity;
   //    density = density * sqrt(vp.view_scale_ppm);
@@ -2109,39 +2185,36 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
   int history_size = 27 / sqrt(density);
   history_size = wxMin(history_size, MAX_PARTICLE_HISTORY);
 
-  std::vector<Particle>::iterator it;
   // if the history size changed
-  if (m_ParticleMap->history_size != history_size) {
-    for (unsigned int i = 0; i < particles.size(); i++) {
-      Particle &it = particles[i];
-      if (m_ParticleMap->history_size > history_size &&
-          it.m_HistoryPos >= history_size) {
-        it = particles[particles.size() - 1];
-        particles.pop_back();
+  if (particles.history_size != history_size) {
+    for (size_t i = 0; i < particles.Count(); i++) {
+      if (particles.history_size > history_size &&
+          particles.m_HistoryPos[i] >= history_size) {
+        particles.Remove(i);
         i--;
         continue;
       }
 
-      it.m_HistorySize = it.m_HistoryPos + 1;
+      particles.m_HistorySize[i] = particles.m_HistoryPos[i] + 1;
     }
-    m_ParticleMap->history_size = history_size;
+    particles.history_size = history_size;
   }
 
   // Did the viewport change?  update cached screen coordinates
   // we could use normalized coordinates in opengl and avoid this
-  PlugIn_ViewPort &lvp = m_ParticleMap->last_viewport;
+  PlugIn_ViewPort &lvp = particles.last_viewport;
   if (lvp.bValid == false || vp->view_scale_ppm != lvp.view_scale_ppm ||
       vp->skew != lvp.skew || vp->rotation != lvp.rotation) {
-    for (it = particles.begin(); it != particles.end(); it++)
-      for (int i = 0; i < it->m_HistorySize; i++) {
-        Particle::ParticleNode &n = it->m_History[i];
-        float(&p)[2] = n.m_Pos;
+    for (size_t i = 0; i < particles.Count(); i++)
+      for (int j = 0; j < particles.m_HistorySize[i]; j++) {
+        float *p = particles.Pos(i, j);
         if (p[0] == -10000) continue;
 
         wxPoint ps;
         GetCanvasPixLL(vp, &ps, p[1], p[0]);
-        n.m_Screen[0] = ps.x;
-        n.m_Screen[1] = ps.y;
+        float *s = particles.Screen(i, j);
+        s[0] = ps.x;
+        s[1] = ps.y;
       }
 
     lvp = *vp;
@@ -2153,100 +2226,59 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
 
       p1 -= p2;
 
-      for (it = particles.begin(); it != particles.end(); it++)
-        for (int i = 0; i < it->m_HistorySize; i++) {
-          Particle::ParticleNode &n = it->m_History[i];
-          float(&p)[2] = n.m_Pos;
-          if (p[0] == -10000) continue;
+      for (size_t i = 0; i < particles.Count(); i++)
+        for (int j = 0; j < particles.m_HistorySize[i]; j++) {
+          if (particles.Pos(i, j)[0] == -10000) continue;
 
-          n.m_Screen[0] += p1.x;
-          n.m_Screen[1] += p1.y;
+          float *s = particles.Screen(i, j);
+          s[0] += p1.x;
+          s[1] += p1.y;
         }
       lvp = *vp;
     }
 
-  double ptime = 0;
-
   // update particle map
   if (m_bUpdateParticles) {
-    for (unsigned int i = 0; i < particles.size(); i++) {
-      Particle &it = particles[i];
-
-      // Update the interpolation factor
-      if (++it.m_Run < run_count) continue;
-      it.m_Run = 0;
-
-      // don't allow particle to live too long
-      if (it.m_Duration > max_duration) {
-        it = particles[particles.size() - 1];
-        particles.pop_back();
-        i--;
-        continue;
-      }
-
-      it.m_Duration++;
-
-      float(&pp)[2] = it.m_History[it.m_HistoryPos].m_Pos;
-
-      // maximum history size
-      if (++it.m_HistorySize > history_size) it.m_HistorySize = history_size;
-
-      if (++it.m_HistoryPos >= history_size) it.m_HistoryPos = 0;
-
-      Particle::ParticleNode &n = it.m_History[it.m_HistoryPos];
-      float(&p)[2] = n.m_Pos;
-      double vkn = 0, ang;
-
-      if (it.m_Duration < max_duration - history_size &&
-          GribRecord::getInterpolatedValues(vkn, ang, pGRX, pGRY, pp[0],
-                                            pp[1]) &&
-          vkn > 0 && vkn < 100) {
-        vkn = m_Settings.CalibrateValue(settings, vkn);
-        double d;
-        if (settings == GribOverlaySettings::CURRENT)
-          d = vkn * run_count;
-        else
-          d = vkn * run_count / 4;
-
-        ang += 180;
-
-#if 0    // elliptical very accurate but incredibly slow
-                double dp[2];
-                PositionBearingDistanceMercator_Plugin(pp[1], pp[0], ang,
-                                                       d, &dp[1], &dp[0]);
-                p[0] = dp[0];
-                p[1] = dp[1];
-#elif 0  // really fast rectangular.. not really good at high latitudes
-
-        float angr = ang / 180 * M_PI;
-        p[0] = pp[0] + sinf(angr) * d / 60;
-        p[1] = pp[1] + cosf(angr) * d / 60;
-#else  // spherical (close enough)
-        float angr = ang / 180 * M_PI;
-        float latr = pp[1] * M_PI / 180;
-        float D = d / 3443;  // earth radius in nm
-        float sD = sinf(D), cD = cosf(D);
-        float sy = sinf(latr), cy = cosf(latr);
-        float sa = sinf(angr), ca = cosf(angr);
-
-        p[0] = pp[0] + asinf(sa * sD / cy) * 180 / M_PI;
-        p[1] = asinf(sy * cD + cy * sD * ca) * 180 / M_PI;
-#endif
+    // values are read from the workers below
+    pGRX->loadData();
+    pGRY->loadData();
+
+    size_t count = particles.Count();
+    size_t chunks = (count + PARTICLE_CHUNK - 1) / PARTICLE_CHUNK;
+    bool current = settings == GribOverlaySettings::CURRENT;
+    auto calibrate = [this, settings](double v) {
+      return m_Settings.CalibrateValue(settings, v);
+    };
+    auto color = [this, settings](double v, wxUint8 &r, wxUint8 &g,
+                                  wxUint8 &b) {
+      GetGraphicColor(settings, v, r, g, b);
+    };
+    m_Workers->ParallelFor(chunks, [&](size_t chunk) {
+      particles.Advance(chunk * PARTICLE_CHUNK,
+                        wxMin(count, (chunk + 1) * PARTICLE_CHUNK), pGRX, pGRY,
+                        current, calibrate, color);
+    });
+
+    // project moved particles, GetCanvasPixLL() is plugin API and stays on
+    // this thread, and drop expired ones
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+      if (particles.m_State[i] == ParticleMap::EXPIRED) continue;
+
+      if (particles.m_State[i] == ParticleMap::MOVED) {
+        int pos = particles.m_HistoryPos[i];
+        float *p = particles.Pos(i, pos);
         wxPoint ps;
         GetCanvasPixLL(vp, &ps, p[1], p[0]);
 
-        n.m_Screen[0] = ps.x;
-        n.m_Screen[1] = ps.y;
-
-        wxColor c = GetGraphicColor(settings, vkn);
-
-        n.m_Color[0] = c.Red();
-        n.m_Color[1] = c.Green();
-        n.m_Color[2] = c.Blue();
-      } else
-        p[0] = -10000;
-      ptime += sw.Time();
+        float *s = particles.Screen(i, pos);
+        s[0] = ps.x;
+        s[1] = ps.y;
+      }
+      if (kept != i) particles.Move(i, kept);
+      kept++;
     }
+    particles.Resize(kept);
   }
   m_bUpdateParticles = false;
 
@@ -2256,12 +2288,13 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
   if (total_particles > 60000) total_particles = 60000;
 
   // remove particles if needed;
-  int remove_particles = ((int)particles.size() - total_particles) / 16;
-  for (int i = 0; i < remove_particles; i++) particles.pop_back();
+  int remove_particles = ((int)particles.Count() - total_particles) / 16;
+  if (remove_particles > 0)
+    particles.Resize(particles.Count() - remove_particles);
 
   // add new particles as needed
   int run = 0;
-  int new_particles = (total_particles - (int)particles.size()) / 64;
+  int new_particles = (total_particles - (int)particles.Count()) / 64;
 
   for (int npi = 0; npi < new_particles; npi++) {
     float p[2];
@@ -2287,26 +2320,25 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
         break;
     }
 
-    Particle np;
-    np.m_Duration = rand() % (max_duration / 2);
-    np.m_HistoryPos = 0;
-    np.m_HistorySize = 1;
-    np.m_Run = run++;
-    if (run == run_count) run = 0;
+    size_t np = particles.Count();
+    particles.Resize(np + 1);
+    particles.m_Duration[np] = rand() % (ParticleMap::MAX_DURATION / 2);
+    particles.m_HistoryPos[np] = 0;
+    particles.m_HistorySize[np] = 1;
+    particles.m_Run[np] = run++;
+    if (run == ParticleMap::RUN_COUNT) run = 0;
+    particles.m_State[np] = ParticleMap::KEPT;
 
-    memcpy(np.m_History[np.m_HistoryPos].m_Pos, p, sizeof p);
+    memcpy(particles.Pos(np, 0), p, sizeof p);
 
     wxPoint ps;
     GetCanvasPixLL(vp, &ps, p[1], p[0]);
-    np.m_History[np.m_HistoryPos].m_Screen[0] = ps.x;
-    np.m_History[np.m_HistoryPos].m_Screen[1] = ps.y;
+    float *s = particles.Screen(np, 0);
+    s[0] = ps.x;
+    s[1] = ps.y;
 
-    wxColour c = GetGraphicColor(settings, vkn);
-    np.m_History[np.m_HistoryPos].m_Color[0] = c.Red();
-    np.m_History[np.m_HistoryPos].m_Color[1] = c.Green();
-    np.m_History[np.m_HistoryPos].m_Color[2] = c.Blue();
-
-    particles.push_back(np);
+    wxUint8 *c = particles.Color(np, 0);
+    GetGraphicColor(settings, vkn, c[0], c[1], c[2]);
   }
 
   // settings for opengl lines
@@ -2320,28 +2352,26 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
   }
 
   int cnt = 0;
-  unsigned char *&ca = m_ParticleMap->color_array;
-  float *&va = m_ParticleMap->vertex_array;
-  float *&caf = m_ParticleMap->color_float_array;
+  unsigned char *&ca = particles.color_array;
+  float *&va = particles.vertex_array;
+  float *&caf = particles.color_float_array;
 
-  if (m_ParticleMap->array_size < particles.size() && !m_pdc) {
-    m_ParticleMap->array_size = 2 * particles.size();
+  if (particles.array_size < particles.Count() && !m_pdc) {
+    particles.array_size = 2 * particles.Count();
     delete[] ca;
     delete[] va;
     delete[] caf;
 
-    ca =
-        new unsigned char[m_ParticleMap->array_size * MAX_PARTICLE_HISTORY * 8];
-    caf = new float[m_ParticleMap->array_size * MAX_PARTICLE_HISTORY * 8];
-    va = new float[m_ParticleMap->array_size * MAX_PARTICLE_HISTORY * 4];
+    ca = new unsigned char[particles.array_size * MAX_PARTICLE_HISTORY * 8];
+    caf = new float[particles.array_size * MAX_PARTICLE_HISTORY * 8];
+    va = new float[particles.array_size * MAX_PARTICLE_HISTORY * 4];
   }
 
   // draw particles
-  for (std::vector<Particle>::iterator it = particles.begin();
-       it != particles.end(); it++) {
+  for (size_t pi = 0; pi < particles.Count(); pi++) {
     wxUint8 alpha = 250;
 
-    int i = it->m_HistoryPos;
+    int i = particles.m_HistoryPos[pi];
 
     bool lip_valid = false;
     float *lp = nullptr, lip[2];
@@ -2349,10 +2379,10 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
     float lcf[4];
 
     for (;;) {
-      float(&dp)[2] = it->m_History[i].m_Pos;
+      float *dp = particles.Pos(pi, i);
       if (dp[0] != -10000) {
-        float(&sp)[2] = it->m_History[i].m_Screen;
-        wxUint8(&ci)[3] = it->m_History[i].m_Color;
+        float *sp = particles.Screen(pi, i);
+        wxUint8 *ci = particles.Color(pi, i);
 
         wxUint8 c[4] = {ci[0], ci[1], (unsigned char)(ci[2] + 240 - alpha / 2),
                         alpha};
@@ -2367,7 +2397,7 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
 
           // interpolate between points..  a cubic interpolation
           // might allow a much higher run_count
-          float d = (float)it->m_Run / run_count;
+          float d = (float)particles.m_Run[pi] / ParticleMap::RUN_COUNT;
           for (int j = 0; j < 2; j++) sip[j] = d * lp[j] + (1 - d) * sp[j];
 
           if (lip_valid && fabsf(lip[0] - sip[0]) < vp->pix_width) {
@@ -2377,11 +2407,11 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
             } else {
               memcpy(ca + 4 * cnt, c, sizeof lc);
               memcpy(caf + 4 * cnt, cf, sizeof lcf);
-              memcpy(va + 2 * cnt, lip, sizeof sp);
+              memcpy(va + 2 * cnt, lip, sizeof lip);
               cnt++;
               memcpy(ca + 4 * cnt, lc, sizeof c);
               memcpy(caf + 4 * cnt, lcf, sizeof cf);
-              memcpy(va + 2 * cnt, sip, sizeof sp);
+              memcpy(va + 2 * cnt, sip, sizeof sip);
               cnt++;
             }
           }
@@ -2398,10 +2428,10 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
 
       if (--i < 0) {
         i = history_size - 1;
-        if (i >= it->m_HistorySize) break;
+        if (i >= particles.m_HistorySize[pi]) break;
       }
 
-      if (i == it->m_HistoryPos) break;
+      if (i == particles.m_HistoryPos[pi]) break;
 
       alpha -= 240 / history_size;
     }
@@ -2440,7 +2470,10 @@ void GRIBOverlayFactory::RenderGribParticles(int settings, GribRecord **pGR,
 
 void GRIBOverlayFactory::OnParticleTimer(wxTimerEvent &event) {
   m_bUpdateParticles = true;
+  RefreshCanvas();
+}
 
+void GRIBOverlayFactory::RefreshCanvas() {
   // If multicanvas are active, render the overlay on the right canvas only
   if (GetCanvasCount() > 1)               // multi?
     GetCanvasByIndex(1)->Refresh(false);  // update the last rendered canvas
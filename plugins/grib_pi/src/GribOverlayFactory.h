@@ -43,6 +43,8 @@
 
 #include "pi_ocpndc.h"
 #include "pi_TexFont.h"
+#include "GribParticles.h"
+#include "GribThreadPool.h"
 
 /**
  * Container for rendered GRIB data visualizations in texture or bitmap form.
@@ -79,67 +81,10 @@ public:
   double m_dwidth, m_dheight;
 };
 
-#define MAX_PARTICLE_HISTORY 8
+#include <algorithm>
 #include <vector>
 #include <list>
-/**
- * Individual particle for wind/current animation.
- *
- * Represents a single particle in the animation system with position history
- * and rendering attributes.
- */
-struct Particle {
-  /** Duration this particle should exist in animation cycles. */
-  int m_Duration;
-
-  // history is a ringbuffer.. because so many particles are
-  // used, it is a slight optimization over std::list
-  int m_HistoryPos, m_HistorySize, m_Run;
-  struct ParticleNode {
-    float m_Pos[2];
-    float m_Screen[2];
-    wxUint8 m_Color[3];
-  } m_History[MAX_PARTICLE_HISTORY];
-};
-
-/**
- * Manager for particle animation system.
- *
- * Handles collections of particles and their rendering data arrays.
- */
-struct ParticleMap {
-public:
-  ParticleMap(int settings)
-      : m_Setting(settings),
-        history_size(0),
-        array_size(0),
-        color_array(nullptr),
-        vertex_array(nullptr),
-        color_float_array(nullptr) {
-    // XXX should be done in default PlugIn_ViewPort CTOR
-    last_viewport.bValid = false;
-  }
-
-  ~ParticleMap() {
-    delete[] color_array;
-    delete[] vertex_array;
-    delete[] color_float_array;
-  }
-
-  std::vector<Particle> m_Particles;
-
-  // particles are rebuilt whenever any of these fields change
-  time_t m_Reference_Time;
-  int m_Setting;
-  int history_size;
-
-  unsigned int array_size;
-  unsigned char *color_array;
-  float *vertex_array;
-  float *color_float_array;
-
-  PlugIn_ViewPort last_viewport;
-};
+#include <memory>
 
 class LineBuffer {
 public:
@@ -165,6 +110,7 @@ private:
 class GRIBUICtrlBar;
 class GribRecord;
 class GribTimelineRecordSet;
+class IsoLineSet;
 
 /**
  * Factory class for creating and managing GRIB data visualizations.
@@ -240,17 +186,28 @@ private:
    *
    * This function draws isobar lines at specific intervals defined in the
    * settings. It also handles label placement along the isobars. For pressure,
-   * the function supports different unit conversions. The implementation caches
-   * isobar calculations to improve performance.
+   * the function supports different unit conversions. Isobars are extracted
+   * level by level on the worker threads and nothing is drawn until they are
+   * all done, they are cached per record content so they are not extracted
+   * again when the same record is displayed later.
    *
    * @param settings The settings index identifying the data type (PRESSURE,
    * etc.)
    * @param pGR Array of GribRecord pointers containing the data
-   * @param pIsobarArray Array of cached isobar objects for reuse
+   * @param pIsoLines Array of cached isobar sets for reuse
    * @param vp Current viewport for rendering
    */
   void RenderGribIsobar(int config, GribRecord **pGR,
-                        wxArrayPtrVoid **pIsobarArray, PlugIn_ViewPort *vp);
+                        std::shared_ptr<IsoLineSet> *pIsoLines,
+                        PlugIn_ViewPort *vp);
+  /**
+   * Returns the isolines of record rec at values, from the cache or queued
+   * for extraction on a copy of rec.
+   */
+  std::shared_ptr<IsoLineSet> GetIsoLines(int settings, const GribRecord &rec,
+                                          const std::vector<double> &values,
+                                          const std::vector<double> &coeffs,
+                                          double offset);
   /**
    * Renders direction arrows for vector fields like wind or current.
    *
@@ -309,6 +266,8 @@ private:
   void RenderGribParticles(int settings, GribRecord **pGR, PlugIn_ViewPort *vp);
   void DrawLineBuffer(LineBuffer &buffer);
   void OnParticleTimer(wxTimerEvent &event);
+  void OnIsoLineTimer(wxTimerEvent &event);
+  void RefreshCanvas();
 
   wxString GetRefString(GribRecord *rec, int map);
   void DrawMessageWindow(wxString msg, int x, int y, wxFont *mfont);
@@ -371,11 +330,35 @@ private:
   wxTimer m_tParticleTimer;
   bool m_bUpdateParticles;
 
+  /**
+   * Isolines of a record, keyed by a hash of its values and levels. The
+   * hash only selects candidates, a hit must have the same grid, levels and
+   * values.
+   */
+  struct IsoLineCacheEntry {
+    int settings;
+    unsigned long long key;
+    /** Grid geometry, levels and calibration the isolines were built with. */
+    std::vector<double> params;
+    /** Record values the isolines were extracted from. */
+    std::vector<double> grid;
+    std::shared_ptr<IsoLineSet> isoLines;
+  };
+  /** Recently used isolines, most recent last. */
+  std::list<IsoLineCacheEntry> m_IsoLineCache;
+  /** Polls isolines being extracted and redraws once they are done. */
+  wxTimer m_tIsoLineTimer;
+
   LineBuffer m_WindArrowCache[14];
   LineBuffer m_SingleArrow[2], m_DoubleArrow[2];
 
   double m_pixelMM;
   int windArrowSize;
+
+  /** Worker threads, shared with the GRIB readers. */
+  // last so the workers are joined before anything they use is destroyed,
+  // when the factory holds the last reference to the pool
+  std::shared_ptr<GribThreadPool> m_Workers;
 };
 
 #endif
\ No newline at end of file
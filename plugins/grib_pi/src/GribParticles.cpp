@@ -0,0 +1,106 @@
+/***************************************************************************
+ *   Copyright (C) 2014 by David S. Register                               *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+/**
+ * \file
+ * \implements \ref GribParticles.h
+ */
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+#include "wx/wx.h"
+#endif  // precompiled headers
+
+#include <cmath>
+
+#include "GribParticles.h"
+#include "GribRecord.h"
+
+void ParticleMap::Advance(size_t begin, size_t end, const GribRecord *pGRX,
+                          const GribRecord *pGRY, bool current,
+                          const std::function<double(double)> &calibrate,
+                          const ParticleColorFn &color) {
+  for (size_t i = begin; i < end; i++) {
+    wxUint8 &state = m_State[i];
+    state = KEPT;
+
+    // Update the interpolation factor
+    if (++m_Run[i] < RUN_COUNT) continue;
+    m_Run[i] = 0;
+
+    // don't allow particle to live too long
+    if (m_Duration[i] > MAX_DURATION) {
+      state = EXPIRED;
+      continue;
+    }
+
+    int duration = ++m_Duration[i];
+
+    int &pos = m_HistoryPos[i];
+    float *pp = Pos(i, pos);
+
+    // maximum history size
+    if (++m_HistorySize[i] > history_size) m_HistorySize[i] = history_size;
+
+    if (++pos >= history_size) pos = 0;
+
+    float *p = Pos(i, pos);
+    double vkn = 0, ang;
+
+    if (duration < MAX_DURATION - history_size &&
+        GribRecord::getInterpolatedValues(vkn, ang, pGRX, pGRY, pp[0],
+                                          pp[1]) &&
+        vkn > 0 && vkn < 100) {
+      vkn = calibrate(vkn);
+      double d;
+      if (current)
+        d = vkn * RUN_COUNT;
+      else
+        d = vkn * RUN_COUNT / 4;
+
+      ang += 180;
+
+#if 0    // elliptical very accurate but incredibly slow
+            double dp[2];
+            PositionBearingDistanceMercator_Plugin(pp[1], pp[0], ang,
+                                                   d, &dp[1], &dp[0]);
+            p[0] = dp[0];
+            p[1] = dp[1];
+#elif 0  // really fast rectangular.. not really good at high latitudes
+
+      float angr = ang / 180 * M_PI;
+      p[0] = pp[0] + sinf(angr) * d / 60;
+      p[1] = pp[1] + cosf(angr) * d / 60;
+#else  // spherical (close enough)
+      float angr = ang / 180 * M_PI;
+      float latr = pp[1] * M_PI / 180;
+      float D = d / 3443;  // earth radius in nm
+      float sD = sinf(D), cD = cosf(D);
+      float sy = sinf(latr), cy = cosf(latr);
+      float sa = sinf(angr), ca = cosf(angr);
+
+      p[0] = pp[0] + asinf(sa * sD / cy) * 180 / M_PI;
+      p[1] = asinf(sy * cD + cy * sD * ca) * 180 / M_PI;
+#endif
+      wxUint8 *c = Color(i, pos);
+      color(vkn, c[0], c[1], c[2]);
+      state = MOVED;
+    } else
+      p[0] = -10000;
+  }
+}
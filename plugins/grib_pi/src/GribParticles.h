@@ -0,0 +1,165 @@
+/***************************************************************************
+ *   Copyright (C) 2014 by David S. Register                               *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ ***************************************************************************/
+/**
+ * \file
+ * Particles animating the wind and current overlays.
+ *
+ * Each particle moves with the flow and keeps a short history of its
+ * positions, drawn as a fading trail.
+ */
+#ifndef GRIBPARTICLES_H
+#define GRIBPARTICLES_H
+
+#include <algorithm>
+#include <ctime>
+#include <functional>
+#include <vector>
+
+#include "ocpn_plugin.h"
+
+class GribRecord;
+
+#define MAX_PARTICLE_HISTORY 8
+
+/** Sets the RGB color of a particle moving at a calibrated speed. */
+typedef std::function<void(double, wxUint8 &, wxUint8 &, wxUint8 &)>
+    ParticleColorFn;
+
+/**
+ * Manager for particle animation system.
+ *
+ * Handles collections of particles and their rendering data arrays.
+ * Particles are stored as a structure of arrays, each field of all
+ * particles is contiguous so the update step can process them in
+ * independent chunks.
+ */
+struct ParticleMap {
+public:
+  ParticleMap(int settings)
+      : m_Setting(settings),
+        history_size(0),
+        array_size(0),
+        color_array(nullptr),
+        vertex_array(nullptr),
+        color_float_array(nullptr) {
+    // XXX should be done in default PlugIn_ViewPort CTOR
+    last_viewport.bValid = false;
+  }
+
+  ~ParticleMap() {
+    delete[] color_array;
+    delete[] vertex_array;
+    delete[] color_float_array;
+  }
+
+  /** Update steps between two history nodes of a particle. */
+  static const int RUN_COUNT = 6;
+  /** Particle lifetime in history nodes. */
+  static const int MAX_DURATION = 50;
+  /** Outcome of the last update step of a particle, see m_State. */
+  enum { KEPT, MOVED, EXPIRED };
+
+  size_t Count() const { return m_Duration.size(); }
+
+  /** Resizes all particle arrays, new particles are uninitialized. */
+  void Resize(size_t count) {
+    m_Duration.resize(count);
+    m_HistoryPos.resize(count);
+    m_HistorySize.resize(count);
+    m_Run.resize(count);
+    m_State.resize(count);
+    m_Pos.resize(count * MAX_PARTICLE_HISTORY * 2);
+    m_Screen.resize(count * MAX_PARTICLE_HISTORY * 2);
+    m_Color.resize(count * MAX_PARTICLE_HISTORY * 3);
+  }
+
+  /** Copies particle from over particle to. */
+  void Move(size_t from, size_t to) {
+    m_Duration[to] = m_Duration[from];
+    m_HistoryPos[to] = m_HistoryPos[from];
+    m_HistorySize[to] = m_HistorySize[from];
+    m_Run[to] = m_Run[from];
+    m_State[to] = m_State[from];
+    std::copy_n(Pos(from, 0), MAX_PARTICLE_HISTORY * 2, Pos(to, 0));
+    std::copy_n(Screen(from, 0), MAX_PARTICLE_HISTORY * 2, Screen(to, 0));
+    std::copy_n(Color(from, 0), MAX_PARTICLE_HISTORY * 3, Color(to, 0));
+  }
+
+  /** Removes particle i, replacing it by the last particle. */
+  void Remove(size_t i) {
+    size_t last = Count() - 1;
+    if (i != last) Move(last, i);
+    Resize(last);
+  }
+
+  /**
+   * Advances particles [begin, end) by one update step in the wind or
+   * current given by pGRX and pGRY, recording the outcome in m_State.
+   * Invoked from the worker threads on disjoint ranges: the record values
+   * must be loaded and screen positions are updated by the caller.
+   * @param current True for currents, winds move particles 4 times slower.
+   * @param calibrate Converts a speed read from the records to display units.
+   * @param color Sets the color of a node moving at a calibrated speed.
+   */
+  void Advance(size_t begin, size_t end, const GribRecord *pGRX,
+               const GribRecord *pGRY, bool current,
+               const std::function<double(double)> &calibrate,
+               const ParticleColorFn &color);
+
+  /** Longitude and latitude of history node of particle i. */
+  float *Pos(size_t i, int node) {
+    return &m_Pos[(i * MAX_PARTICLE_HISTORY + node) * 2];
+  }
+  /** Screen position of history node of particle i. */
+  float *Screen(size_t i, int node) {
+    return &m_Screen[(i * MAX_PARTICLE_HISTORY + node) * 2];
+  }
+  /** RGB color of history node of particle i. */
+  wxUint8 *Color(size_t i, int node) {
+    return &m_Color[(i * MAX_PARTICLE_HISTORY + node) * 3];
+  }
+
+  /** Duration each particle should exist in animation cycles. */
+  std::vector<int> m_Duration;
+
+  // history is a ringbuffer.. because so many particles are
+  // used, it is a slight optimization over std::list
+  std::vector<int> m_HistoryPos, m_HistorySize, m_Run;
+
+  /** Outcome of the last update step of each particle. */
+  std::vector<wxUint8> m_State;
+
+  // history nodes, MAX_PARTICLE_HISTORY per particle
+  std::vector<float> m_Pos, m_Screen;
+  std::vector<wxUint8> m_Color;
+
+  // particles are rebuilt whenever any of these fields change
+  time_t m_Reference_Time;
+  int m_Setting;
+  int history_size;
+
+  unsigned int array_size;
+  unsigned char *color_array;
+  float *vertex_array;
+  float *color_float_array;
+
+  PlugIn_ViewPort last_viewport;
+};
+
+#endif
@@ -34,11 +34,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 GribReader::GribReader() {
   ok = false;
   dewpointDataStatus = NO_DATA_IN_FILE;
+  dataCache = std::make_shared<GribDataCache>();
 }
 //-------------------------------------------------------------------------------
 GribReader::GribReader(const wxString fname) {
   ok = false;
   dewpointDataStatus = NO_DATA_IN_FILE;
+  dataCache = std::make_shared<GribDataCache>();
   if (fname != _T("")) {
     openFile(fname);
   } else {
@@ -125,6 +127,14 @@ void GribReader::readAllGribRecords() {
   bool b_EOF;
   bool is_v2 = false;
 
+  // Seeking back in a compressed file means decompressing it again from
+  // the start, only index records of uncompressed files.
+  std::shared_ptr<GribDataFile> dataFile;
+  if (file->type == ZU_COMPRESS_NONE) {
+    dataFile = std::make_shared<GribDataFile>(
+        std::string((const char *)fileName.mb_str()), dataCache);
+  }
+
   do {
     id++;
     // use the previously seen record type first
@@ -133,10 +143,10 @@ void GribReader::readAllGribRecords() {
     // file from the start
 
     if (is_v2 == false) {
-      rec = new GribV1Record(file, id);
+      rec = new GribV1Record(file, id, dataFile);
       if (rec->isOk() == false) {
         delete rec;
-        rec = new GribV2Record(file, id);
+        rec = new GribV2Record(file, id, dataFile);
         is_v2 = rec->isOk();
       }
     } else {
@@ -145,13 +155,13 @@ void GribReader::readAllGribRecords() {
         rec = rec2->GribV2NextDataSet(file, id);
         delete prevDataSet;
       } else {
-        rec = new GribV2Record(file, id);
+        rec = new GribV2Record(file, id, dataFile);
       }
 
       is_v2 = rec->isOk();
       if (rec->isOk() == false) {
         delete rec;
-        rec = new GribV1Record(file, id);
+        rec = new GribV1Record(file, id, dataFile);
       }
     }
     prevDataSet = nullptr;
@@ -353,6 +363,7 @@ void GribReader::computeAccumulationRecords(int dataType, int levelType,
   int p1 = 0, p2 = 0;
 
   if (setdates.empty()) return;
+  loadRecords(dataType, levelType, levelValue);
 
   // XXX only work if P2 -P1 === time
   for (rit = setdates.rbegin(); rit != setdates.rend(); ++rit) {
@@ -427,6 +438,8 @@ void GribReader::readGribFileContent() {
   //    hoursBetweenRecords = computeHoursBeetweenGribRecords();
   // XXX should it be done after reading all files, rather than per file?
   if (getNumberOfGribRecords(GRB_WIND_GUST, LV_GND_SURF, 0) == 0) {
+    loadRecords(GRB_WIND_GUST_VX, LV_GND_SURF, 0);
+    loadRecords(GRB_WIND_GUST_VY, LV_GND_SURF, 0);
     for (auto date : setAllDates) {
       GribRecord *recX = getGribRecord(GRB_WIND_GUST_VX, LV_GND_SURF, 0, date);
       if (recX == nullptr) continue;
@@ -451,6 +464,8 @@ void GribReader::readGribFileContent() {
     return;
 
   dewpointDataStatus = COMPUTED_DATA;
+  loadRecords(GRB_TEMP, LV_ABOV_GND, 2);
+  loadRecords(GRB_HUMID_REL, LV_ABOV_GND, 2);
   for (auto iter : setAllDates) {
     time_t date = iter;
     GribRecord *recModel = getGribRecord(GRB_TEMP, LV_ABOV_GND, 2, date);
@@ -458,6 +473,7 @@ void GribReader::readGribFileContent() {
 
     // Crée un GribRecord avec les dewpoints calculés
     GribRecord *recDewpoint = new GribRecord(*recModel);
+    recDewpoint->detachData();
     recDewpoint->setDataType(GRB_DEWPOINT);
     for (zuint i = 0; i < (zuint)recModel->getNi(); i++) {
       for (zuint j = 0; j < (zuint)recModel->getNj(); j++) {
@@ -508,6 +524,13 @@ int GribReader::getNumberOfGribRecords(int dataType, int levelType,
     return 0;
 }
 
+//---------------------------------------------------------------------
+void GribReader::loadRecords(int dataType, int levelType, int levelValue) {
+  std::vector<GribRecord *> *liste =
+      getListOfGribRecords(dataType, levelType, levelValue);
+  if (liste != nullptr) dataCache->load(*liste);
+}
+
 //---------------------------------------------------------------------
 std::vector<GribRecord *> *GribReader::getListOfGribRecords(int dataType,
                                                             int levelType,
@@ -45,8 +45,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <vector>
 #include <set>
 #include <map>
+#include <memory>
 
 #include "GribRecord.h"
+#include "GribDataCache.h"
 #include "zuFile.h"
 
 //===============================================================
@@ -56,6 +58,11 @@ public:
   GribReader(const wxString fname);
   ~GribReader();
 
+  /**
+   * Reads the records of a file. Records of uncompressed files are only
+   * indexed, their values are decoded on first use and kept in the data
+   * cache. Records of compressed files are decoded while reading.
+   */
   void openFile(const wxString fname);
   bool isOk() { return ok; }
   long getFileSize() { return fileSize; }
@@ -124,6 +131,9 @@ public:
     return &mapGribRecords;
   }  // dsr
 
+  /** Decoded values of the lazily decoded records of all files. */
+  GribDataCache &getDataCache() { return *dataCache; }
+
 private:
   bool ok;
   wxString fileName;
@@ -131,10 +141,13 @@ private:
   long fileSize;
   //        double    hoursBetweenRecords;
   int dewpointDataStatus;
+  std::shared_ptr<GribDataCache> dataCache;
 
   std::map<std::string, std::vector<GribRecord *> *> mapGribRecords;
 
   void storeRecordInMap(GribRecord *rec);
+  // Decode all records of a type in parallel before computing from them
+  void loadRecords(int dataType, int levelType, int levelValue);
 
   void readGribFileContent();
   void readAllGribRecords();
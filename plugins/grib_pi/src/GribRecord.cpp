@@ -30,6 +30,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // #include <QDateTime>
 
 #include "GribRecord.h"
+#include "GribDataCache.h"
 
 // interpolate two angles in range +- 180 or +-PI, with resulting angle in the
 // same range
@@ -61,8 +62,14 @@ GribRecord::GribRecord(const GribRecord &rec) {
   // recopie les champs de bits
   if (rec.data != nullptr) {
     int size = rec.Ni * rec.Nj;
-    this->data = new double[size];
-    for (int i = 0; i < size; i++) this->data[i] = rec.data[i];
+    double *values = new double[size];
+    for (int i = 0; i < size; i++) values[i] = rec.data[i];
+    if (m_packed) {
+      this->data = nullptr;
+      m_packed->getCache().insert(this, values);
+    } else {
+      this->data = values;
+    }
   }
   if (rec.BMSbits != nullptr) {
     int size = rec.BMSsize;
@@ -159,6 +166,8 @@ bool GribRecord::GetInterpolatedParameters(
 GribRecord *GribRecord::InterpolatedRecord(const GribRecord &rec1,
                                            const GribRecord &rec2, double d,
                                            bool dir) {
+  rec1.loadData();
+  rec2.loadData();
   double La1, Lo1, La2, Lo2, Di, Dj;
   int im1, jm1, im2, jm2;
   int Ni, Nj, rec1offi, rec1offj, rec2offi, rec2offj;
@@ -204,6 +213,8 @@ GribRecord *GribRecord::InterpolatedRecord(const GribRecord &rec1,
 
   GribRecord *ret = new GribRecord;
   *ret = rec1;
+  ret->m_packed.reset();
+  ret->m_dataScale = 1.;
 
   ret->Di = Di, ret->Dj = Dj;
   ret->Ni = Ni, ret->Nj = Nj;
@@ -233,6 +244,10 @@ GribRecord *GribRecord::Interpolated2DRecord(
   int Ni, Nj, rec1offi, rec1offj, rec2offi, rec2offj;
 
   rety = 0;
+  rec1x.loadData();
+  rec1y.loadData();
+  rec2x.loadData();
+  rec2y.loadData();
   if (!GetInterpolatedParameters(rec1x, rec2x, La1, Lo1, La2, Lo2, Di, Dj, im1,
                                  jm1, im2, jm2, Ni, Nj, rec1offi, rec1offj,
                                  rec2offi, rec2offj))
@@ -286,6 +301,8 @@ GribRecord *GribRecord::Interpolated2DRecord(
   GribRecord *ret = new GribRecord;
 
   *ret = rec1x;
+  ret->m_packed.reset();
+  ret->m_dataScale = 1.;
 
   ret->Di = Di, ret->Dj = Dj;
   ret->Ni = Ni, ret->Nj = Nj;
@@ -312,7 +329,10 @@ GribRecord *GribRecord::Interpolated2DRecord(
 
 GribRecord *GribRecord::MagnitudeRecord(const GribRecord &rec1,
                                         const GribRecord &rec2) {
+  rec1.loadData();
+  rec2.loadData();
   GribRecord *rec = new GribRecord(rec1);
+  rec->detachData();
 
   /* generate a record which is the combined magnitude of two records */
   if (rec1.data && rec2.data && rec1.Ni == rec2.Ni && rec1.Nj == rec2.Nj) {
@@ -338,6 +358,8 @@ GribRecord *GribRecord::MagnitudeRecord(const GribRecord &rec1,
 }
 
 void GribRecord::Polar2UV(GribRecord *pDIR, GribRecord *pSPEED) {
+  pDIR->detachData();
+  pSPEED->detachData();
   if (pDIR->data && pSPEED->data && pDIR->Ni == pSPEED->Ni &&
       pDIR->Nj == pSPEED->Nj) {
     int size = pDIR->Ni * pDIR->Nj;
@@ -361,12 +383,15 @@ void GribRecord::Polar2UV(GribRecord *pDIR, GribRecord *pSPEED) {
 
 void GribRecord::Substract(const GribRecord &rec, bool pos) {
   // for now only substract records of same size
+  rec.loadData();
   if (rec.data == 0 || !rec.isOk()) return;
 
+  loadData();
   if (data == 0 || !isOk()) return;
 
   if (Ni != rec.Ni || Nj != rec.Nj) return;
 
+  detachData();
   zuint size = Ni * Nj;
   for (zuint i = 0; i < size; i++) {
     if (rec.data[i] == GRIB_NOTDEF) continue;
@@ -397,8 +422,10 @@ void GribRecord::Average(const GribRecord &rec) {
   // rec  : 0-11
   // compute average 11-12
 
+  rec.loadData();
   if (rec.data == 0 || !rec.isOk()) return;
 
+  loadData();
   if (data == 0 || !isOk()) return;
 
   if (Ni != rec.Ni || Nj != rec.Nj) return;
@@ -410,6 +437,7 @@ void GribRecord::Average(const GribRecord &rec) {
 
   if (d2 <= d1) return;
 
+  detachData();
   zuint size = Ni * Nj;
   double diff = d2 - d1;
   for (zuint i = 0; i < size; i++) {
@@ -439,6 +467,7 @@ std::string GribRecord::makeKey(
 }
 //-----------------------------------------
 GribRecord::~GribRecord() {
+  if (m_packed && data) m_packed->getCache().remove(this);
   if (data) {
     delete[] data;
     data = nullptr;
@@ -454,17 +483,53 @@ GribRecord::~GribRecord() {
 
 //-------------------------------------------------------------------------------
 void GribRecord::multiplyAllData(double k) {
-  if (data == 0 || !isOk()) return;
+  if (!isOk()) return;
+  // Also applied to the values decoded again after being dropped
+  if (m_packed) m_dataScale *= k;
+  if (data == 0) return;
+  scaleValues(data, k);
+}
 
+//-------------------------------------------------------------------------------
+void GribRecord::scaleValues(double *values, double k) const {
   for (zuint j = 0; j < Nj; j++) {
     for (zuint i = 0; i < Ni; i++) {
-      if (isDefined(i, j)) {
-        data[j * Ni + i] *= k;
+      if (hasValue(i, j) && values[j * Ni + i] != GRIB_NOTDEF) {
+        values[j * Ni + i] *= k;
       }
     }
   }
 }
 
+//-------------------------------------------------------------------------------
+bool GribRecord::loadData() const {
+  if (data != nullptr) {
+    if (m_packed) m_packed->getCache().touch(this);
+    return true;
+  }
+  if (!m_packed) return false;
+
+  double *values = m_packed->decode(*this);
+  if (values == nullptr) {
+    erreur("Record %d: can't decode data", id);
+    values = new double[Ni * Nj];
+    for (zuint i = 0; i < Ni * Nj; i++) values[i] = GRIB_NOTDEF;
+  } else if (m_dataScale != 1.) {
+    scaleValues(values, m_dataScale);
+  }
+  m_packed->getCache().insert(const_cast<GribRecord *>(this), values);
+  return true;
+}
+
+//-------------------------------------------------------------------------------
+void GribRecord::detachData() {
+  if (!m_packed) return;
+  loadData();
+  m_packed->getCache().remove(this);
+  m_packed.reset();
+  m_dataScale = 1.;
+}
+
 //----------------------------------------------
 void GribRecord::setRecordCurrentDate(time_t t) {
   curDate = t;
@@ -29,6 +29,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <iostream>
 #include <cmath>
+#include <memory>
+
+class GribPackedData;
 
 #define DEBUG_INFO false
 #define DEBUG_ERROR true
@@ -181,7 +184,10 @@ public:
  */
 class GribRecord {
 public:
-  /** Copy constructor performs a deep copy of the GribRecord. */
+  /**
+   * Copy constructor performs a deep copy of the GribRecord. The copy of a
+   * lazily decoded record is lazy too, sharing its packed values.
+   */
   GribRecord(const GribRecord &rec);
   GribRecord() { m_bfilled = false; }
 
@@ -274,6 +280,24 @@ public:
   void Substract(const GribRecord &rec, bool positive = true);
   void Average(const GribRecord &rec);
 
+  /**
+   * Decodes the values of a record read by the header only pass of
+   * GribReader, a no-op if they are present. Invoked by the value
+   * accessors, callers reading values from several threads must invoke it
+   * first.
+   *
+   * @return false if there are no values, true otherwise. Values which
+   * can't be decoded read as GRIB_NOTDEF.
+   */
+  bool loadData() const;
+  /**
+   * Decodes values if needed and keeps them for the record lifetime. Used
+   * before changing values in a way decoding again would not reproduce.
+   */
+  void detachData();
+  /** Returns true if values are decoded lazily and may be dropped. */
+  bool isLazy() const { return m_packed != nullptr; }
+
   bool isOk() const { return ok; };
   bool isDataKnown() const { return knownData; };
   bool isEof() const { return eof; };
@@ -477,9 +501,17 @@ public:
    * @return Data value at grid point (i,j)
    * @note No bounds checking is performed
    */
-  double getValue(int i, int j) const { return data[j * Ni + i]; }
+  double getValue(int i, int j) const {
+    if (data == nullptr) loadData();
+    return data[j * Ni + i];
+  }
 
+  /**
+   * Sets the value at a grid point. Changes to a lazily decoded record are
+   * lost when its values are dropped from the cache, see detachData().
+   */
   void setValue(zuint i, zuint j, double v) {
+    if (data == nullptr) loadData();
     if (i < Ni && j < Nj) data[j * Ni + i] = v;
   }
 
@@ -589,6 +621,11 @@ public:
   void setFilled(bool val = true) { m_bfilled = val; }
 
 private:
+  friend class GribDataCache;
+
+  /** Multiply defined values by k, as multiplyAllData(). */
+  void scaleValues(double *values, double k) const;
+
   // Is a point within the extent of the grid?
   inline bool isPointInMap(double x, double y) const;
   inline bool isXInMap(double x) const;
@@ -666,6 +703,13 @@ protected:
    * partial loading states during record construction.
    */
   bool m_bfilled;
+  /**
+   * Location of the packed values of a record read by the header only
+   * pass, nullptr if the record owns its values.
+   */
+  std::shared_ptr<GribPackedData> m_packed;
+  /** Factor applied to values when they are decoded. */
+  double m_dataScale = 1.;
 
   //---------------------------------------------
   // SECTION 0: THE INDICATOR SECTION (IS)
@@ -763,7 +807,7 @@ protected:
   zuint BMSsize;
   zuchar *BMSbits;
   // SECTION 4: BINARY DATA SECTION (BDS)
-  double *data;
+  mutable double *data;
   // SECTION 5: END SECTION (ES)
 
   time_t makeDate(zuint year, zuint month, zuint day, zuint hour, zuint min,
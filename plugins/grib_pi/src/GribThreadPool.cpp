@@ -0,0 +1,130 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+/**
+ * \file
+ * \implements \ref GribThreadPool.h
+ */
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "GribThreadPool.h"
+
+GribThreadPool::GribThreadPool(unsigned int threadCount) : m_bStop(false) {
+  if (threadCount == 0) {
+    unsigned int cpus = std::thread::hardware_concurrency();
+    threadCount = std::max(1u, cpus > 1 ? cpus - 1 : 1);
+  }
+  for (unsigned int i = 0; i < threadCount; i++)
+    m_Threads.emplace_back(&GribThreadPool::Run, this);
+}
+
+GribThreadPool::~GribThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_bStop = true;
+    m_Tasks.clear();
+  }
+  m_Cond.notify_all();
+  for (auto &thread : m_Threads) thread.join();
+}
+
+std::shared_ptr<GribThreadPool> GribThreadPool::GetShared() {
+  static std::mutex mutex;
+  static std::weak_ptr<GribThreadPool> shared;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto pool = shared.lock();
+  if (!pool) {
+    pool = std::make_shared<GribThreadPool>();
+    shared = pool;
+  }
+  return pool;
+}
+
+void GribThreadPool::Submit(std::function<void()> task) {
+  Push(std::move(task), false);
+}
+
+void GribThreadPool::Push(std::function<void()> task, bool front) {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (front)
+      m_Tasks.push_front(std::move(task));
+    else
+      m_Tasks.push_back(std::move(task));
+  }
+  m_Cond.notify_one();
+}
+
+void GribThreadPool::Run() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_Cond.wait(lock, [this] { return m_bStop || !m_Tasks.empty(); });
+      if (m_bStop) return;
+      task = std::move(m_Tasks.front());
+      m_Tasks.pop_front();
+    }
+    task();
+  }
+}
+
+namespace {
+// Shared by the caller and the helpers of a ParallelFor(), helpers may
+// still be queued when the caller returns.
+struct ParallelForState {
+  ParallelForState(size_t count, const std::function<void(size_t)> *fn)
+      : next(0), busy(0), count(count), fn(fn) {}
+
+  // Runs the remaining items, fn is not used once they are all taken
+  void Work() {
+    for (size_t i = next++; i < count; i = next++) (*fn)(i);
+  }
+
+  std::atomic<size_t> next;
+  std::atomic<size_t> busy;
+  const size_t count;
+  const std::function<void(size_t)> *fn;
+  std::mutex mutex;
+  std::condition_variable done;
+};
+}  // namespace
+
+void GribThreadPool::ParallelFor(size_t count,
+                                 const std::function<void(size_t)> &fn) {
+  if (count == 0) return;
+  auto state = std::make_shared<ParallelForState>(count, &fn);
+  size_t helpers = std::min<size_t>(m_Threads.size(), count - 1);
+  for (size_t i = 0; i < helpers; i++) {
+    Push(
+        [state] {
+          state->busy++;
+          state->Work();
+          if (--state->busy == 0) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->done.notify_all();
+          }
+        },
+        true);
+  }
+  state->Work();
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&state] { return state->busy == 0; });
+}
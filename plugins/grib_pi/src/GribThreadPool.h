@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN development team                        *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
+ **************************************************************************/
+/**
+ * \file
+ * Worker threads of the GRIB plugin.
+ *
+ * The pool runs the work which can be split in independent parts, like
+ * decoding records, advancing particles and extracting isolines. Threads
+ * are joined when the pool is destroyed, queued tasks not started by then
+ * are dropped.
+ *
+ * GetShared() returns the pool used by all parts of the plugin, it is
+ * started on first use and destroyed when its last user releases it.
+ * GRIBOverlayFactory keeps it alive while the plugin is active. Tasks must
+ * not hold a reference to it, a worker can't join itself.
+ */
+#ifndef GRIBTHREADPOOL_H
+#define GRIBTHREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class GribThreadPool {
+public:
+  /** Starts threadCount workers, one per CPU less the caller if 0. */
+  explicit GribThreadPool(unsigned int threadCount = 0);
+  ~GribThreadPool();
+
+  GribThreadPool(const GribThreadPool &) = delete;
+  GribThreadPool &operator=(const GribThreadPool &) = delete;
+
+  /** Pool shared by the GRIB readers and the overlay factory. */
+  static std::shared_ptr<GribThreadPool> GetShared();
+
+  /** Queues a task run later by a worker thread. */
+  void Submit(std::function<void()> task);
+
+  /**
+   * Invokes fn(i) for i in [0, count), spread over the caller and the
+   * workers, and returns when all invocations are done. The workers help
+   * ahead of queued tasks, the caller does the whole work if none is free.
+   */
+  void ParallelFor(size_t count, const std::function<void(size_t)> &fn);
+
+  unsigned int GetThreadCount() const { return m_Threads.size(); }
+
+private:
+  void Push(std::function<void()> task, bool front);
+  void Run();
+
+  std::vector<std::thread> m_Threads;
+  std::deque<std::function<void()>> m_Tasks;
+  std::mutex m_Mutex;
+  std::condition_variable m_Cond;
+  bool m_bStop;
+};
+
+#endif
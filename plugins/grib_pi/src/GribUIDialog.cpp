@@ -139,9 +139,7 @@ wxWindow *GetGRIBCanvas() {
    a subset of the input, but also would need to be recomputed when panning the
    screen */
 GribTimelineRecordSet::GribTimelineRecordSet(unsigned int cnt)
-    : GribRecordSet(cnt) {
-  for (int i = 0; i < Idx_COUNT; i++) m_IsobarArray[i] = nullptr;
-}
+    : GribRecordSet(cnt) {}
 
 GribTimelineRecordSet::~GribTimelineRecordSet() {
   // RemoveGribRecords();
@@ -149,17 +147,8 @@ GribTimelineRecordSet::~GribTimelineRecordSet() {
 }
 
 void GribTimelineRecordSet::ClearCachedData() {
-  for (int i = 0; i < Idx_COUNT; i++) {
-    if (m_IsobarArray[i]) {
-      // Clear out the cached isobars
-      for (unsigned int j = 0; j < m_IsobarArray[i]->GetCount(); j++) {
-        IsoLine *piso = (IsoLine *)m_IsobarArray[i]->Item(j);
-        delete piso;
-      }
-      delete m_IsobarArray[i];
-      m_IsobarArray[i] = nullptr;
-    }
-  }
+  // Clear out the cached isobars
+  for (int i = 0; i < Idx_COUNT; i++) m_IsoLines[i].reset();
 }
 
 //---------------------------------------------------------------------------------------
@@ -1333,6 +1322,7 @@ void GRIBUICtrlBar::TimelineChanged() {
 
   wxDateTime time = TimelineTime();
   SetGribTimelineRecordSet(GetTimeLineRecordSet(time));
+  m_bGRIBActiveFile->TrimDataCache(m_pTimelineSet);
 
   if (!m_InterpolateMode) {
     /* get closest value to update timeline */
@@ -1449,6 +1439,20 @@ GribTimelineRecordSet *GRIBUICtrlBar::GetTimeLineRecordSet(wxDateTime time) {
 
   if (rsa->GetCount() == 0) return nullptr;
 
+  // Decode the records of the sets around time in parallel, most records
+  // interpolated below come from these.
+  const GribRecordSet *before = nullptr, *after = nullptr;
+  for (unsigned int j = 0; j < rsa->GetCount(); j++) {
+    GribRecordSet *GRS = &rsa->Item(j);
+    wxDateTime curtime = GRS->m_Reference_Time;
+    if (curtime <= time) before = GRS;
+    if (curtime >= time) {
+      after = GRS;
+      break;
+    }
+  }
+  m_bGRIBActiveFile->LoadDataCache({before, after});
+
   GribTimelineRecordSet *set =
       new GribTimelineRecordSet(m_bGRIBActiveFile->GetCounter());
   for (int i = 0; i < Idx_COUNT; i++) {
@@ -2306,6 +2310,23 @@ GRIBFile::GRIBFile(const wxArrayString &file_names, bool CumRec, bool WaveRec,
   }
 
   if (polarWind || polarCurrent) {
+    // Decode the direction and speed records converted below in parallel
+    std::vector<GribRecord *> polar;
+    for (unsigned int j = 0; j < m_GribRecordSetArray.GetCount(); j++) {
+      for (unsigned int i = 0; i < Idx_COUNT; i++) {
+        GribRecord *pRec = m_GribRecordSetArray.Item(j).m_GribRecordPtrArray[i];
+        if (pRec == nullptr) continue;
+        switch (pRec->getDataType()) {
+          case GRB_WIND_DIR:
+          case GRB_WIND_SPEED:
+          case GRB_CUR_DIR:
+          case GRB_CUR_SPEED:
+            polar.push_back(pRec);
+            break;
+        }
+      }
+    }
+    m_pGribReader->getDataCache().load(polar);
     for (unsigned int j = 0; j < m_GribRecordSetArray.GetCount(); j++) {
       for (unsigned int i = 0; i < Idx_COUNT; i++) {
         int idx = -1;
@@ -2369,10 +2390,38 @@ GRIBFile::GRIBFile(const wxArrayString &file_names, bool CumRec, bool WaveRec,
   if (isOK)
     m_pRefDateTime =
         pRec->getRecordRefDate();  // to ovoid crash with some bad files
+
+  // Drop values decoded while fixing up records
+  TrimDataCache(nullptr);
 }
 
 GRIBFile::~GRIBFile() { delete m_pGribReader; }
 
+void GRIBFile::TrimDataCache(const GribRecordSet *set) {
+  if (m_pGribReader == nullptr) return;
+  GribDataCache &cache = m_pGribReader->getDataCache();
+  if (set != nullptr) {
+    for (int i = 0; i < Idx_COUNT; i++) {
+      GribRecord *rec = set->m_GribRecordPtrArray[i];
+      if (rec) cache.touch(rec);
+    }
+  }
+  cache.trim();
+}
+
+void GRIBFile::LoadDataCache(const std::vector<const GribRecordSet *> &sets) {
+  if (m_pGribReader == nullptr) return;
+  std::vector<GribRecord *> records;
+  for (auto set : sets) {
+    if (set == nullptr) continue;
+    for (int i = 0; i < Idx_COUNT; i++) {
+      if (set->m_GribRecordPtrArray[i])
+        records.push_back(set->m_GribRecordPtrArray[i]);
+    }
+  }
+  m_pGribReader->getDataCache().load(records);
+}
+
 //---------------------------------------------------------------------------------------
 //               GRIB Cursor Data Ctrl & Display implementation
 //---------------------------------------------------------------------------------------
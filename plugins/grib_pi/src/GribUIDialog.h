@@ -166,10 +166,11 @@ public:
    * Array of cached isobar calculations for each data type (wind, pressure,
    * etc).
    *
-   * Each element is a pointer to a wxArrayPtrVoid containing IsoLine objects.
-   * Used to speed up rendering by avoiding recalculation of isobars.
+   * Each element is shared with the isoline cache of GRIBOverlayFactory,
+   * which keeps the isolines of recently displayed records so going back
+   * in the timeline does not extract them again.
    */
-  wxArrayPtrVoid *m_IsobarArray[Idx_COUNT];
+  std::shared_ptr<IsoLineSet> m_IsoLines[Idx_COUNT];
 };
 
 //----------------------------------------------------------------------------------------------------------
@@ -477,6 +478,19 @@ public:
 
   const unsigned int GetCounter() { return m_counter; }
 
+  /**
+   * Drops the decoded values of the least recently used records beyond the
+   * cache limit, after marking the records of set as the most recently
+   * used. Must not run while another thread reads record values.
+   */
+  void TrimDataCache(const GribRecordSet *set);
+
+  /**
+   * Decodes the values of the records of sets in parallel, one record per
+   * worker thread task, instead of one after the other on first use.
+   */
+  void LoadDataCache(const std::vector<const GribRecordSet *> &sets);
+
   WX_DEFINE_ARRAY_INT(int, GribIdxArray);
   GribIdxArray m_GribIdxArray;
 
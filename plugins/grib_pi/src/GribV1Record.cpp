@@ -28,6 +28,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdlib.h>
 
 #include "GribV1Record.h"
+#include "GribDataCache.h"
 
 //-------------------------------------------------------------------------------
 // Adjust data type from different mete center
@@ -318,7 +319,8 @@ void GribV1Record::translateDataType() {
 //-------------------------------------------------------------------------------
 // Lecture depuis un fichier
 //-------------------------------------------------------------------------------
-GribV1Record::GribV1Record(ZUFILE* file, int id_) {
+GribV1Record::GribV1Record(ZUFILE* file, int id_,
+                           std::shared_ptr<GribDataFile> dataFile) {
   id = id_;
   //   seekStart = zu_tell(file);           // moved to section 0 read
   data = nullptr;
@@ -388,7 +390,7 @@ GribV1Record::GribV1Record(ZUFILE* file, int id_) {
     zu_seek(file, fileOffset3 + sectionSize3, SEEK_SET);
   }
   if (ok) {
-    ok = readGribSection4_BDS(file);
+    ok = readGribSection4_BDS(file, dataFile);
     zu_seek(file, fileOffset4 + sectionSize4, SEEK_SET);
   }
   if (ok) {
@@ -419,7 +421,7 @@ GribV1Record::GribV1Record(const GribRecord& rec) : GribRecord(rec) {
 GribV1Record::~GribV1Record() {}
 
 //----------------------------------------------
-static zuint readPackedBits(zuchar* buf, zuint first, zuint nbBits) {
+static zuint readPackedBits(const zuchar* buf, zuint first, zuint nbBits) {
 #if 0
     // should test when loading nbBitsInPack?
     if (nbBits == 0 || nbBits > 31) {
@@ -437,6 +439,101 @@ static zuint readPackedBits(zuchar* buf, zuint first, zuint nbBits) {
   return val;
 }
 
+//----------------------------------------------
+// Unpack simple packed values of rec, in the order given by isAdjacentI
+static double* unpackBDS(const GribRecord& rec, bool isAdjacentI,
+                         const zuchar* buf, double refValue,
+                         double scaleFactorEpow2, double decimalFactorD,
+                         zuint nbBitsInPack) {
+  zuint Ni = rec.getNi();
+  zuint Nj = rec.getNj();
+  double* data = new double[Ni * Nj];
+  zuint startbit = 0;
+  zuint i, j, x;
+  int ind;
+  if (isAdjacentI) {
+    for (j = 0; j < Nj; j++) {
+      for (i = 0; i < Ni; i++) {
+#if 0
+                // XXX
+                // not need because we do it in XY after recomputing Di and Dj?
+                if (!hasDiDj && !isScanJpositive) {
+                    ind = (Nj-1 -j)*Ni+i;
+                }
+                else {
+                    ind = j*Ni+i;
+                }
+#else
+        ind = j * Ni + i;
+#endif
+
+        if (rec.hasValue(i, j)) {
+          x = readPackedBits(buf, startbit, nbBitsInPack);
+          data[ind] = (refValue + x * scaleFactorEpow2) / decimalFactorD;
+          startbit += nbBitsInPack;
+          // printf(" %d %d %f ", i,j, data[ind]);
+        } else {
+          data[ind] = GRIB_NOTDEF;
+        }
+      }
+    }
+  } else {
+    for (i = 0; i < Ni; i++) {
+      for (j = 0; j < Nj; j++) {
+#if 0
+                if (!hasDiDj && !isScanJpositive) {
+                    ind = (Nj-1 -j)*Ni+i;
+                }
+                else {
+                    ind = j*Ni+i;
+                }
+#else
+        ind = j * Ni + i;
+#endif
+
+        if (rec.hasValue(i, j)) {
+          x = readPackedBits(buf, startbit, nbBitsInPack);
+          startbit += nbBitsInPack;
+          data[ind] = (refValue + x * scaleFactorEpow2) / decimalFactorD;
+          // printf(" %d %d %f ", i,j, data[ind]);
+        } else {
+          data[ind] = GRIB_NOTDEF;
+        }
+      }
+    }
+  }
+  return data;
+}
+
+//----------------------------------------------
+// Binary data section left packed in the file by the header only pass
+class GribV1PackedData : public GribPackedData {
+public:
+  GribV1PackedData(std::shared_ptr<GribDataFile> file, long offset, long size,
+                   bool isAdjacentI, double refValue, double scaleFactorEpow2,
+                   double decimalFactorD, zuint nbBitsInPack)
+      : GribPackedData(file, offset, size),
+        isAdjacentI(isAdjacentI),
+        refValue(refValue),
+        scaleFactorEpow2(scaleFactorEpow2),
+        decimalFactorD(decimalFactorD),
+        nbBitsInPack(nbBitsInPack) {}
+
+protected:
+  double* unpack(const GribRecord& rec,
+                 const std::vector<unsigned char>& buf) const override {
+    return unpackBDS(rec, isAdjacentI, buf.data(), refValue,
+                     scaleFactorEpow2, decimalFactorD, nbBitsInPack);
+  }
+
+private:
+  bool isAdjacentI;
+  double refValue;
+  double scaleFactorEpow2;
+  double decimalFactorD;
+  zuint nbBitsInPack;
+};
+
 //==============================================================
 // Lecture des données
 //==============================================================
@@ -663,7 +760,8 @@ bool GribV1Record::readGribSection3_BMS(ZUFILE* file) {
 //----------------------------------------------
 // SECTION 4: BINARY DATA SECTION (BDS)
 //----------------------------------------------
-bool GribV1Record::readGribSection4_BDS(ZUFILE* file) {
+bool GribV1Record::readGribSection4_BDS(ZUFILE* file,
+                                       std::shared_ptr<GribDataFile> dataFile) {
   fileOffset4 = zu_tell(file);
   sectionSize4 = readInt3(file);  // byte 1-2-3
 
@@ -701,8 +799,14 @@ bool GribV1Record::readGribSection4_BDS(ZUFILE* file) {
     ok = false;
     return ok;
   }
-  zuint startbit = 0;
   int datasize = sectionSize4 - 11;
+  if (dataFile) {
+    // Header only pass, the caller seeks past the packed values
+    m_packed = std::make_shared<GribV1PackedData>(
+        dataFile, fileOffset4 + 11, datasize, isAdjacentI, refValue,
+        scaleFactorEpow2, decimalFactorD, nbBitsInPack);
+    return ok;
+  }
   zuchar* buf =
       new zuchar[datasize +
                  4]();  // +4 pour simplifier les décalages ds readPackedBits
@@ -717,63 +821,8 @@ bool GribV1Record::readGribSection4_BDS(ZUFILE* file) {
     return ok;
   }
 
-  // Allocate memory for the data
-  data = new double[Ni * Nj];
-
-  // Read data in the order given by isAdjacentI
-  zuint i, j, x;
-  int ind;
-  if (isAdjacentI) {
-    for (j = 0; j < Nj; j++) {
-      for (i = 0; i < Ni; i++) {
-#if 0
-                // XXX
-                // not need because we do it in XY after recomputing Di and Dj?
-                if (!hasDiDj && !isScanJpositive) {
-                    ind = (Nj-1 -j)*Ni+i;
-                }
-                else {
-                    ind = j*Ni+i;
-                }
-#else
-        ind = j * Ni + i;
-#endif
-
-        if (hasValue(i, j)) {
-          x = readPackedBits(buf, startbit, nbBitsInPack);
-          data[ind] = (refValue + x * scaleFactorEpow2) / decimalFactorD;
-          startbit += nbBitsInPack;
-          // printf(" %d %d %f ", i,j, data[ind]);
-        } else {
-          data[ind] = GRIB_NOTDEF;
-        }
-      }
-    }
-  } else {
-    for (i = 0; i < Ni; i++) {
-      for (j = 0; j < Nj; j++) {
-#if 0
-                if (!hasDiDj && !isScanJpositive) {
-                    ind = (Nj-1 -j)*Ni+i;
-                }
-                else {
-                    ind = j*Ni+i;
-                }
-#else
-        ind = j * Ni + i;
-#endif
-
-        if (hasValue(i, j)) {
-          x = readPackedBits(buf, startbit, nbBitsInPack);
-          startbit += nbBitsInPack;
-          data[ind] = (refValue + x * scaleFactorEpow2) / decimalFactorD;
-          // printf(" %d %d %f ", i,j, data[ind]);
-        } else {
-          data[ind] = GRIB_NOTDEF;
-        }
-      }
-    }
-  }
+  data = unpackBDS(*this, isAdjacentI, buf, refValue, scaleFactorEpow2,
+                   decimalFactorD, nbBitsInPack);
 
   delete[] buf;
   return ok;
@@ -33,10 +33,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "zuFile.h"
 #include "GribRecord.h"
 
+class GribDataFile;
+
 //----------------------------------------------
 class GribV1Record : public GribRecord {
 public:
-  GribV1Record(ZUFILE* file, int id_);
+  /**
+   * Read next record from file. If dataFile is set, the values are not
+   * decoded but located in dataFile to be decoded on first use.
+   */
+  GribV1Record(ZUFILE* file, int id_,
+               std::shared_ptr<GribDataFile> dataFile = nullptr);
   GribV1Record(const GribRecord& rec);
   GribV1Record() {}
 
@@ -90,7 +97,8 @@ private:
   bool readGribSection1_PDS(ZUFILE* file);
   bool readGribSection2_GDS(ZUFILE* file);
   bool readGribSection3_BMS(ZUFILE* file);
-  bool readGribSection4_BDS(ZUFILE* file);
+  bool readGribSection4_BDS(ZUFILE* file,
+                            std::shared_ptr<GribDataFile> dataFile);
   bool readGribSection5_ES(ZUFILE* file);
 
   //---------------------------------------------
@@ -43,7 +43,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
 #include "GribV2Record.h"
+#include "GribDataCache.h"
 
 #ifdef JASPER
 #include <jasper/jasper.h>
@@ -228,6 +234,10 @@ static int dec_jpeg2000(char *injpc, int bufsize, int *outfld)
 
   //    jas_init();
 
+  // Records are decoded on worker threads, JasPer keeps global state.
+  static std::mutex jasper_mutex;
+  std::lock_guard<std::mutex> lock(jasper_mutex);
+
   ier = 0;
   //
   //     Create jas_stream_t containing input JPEG200 codestream in memory.
@@ -340,6 +350,104 @@ static inline void getBits(unsigned const char *buf, int *loc, size_t first,
   *loc = val;
 }
 
+// Unpack blocks of 8 values of W bits, which are W bytes long. Offsets,
+// shifts and masks are constants the compiler unrolls the loop with.
+// Reads up to 8 bytes past the last block.
+template <int W>
+static void unpackBlocks(unsigned const char *p, size_t blocks, int *out) {
+  for (size_t b = 0; b < blocks; b++, p += W, out += 8) {
+    for (int j = 0; j < 8; j++) {
+      unsigned const char *q = p + j * W / 8;
+      uint64_t word = (uint64_t(q[0]) << 56) | (uint64_t(q[1]) << 48) |
+                      (uint64_t(q[2]) << 40) | (uint64_t(q[3]) << 32) |
+                      (uint64_t(q[4]) << 24) | (uint64_t(q[5]) << 16) |
+                      (uint64_t(q[6]) << 8) | uint64_t(q[7]);
+      out[j] = (zuint)((word >> (64 - j * W % 8 - W)) &
+                       ((uint64_t(1) << W) - 1));
+    }
+  }
+}
+
+#define UNPACK_BLOCKS(w)             \
+  case w:                            \
+    unpackBlocks<w>(p, blocks, out); \
+    break;
+
+// Unpack count consecutive values of nbBits bits each starting at bit first,
+// as count calls to getBits() would. Never reads past the byte holding the
+// last bit.
+static void unpackBits(unsigned const char *buf, size_t first, int nbBits,
+                       int count, int *out) {
+  if (nbBits == 0) {
+    std::fill(out, out + count, 0);
+    return;
+  }
+  unsigned const char *p = buf + first / 8;
+  if (first % 8 == 0 && nbBits <= 32 && count > 0) {
+    // Whole blocks followed by at least 8 bytes of values
+    size_t bytes = size_t(count) * nbBits / 8;
+    size_t blocks = bytes >= 8 ? (bytes - 8) / nbBits : 0;
+    switch (nbBits) {
+      UNPACK_BLOCKS(1) UNPACK_BLOCKS(2) UNPACK_BLOCKS(3) UNPACK_BLOCKS(4)
+      UNPACK_BLOCKS(5) UNPACK_BLOCKS(6) UNPACK_BLOCKS(7) UNPACK_BLOCKS(8)
+      UNPACK_BLOCKS(9) UNPACK_BLOCKS(10) UNPACK_BLOCKS(11) UNPACK_BLOCKS(12)
+      UNPACK_BLOCKS(13) UNPACK_BLOCKS(14) UNPACK_BLOCKS(15) UNPACK_BLOCKS(16)
+      UNPACK_BLOCKS(17) UNPACK_BLOCKS(18) UNPACK_BLOCKS(19) UNPACK_BLOCKS(20)
+      UNPACK_BLOCKS(21) UNPACK_BLOCKS(22) UNPACK_BLOCKS(23) UNPACK_BLOCKS(24)
+      UNPACK_BLOCKS(25) UNPACK_BLOCKS(26) UNPACK_BLOCKS(27) UNPACK_BLOCKS(28)
+      UNPACK_BLOCKS(29) UNPACK_BLOCKS(30) UNPACK_BLOCKS(31) UNPACK_BLOCKS(32)
+    }
+    p += blocks * nbBits;
+    out += blocks * 8;
+    count -= blocks * 8;
+  }
+  // Remaining values, one byte at a time
+  const uint64_t mask = (uint64_t(1) << nbBits) - 1;
+  uint64_t acc = 0;
+  int avail = 0;
+  if (count > 0) {
+    acc = *p++ & (0xff >> (first % 8));
+    avail = 8 - first % 8;
+  }
+  for (int i = 0; i < count; i++) {
+    while (avail < nbBits) {
+      acc = (acc << 8) | *p++;
+      avail += 8;
+    }
+    avail -= nbBits;
+    out[i] = (zuint)((acc >> avail) & mask);
+  }
+}
+#undef UNPACK_BLOCKS
+
+// Grid point l = R + vals[k] * E / D, k counting the points present in the
+// bit map. Without bit map this is a plain loop the compiler vectorizes.
+static void scalePackedValues(const GRIBMessage *grib_msg, const int *vals,
+                              float E, float D, double *gridpoints,
+                              int npoints) {
+  const float R = grib_msg->md.R;
+  const unsigned char *bitmap = grib_msg->md.bitmap;
+  if (bitmap == nullptr) {
+    for (int l = 0; l < npoints; l++) gridpoints[l] = R + vals[l] * E / D;
+    return;
+  }
+  for (int l = 0, k = 0; l < npoints; l++) {
+    if (bitmap[l] == 1)
+      gridpoints[l] = R + vals[k++] * E / D;
+    else
+      gridpoints[l] = GRIB_MISSING_VALUE;
+  }
+}
+
+// Number of values packed for npoints grid points.
+static int countPackedValues(const GRIBMessage *grib_msg, int npoints) {
+  const unsigned char *bitmap = grib_msg->md.bitmap;
+  if (bitmap == nullptr) return npoints;
+  int count = 0;
+  for (int l = 0; l < npoints; l++) count += bitmap[l] == 1;
+  return count;
+}
+
 //-------------------------------------------------------------------------------
 // Lecture depuis un fichier
 //-------------------------------------------------------------------------------
@@ -750,7 +858,7 @@ static bool unpackDS(GRIBMessage *grib_msg) {
 
   struct {
     int *ref_vals, *widths;
-    int *lengths;
+    int *lengths, *values;
     int *first_vals = 0, sign, omin;
     long long miss_val, group_miss_val;
     int max_length;
@@ -763,17 +871,15 @@ static bool unpackDS(GRIBMessage *grib_msg) {
   off = grib_msg->offset + 40;
   int npoints = grib_msg->md.ny * grib_msg->md.nx;
   switch (grib_msg->md.drs_templ_num) {
-    case 0:
+    case 0: {
+      int count = countPackedValues(grib_msg, npoints);
+      int *vals = new int[count];
+      unpackBits(grib_msg->buffer, off, grib_msg->md.pack_width, count, vals);
       grib_msg->grids.gridpoints = new double[npoints];
-      for (l = 0; l < npoints; l++) {
-        if (grib_msg->md.bitmap == nullptr || grib_msg->md.bitmap[l] == 1) {
-          getBits(grib_msg->buffer, &pval, off, grib_msg->md.pack_width);
-          grib_msg->grids.gridpoints[l] = grib_msg->md.R + pval * E / D;
-          off += grib_msg->md.pack_width;
-        } else
-          grib_msg->grids.gridpoints[l] = GRIB_MISSING_VALUE;
-      }
-      break;
+      scalePackedValues(grib_msg, vals, E, D, grib_msg->grids.gridpoints,
+                        npoints);
+      delete[] vals;
+    } break;
     case 3:
       if (grib_msg->md.complex_pack.num_groups > 0) {
         if (grib_msg->md.complex_pack.spatial_diff.order) {
@@ -814,26 +920,26 @@ static bool unpackDS(GRIBMessage *grib_msg) {
       groups.widths = new int[grib_msg->md.complex_pack.num_groups];
       groups.lengths = new int[grib_msg->md.complex_pack.num_groups];
 
-      for (n = 0; n < grib_msg->md.complex_pack.num_groups; ++n) {
-        getBits(grib_msg->buffer, &groups.ref_vals[n], off,
-                grib_msg->md.pack_width);
-        off += grib_msg->md.pack_width;
-      }
+      unpackBits(grib_msg->buffer, off, grib_msg->md.pack_width,
+                 grib_msg->md.complex_pack.num_groups, groups.ref_vals);
+      off += grib_msg->md.complex_pack.num_groups * grib_msg->md.pack_width;
       off = (off + 7) & ~7;  // byte boundary padding
 
+      unpackBits(grib_msg->buffer, off,
+                 grib_msg->md.complex_pack.width.pack_width,
+                 grib_msg->md.complex_pack.num_groups, groups.widths);
       for (n = 0; n < grib_msg->md.complex_pack.num_groups; ++n) {
-        getBits(grib_msg->buffer, &groups.widths[n], off,
-                grib_msg->md.complex_pack.width.pack_width);
         groups.widths[n] += grib_msg->md.complex_pack.width.ref;
-        off += grib_msg->md.complex_pack.width.pack_width;
       }
+      off += grib_msg->md.complex_pack.num_groups *
+             grib_msg->md.complex_pack.width.pack_width;
       off = (off + 7) & ~7;
 
-      for (n = 0; n < grib_msg->md.complex_pack.num_groups; ++n) {
-        getBits(grib_msg->buffer, &groups.lengths[n], off,
-                grib_msg->md.complex_pack.length.pack_width);
-        off += grib_msg->md.complex_pack.length.pack_width;
-      }
+      unpackBits(grib_msg->buffer, off,
+                 grib_msg->md.complex_pack.length.pack_width,
+                 grib_msg->md.complex_pack.num_groups, groups.lengths);
+      off += grib_msg->md.complex_pack.num_groups *
+             grib_msg->md.complex_pack.length.pack_width;
       off = (off + 7) & ~7;
 
       groups.max_length = 0;
@@ -850,6 +956,7 @@ static bool unpackDS(GRIBMessage *grib_msg) {
         groups.max_length = groups.lengths[n];
       }
       // unpack the field of differences
+      groups.values = new int[groups.max_length];
       for (n = 0, l = 0; n < grib_msg->md.complex_pack.num_groups; ++n) {
         if (groups.widths[n] > 0) {
           if (grib_msg->md.complex_pack.miss_val_mgmt > 0) {
@@ -857,12 +964,25 @@ static bool unpackDS(GRIBMessage *grib_msg) {
           } else {
             groups.group_miss_val = GRIB_MISSING_VALUE;
           }
+          unpackBits(grib_msg->buffer, off, groups.widths[n], groups.lengths[n],
+                     groups.values);
+          off += groups.lengths[n] * groups.widths[n];
+          if (grib_msg->md.bitmap == nullptr &&
+              grib_msg->md.complex_pack.miss_val_mgmt == 0) {
+            // Nothing missing, a plain loop the compiler vectorizes
+            const int base = groups.ref_vals[n] + groups.omin;
+            double *gp = grib_msg->grids.gridpoints + l;
+            for (int i = 0; i < groups.lengths[n]; ++i) {
+              gp[i] = groups.values[i] + base;
+            }
+            l += groups.lengths[n];
+            continue;
+          }
           for (int i = 0; i < groups.lengths[n];) {
             if (grib_msg->md.bitmap != nullptr && grib_msg->md.bitmap[l] == 0) {
               grib_msg->grids.gridpoints[l] = GRIB_MISSING_VALUE;
             } else {
-              getBits(grib_msg->buffer, &pval, off, groups.widths[n]);
-              off += groups.widths[n];
+              pval = groups.values[i];
               if (pval == groups.group_miss_val) {
                 grib_msg->grids.gridpoints[l] = GRIB_MISSING_VALUE;
               } else {
@@ -925,16 +1045,18 @@ static bool unpackDS(GRIBMessage *grib_msg) {
           }
         }
         delete[] groups.first_vals;
-      } else
+      } else {
+        // Branch free so that it is vectorized
+        double *gp = grib_msg->grids.gridpoints;
         for (l = 0; l < npoints; ++l) {
-          if (grib_msg->grids.gridpoints[l] != GRIB_MISSING_VALUE) {
-            grib_msg->grids.gridpoints[l] =
-                grib_msg->md.R + grib_msg->grids.gridpoints[l] * E / D;
-          }
+          gp[l] = gp[l] != GRIB_MISSING_VALUE ? grib_msg->md.R + gp[l] * E / D
+                                              : gp[l];
         }
+      }
       delete[] groups.ref_vals;
       delete[] groups.widths;
       delete[] groups.lengths;
+      delete[] groups.values;
       break;
     case 4: {
       // Grid point data - IEEE Floating Point Data
@@ -979,23 +1101,17 @@ static bool unpackDS(GRIBMessage *grib_msg) {
 #ifdef JASPER
     case 40:
     case 40000:
-      int len, *jvals, cnt;
+      int len, *jvals;
       getBits(grib_msg->buffer, &len, grib_msg->offset, 32);
       if (len < 5) return false;
       len = len - 5;
-      jvals = new int[npoints];
+      jvals = new int[npoints]();
       grib_msg->grids.gridpoints = new double[npoints];
       if (len > 0)
         dec_jpeg2000((char *)&grib_msg->buffer[grib_msg->offset / 8 + 5], len,
                      jvals);
-      cnt = 0;
-      for (l = 0; l < npoints; l++) {
-        if (grib_msg->md.bitmap == nullptr || grib_msg->md.bitmap[l] == 1) {
-          if (len == 0) jvals[cnt] = 0;
-          grib_msg->grids.gridpoints[l] = grib_msg->md.R + jvals[cnt++] * E / D;
-        } else
-          grib_msg->grids.gridpoints[l] = GRIB_MISSING_VALUE;
-      }
+      scalePackedValues(grib_msg, jvals, E, D, grib_msg->grids.gridpoints,
+                        npoints);
       delete[] jvals;
       break;
 #endif
@@ -1538,12 +1654,61 @@ void GribV2Record::translateDataType() {
   // this->print();
 }
 
+// -------------------------------------
+// Data section left packed in the file by the header only pass
+class GribV2PackedData : public GribPackedData {
+public:
+  GribV2PackedData(std::shared_ptr<GribDataFile> file, long offset, long size,
+                   int gdsOffset, int drsOffset, int bmsOffset, int dsOffset)
+      : GribPackedData(file, offset, size),
+        gdsOffset(gdsOffset),
+        drsOffset(drsOffset),
+        bmsOffset(bmsOffset),
+        dsOffset(dsOffset) {}
+
+protected:
+  // Unpack the sections the data set was read with, buf is the message
+  double *unpack(const GribRecord &rec,
+                 const std::vector<unsigned char> &buf) const override {
+    if (gdsOffset < 0 || drsOffset < 0) return nullptr;
+    GRIBMessage msg;
+    msg.buffer = const_cast<unsigned char *>(buf.data());
+    msg.total_len = buf.size() - 4;
+    msg.md.nx = msg.md.ny = 0;
+    bool ok = true;
+    msg.offset = gdsOffset;
+    ok = ok && unpackGDS(&msg);
+    msg.offset = drsOffset;
+    ok = ok && unpackDRS(&msg);
+    if (bmsOffset >= 0) {
+      msg.offset = bmsOffset;
+      ok = ok && unpackBMS(&msg);
+    }
+    msg.offset = dsOffset;
+    ok = ok && unpackDS(&msg);
+    msg.buffer = nullptr;  // Owned by buf
+
+    double *values = msg.grids.gridpoints;
+    msg.grids.gridpoints = nullptr;
+    if (!ok || msg.md.nx != rec.getNi() || msg.md.ny != rec.getNj()) {
+      delete[] values;
+      return nullptr;
+    }
+    return values;
+  }
+
+private:
+  int gdsOffset, drsOffset, bmsOffset, dsOffset;
+};
+
 // -------------------------------------
 void GribV2Record::readDataSet(ZUFILE *file) {
   bool skip = false;
   bool DS = false;
   int len, sec_num;
 
+  m_packed.reset();
+  m_dataScale = 1.;
   data = nullptr;
   BMSbits = nullptr;
   hasBMS = false;
@@ -1564,6 +1729,7 @@ void GribV2Record::readDataSet(ZUFILE *file) {
         if (skip == true) break;
         ok = unpackGDS(grib_msg);
         if (ok) {
+          gdsOffset = grib_msg->offset;
           Ni = grib_msg->md.nx;
           Nj = grib_msg->md.ny;
           La1 = grib_msg->md.slat;
@@ -1651,10 +1817,14 @@ void GribV2Record::readDataSet(ZUFILE *file) {
       case 5:  //  Section 5: Data Representation Section
         if (skip == true) break;
         ok = unpackDRS(grib_msg);
+        drsOffset = grib_msg->offset;
         break;
       case 6:  //  Section 6: Bit-Map Section
         if (skip == true) break;
         ok = unpackBMS(grib_msg);
+        // 254: bit map defined by a previous section applies
+        if (grib_msg->buffer[grib_msg->offset / 8 + 5] != 254)
+          bmsOffset = grib_msg->offset;
         if (ok) {
           if (grib_msg->md.bmssize != 0) {
             hasBMS = true;
@@ -1665,7 +1835,12 @@ void GribV2Record::readDataSet(ZUFILE *file) {
         }
         break;
       case 7:  // Section 7: Data Section
-        if (skip == false) {
+        if (skip == false && dataFile) {
+          // Header only pass, unpacked on first use
+          m_packed = std::make_shared<GribV2PackedData>(
+              dataFile, seekStart, grib_msg->total_len, gdsOffset, drsOffset,
+              bmsOffset, grib_msg->offset);
+        } else if (skip == false) {
           ok = unpackDS(grib_msg);
           if (ok) {
             data = grib_msg->grids.gridpoints;
@@ -1707,7 +1882,9 @@ void GribV2Record::readDataSet(ZUFILE *file) {
 }
 
 // -----------------
-GribV2Record::GribV2Record(ZUFILE *file, int id_) {
+GribV2Record::GribV2Record(ZUFILE *file, int id_,
+                           std::shared_ptr<GribDataFile> dataFile)
+    : dataFile(dataFile), gdsOffset(-1), drsOffset(-1), bmsOffset(-1) {
   id = id_;
   seekStart = zu_tell(file);  // moved to section 0 read
   data = nullptr;
@@ -35,11 +35,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "GribRecord.h"
 
 class GRIBMessage;
+class GribDataFile;
 
 //----------------------------------------------
 class GribV2Record : public GribRecord {
 public:
-  GribV2Record(ZUFILE* file, int id_);
+  /**
+   * Read next message from file. If dataFile is set, the values are not
+   * decoded but located in dataFile to be decoded on first use.
+   */
+  GribV2Record(ZUFILE* file, int id_,
+               std::shared_ptr<GribDataFile> dataFile = nullptr);
   GribV2Record(const GribRecord& rec);
   GribV2Record() { grib_msg = 0; }
 
@@ -53,6 +59,13 @@ private:
   zuint periodSeconds(zuchar unit, zuint P1, zuint P2, zuchar range);
   void readDataSet(ZUFILE* file);
   class GRIBMessage* grib_msg;
+  /** File values are decoded from on first use, nullptr to decode now. */
+  std::shared_ptr<GribDataFile> dataFile;
+  /**
+   * Bit offsets in the message of the sections the values of the current
+   * data set are unpacked with, -1 if none.
+   */
+  int gdsOffset, drsOffset, bmsOffset;
 
   //-----------------------------------------
   void translateDataType();  // adapte les codes des différents centres météo
@@ -27,11 +27,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 // #include "chcanv.h"
 // #include "model/georef.h"
-#include <wx/graphics.h>
 
 #include "IsoLine.h"
-#include "GribSettingsDialog.h"
-#include "GribOverlayFactory.h"
+#include "GribThreadPool.h"
 
 #ifdef __OCPN__ANDROID__
 #include "qdebug.h"
@@ -164,15 +162,9 @@ double round_msvc(double x) { return (floor(x + 0.5)); }
 //---------------------------------------------------------------
 IsoLine::IsoLine(double val, double coeff, double offset,
                  const GribRecord *rec_) {
-  if (wxGetDisplaySize().x > 0) {
-    m_pixelMM = PlugInGetDisplaySizeMM() / wxGetDisplaySize().x;
-    m_pixelMM = wxMax(.02, m_pixelMM);  // protect against bad data
-  } else
-    m_pixelMM = 0.27;  // semi-standard number...
-
+  // Built on worker threads by IsoLineSet, must not use the GUI
   value = val / coeff - offset;
 
-  rec = rec_;
   W = rec_->getNi();
   H = rec_->getNj();
 
@@ -240,6 +232,37 @@ IsoLine::~IsoLine() {
   m_SegListList.Clear();
 }
 
+//---------------------------------------------------------------
+IsoLineSet::IsoLineSet(GribRecord *rec, const std::vector<double> &values,
+                       const std::vector<double> &coeffs, double offset)
+    : m_Record(rec),
+      m_Values(values),
+      m_Coeffs(coeffs),
+      m_Offset(offset),
+      m_Lines(values.size()),
+      m_Pending(values.size()) {
+  // Workers read the values concurrently, make sure they stay
+  m_Record->detachData();
+}
+
+void IsoLineSet::Extract(const std::shared_ptr<IsoLineSet> &set,
+                         GribThreadPool &pool) {
+  std::weak_ptr<IsoLineSet> weak = set;
+  for (size_t i = 0; i < set->m_Values.size(); i++) {
+    pool.Submit([weak, i] {
+      if (auto set = weak.lock()) set->ExtractLevel(i);
+    });
+  }
+}
+
+void IsoLineSet::ExtractLevel(size_t i) {
+  m_Lines[i].reset(
+      new IsoLine(m_Values[i], m_Coeffs[i], m_Offset, m_Record.get()));
+  // The last level done releases the record
+  if (--m_Pending == 0) m_Record.reset();
+}
+
+//---------------------------------------------------------------
 MySegList *IsoLine::BuildContinuousSegment(void) {
   MySegList::Node *node;
   Segment *seg;
@@ -368,240 +391,6 @@ MySegList *IsoLine::BuildContinuousSegment(void) {
   return ret_list;
 }
 
-//---------------------------------------------------------------
-void IsoLine::drawIsoLine(GRIBOverlayFactory *pof, wxDC *dc,
-                          PlugIn_ViewPort *vp, bool bHiDef) {
-  int nsegs = trace.size();
-  if (nsegs < 1) return;
-
-  GetGlobalColor(_T ( "UITX1" ), &isoLineColor);
-
-#if wxUSE_GRAPHICS_CONTEXT
-  wxGraphicsContext *pgc = nullptr;
-#endif
-
-  if (dc) {
-    wxPen ppISO(isoLineColor, 2);
-
-#if wxUSE_GRAPHICS_CONTEXT
-    wxMemoryDC *pmdc;
-    pmdc = dynamic_cast<wxMemoryDC *>(dc);
-    pgc = wxGraphicsContext::Create(*pmdc);
-    pgc->SetPen(ppISO);
-#endif
-    dc->SetPen(ppISO);
-  } else { /* opengl */
-#ifdef ocpnUSE_GL
-    // #ifndef USE_ANDROID_GLES2
-    //            if(m_pixelMM > 0.2){        // pixel size large enough to
-    //            render well
-    //            //      Enable anti-aliased lines, at best quality
-    //              glEnable( GL_LINE_SMOOTH );
-    //              glEnable( GL_BLEND );
-    //              glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
-    //              glHint( GL_LINE_SMOOTH_HINT, GL_NICEST );
-    //              glLineWidth( 2 );
-    //            }
-    //            else{
-    //              glLineWidth( 0.4/m_pixelMM);        //  set a target line
-    //              width by MM
-    //            }
-    // #else
-    if (pof->m_oDC) {
-      wxPen ppISO(isoLineColor, 2);
-      pof->m_oDC->SetPen(ppISO);
-    }
-#endif
-  }
-
-  std::list<Segment *>::iterator it;
-
-  //---------------------------------------------------------
-  // Dessine les segments
-  //---------------------------------------------------------
-  for (it = trace.begin(); it != trace.end(); it++) {
-    Segment *seg = *it;
-
-    if (vp->m_projection_type == PI_PROJECTION_MERCATOR ||
-        vp->m_projection_type == PI_PROJECTION_EQUIRECTANGULAR) {
-      /* skip segments that go the wrong way around the world */
-      double sx1 = seg->px1, sx2 = seg->px2;
-      if (sx2 - sx1 > 180)
-        sx2 -= 360;
-      else if (sx1 - sx2 > 180)
-        sx1 -= 360;
-
-      if ((sx1 + 180 < vp->clon && sx2 + 180 > vp->clon) ||
-          (sx1 + 180 > vp->clon && sx2 + 180 < vp->clon) ||
-          (sx1 - 180 < vp->clon && sx2 - 180 > vp->clon) ||
-          (sx1 - 180 > vp->clon && sx2 - 180 < vp->clon))
-        continue;
-    }
-
-    wxPoint ab;
-    GetCanvasPixLL(vp, &ab, seg->py1, seg->px1);
-    wxPoint cd;
-    GetCanvasPixLL(vp, &cd, seg->py2, seg->px2);
-
-    if (dc) {
-#if wxUSE_GRAPHICS_CONTEXT
-      if (bHiDef && pgc)
-        pgc->StrokeLine(ab.x, ab.y, cd.x, cd.y);
-      else
-#endif
-        dc->DrawLine(ab.x, ab.y, cd.x, cd.y);
-    } else { /* opengl */
-#ifdef ocpnUSE_GL
-
-      if (pof->m_oDC) {
-        pof->m_oDC->DrawLine(ab.x, ab.y, cd.x, cd.y);
-      }
-
-#endif
-    }
-  }
-
-#if wxUSE_GRAPHICS_CONTEXT
-  delete pgc;
-#endif
-
-  //      if(!dc) /* opengl */
-  //          glEnd();
-}
-
-//---------------------------------------------------------------
-
-void IsoLine::drawIsoLineLabels(GRIBOverlayFactory *pof, wxDC *dc,
-                                PlugIn_ViewPort *vp, int density, int first,
-                                wxImage &imageLabel)
-
-{
-  std::list<Segment *>::iterator it;
-  int nb = first;
-  wxString label;
-
-  //---------------------------------------------------------
-  // Ecrit les labels
-  //---------------------------------------------------------
-  wxRect prev;
-  for (it = trace.begin(); it != trace.end(); it++, nb++) {
-    if (nb % density == 0) {
-      Segment *seg = *it;
-
-      //            if(vp->vpBBox.PointInBox((seg->px1 + seg->px2)/2., (seg->py1
-      //            + seg->py2)/2., 0.))
-      {
-        wxPoint ab;
-        GetCanvasPixLL(vp, &ab, seg->py1, seg->px1);
-        wxPoint cd;
-        GetCanvasPixLL(vp, &cd, seg->py1, seg->px1);
-
-        int w = imageLabel.GetWidth();
-        int h = imageLabel.GetHeight();
-
-        int label_offset = 6;
-        int xd = (ab.x + cd.x - (w + label_offset * 2)) / 2;
-        int yd = (ab.y + cd.y - h) / 2;
-
-        int x = xd - label_offset;
-        wxRect r(x, yd, w, h);
-        r.Inflate(w);
-        if (!prev.Intersects(r)) {
-          prev = r;
-
-          /* don't use alpha for isobars, for some reason draw bitmap ignores
-             the 4th argument (true or false has same result) */
-          wxImage img(w, h, imageLabel.GetData(), true);
-          dc->DrawBitmap(img, xd, yd, false);
-        }
-      }
-    }
-  }
-}
-
-void IsoLine::drawIsoLineLabelsGL(GRIBOverlayFactory *pof, PlugIn_ViewPort *vp,
-                                  int density, int first, wxString label,
-                                  wxColour &color, TexFont &texfont)
-
-{
-  std::list<Segment *>::iterator it;
-  int nb = first;
-
-#ifdef ocpnUSE_GL
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-  //---------------------------------------------------------
-  // Ecrit les labels
-  //---------------------------------------------------------
-  wxRect prev;
-  for (it = trace.begin(); it != trace.end(); it++, nb++) {
-    if (nb % density == 0) {
-      Segment *seg = *it;
-
-      //            if(vp->vpBBox.PointInBox((seg->px1 + seg->px2)/2., (seg->py1
-      //            + seg->py2)/2., 0.))
-      {
-        wxPoint ab;
-        GetCanvasPixLL(vp, &ab, seg->py1, seg->px1);
-        wxPoint cd;
-        GetCanvasPixLL(vp, &cd, seg->py1, seg->px1);
-
-        int w, h;
-        texfont.GetTextExtent(label, &w, &h);
-
-        int label_offsetx = 6, label_offsety = 1;
-        int xd = (ab.x + cd.x - (w + label_offsetx * 2)) / 2;
-        int yd = (ab.y + cd.y - h) / 2;
-        int x = xd - label_offsetx, y = yd - label_offsety;
-        w += 2 * label_offsetx, h += 2 * label_offsety;
-
-        wxRect r(x, y, w, h);
-        r.Inflate(w);
-        if (!prev.Intersects(r)) {
-#if 1
-          prev = r;
-          if (pof->m_oDC) {
-            // pof->m_oDC->SetFont( *mfont );
-            pof->m_oDC->SetPen(*wxBLACK_PEN);
-            pof->m_oDC->SetBrush(color);
-            pof->m_oDC->DrawRectangle(x, y, w, h);
-            pof->m_oDC->DrawText(label, xd, yd);
-          }
-
-#else
-          prev = r;
-          glColor4ub(color.Red(), color.Green(), color.Blue(), color.Alpha());
-
-          /* draw bounding rectangle */
-          glBegin(GL_QUADS);
-          glVertex2i(x, y);
-          glVertex2i(x + w, y);
-          glVertex2i(x + w, y + h);
-          glVertex2i(x, y + h);
-          glEnd();
-
-          glColor3ub(0, 0, 0);
-
-          glBegin(GL_LINE_LOOP);
-          glVertex2i(x, y);
-          glVertex2i(x + w, y);
-          glVertex2i(x + w, y + h);
-          glVertex2i(x, y + h);
-          glEnd();
-
-          glEnable(GL_TEXTURE_2D);
-          texfont.RenderString(label, xd, yd);
-          glDisable(GL_TEXTURE_2D);
-#endif
-        }
-      }
-    }
-  }
-  glDisable(GL_BLEND);
-#endif
-}
-
 //==================================================================================
 // Segment
 //==================================================================================
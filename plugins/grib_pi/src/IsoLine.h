@@ -42,8 +42,10 @@
 #ifndef ISOLINE_H
 #define ISOLINE_H
 
+#include <atomic>
 #include <iostream>
 #include <cmath>
+#include <memory>
 #include <vector>
 #include <list>
 #include <set>
@@ -141,7 +143,6 @@ public:
 private:
   double value;
   int W, H;  // taille de la grille
-  const GribRecord *rec;
 
   wxColour isoLineColor;
   std::list<Segment *> trace;
@@ -158,8 +159,50 @@ private:
 
   MySegList m_seglist;
   MySegListList m_SegListList;
+};
+
+class GribThreadPool;
+
+/**
+ * Isolines of a record at a series of values.
+ *
+ * Each value is extracted by its own task on the worker threads, the set
+ * is drawable once IsReady() returns true. The set owns a private copy of
+ * the record so extraction is not affected by the cache dropping values
+ * or the record being deleted. The copy is released when the last level
+ * is done.
+ */
+class IsoLineSet {
+public:
+  /**
+   * @param rec Record to extract isolines from, owned by the set.
+   * @param values Isoline values in display units.
+   * @param coeffs Calibration factor of each value.
+   * @param offset Calibration offset of the values.
+   */
+  IsoLineSet(GribRecord *rec, const std::vector<double> &values,
+             const std::vector<double> &coeffs, double offset);
+
+  /**
+   * Queues the extraction of all levels of set on pool. Queued levels are
+   * skipped if the set is deleted before they run.
+   */
+  static void Extract(const std::shared_ptr<IsoLineSet> &set,
+                      GribThreadPool &pool);
+
+  bool IsReady() const { return m_Pending == 0; }
+  /** Number of isolines, only valid once ready. */
+  size_t GetCount() const { return m_Lines.size(); }
+  IsoLine *Item(size_t i) const { return m_Lines[i].get(); }
+
+private:
+  void ExtractLevel(size_t i);
 
-  double m_pixelMM;
+  std::unique_ptr<GribRecord> m_Record;
+  std::vector<double> m_Values, m_Coeffs;
+  double m_Offset;
+  std::vector<std::unique_ptr<IsoLine>> m_Lines;
+  std::atomic<size_t> m_Pending;
 };
 
 #endif
@@ -0,0 +1,267 @@
+/**********************************************************************
+zyGrib: meteorological GRIB file viewer
+Copyright (C) 2008 - Jacques Zaninetti - http://www.zygrib.org
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+***********************************************************************/
+/**
+ * \file
+ * Drawing of the isolines of \ref IsoLine.h, apart from the extraction so
+ * the latter does not depend on the overlay factory.
+ */
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+#include "wx/wx.h"
+#endif  // precompiled headers
+
+#include <wx/graphics.h>
+
+#include "IsoLine.h"
+#include "GribSettingsDialog.h"
+#include "GribOverlayFactory.h"
+
+//---------------------------------------------------------------
+void IsoLine::drawIsoLine(GRIBOverlayFactory *pof, wxDC *dc,
+                          PlugIn_ViewPort *vp, bool bHiDef) {
+  int nsegs = trace.size();
+  if (nsegs < 1) return;
+
+  GetGlobalColor(_T ( "UITX1" ), &isoLineColor);
+
+#if wxUSE_GRAPHICS_CONTEXT
+  wxGraphicsContext *pgc = nullptr;
+#endif
+
+  if (dc) {
+    wxPen ppISO(isoLineColor, 2);
+
+#if wxUSE_GRAPHICS_CONTEXT
+    wxMemoryDC *pmdc;
+    pmdc = dynamic_cast<wxMemoryDC *>(dc);
+    pgc = wxGraphicsContext::Create(*pmdc);
+    pgc->SetPen(ppISO);
+#endif
+    dc->SetPen(ppISO);
+  } else { /* opengl */
+#ifdef ocpnUSE_GL
+    // #ifndef USE_ANDROID_GLES2
+    //            if(m_pixelMM > 0.2){        // pixel size large enough to
+    //            render well
+    //            //      Enable anti-aliased lines, at best quality
+    //              glEnable( GL_LINE_SMOOTH );
+    //              glEnable( GL_BLEND );
+    //              glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
+    //              glHint( GL_LINE_SMOOTH_HINT, GL_NICEST );
+    //              glLineWidth( 2 );
+    //            }
+    //            else{
+    //              glLineWidth( 0.4/m_pixelMM);        //  set a target line
+    //              width by MM
+    //            }
+    // #else
+    if (pof->m_oDC) {
+      wxPen ppISO(isoLineColor, 2);
+      pof->m_oDC->SetPen(ppISO);
+    }
+#endif
+  }
+
+  std::list<Segment *>::iterator it;
+
+  //---------------------------------------------------------
+  // Dessine les segments
+  //---------------------------------------------------------
+  for (it = trace.begin(); it != trace.end(); it++) {
+    Segment *seg = *it;
+
+    if (vp->m_projection_type == PI_PROJECTION_MERCATOR ||
+        vp->m_projection_type == PI_PROJECTION_EQUIRECTANGULAR) {
+      /* skip segments that go the wrong way around the world */
+      double sx1 = seg->px1, sx2 = seg->px2;
+      if (sx2 - sx1 > 180)
+        sx2 -= 360;
+      else if (sx1 - sx2 > 180)
+        sx1 -= 360;
+
+      if ((sx1 + 180 < vp->clon && sx2 + 180 > vp->clon) ||
+          (sx1 + 180 > vp->clon && sx2 + 180 < vp->clon) ||
+          (sx1 - 180 < vp->clon && sx2 - 180 > vp->clon) ||
+          (sx1 - 180 > vp->clon && sx2 - 180 < vp->clon))
+        continue;
+    }
+
+    wxPoint ab;
+    GetCanvasPixLL(vp, &ab, seg->py1, seg->px1);
+    wxPoint cd;
+    GetCanvasPixLL(vp, &cd, seg->py2, seg->px2);
+
+    if (dc) {
+#if wxUSE_GRAPHICS_CONTEXT
+      if (bHiDef && pgc)
+        pgc->StrokeLine(ab.x, ab.y, cd.x, cd.y);
+      else
+#endif
+        dc->DrawLine(ab.x, ab.y, cd.x, cd.y);
+    } else { /* opengl */
+#ifdef ocpnUSE_GL
+
+      if (pof->m_oDC) {
+        pof->m_oDC->DrawLine(ab.x, ab.y, cd.x, cd.y);
+      }
+
+#endif
+    }
+  }
+
+#if wxUSE_GRAPHICS_CONTEXT
+  delete pgc;
+#endif
+
+  //      if(!dc) /* opengl */
+  //          glEnd();
+}
+
+//---------------------------------------------------------------
+
+void IsoLine::drawIsoLineLabels(GRIBOverlayFactory *pof, wxDC *dc,
+                                PlugIn_ViewPort *vp, int density, int first,
+                                wxImage &imageLabel)
+
+{
+  std::list<Segment *>::iterator it;
+  int nb = first;
+  wxString label;
+
+  //---------------------------------------------------------
+  // Ecrit les labels
+  //---------------------------------------------------------
+  wxRect prev;
+  for (it = trace.begin(); it != trace.end(); it++, nb++) {
+    if (nb % density == 0) {
+      Segment *seg = *it;
+
+      //            if(vp->vpBBox.PointInBox((seg->px1 + seg->px2)/2., (seg->py1
+      //            + seg->py2)/2., 0.))
+      {
+        wxPoint ab;
+        GetCanvasPixLL(vp, &ab, seg->py1, seg->px1);
+        wxPoint cd;
+        GetCanvasPixLL(vp, &cd, seg->py1, seg->px1);
+
+        int w = imageLabel.GetWidth();
+        int h = imageLabel.GetHeight();
+
+        int label_offset = 6;
+        int xd = (ab.x + cd.x - (w + label_offset * 2)) / 2;
+        int yd = (ab.y + cd.y - h) / 2;
+
+        int x = xd - label_offset;
+        wxRect r(x, yd, w, h);
+        r.Inflate(w);
+        if (!prev.Intersects(r)) {
+          prev = r;
+
+          /* don't use alpha for isobars, for some reason draw bitmap ignores
+             the 4th argument (true or false has same result) */
+          wxImage img(w, h, imageLabel.GetData(), true);
+          dc->DrawBitmap(img, xd, yd, false);
+        }
+      }
+    }
+  }
+}
+
+void IsoLine::drawIsoLineLabelsGL(GRIBOverlayFactory *pof, PlugIn_ViewPort *vp,
+                                  int density, int first, wxString label,
+                                  wxColour &color, TexFont &texfont)
+
+{
+  std::list<Segment *>::iterator it;
+  int nb = first;
+
+#ifdef ocpnUSE_GL
+  glEnable(GL_BLEND);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+  //---------------------------------------------------------
+  // Ecrit les labels
+  //---------------------------------------------------------
+  wxRect prev;
+  for (it = trace.begin(); it != trace.end(); it++, nb++) {
+    if (nb % density == 0) {
+      Segment *seg = *it;
+
+      //            if(vp->vpBBox.PointInBox((seg->px1 + seg->px2)/2., (seg->py1
+      //            + seg->py2)/2., 0.))
+      {
+        wxPoint ab;
+        GetCanvasPixLL(vp, &ab, seg->py1, seg->px1);
+        wxPoint cd;
+        GetCanvasPixLL(vp, &cd, seg->py1, seg->px1);
+
+        int w, h;
+        texfont.GetTextExtent(label, &w, &h);
+
+        int label_offsetx = 6, label_offsety = 1;
+        int xd = (ab.x + cd.x - (w + label_offsetx * 2)) / 2;
+        int yd = (ab.y + cd.y - h) / 2;
+        int x = xd - label_offsetx, y = yd - label_offsety;
+        w += 2 * label_offsetx, h += 2 * label_offsety;
+
+        wxRect r(x, y, w, h);
+        r.Inflate(w);
+        if (!prev.Intersects(r)) {
+#if 1
+          prev = r;
+          if (pof->m_oDC) {
+            // pof->m_oDC->SetFont( *mfont );
+            pof->m_oDC->SetPen(*wxBLACK_PEN);
+            pof->m_oDC->SetBrush(color);
+            pof->m_oDC->DrawRectangle(x, y, w, h);
+            pof->m_oDC->DrawText(label, xd, yd);
+          }
+
+#else
+          prev = r;
+          glColor4ub(color.Red(), color.Green(), color.Blue(), color.Alpha());
+
+          /* draw bounding rectangle */
+          glBegin(GL_QUADS);
+          glVertex2i(x, y);
+          glVertex2i(x + w, y);
+          glVertex2i(x + w, y + h);
+          glVertex2i(x, y + h);
+          glEnd();
+
+          glColor3ub(0, 0, 0);
+
+          glBegin(GL_LINE_LOOP);
+          glVertex2i(x, y);
+          glVertex2i(x + w, y);
+          glVertex2i(x + w, y + h);
+          glVertex2i(x, y + h);
+          glEnd();
+
+          glEnable(GL_TEXTURE_2D);
+          texfont.RenderString(label, xd, yd);
+          glDisable(GL_TEXTURE_2D);
+#endif
+        }
+      }
+    }
+  }
+  glDisable(GL_BLEND);
+#endif
+}
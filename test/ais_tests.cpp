@@ -0,0 +1,221 @@
+#include "config.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if (defined(OCPN_GHC_FILESYSTEM) || \
+     (defined(__clang_major__) && (__clang_major__ < 15)))
+#include <ghc/filesystem.hpp>
+namespace fs = ghc::filesystem;
+#else
+#include <filesystem>
+#include <utility>
+namespace fs = std::filesystem;
+#endif
+
+#include <gtest/gtest.h>
+
+#include "model/ais_bitstring.h"
+
+/**
+ * The character at a time, bit at a time AisBitstring used up to 2025,
+ * reference for correctness and performance.
+ */
+class LegacyBitstring {
+public:
+  LegacyBitstring(const char* str) {
+    byte_length = strlen(str);
+    for (int i = 0; i < byte_length; i++) bitbytes[i] = to_6bit(str[i]);
+  }
+
+  unsigned char to_6bit(const char c) {
+    if (c < 0x30) return (unsigned char)-1;
+    if (c > 0x77) return (unsigned char)-1;
+    if ((0x57 < c) && (c < 0x60)) return (unsigned char)-1;
+    unsigned char cp = c;
+    cp += 0x28;
+    if (cp > 0x80)
+      cp += 0x20;
+    else
+      cp += 0x28;
+    return (unsigned char)(cp & 0x3f);
+  }
+
+  int GetInt(int sp, int len, bool signed_flag = false) {
+    int acc = 0;
+    int s0p = sp - 1;
+    for (int i = 0; i < len; i++) {
+      acc = static_cast<int>(static_cast<unsigned>(acc) << 1);
+      int cp = (s0p + i) / 6;
+      int cx = bitbytes[cp];
+      int c0 = (cx >> (5 - ((s0p + i) % 6))) & 1;
+      if (i == 0 && signed_flag && c0) acc = ~acc;
+      acc |= c0;
+    }
+    return acc;
+  }
+
+  int GetStr(int sp, int bit_len, char* dest, int max_len) {
+    int s0p = sp - 1;
+    int k = 0;
+    int i = 0;
+    while (i < bit_len && k < max_len) {
+      char acc = 0;
+      for (int j = 0; j < 6; j++) {
+        acc = acc << 1;
+        int cp = (s0p + i) / 6;
+        int cx = bitbytes[cp];
+        int cs = 5 - ((s0p + i) % 6);
+        acc |= (cx >> cs) & 1;
+        i++;
+      }
+      dest[k] = (char)(acc & 0x3f);
+      if (acc < 32) dest[k] += 0x40;
+      k++;
+    }
+    dest[k] = 0;
+    return k;
+  }
+
+  int GetBitCount() { return byte_length * 6; }
+
+private:
+  unsigned char bitbytes[AIS_MAX_MESSAGE_LEN];
+  int byte_length;
+};
+
+/** Return all complete VDM payloads in the recorded test logs. */
+static std::vector<std::string> LoadCorpus() {
+  std::vector<std::string> payloads;
+  for (const char* file : {"Go_to_Guernesey.txt", "Hakefjord.log"}) {
+    std::ifstream stream(fs::path(TESTDATA) / file);
+    std::string line;
+    std::string accumulator;
+    while (std::getline(stream, line)) {
+      if (line.compare(0, 6, "!AIVDM") != 0) continue;
+      std::vector<std::string> fields;
+      size_t start = 0;
+      for (size_t comma; (comma = line.find(',', start)) != std::string::npos;
+           start = comma + 1) {
+        fields.push_back(line.substr(start, comma - start));
+      }
+      if (fields.size() < 6) continue;
+      if (fields[2] == "1") accumulator.clear();
+      accumulator += fields[5];
+      if (fields[1] == fields[2] && !accumulator.empty() &&
+          accumulator.size() < AIS_MAX_MESSAGE_LEN) {
+        payloads.push_back(accumulator);
+      }
+    }
+  }
+  return payloads;
+}
+
+/**
+ * Decode the fields of the common messages; position reports and static
+ * data. Return something depending on all of them.
+ */
+template <typename Bitstring>
+static long DecodeFields(Bitstring& bits) {
+  long sum = bits.GetInt(1, 6) + bits.GetInt(9, 30);
+  switch (bits.GetInt(1, 6)) {
+    case 1:
+    case 2:
+    case 3:
+      sum += bits.GetInt(39, 4) + bits.GetInt(43, 8, true);
+      sum += bits.GetInt(51, 10) + bits.GetInt(62, 28, true);
+      sum += bits.GetInt(90, 27, true) + bits.GetInt(117, 12);
+      sum += bits.GetInt(129, 9) + bits.GetInt(138, 6);
+      break;
+    case 18:
+      sum += bits.GetInt(47, 10) + bits.GetInt(58, 28, true);
+      sum += bits.GetInt(86, 27, true) + bits.GetInt(113, 12);
+      sum += bits.GetInt(125, 9) + bits.GetInt(134, 6);
+      break;
+    case 5: {
+      char name[21];
+      sum += bits.GetInt(40, 30) + bits.GetStr(71, 42, name, 7);
+      sum += bits.GetStr(113, 120, name, 20) + name[0];
+      sum += bits.GetInt(233, 8) + bits.GetInt(241, 9);
+      break;
+    }
+    default:
+      break;
+  }
+  return sum;
+}
+
+TEST(AisBitstring, MatchesLegacy) {
+  auto payloads = LoadCorpus();
+  ASSERT_GT(payloads.size(), 10000);
+
+  // Payloads using all characters, also invalid ones.
+  payloads.push_back(
+      "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVW`abcdefghijklmnopqrstuvw");
+  payloads.push_back("!\"#$%&'()*+,-./XYZ[\\]^_xyz{|}~");
+
+  const int lengths[] = {1, 2, 6, 8, 10, 12, 27, 28, 30, 32};
+  for (size_t n = 0; n < payloads.size(); n += 10) {
+    const char* payload = payloads[n].c_str();
+    AisBitstring bits(payload);
+    LegacyBitstring legacy(payload);
+    ASSERT_EQ(bits.GetBitCount(), legacy.GetBitCount()) << payload;
+    for (int len : lengths) {
+      for (int sp = 1; sp + len - 1 <= legacy.GetBitCount(); sp++) {
+        ASSERT_EQ(bits.GetInt(sp, len), legacy.GetInt(sp, len))
+            << payload << " sp: " << sp << " len: " << len;
+        ASSERT_EQ(bits.GetInt(sp, len, true), legacy.GetInt(sp, len, true))
+            << payload << " sp: " << sp << " len: " << len;
+      }
+    }
+    char str[21];
+    char legacy_str[21];
+    for (int sp = 1; sp + 6 <= legacy.GetBitCount(); sp += 6) {
+      int max_bits = legacy.GetBitCount() - sp + 1;
+      int k = bits.GetStr(sp, max_bits, str, 20);
+      ASSERT_EQ(k, legacy.GetStr(sp, max_bits, legacy_str, 20));
+      ASSERT_STREQ(str, legacy_str);
+    }
+  }
+}
+
+/**
+ * Messages per second decoded, recorded AIS corpus. Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(AisBitstring, DISABLED_Benchmark) {
+  using clock = std::chrono::steady_clock;
+  static const int kRounds = 20;
+
+  auto payloads = LoadCorpus();
+  ASSERT_FALSE(payloads.empty());
+
+  long legacy_sum = 0;
+  auto t0 = clock::now();
+  for (int round = 0; round < kRounds; round++) {
+    for (const auto& payload : payloads) {
+      LegacyBitstring bits(payload.c_str());
+      legacy_sum += DecodeFields(bits);
+    }
+  }
+  std::chrono::duration<double> legacy_secs = clock::now() - t0;
+
+  long sum = 0;
+  t0 = clock::now();
+  for (int round = 0; round < kRounds; round++) {
+    for (const auto& payload : payloads) {
+      AisBitstring bits(payload.c_str());
+      sum += DecodeFields(bits);
+    }
+  }
+  std::chrono::duration<double> secs = clock::now() - t0;
+
+  EXPECT_EQ(sum, legacy_sum);
+  const double count = static_cast<double>(payloads.size()) * kRounds;
+  RecordProperty("legacy_msgs_per_sec",
+                 std::to_string(count / legacy_secs.count()));
+  RecordProperty("msgs_per_sec", std::to_string(count / secs.count()));
+}
@@ -2,6 +2,8 @@
 
 #include <chrono>
 #include <fstream>
+#include <mutex>
+#include <queue>
 #include <string>
 #include <thread>
 
@@ -25,6 +27,7 @@ namespace fs = std::filesystem;
 #include "model/comm_out_queue.h"
 #include "model/logger.h"
 #include "model/ocpn_utils.h"
+#include "model/ring_buffer.h"
 
 #include "observable.h"
 
@@ -164,3 +167,130 @@ TEST(N0183Nuffer, Basic) {
   EXPECT_TRUE(n0183_buffer.HasSentence());
   EXPECT_EQ(n0183_buffer.GetSentence(), input1);
 }
+
+TEST(RingBuffer, SpscOverflow) {
+  SpscRingBuffer<int> buffer(5);
+  EXPECT_EQ(buffer.capacity(), 8);
+  for (int i = 0; i < 10; i++) buffer.try_push(i);
+  EXPECT_EQ(buffer.size(), 8);
+  EXPECT_EQ(buffer.overflows(), 2);
+
+  std::vector<int> out;
+  EXPECT_EQ(buffer.try_pop_n(out, 3), 3);
+  EXPECT_EQ(out, std::vector<int>({0, 1, 2}));
+  int value;
+  EXPECT_TRUE(buffer.try_pop(value));
+  EXPECT_EQ(value, 3);
+  EXPECT_EQ(buffer.try_pop_n(out, 100), 4);
+  EXPECT_EQ(out.back(), 7);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_FALSE(buffer.try_pop(value));
+
+  const int bytes[] = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+  EXPECT_EQ(buffer.try_push_n(bytes, 10), 8);
+  EXPECT_EQ(buffer.overflows(), 4);
+}
+
+TEST(RingBuffer, SpscOverwrite) {
+  SpscRingBuffer<int> buffer(4);
+  const int first[] = {1, 2, 3};
+  EXPECT_EQ(buffer.push_n_overwrite(first, 3), 0);
+  const int second[] = {4, 5, 6};
+  EXPECT_EQ(buffer.push_n_overwrite(second, 3), 2);
+  std::vector<int> out;
+  buffer.try_pop_n(out, 100);
+  EXPECT_EQ(out, std::vector<int>({3, 4, 5, 6}));
+
+  const int many[] = {7, 8, 9, 10, 11, 12};
+  EXPECT_EQ(buffer.push_n_overwrite(many, 6), 2);
+  out.clear();
+  buffer.try_pop_n(out, 100);
+  EXPECT_EQ(out, std::vector<int>({9, 10, 11, 12}));
+  EXPECT_EQ(buffer.overflows(), 4);
+}
+
+TEST(RingBuffer, MpscThreads) {
+  static const int kCount = 20000;
+  MpscRingBuffer<std::string> buffer(64);
+  auto producer = [&](const char* prefix) {
+    for (int i = 0; i < kCount; i++) {
+      std::string line(prefix + std::to_string(i));
+      while (!buffer.try_push(line)) std::this_thread::yield();
+    }
+  };
+  std::thread t1(producer, "$GPGGA ");
+  std::thread t2(producer, "$GPGLL ");
+
+  // Each producer's items must arrive in order.
+  int next_gga = 0;
+  int next_gll = 0;
+  std::vector<std::string> batch;
+  while (next_gga + next_gll < 2 * kCount) {
+    batch.clear();
+    if (buffer.try_pop_n(batch, 16) == 0) std::this_thread::yield();
+    for (const auto& line : batch) {
+      int& next = ocpn::startswith(line, "$GPGGA") ? next_gga : next_gll;
+      ASSERT_EQ(std::stoi(line.substr(7)), next);
+      next++;
+    }
+  }
+  t1.join();
+  t2.join();
+  EXPECT_TRUE(buffer.empty());
+}
+
+/**
+ * Microbenchmark: one producer thread against consumer, old vs new queue.
+ * Run with --gtest_also_run_disabled_tests.
+ */
+TEST(RingBuffer, DISABLED_Benchmark) {
+  static const int kCount = 200000;
+  using clock = std::chrono::steady_clock;
+  std::vector<uint8_t> msg(40, 'x');
+
+  // The mutex guarded queue the drivers used before, locked per operation
+  std::queue<std::vector<uint8_t>> old_queue;
+  std::mutex old_mutex;
+  auto t0 = clock::now();
+  std::thread old_producer([&] {
+    for (int i = 0; i < kCount; i++) {
+      std::lock_guard<std::mutex> lock(old_mutex);
+      old_queue.push(msg);
+    }
+  });
+  for (int n = 0; n < kCount;) {
+    std::vector<uint8_t> qmsg;
+    {
+      std::lock_guard<std::mutex> lock(old_mutex);
+      if (!old_queue.empty()) {
+        qmsg = old_queue.front();
+        old_queue.pop();
+        n++;
+      }
+    }
+    if (qmsg.empty()) std::this_thread::yield();
+  }
+  old_producer.join();
+  std::chrono::duration<double, std::milli> old_ms = clock::now() - t0;
+
+  SpscRingBuffer<std::vector<uint8_t>> new_queue(1024);
+  t0 = clock::now();
+  std::thread new_producer([&] {
+    for (int i = 0; i < kCount; i++) {
+      while (!new_queue.try_push(msg)) std::this_thread::yield();
+    }
+  });
+  std::vector<std::vector<uint8_t>> batch;
+  for (int n = 0; n < kCount;) {
+    batch.clear();
+    size_t count = new_queue.try_pop_n(batch, 64);
+    if (count == 0) std::this_thread::yield();
+    n += count;
+  }
+  new_producer.join();
+  std::chrono::duration<double, std::milli> new_ms = clock::now() - t0;
+
+  RecordProperty("mutex_queue_ms", std::to_string(old_ms.count()));
+  RecordProperty("ring_buffer_ms", std::to_string(new_ms.count()));
+  EXPECT_TRUE(new_queue.empty());
+}
@@ -0,0 +1,153 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "label_grid.h"
+
+/** Labels with a current rectangle, as S52_TextC::rText. */
+struct Label {
+  LabelRect rect;
+};
+
+/** Linear scan of the declutter list, as done before the grid. */
+struct LinearList {
+  std::vector<Label*> labels;
+
+  bool Overlaps(const LabelRect& rect, const Label* except) const {
+    for (auto label : labels) {
+      if (label->rect.Intersects(rect) && label != except) return true;
+    }
+    return false;
+  }
+  bool Contains(const Label* label) const {
+    for (auto l : labels) {
+      if (l == label) return true;
+    }
+    return false;
+  }
+};
+
+static std::vector<LabelRect> MakeRects(int count, int screen_w,
+                                        int screen_h) {
+  std::mt19937 rng(4711);
+  auto uniform = [&](int a, int b) {
+    return std::uniform_int_distribution<int>(a, b)(rng);
+  };
+  std::vector<LabelRect> rects;
+  for (int i = 0; i < count; i++) {
+    // Mostly small labels, some empty and a few very wide ones.
+    const int w = i % 97 == 0 ? 0 : i % 89 == 0 ? 900 : uniform(4, 120);
+    const int h = i % 101 == 0 ? 0 : uniform(8, 24);
+    rects.push_back(
+        {uniform(-150, screen_w + 20), uniform(-30, screen_h + 10), w, h});
+  }
+  return rects;
+}
+
+TEST(LabelGrid, IntersectsAsWxRect) {
+  const LabelRect a{0, 0, 10, 10};
+  EXPECT_TRUE(a.Intersects({9, 9, 1, 1}));
+  EXPECT_FALSE(a.Intersects({10, 0, 5, 5}));
+  EXPECT_FALSE(a.Intersects({0, 10, 5, 5}));
+  EXPECT_TRUE(a.Intersects({-5, -5, 6, 6}));
+  EXPECT_FALSE(a.Intersects({-5, -5, 5, 5}));
+  EXPECT_FALSE(a.Intersects({5, 5, 0, 3}));
+}
+
+/**
+ * Declutter steps of s52plib::RenderT_All() for one label: RenderText()
+ * draws it unless CheckTextRectList() finds an overlap, the rectangle is
+ * then recorded. Return true if drawn.
+ */
+static bool Render(LabelGrid<Label*>& grid, Label* label,
+                   const LabelRect& rect, bool declutter = true) {
+  const bool drawn = !declutter || !grid.Overlaps(rect, label);
+  label->rect = rect;
+  grid.Update(label, rect, declutter && drawn);
+  return drawn;
+}
+
+TEST(LabelGrid, DeclutterAsRenderText) {
+  LabelGrid<Label*> grid;
+  Label a, b, c, d, e, f;
+
+  EXPECT_TRUE(Render(grid, &a, {0, 0, 100, 20}));
+  EXPECT_FALSE(Render(grid, &b, {50, 10, 100, 20}));
+  EXPECT_FALSE(grid.Contains(&b));
+  EXPECT_TRUE(Render(grid, &c, {200, 0, 50, 20}));
+
+  // Second text of a, checked against all labels but a and grown
+  EXPECT_TRUE(Render(grid, &a, {0, 0, 160, 20}));
+  EXPECT_FALSE(Render(grid, &d, {150, 5, 20, 10}));
+  EXPECT_EQ(grid.GetCount(), 2u);
+
+  // Declutter off: drawn but not recorded
+  EXPECT_TRUE(Render(grid, &e, {0, 100, 50, 20}, false));
+  EXPECT_FALSE(grid.Contains(&e));
+  EXPECT_TRUE(Render(grid, &f, {10, 105, 50, 20}));
+
+  // Texts of an unloaded chart, others stay decluttered against
+  grid.Remove(&a);
+  EXPECT_TRUE(Render(grid, &b, {50, 10, 100, 20}));
+  EXPECT_FALSE(Render(grid, &d, {210, 5, 20, 10}));
+  EXPECT_EQ(grid.GetCount(), 3u);
+}
+
+/**
+ * Dense screens rendered as by s52plib, some objects with several texts.
+ * The grid must find the same overlaps as a linear scan.
+ */
+TEST(LabelGrid, PlacementMatchesLinearScan) {
+  const auto rects = MakeRects(4000, 1920, 1080);
+  std::vector<Label> labels(rects.size());
+
+  for (int frame = 0; frame < 3; frame++) {
+    LabelGrid<Label*> grid;
+    LinearList list;
+    size_t drawn = 0;
+    for (size_t i = 0; i < rects.size(); i++) {
+      Label* label = &labels[(i * 7 + frame) % labels.size()];
+      LabelRect rect = rects[i];
+      if (i % 5 == 0 && list.Contains(label)) {
+        rect.width += 40;  // Second text of the same object
+      }
+      const bool overlaps = list.Overlaps(rect, label);
+      ASSERT_EQ(grid.Overlaps(rect, label), overlaps) << i;
+      ASSERT_EQ(Render(grid, label, rect), !overlaps) << i;
+      if (!overlaps && !list.Contains(label)) list.labels.push_back(label);
+      drawn += !overlaps;
+      ASSERT_EQ(grid.GetCount(), list.labels.size());
+    }
+    EXPECT_GT(drawn, 100u);
+    EXPECT_LT(drawn, rects.size());
+    for (int i = 0; i < 2000; i++) {
+      const LabelRect probe = rects[(i * 13) % rects.size()];
+      ASSERT_EQ(grid.Overlaps(probe, nullptr), list.Overlaps(probe, nullptr));
+    }
+  }
+}
+
+/**
+ * Milliseconds to place all labels of a dense screen. Timing only, run
+ * with --gtest_also_run_disabled_tests.
+ */
+TEST(LabelGrid, DISABLED_Benchmark) {
+  using clock = std::chrono::steady_clock;
+  const auto rects = MakeRects(20000, 3840, 2160);
+  std::vector<Label> labels(rects.size());
+  LabelGrid<Label*> grid;
+
+  auto t0 = clock::now();
+  size_t drawn = 0;
+  for (size_t i = 0; i < rects.size(); i++) {
+    if (grid.Overlaps(rects[i], &labels[i])) continue;
+    grid.Set(&labels[i], rects[i]);
+    drawn++;
+  }
+  std::chrono::duration<double, std::milli> ms = clock::now() - t0;
+  EXPECT_GT(drawn, 0u);
+  RecordProperty("ms_per_screen", std::to_string(ms.count()));
+}
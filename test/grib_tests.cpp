@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "std_filesystem.h"
+
+#include "GribParticles.h"
+#include "GribReader.h"
+#include "GribThreadPool.h"
+#include "IsoLine.h"
+
+static const char* const kSample = TESTDATA "/grib2_sample.grb2";
+
+/** All records of reader, in map order. */
+static std::vector<GribRecord*> AllRecords(GribReader& reader) {
+  std::vector<GribRecord*> records;
+  for (auto& kv : *reader.getGribMap()) {
+    for (auto rec : *kv.second) records.push_back(rec);
+  }
+  return records;
+}
+
+/** The GRIB2 files in the $GRIB_CORPUS directory, the sample if not set. */
+static std::vector<std::string> CorpusFiles() {
+  std::vector<std::string> files;
+  const char* dir = std::getenv("GRIB_CORPUS");
+  if (dir) {
+    for (const auto& entry : fs::directory_iterator(dir)) {
+      auto ext = entry.path().extension().string();
+      if (ext == ".grb2" || ext == ".grib2") {
+        files.push_back(entry.path().string());
+      }
+    }
+    std::sort(files.begin(), files.end());
+  }
+  if (files.empty()) files.push_back(kSample);
+  return files;
+}
+
+template <typename T>
+static bool SameBytes(const std::vector<T>& a, const std::vector<T>& b) {
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+/** Same grid and bitwise identical values, NaN included. */
+static void ExpectSameValues(const GribRecord& a, const GribRecord& b) {
+  ASSERT_EQ(a.getNi(), b.getNi());
+  ASSERT_EQ(a.getNj(), b.getNj());
+  int diffs = 0;
+  for (int j = 0; j < a.getNj(); j++) {
+    for (int i = 0; i < a.getNi(); i++) {
+      double va = a.getValue(i, j);
+      double vb = b.getValue(i, j);
+      if (std::memcmp(&va, &vb, sizeof va) != 0) diffs++;
+    }
+  }
+  EXPECT_EQ(diffs, 0);
+}
+
+TEST(GribThreadPool, ParallelForRunsEachIndexOnce) {
+  auto pool = GribThreadPool::GetShared();
+  const size_t kCount = 10000;
+  std::vector<std::atomic<int>> runs(kCount);
+  pool->ParallelFor(kCount, [&runs](size_t i) { runs[i]++; });
+  for (size_t i = 0; i < kCount; i++) EXPECT_EQ(runs[i], 1) << i;
+}
+
+TEST(GribThreadPool, SharedWhileHeld) {
+  auto pool = GribThreadPool::GetShared();
+  EXPECT_EQ(pool, GribThreadPool::GetShared());
+  EXPECT_GE(pool->GetThreadCount(), 1u);
+}
+
+/**
+ * First record of a field in the sample as decoded before values were
+ * unpacked in blocks, by the per value bit reader getBits().
+ */
+struct SampleField {
+  int data_type;
+  int missing;  ///< Count of GRIB_NOTDEF values
+  double sum;   ///< Sum of the defined values
+  double at_0_0;
+  double at_17_9;
+  double at_40_30;
+};
+
+static const SampleField kSampleFields[] = {
+    // Simple packing, 12 bits
+    {GRB_TEMP, 0, 370253.40, 285.0, 292.3, 292.2},
+    // Complex packing, spatial differencing
+    {GRB_WIND_VX, 0, 36524.10, 20.0, 29.3, 27.7},
+    // Simple packing, 11 bits, bit map
+    {GRB_WIND_VY, 115, 61773.20, GRIB_NOTDEF, 55.4, 45.2},
+    // Complex packing
+    {GRB_PRESSURE, 0, 127397066.0, 100000.0, 100171.0, 100420.0}};
+
+static void ExpectSampleValues(GribReader& reader) {
+  for (const auto& field : kSampleFields) {
+    SCOPED_TRACE(field.data_type);
+    GribRecord* rec = nullptr;
+    for (auto& kv : *reader.getGribMap()) {
+      auto first = kv.second->front();
+      if (first->getDataType() == field.data_type) rec = first;
+    }
+    ASSERT_TRUE(rec);
+    ASSERT_EQ(rec->getNi(), 41);
+    ASSERT_EQ(rec->getNj(), 31);
+    int missing = 0;
+    double sum = 0;
+    for (int j = 0; j < rec->getNj(); j++) {
+      for (int i = 0; i < rec->getNi(); i++) {
+        double v = rec->getValue(i, j);
+        if (v == GRIB_NOTDEF)
+          missing++;
+        else
+          sum += v;
+      }
+    }
+    EXPECT_EQ(missing, field.missing);
+    EXPECT_NEAR(sum, field.sum, 0.05);
+    EXPECT_NEAR(rec->getValue(0, 0), field.at_0_0, 1e-4);
+    EXPECT_NEAR(rec->getValue(17, 9), field.at_17_9, 1e-4);
+    EXPECT_NEAR(rec->getValue(40, 30), field.at_40_30, 1e-4);
+  }
+}
+
+TEST(GribDataCache, ParallelLoadMatchesSerial) {
+  GribReader serial(kSample);
+  GribReader parallel(kSample);
+  ASSERT_TRUE(serial.isOk());
+  ASSERT_TRUE(parallel.isOk());
+  auto expected = AllRecords(serial);
+  auto records = AllRecords(parallel);
+  ASSERT_EQ(records.size(), expected.size());
+  ASSERT_FALSE(records.empty());
+
+  for (auto rec : expected) ASSERT_TRUE(rec->loadData());
+  parallel.getDataCache().load(records);
+  EXPECT_EQ(parallel.getDataCache().getCount(),
+            serial.getDataCache().getCount());
+  for (size_t i = 0; i < records.size(); i++) {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(records[i]->getDataType(), expected[i]->getDataType());
+    EXPECT_EQ(records[i]->getLevelType(), expected[i]->getLevelType());
+    EXPECT_EQ(records[i]->getLevelValue(), expected[i]->getLevelValue());
+    EXPECT_EQ(records[i]->getRecordCurrentDate(),
+              expected[i]->getRecordCurrentDate());
+    ExpectSameValues(*records[i], *expected[i]);
+  }
+  ExpectSampleValues(parallel);
+}
+
+/**
+ * Decoding time of a GRIB2 corpus record by record on the caller and with
+ * GribDataCache::load(). Set GRIB_CORPUS to a directory of GRIB2 files to
+ * measure real downloads, the sample is used otherwise. Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(GribDataCache, DISABLED_DecodeBenchmark) {
+  using clock = std::chrono::steady_clock;
+  std::chrono::duration<double> serial_time(0);
+  std::chrono::duration<double> parallel_time(0);
+  size_t count = 0;
+  for (const auto& path : CorpusFiles()) {
+    SCOPED_TRACE(path);
+    GribReader serial(path);
+    GribReader parallel(path);
+    ASSERT_TRUE(serial.isOk());
+    ASSERT_TRUE(parallel.isOk());
+    auto expected = AllRecords(serial);
+    auto records = AllRecords(parallel);
+    ASSERT_EQ(records.size(), expected.size());
+
+    auto t0 = clock::now();
+    for (auto rec : expected) rec->loadData();
+    serial_time += clock::now() - t0;
+    t0 = clock::now();
+    parallel.getDataCache().load(records);
+    parallel_time += clock::now() - t0;
+    EXPECT_EQ(parallel.getDataCache().getCount(),
+              serial.getDataCache().getCount());
+    count += records.size();
+  }
+  RecordProperty("records", std::to_string(count));
+  RecordProperty("serial_ms", std::to_string(serial_time.count() * 1000));
+  RecordProperty("parallel_ms", std::to_string(parallel_time.count() * 1000));
+}
+
+/** Waits until all levels of set are extracted, false on timeout. */
+static bool WaitReady(const IsoLineSet& set) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (!set.IsReady()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+TEST(IsoLineSet, ParallelExtractMatchesSerial) {
+  GribReader reader(kSample);
+  ASSERT_TRUE(reader.isOk());
+  auto records = reader.getListOfGribRecords(GRB_PRESSURE, LV_MSL, 0);
+  ASSERT_NE(records, nullptr);
+  ASSERT_FALSE(records->empty());
+
+  auto pool = GribThreadPool::GetShared();
+  for (auto rec : *records) {
+    // isobars every hPa over the range of the record
+    double lo = rec->getValue(0, 0), hi = lo;
+    for (int j = 0; j < rec->getNj(); j++) {
+      for (int i = 0; i < rec->getNi(); i++) {
+        lo = std::min(lo, rec->getValue(i, j));
+        hi = std::max(hi, rec->getValue(i, j));
+      }
+    }
+    std::vector<double> values, coeffs;
+    for (double v = std::ceil(lo / 100) * 100; v <= hi; v += 100) {
+      values.push_back(v);
+      coeffs.push_back(1.0);
+    }
+    ASSERT_GT(values.size(), 2u);
+
+    auto set = std::make_shared<IsoLineSet>(new GribRecord(*rec), values,
+                                            coeffs, 0.0);
+    IsoLineSet::Extract(set, *pool);
+    ASSERT_TRUE(WaitReady(*set));
+    ASSERT_EQ(set->GetCount(), values.size());
+    int segments = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+      IsoLine expected(values[i], coeffs[i], 0.0, rec);
+      ASSERT_NE(set->Item(i), nullptr);
+      EXPECT_EQ(set->Item(i)->getValue(), expected.getValue());
+      EXPECT_EQ(set->Item(i)->getNbSegments(), expected.getNbSegments());
+      segments += expected.getNbSegments();
+    }
+    EXPECT_GT(segments, 0);
+  }
+}
+
+TEST(IsoLineSet, DeletedBeforeExtraction) {
+  GribReader reader(kSample);
+  ASSERT_TRUE(reader.isOk());
+  GribRecord* rec = reader.getFirstGribRecord(GRB_PRESSURE, LV_MSL, 0);
+  ASSERT_NE(rec, nullptr);
+
+  GribThreadPool pool(1);
+  // keeps the only worker busy until the set is gone
+  std::atomic<bool> release(false), done(false);
+  pool.Submit([&release] {
+    while (!release) std::this_thread::yield();
+  });
+  auto set = std::make_shared<IsoLineSet>(
+      new GribRecord(*rec), std::vector<double>{101000, 101300},
+      std::vector<double>{1, 1}, 0.0);
+  IsoLineSet::Extract(set, pool);
+  std::weak_ptr<IsoLineSet> weak = set;
+  set.reset();
+  EXPECT_TRUE(weak.expired());
+
+  // the queued levels run next and must skip the deleted set
+  pool.Submit([&done] { done = true; });
+  release = true;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+  while (!done && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(done);
+}
+
+/** Particles at random positions over rec, as RenderGribParticles(). */
+static void SeedParticles(ParticleMap& particles, const GribRecord& rec,
+                          size_t count) {
+  std::mt19937 rng(4711);
+  std::uniform_real_distribution<float> lon(rec.getLonMin(), rec.getLonMax());
+  std::uniform_real_distribution<float> lat(rec.getLatMin(), rec.getLatMax());
+  particles.history_size = MAX_PARTICLE_HISTORY;
+  particles.Resize(count);
+  for (size_t i = 0; i < count; i++) {
+    particles.m_Duration[i] = i % (ParticleMap::MAX_DURATION / 2);
+    particles.m_HistoryPos[i] = 0;
+    particles.m_HistorySize[i] = 1;
+    particles.m_Run[i] = i % ParticleMap::RUN_COUNT;
+    particles.m_State[i] = ParticleMap::KEPT;
+    particles.Pos(i, 0)[0] = lon(rng);
+    particles.Pos(i, 0)[1] = lat(rng);
+  }
+}
+
+TEST(ParticleMap, ParallelAdvanceMatchesSerial) {
+  GribReader reader(kSample);
+  ASSERT_TRUE(reader.isOk());
+  GribRecord* x = reader.getFirstGribRecord(GRB_WIND_VX, LV_ABOV_GND, 10);
+  GribRecord* y = reader.getFirstGribRecord(GRB_WIND_VY, LV_ABOV_GND, 10);
+  ASSERT_NE(x, nullptr);
+  ASSERT_NE(y, nullptr);
+  x->loadData();
+  y->loadData();
+
+  const size_t kCount = 5000;
+  const size_t kChunk = 64;
+  ParticleMap serial(0), parallel(0);
+  SeedParticles(serial, *x, kCount);
+  SeedParticles(parallel, *x, kCount);
+  auto calibrate = [](double v) { return v * 3600 / 1852; };
+  auto color = [](double v, wxUint8& r, wxUint8& g, wxUint8& b) {
+    r = g = b = static_cast<wxUint8>(std::min(v * 10, 255.0));
+  };
+
+  auto pool = GribThreadPool::GetShared();
+  size_t moved = 0, expired = 0;
+  for (int step = 0; step < 200; step++) {
+    serial.Advance(0, kCount, x, y, false, calibrate, color);
+    pool->ParallelFor((kCount + kChunk - 1) / kChunk, [&](size_t chunk) {
+      parallel.Advance(chunk * kChunk, std::min(kCount, (chunk + 1) * kChunk),
+                       x, y, false, calibrate, color);
+    });
+    ASSERT_TRUE(SameBytes(parallel.m_State, serial.m_State)) << step;
+    moved += std::count(serial.m_State.begin(), serial.m_State.end(),
+                        ParticleMap::MOVED);
+    expired += std::count(serial.m_State.begin(), serial.m_State.end(),
+                          ParticleMap::EXPIRED);
+  }
+  EXPECT_GT(moved, 0u);
+  EXPECT_GT(expired, 0u);
+  EXPECT_TRUE(SameBytes(parallel.m_Duration, serial.m_Duration));
+  EXPECT_TRUE(SameBytes(parallel.m_HistoryPos, serial.m_HistoryPos));
+  EXPECT_TRUE(SameBytes(parallel.m_HistorySize, serial.m_HistorySize));
+  EXPECT_TRUE(SameBytes(parallel.m_Run, serial.m_Run));
+  EXPECT_TRUE(SameBytes(parallel.m_Pos, serial.m_Pos));
+  EXPECT_TRUE(SameBytes(parallel.m_Color, serial.m_Color));
+}
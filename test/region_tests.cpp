@@ -0,0 +1,294 @@
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "LLRegion.h"
+#include "poly_clip.h"
+
+/** Synthetic quilt: viewport and chart cell outlines covering it. */
+struct Quilt {
+  double lat;
+  double lon;
+  double height;
+  double width;
+  std::vector<std::vector<double>> cells;  ///< lat, lon pairs
+};
+
+static double Area(const LLRegion& region) {
+  double area = 0;
+  for (const auto& contour : region.contours) {
+    contour_pt last = contour.back();
+    for (const auto& pt : contour) {
+      area += last.x * pt.y - pt.x * last.y;
+      last = pt;
+    }
+  }
+  return area / 2;
+}
+
+/**
+ * Chart cell outline, a rectangle with n points on each side moved by up
+ * to jitter times the cell size across the side. Less so close to the
+ * corners, keeping the outline simple.
+ */
+static std::vector<double> MakeCell(std::mt19937& rng, double lat, double lon,
+                                    double h, double w, int n, double jitter) {
+  std::uniform_real_distribution<double> uniform(-jitter, jitter);
+  std::vector<double> points;
+  auto add = [&](double la, double lo) {
+    points.push_back(la);
+    points.push_back(lo);
+  };
+  auto jit = [&](int i) { return uniform(rng) * sin(M_PI * i / n); };
+  for (int i = 0; i < n; i++) add(lat + jit(i) * h, lon + w * i / n);
+  for (int i = 0; i < n; i++) add(lat + h * i / n, lon + w + jit(i) * w);
+  for (int i = 0; i < n; i++) add(lat + h + jit(i) * h, lon + w - w * i / n);
+  for (int i = 0; i < n; i++) add(lat + h - h * i / n, lon + jit(i) * w);
+  return points;
+}
+
+/**
+ * Viewports at random places with cells of different sizes and detail
+ * partly overlapping them, also some cells sharing edges exactly.
+ */
+static std::vector<Quilt> MakeQuilts(int count) {
+  std::mt19937 rng(4711);
+  auto uniform = [&](double a, double b) {
+    return std::uniform_real_distribution<double>(a, b)(rng);
+  };
+  std::vector<Quilt> quilts;
+  for (int q = 0; q < count; q++) {
+    Quilt quilt;
+    quilt.lat = uniform(-60, 60);
+    quilt.lon = uniform(-170, 170);
+    quilt.height = uniform(0.05, 1);
+    quilt.width = uniform(0.05, 1.5);
+    const int n_cells = 5 + q % 30;
+    for (int i = 0; i < n_cells; i++) {
+      const double h = uniform(0.02, 1.5) * quilt.height;
+      const double w = uniform(0.02, 1.5) * quilt.width;
+      quilt.cells.push_back(MakeCell(rng, quilt.lat + uniform(-h, quilt.height),
+                                     quilt.lon + uniform(-w, quilt.width), h,
+                                     w, 1 + (i * 7) % 60, q % 3 ? 0.05 : 0));
+    }
+    const double h = quilt.height / 2;
+    const double w = quilt.width / 2;
+    quilt.cells.push_back(MakeCell(rng, quilt.lat, quilt.lon, h, w, 1, 0));
+    quilt.cells.push_back(MakeCell(rng, quilt.lat, quilt.lon + w, h, w, 1, 0));
+    quilts.push_back(quilt);
+  }
+  return quilts;
+}
+
+/** Region operations done by Quilt::Compose() for each chart. */
+static void Compose(const Quilt& quilt, LLRegion& unused, LLRegion& covered) {
+  const LLRegion viewport(quilt.lat, quilt.lon, quilt.lat + quilt.height,
+                          quilt.lon + quilt.width);
+  unused = viewport;
+  covered.Clear();
+  for (const auto& cell : quilt.cells) {
+    LLRegion chart(cell.size() / 2, cell.data());
+    LLRegion region = viewport;
+    region.Intersect(chart);
+    if (region.Empty()) continue;
+    unused.Subtract(chart);
+    covered.Union(region);
+  }
+}
+
+/** Distance from lat, lon to the outline of cell, in degrees. */
+static double EdgeDistance(const std::vector<double>& cell, double lat,
+                           double lon) {
+  double distance = HUGE_VAL;
+  const size_t n = cell.size() / 2;
+  for (size_t i = 0, j = n - 1; i < n; j = i++) {
+    const double ay = cell[2 * j], ax = cell[2 * j + 1];
+    const double dy = cell[2 * i] - ay, dx = cell[2 * i + 1] - ax;
+    double t = ((lat - ay) * dy + (lon - ax) * dx) / (dx * dx + dy * dy);
+    t = std::max(0.0, std::min(1.0, t));
+    distance = std::min(distance, std::hypot(ay + t * dy - lat,
+                                             ax + t * dx - lon));
+  }
+  return distance;
+}
+
+/** Winding number of the outline of cell around lat, lon. */
+static int CellWinding(const std::vector<double>& cell, double lat,
+                       double lon) {
+  int winding = 0;
+  const size_t n = cell.size() / 2;
+  for (size_t i = 0, j = n - 1; i < n; j = i++) {
+    const double ay = cell[2 * j], ax = cell[2 * j + 1];
+    const double by = cell[2 * i], bx = cell[2 * i + 1];
+    const double side = (bx - ax) * (lat - ay) - (by - ay) * (lon - ax);
+    if (ay <= lat && by > lat && side > 0) winding++;
+    if (ay > lat && by <= lat && side < 0) winding--;
+  }
+  return winding;
+}
+
+/** Nonzero winding point in polygon test. */
+static bool CellContains(const std::vector<double>& cell, double lat,
+                         double lon) {
+  return CellWinding(cell, lat, lon) != 0;
+}
+
+TEST(LLRegion, BooleanOperations) {
+  // Results are rounded to a grid of about 1e-5 degrees
+  static const double kEps = 1e-4;
+  const LLRegion a(0, 0, 2, 2);
+  const LLRegion b(1, 1, 3, 3);
+
+  LLRegion region = a;
+  region.Intersect(b);
+  EXPECT_NEAR(Area(region), 1, kEps);
+  EXPECT_TRUE(region.Contains(1.5, 1.5));
+  EXPECT_FALSE(region.Contains(0.5, 0.5));
+
+  region = a;
+  region.Union(b);
+  EXPECT_NEAR(Area(region), 7, kEps);
+  EXPECT_EQ(region.contours.size(), 1);
+
+  region = a;
+  region.Subtract(b);
+  EXPECT_NEAR(Area(region), 3, kEps);
+  EXPECT_FALSE(region.Contains(1.5, 1.5));
+  EXPECT_TRUE(region.Contains(0.5, 1.5));
+
+  // Hole, and regions sharing an edge merged to one.
+  region = LLRegion(0, 0, 3, 3);
+  region.Subtract(LLRegion(1, 1, 2, 2));
+  EXPECT_NEAR(Area(region), 8, kEps);
+  EXPECT_EQ(region.contours.size(), 2);
+  region.Union(LLRegion(1, 1, 2, 2));
+  EXPECT_NEAR(Area(region), 9, kEps);
+  EXPECT_EQ(region.contours.size(), 1);
+
+  region = a;
+  region.Intersect(LLRegion(5, 5, 6, 6));
+  EXPECT_TRUE(region.Empty());
+}
+
+/**
+ * Self crossing outline with vertices a few grid steps apart. Snap rounding
+ * its crossings keeps creating new ones close to the snapped points, for
+ * more rounds than PolyClipper allows on the grid LLRegion starts with.
+ */
+TEST(LLRegion, UnsettledSnapRounding) {
+  static const double kMargin = 2e-5;
+  static const int kOffsets[] = {  // micro degrees from 45N 70W
+      910, 273, 587, 565, 624, 929, 49,  732, 442, 277, 200,
+      512, 148, 242, 213, 598, 739, 313, 219, 611, 671, 238,
+      352, 791, 149, 303, 769, 200, 484, 450, 14,  232};
+  std::vector<double> outline;
+  for (size_t i = 0; i < sizeof kOffsets / sizeof *kOffsets; i += 2) {
+    outline.push_back(45 + kOffsets[i] * 1e-6);
+    outline.push_back(-70 + kOffsets[i + 1] * 1e-6);
+  }
+  const size_t n = outline.size() / 2;
+  const LLRegion scribble(n, outline.data());
+  const LLRegion box(45, -70, 45.0005, -69.9995);
+
+  PolyClipper clipper(6e-6);  // LLRegion rounding
+  clipper.Add(scribble.contours);
+  clipper.Add(box.contours);
+  std::vector<poly_contour> unused;
+  ASSERT_FALSE(clipper.Execute(PolyFillRule::kAbsGeqTwo, unused));
+
+  LLRegion intersection = scribble;
+  intersection.Intersect(box);
+  LLRegion difference = scribble;
+  difference.Subtract(box);
+
+  // LLRegion makes the outline counter clockwise, the operations then
+  // apply the winding rules to the sum of both regions
+  const int sign = LLRegion::PointsCCW(n, outline.data()) ? 1 : -1;
+  const std::vector<double> box_outline = {45,       -70,      45, -69.9995,
+                                           45.0005,  -69.9995, 45.0005, -70};
+  int inside = 0;
+  for (int i = 0; i <= 100; i++) {
+    for (int j = 0; j <= 100; j++) {
+      const double lat = 45 + i * 1e-5;
+      const double lon = -70 + j * 1e-5;
+      if (EdgeDistance(outline, lat, lon) < kMargin ||
+          EdgeDistance(box_outline, lat, lon) < kMargin) {
+        continue;
+      }
+      const int winding = sign * CellWinding(outline, lat, lon);
+      const int in_box = CellContains(box_outline, lat, lon) ? 1 : 0;
+      EXPECT_EQ(intersection.Contains(lat, lon),
+                std::abs(winding + in_box) >= 2)
+          << lat << " " << lon;
+      EXPECT_EQ(difference.Contains(lat, lon), winding - in_box > 0)
+          << lat << " " << lon;
+      if (winding > 0 && in_box) inside++;
+    }
+  }
+  EXPECT_GT(inside, 0);
+}
+
+/** Compose results sampled against the input chart outlines. */
+TEST(LLRegion, QuiltMatchesCells) {
+  static const double kMargin = 1e-4;
+  std::mt19937 rng(17);
+  for (const auto& quilt : MakeQuilts(40)) {
+    LLRegion unused;
+    LLRegion covered;
+    Compose(quilt, unused, covered);
+    EXPECT_NEAR(Area(unused) + Area(covered), quilt.height * quilt.width,
+                1e-4);
+
+    std::uniform_real_distribution<double> u(-0.2, 1.2);
+    for (int i = 0; i < 1000; i++) {
+      const double lat = quilt.lat + u(rng) * quilt.height;
+      const double lon = quilt.lon + u(rng) * quilt.width;
+      const double dlat = std::min(lat - quilt.lat,
+                                   quilt.lat + quilt.height - lat);
+      const double dlon = std::min(lon - quilt.lon,
+                                   quilt.lon + quilt.width - lon);
+      if (std::abs(dlat) < kMargin || std::abs(dlon) < kMargin) continue;
+      const bool in_viewport = dlat > 0 && dlon > 0;
+      bool in_chart = false;
+      bool near_edge = false;
+      for (const auto& cell : quilt.cells) {
+        if (EdgeDistance(cell, lat, lon) < kMargin) near_edge = true;
+        if (CellContains(cell, lat, lon)) in_chart = true;
+      }
+      if (near_edge) continue;
+      ASSERT_EQ(covered.Contains(lat, lon), in_viewport && in_chart)
+          << lat << " " << lon;
+      ASSERT_EQ(unused.Contains(lat, lon), in_viewport && !in_chart)
+          << lat << " " << lon;
+    }
+  }
+}
+
+/**
+ * Milliseconds per Compose(), synthetic quilts. Timing only, run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(LLRegion, DISABLED_Benchmark) {
+  using clock = std::chrono::steady_clock;
+  static const int kRounds = 5;
+
+  const auto quilts = MakeQuilts(40);
+  size_t vertices = 0;
+  auto t0 = clock::now();
+  for (int round = 0; round < kRounds; round++) {
+    for (const auto& quilt : quilts) {
+      LLRegion unused;
+      LLRegion covered;
+      Compose(quilt, unused, covered);
+      for (const auto& contour : covered.contours) vertices += contour.size();
+    }
+  }
+  std::chrono::duration<double, std::milli> ms = clock::now() - t0;
+  EXPECT_GT(vertices, 0);
+  RecordProperty("ms_per_compose",
+                 std::to_string(ms.count() / (kRounds * quilts.size())));
+}
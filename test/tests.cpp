@@ -1,12 +1,20 @@
 #include "config.h"
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstdio>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <random>
 #include <thread>
+#include <unordered_map>
 
 #include <wx/app.h>
 #include <wx/event.h>
@@ -15,21 +23,30 @@
 #include <wx/jsonval.h>
 #include <wx/timer.h>
 
+#include <sqlite3.h>
+
 #include <gtest/gtest.h>
 
 #include "model/ais_decoder.h"
 #include "model/ais_defs.h"
 #include "model/ais_state_vars.h"
+#include "model/ais_vdx_worker.h"
 #include "model/cli_platform.h"
 #include "model/comm_ais.h"
 #include "model/comm_appmsg_bus.h"
 #include "model/comm_bridge.h"
+#include "model/comm_can_util.h"
+#include "model/comm_decoder.h"
 #include "model/comm_drv_file.h"
 #include "model/comm_drv_registry.h"
 #include "model/comm_navmsg_bus.h"
 #include "model/config_vars.h"
 #include "model/datetime.h"
+#include "model/georef.h"
+#include "model/harmonic_series.h"
 #include "model/ipc_api.h"
+#include "model/ll_grid_index.h"
+#include "model/ll_rtree.h"
 #include "model/logger.h"
 #include "model/multiplexer.h"
 #include "model/navutil_base.h"
@@ -40,8 +57,13 @@
 #include "model/select.h"
 #include "model/semantic_vers.h"
 #include "model/std_instance_chk.h"
+#include "model/thread_pool.h"
+#include "model/track.h"
+#include "model/track_point_writer.h"
 #include "model/wait_continue.h"
 #include "model/wx_instance_chk.h"
+#include "field_tokenizer.hpp"
+#include "observable_batch.h"
 #include "observable_confvar.h"
 #include "ocpn_plugin.h"
 
@@ -735,6 +757,12 @@ class AisVdmApp : public BasicTest {
     msgbus.Notify(m);
     ProcessPendingEvents();
 
+    // Sentence is decoded by a worker thread, batch posted when done.
+    auto& targets = g_pAIS->GetTargetList();
+    for (int i = 0; i < 100 && targets.find(MMSI) == targets.end(); i++) {
+      std::this_thread::sleep_for(10ms);
+      ProcessPendingEvents();
+    }
     auto found = g_pAIS->GetTargetList().find(MMSI);
     EXPECT_NE(found, g_pAIS->GetTargetList().end());
     if (found != g_pAIS->GetTargetList().end()) {
@@ -779,6 +807,47 @@ class ObsTorture : public wxAppConsole {
   }
 };
 
+class ObsBatch : public wxAppConsole {
+public:
+  ObsBatch(BatchPolicy policy) {
+    Observable o1("batch1");
+    Observable o2("batch2");
+    int batches = 0;
+    std::vector<std::string> values;
+    ObsBatchListener listener(
+        o1,
+        [&](std::vector<ObservedItem>& batch) {
+          batches++;
+          for (auto& item : batch) {
+            auto s = std::static_pointer_cast<const std::string>(item.ptr);
+            values.push_back(item.key + ":" + *s);
+          }
+        },
+        policy, 8);
+    listener.Listen(o2);
+
+    for (int i = 0; i < 10; i++) {
+      o1.Notify(std::make_shared<const std::string>(std::to_string(i)));
+    }
+    o2.Notify(std::make_shared<const std::string>("last"));
+    ProcessPendingEvents();
+    EXPECT_EQ(batches, 1);
+    auto stats = listener.GetStats();
+    EXPECT_EQ(stats.received, 11);
+    EXPECT_EQ(stats.batches, 1);
+    if (policy == BatchPolicy::kLatestOnly) {
+      EXPECT_EQ(values, std::vector<std::string>({"batch1:9", "batch2:last"}));
+      EXPECT_EQ(stats.merged, 9);
+      EXPECT_EQ(stats.dropped, 0);
+    } else {
+      EXPECT_EQ(values.size(), 8);
+      EXPECT_EQ(values.front(), "batch1:0");
+      EXPECT_EQ(stats.merged, 0);
+      EXPECT_EQ(stats.dropped, 3);
+    }
+  }
+};
+
 #ifdef HAVE_UNISTD_H
 class WxInstanceChk : public BasicTest {
 public:
@@ -923,6 +992,40 @@ TEST(Observable, torture) {
   EXPECT_EQ(int_result0, 10);
 }
 
+TEST(Observable, BatchAll) { ObsBatch ob(BatchPolicy::kAll); }
+
+TEST(Observable, BatchLatestOnly) { ObsBatch ob(BatchPolicy::kLatestOnly); }
+
+TEST(Observable, InternedKey) {
+  auto& registry = KeyRegistry::GetInstance();
+  ObsKeyId id = registry.Intern("interned-key");
+  EXPECT_NE(id, KeyRegistry::kNoKey);
+  EXPECT_EQ(registry.Intern(std::string("interned-") + "key"), id);
+  EXPECT_EQ(registry.GetKey(id), "interned-key");
+  EXPECT_NE(registry.Intern("interned-key2"), id);
+
+  auto msg = std::make_shared<const Nmea0183Msg>("GPGGA", "$GPGGA",
+                                                 std::make_shared<NavAddr>());
+  EXPECT_EQ(msg->GetKeyId(), KeyRegistry::kNoKey);
+}
+
+TEST(Observable, NavMsgKeyCache) {
+  auto& registry = KeyRegistry::GetInstance();
+  NavMsgKeyCache cache;
+  ObsKeyId gga_id = cache.N0183("GPGGA");
+  EXPECT_EQ(gga_id, registry.Intern(Nmea0183Msg::MessageKey("GGA")));
+  EXPECT_EQ(cache.N0183("GPGGA"), gga_id);
+  EXPECT_EQ(cache.N0183("GNGGA"), gga_id);
+  EXPECT_EQ(cache.N0183All(), registry.Intern(Nmea0183Msg::MessageKey("ALL")));
+  EXPECT_EQ(cache.N2000(129029), registry.Intern(Nmea2000Msg(129029).key()));
+
+  auto msg = std::make_shared<const Nmea0183Msg>(gga_id, "GPGGA", "$GPGGA",
+                                                 std::make_shared<NavAddr>());
+  EXPECT_EQ(msg->GetKeyId(), gga_id);
+  Nmea0183Msg msg_all(cache.N0183All(), *msg, "ALL");
+  EXPECT_EQ(registry.GetKey(msg_all.GetKeyId()), msg_all.key());
+}
+
 TEST(Drivers, Registry) {
   wxLog::SetActiveTarget(&defaultLog);
   DriverPtr driver1 = std::make_unique<SillyDriver>();
@@ -1034,6 +1137,594 @@ TEST(AIS, AISVDO) { AisVdoApp app; }
 
 TEST(AIS, AISVDM) { AisVdmApp app; }
 
+/** Interleaved multipart messages on two channels and a bad checksum. */
+TEST(AIS, VdxWorker) {
+  std::atomic<int> ready_count(0);
+  AisVdxWorker worker([&] { ready_count++; });
+  worker.Push(
+      "!AIVDM,2,1,1,A,55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQE"
+      "p6ClRp8,0*1C");
+  worker.Push(
+      "!AIVDM,2,1,3,B,55P5TL01VIaAL@7WKO@mBplU@<PDhh000000001S;AJ::4A80?4i@E"
+      "53,0*3E");
+  worker.Push("!AIVDM,2,2,1,A,88888888880,2*25");
+  worker.Push("!AIVDM,1,1,,A,1535SB002qOg@MVLTi@b;H8V08;?,0*48");
+  worker.Push("!AIVDM,2,2,3,B,1@0000000000000,2*55");
+  worker.Push("!AIVDM,1,1,,A,1535SB002qOg@MVLTi@b;H8V08;?,0*47");
+
+  std::vector<AisVdxMessage> messages;
+  for (int i = 0; i < 100 && messages.size() < 3; i++) {
+    std::this_thread::sleep_for(10ms);
+    worker.Drain(messages);
+  }
+  ASSERT_EQ(messages.size(), 3);
+  EXPECT_EQ(messages[0].mmsi, 351759000);
+  EXPECT_EQ(messages[0].message_id, 5);
+  EXPECT_EQ(messages[1].mmsi, 369190000);
+  EXPECT_EQ(messages[1].message_id, 5);
+  EXPECT_EQ(messages[1].sentence, "!AIVDM,2,2,3,B,1@0000000000000,2*55");
+  EXPECT_EQ(messages[2].mmsi, 338781000);
+  EXPECT_EQ(messages[2].message_id, 1);
+  EXPECT_GE(ready_count, 1);
+
+  AisVdxStats stats = worker.GetStats();
+  EXPECT_EQ(stats.sentences, 6);
+  EXPECT_EQ(stats.messages, 3);
+  EXPECT_EQ(stats.bad, 1);
+  EXPECT_EQ(stats.dropped, 0);
+}
+
+/** Synthetic shore station feed, targets spread around Dover Strait. */
+struct SyntheticTarget {
+  int mmsi;
+  double lat;
+  double lon;
+  double dlat;
+  double dlon;
+};
+
+static std::vector<SyntheticTarget> MakeSyntheticTargets(int count) {
+  std::vector<SyntheticTarget> targets;
+  unsigned seed = 4711;
+  auto rnd = [&seed]() {
+    seed = seed * 1103515245 + 12345;
+    return static_cast<double>((seed >> 8) & 0xffff) / 0xffff;
+  };
+  for (int i = 0; i < count; i++) {
+    targets.push_back({200000000 + i, 50.0 + 2 * rnd(), 0.5 + 2 * rnd(),
+                       (rnd() - 0.5) * 0.002, (rnd() - 0.5) * 0.003});
+  }
+  return targets;
+}
+
+TEST(AIS, GridIndexQuery) {
+  auto targets = MakeSyntheticTargets(3000);
+  LLGridIndex<int> grid;
+  for (const auto& t : targets) grid.Update(t.mmsi, t.lat, t.lon);
+  for (auto& t : targets) {
+    t.lat += t.dlat * 50;
+    t.lon += t.dlon * 50;
+    grid.Update(t.mmsi, t.lat, t.lon);
+  }
+  EXPECT_EQ(grid.size(), targets.size());
+
+  std::vector<int> found;
+  grid.QueryBox(50.8, 51.2, 1.2, 1.6, found);
+  std::sort(found.begin(), found.end());
+  std::vector<int> expected;
+  for (const auto& t : targets) {
+    if (t.lat >= 50.8 && t.lat <= 51.2 && t.lon >= 1.2 && t.lon <= 1.6)
+      expected.push_back(t.mmsi);
+  }
+  EXPECT_EQ(found, expected);
+
+  grid.Remove(expected[0]);
+  found.clear();
+  grid.QueryBox(50.8, 51.2, 1.2, 1.6, found);
+  EXPECT_EQ(found.size(), expected.size() - 1);
+
+  // Antimeridian wrap
+  LLGridIndex<int> pacific;
+  pacific.Update(1, -17.0, 179.9);
+  pacific.Update(2, -17.0, -179.9);
+  pacific.Update(3, -17.0, 170.0);
+  found.clear();
+  pacific.Query(-17.0, 180.0, 12.0, found);
+  std::sort(found.begin(), found.end());
+  EXPECT_EQ(found, std::vector<int>({1, 2}));
+}
+
+/**
+ * Replay a synthetic shore feed of count targets through AisDecoder while
+ * own ship moves for ticks updates. Compare UpdateAllCPA() updating all
+ * targets each tick with the grid path updating targets within a 12 NM
+ * alarm radius plus a round-robin slice of the rest, and check that
+ * targets are current when a target list is shown. If benchmark, record
+ * the time of both.
+ */
+class AisCpaApp : public BasicTest {
+public:
+  AisCpaApp(int count, int ticks, bool benchmark) : BasicTest() {
+    using clock = std::chrono::steady_clock;
+    const double radius = 12.0;
+
+    bool list_shown = false;
+    AisDecoderCallbacks callbacks;
+    callbacks.target_list_shown = [&list_shown]() { return list_shown; };
+    AisDecoder full_decoder(callbacks);
+    AisDecoder grid_decoder(callbacks);
+    auto targets = MakeSyntheticTargets(count);
+    for (auto decoder : {&full_decoder, &grid_decoder}) {
+      for (const auto& t : targets) {
+        auto td = std::make_shared<AisTargetData>(AisTargetCallbacks());
+        td->MMSI = t.mmsi;
+        td->Lat = t.lat;
+        td->Lon = t.lon;
+        td->SOG = std::abs(t.dlat + t.dlon) * 5000;
+        td->COG = t.mmsi % 360;
+        td->b_positionOnceValid = true;
+        decoder->GetTargetList()[t.mmsi] = td;
+      }
+    }
+
+    const bool saved_flags[] = {bGPSValid, g_bCPAMax, g_bTCPA_Max};
+    const double saved_values[] = {gLat, gLon, gSog, gCog, g_CPAMax_NM};
+    bGPSValid = true;
+    gSog = 12.0;
+    gCog = 45.0;
+    g_bTCPA_Max = false;
+    g_CPAMax_NM = radius;
+    auto replay = [&](AisDecoder& decoder, bool range_limit) {
+      gLat = 51.0;
+      gLon = 1.4;
+      g_bCPAMax = false;
+      decoder.UpdateAllCPA();  // As if all targets just reported
+      g_bCPAMax = range_limit;
+      auto t0 = clock::now();
+      for (int tick = 0; tick < ticks; tick++) {
+        gLat += 0.003;
+        gLon += 0.004;
+        decoder.UpdateAllCPA();
+      }
+      return std::chrono::duration<double, std::milli>(clock::now() - t0);
+    };
+    auto full_ms = replay(full_decoder, false);
+    auto grid_ms = replay(grid_decoder, true);
+
+    // Targets which may alarm are current in both
+    size_t near = 0;
+    for (const auto& it : full_decoder.GetTargetList()) {
+      const auto& full = *it.second;
+      if (full.Range_NM >= radius) continue;
+      near++;
+      const auto& grid = *grid_decoder.GetTargetList()[it.first];
+      EXPECT_EQ(full.Range_NM, grid.Range_NM);
+      EXPECT_EQ(full.CPA, grid.CPA);
+      EXPECT_EQ(full.TCPA, grid.TCPA);
+    }
+    EXPECT_GT(near, 0);
+
+    // With a target list shown all targets are updated
+    list_shown = true;
+    grid_decoder.UpdateAllCPA();
+    for (const auto& it : full_decoder.GetTargetList()) {
+      const auto& grid = *grid_decoder.GetTargetList()[it.first];
+      EXPECT_EQ(it.second->Range_NM, grid.Range_NM);
+      EXPECT_EQ(it.second->CPA, grid.CPA);
+    }
+    bGPSValid = saved_flags[0];
+    g_bCPAMax = saved_flags[1];
+    g_bTCPA_Max = saved_flags[2];
+    gLat = saved_values[0];
+    gLon = saved_values[1];
+    gSog = saved_values[2];
+    gCog = saved_values[3];
+    g_CPAMax_NM = saved_values[4];
+
+    if (!benchmark) return;
+    ::testing::Test::RecordProperty("full_scan_ms",
+                                    std::to_string(full_ms.count()));
+    ::testing::Test::RecordProperty("grid_ms", std::to_string(grid_ms.count()));
+  }
+};
+
+TEST(AIS, CpaGridMatchesFullScan) { AisCpaApp app(1000, 5, false); }
+
+/** Run with --gtest_also_run_disabled_tests. */
+TEST(AIS, DISABLED_CpaBenchmark) { AisCpaApp app(5000, 30, true); }
+
+/** Synthetic chart database: nested cells from overview to harbour scale. */
+static std::vector<LLRTree<int>::Item> MakeSyntheticCharts(int count) {
+  std::srand(4711);
+  auto rnd = []() { return static_cast<double>(std::rand()) / RAND_MAX; };
+  static const int kScales[] = {3000000, 350000, 90000, 22000, 8000};
+  static const float kSizes[] = {20.0, 4.0, 1.0, 0.25, 0.06};
+  std::vector<LLRTree<int>::Item> charts;
+  for (int i = 0; i < count; i++) {
+    const int band = i < 20 ? 0 : 1 + i % 4;
+    const float lat = -60 + 120 * rnd();
+    const float lon = -180 + 360 * rnd();
+    const float size = kSizes[band] * (0.5 + rnd());
+    charts.push_back({i, lat, lat + size, lon, lon + size, kScales[band]});
+  }
+  // Pacific cells in 0..360 convention, one crossing the antimeridian
+  charts.push_back({count, -20.0, -15.0, 178.0, 182.0, 350000});
+  charts.push_back({count + 1, -18.0, -17.0, 185.0, 186.0, 22000});
+  return charts;
+}
+
+static std::vector<int> ScanCharts(const std::vector<LLRTree<int>::Item>& all,
+                                   double lat_min, double lat_max,
+                                   double lon_min, double lon_max,
+                                   int scale_min, int scale_max) {
+  std::vector<int> found;
+  for (const auto& c : all) {
+    if (c.lat_max < lat_min || c.lat_min > lat_max) continue;
+    if (c.scale < scale_min || c.scale > scale_max) continue;
+    for (double shift : {0.0, 360.0, -360.0}) {
+      if (c.lon_max >= lon_min + shift && c.lon_min <= lon_max + shift) {
+        found.push_back(c.id);
+        break;
+      }
+    }
+  }
+  return found;
+}
+
+TEST(LLRTree, MatchesScan) {
+  auto charts = MakeSyntheticCharts(15000);
+  LLRTree<int> tree;
+  tree.Build(charts);
+  EXPECT_EQ(tree.size(), charts.size());
+
+  std::srand(17);
+  auto rnd = []() { return static_cast<double>(std::rand()) / RAND_MAX; };
+  std::vector<int> found;
+  auto check_queries = [&](int count) {
+    for (int i = 0; i < count; i++) {
+      const double lat = -60 + 120 * rnd();
+      const double lon = -180 + 360 * rnd();
+      const double size = i % 2 ? 0.0 : 2 * rnd();
+      const int scale_max = i % 3 ? INT_MAX : 100000;
+      found.clear();
+      tree.Query(lat, lat + size, lon, lon + size, found, 0, scale_max);
+      std::sort(found.begin(), found.end());
+      ASSERT_EQ(found, ScanCharts(charts, lat, lat + size, lon, lon + size, 0,
+                                  scale_max));
+    }
+  };
+  check_queries(2000);
+
+  found.clear();
+  tree.QueryPoint(-17.5, -174.5, found);
+  std::sort(found.begin(), found.end());
+  EXPECT_EQ(found, ScanCharts(charts, -17.5, -17.5, -174.5, -174.5, 0,
+                              INT_MAX));
+  EXPECT_EQ(found.back(), 15001);
+
+  // Incremental updates, removing shifts the following ids like the
+  // chart database does.
+  for (int i = 0; i < 500; i++) {
+    const float lat = -60 + 120 * rnd();
+    const float lon = -180 + 360 * rnd();
+    LLRTree<int>::Item c{static_cast<int>(charts.size()), lat, lat + 0.1f,
+                         lon, lon + 0.1f, 12000};
+    charts.push_back(c);
+    tree.Insert(c);
+  }
+  for (int i = 0; i < 300; i++) {
+    const int removed = std::rand() % charts.size();
+    ASSERT_TRUE(tree.Remove(removed));
+    charts.erase(charts.begin() + removed);
+    auto shift = [removed](int id) { return id > removed ? id - 1 : id; };
+    tree.RenumberIds(shift);
+    for (auto& c : charts) c.id = shift(c.id);
+  }
+  EXPECT_EQ(tree.size(), charts.size());
+  EXPECT_FALSE(tree.Remove(static_cast<int>(charts.size())));
+  check_queries(2000);
+}
+
+/**
+ * Stack builds: point lookups compared to a full scan. Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(LLRTree, DISABLED_Benchmark) {
+  using clock = std::chrono::steady_clock;
+  auto charts = MakeSyntheticCharts(15000);
+  LLRTree<int> tree;
+  tree.Build(charts);
+  std::vector<int> found;
+
+  static const int kLookups = 2000;
+  size_t scan_hits = 0;
+  auto t0 = clock::now();
+  for (int i = 0; i < kLookups; i++) {
+    const double lat = -60 + 120 * (i % 97) / 97.0;
+    const double lon = -180 + 360 * (i % 89) / 89.0;
+    scan_hits += ScanCharts(charts, lat, lat, lon, lon, 0, INT_MAX).size();
+  }
+  std::chrono::duration<double, std::milli> scan_ms = clock::now() - t0;
+  size_t tree_hits = 0;
+  t0 = clock::now();
+  for (int i = 0; i < kLookups; i++) {
+    const double lat = -60 + 120 * (i % 97) / 97.0;
+    const double lon = -180 + 360 * (i % 89) / 89.0;
+    found.clear();
+    tree.QueryPoint(lat, lon, found);
+    tree_hits += found.size();
+  }
+  std::chrono::duration<double, std::milli> tree_ms = clock::now() - t0;
+  EXPECT_EQ(scan_hits, tree_hits);
+  RecordProperty("full_scan_ms", std::to_string(scan_ms.count()));
+  RecordProperty("rtree_ms", std::to_string(tree_ms.count()));
+}
+
+/**
+ * s57chart view culling close to the antimeridian: the view box extends
+ * past +/-180, object boxes are in either convention.
+ */
+TEST(LLRTree, ViewAcrossAntimeridian) {
+  std::vector<LLRTree<int>::Item> objects = {
+      {0, 10, 11, -175, -174, 0}, {1, 10, 11, 175, 176, 0},
+      {2, 10, 11, 185, 186, 0},   {3, 10, 11, 178, 182, 0},
+      {4, 10, 11, 0, 1, 0},       {5, -1e9, 1e9, -1e9, 1e9, 0},
+      {6, 10, 11, -185, -184, 0}, {7, 20, 21, -175, -174, 0}};
+  LLRTree<int> tree;
+  tree.Build(objects);
+  const std::vector<int> pacific = {0, 1, 2, 3, 5, 6};
+  std::vector<int> found;
+  tree.QueryView(9, 12, 170, 190, found);
+  EXPECT_EQ(found, pacific);
+  tree.QueryView(9, 12, -190, -170, found);
+  EXPECT_EQ(found, pacific);
+  tree.QueryView(9, 12, 179.5, 180.5, found);
+  EXPECT_EQ(found, std::vector<int>({3, 5}));
+  tree.QueryView(9, 12, -10, 10, found);
+  EXPECT_EQ(found, std::vector<int>({4, 5}));
+}
+
+/**
+ * Items of type hit at lat, lon walking the whole select list, as
+ * Select::FindSelectionList() does when zoomed far out. Segments use the
+ * select radius of the last Find*() call.
+ */
+static std::vector<SelectItem*> WalkSelectList(Select& select, float radius,
+                                               float lat, float lon,
+                                               int type) {
+  std::vector<SelectItem*> hits;
+  auto node = select.GetSelectList()->GetFirst();
+  for (; node; node = node->GetNext()) {
+    SelectItem* item = node->GetData();
+    if (item->m_seltype != type) continue;
+    bool hit;
+    if (type == SELTYPE_ROUTESEGMENT || type == SELTYPE_TRACKSEGMENT) {
+      hit = select.IsSegmentSelected(item->m_slat, item->m_slat2,
+                                     item->m_slon, item->m_slon2, lat, lon);
+    } else {
+      hit = fabs(lat - item->m_slat) < radius &&
+            fabs(lon - item->m_slon) < radius;
+    }
+    if (hit) hits.push_back(item);
+  }
+  return hits;
+}
+
+/**
+ * Grid lookups of Select compared to walking the select list, including
+ * the list order, after adding, moving and deleting items. Items are
+ * placed close to the IDL, the prime meridian and in open sea, some
+ * segments are longer than the grid handles.
+ */
+TEST(Select, GridMatchesListWalk) {
+  if (!g_BasePlatform) g_BasePlatform = new BasePlatform();
+  if (!pWayPointMan) {
+    pWayPointMan = new WayPointman([](wxString) { return *wxBLACK; });
+  }
+  Select select;
+  Route route;
+  Route layer_route;
+  layer_route.m_bIsInLayer = true;
+  Track track;
+  std::vector<std::unique_ptr<RoutePoint>> route_points;
+  std::vector<std::unique_ptr<TrackPoint>> track_points;
+  static int targets[40];
+  static int stations[20];
+
+  // Routes and tracks zigzag east from lon0, each fourth leg is long
+  static const double kOrigins[][2] = {{10, 179.7}, {-5, -0.3}, {42, 7}};
+  for (const auto& origin : kOrigins) {
+    const double lat0 = origin[0], lon0 = origin[1];
+    auto position = [&](int i) {
+      const double leg = i % 4 == 3 ? 0.25 : 0.04;
+      return std::make_pair(lat0 + (i % 2) * leg, lon0 + 0.03 * i);
+    };
+    for (int i = 0; i < 20; i++) {
+      auto a = position(i), b = position(i + 1);
+      // Route points wrap at the IDL, track points may be past 180
+      double lon_a = a.second > 180 ? a.second - 360 : a.second;
+      double lon_b = b.second > 180 ? b.second - 360 : b.second;
+      route_points.emplace_back(
+          new RoutePoint(a.first, lon_a, "", "", "guid", false));
+      RoutePoint* rp = route_points.back().get();
+      route_points.emplace_back(
+          new RoutePoint(b.first, lon_b, "", "", "guid", false));
+      select.AddSelectableRouteSegment(a.first, lon_a, b.first, lon_b, rp,
+                                       route_points.back().get(),
+                                       i % 3 ? &route : &layer_route);
+      track_points.emplace_back(new TrackPoint(a.first - 0.02, a.second));
+      TrackPoint* tp = track_points.back().get();
+      track_points.emplace_back(new TrackPoint(b.first - 0.02, b.second));
+      select.AddSelectableTrackSegment(a.first - 0.02, a.second,
+                                       b.first - 0.02, b.second, tp,
+                                       track_points.back().get(), &track);
+    }
+  }
+  for (int i = 0; i < 40; i++) {
+    const auto& origin = kOrigins[i % 3];
+    select.AddSelectablePoint(origin[0] + 0.011 * i, origin[1] + 0.017 * i,
+                              &targets[i], SELTYPE_AISTARGET);
+  }
+  for (int i = 0; i < 20; i++) {
+    const auto& origin = kOrigins[i % 3];
+    select.AddSelectablePoint(origin[0] + 0.023 * i, origin[1] + 0.013 * i,
+                              &stations[i],
+                              i % 2 ? SELTYPE_TIDEPOINT : SELTYPE_CURRENTPOINT);
+  }
+
+  // Move targets, some across the IDL, and route points, then delete some
+  for (int i = 0; i < 40; i += 3) {
+    const auto& origin = kOrigins[i % 3];
+    select.ModifySelectablePoint(origin[0] + 0.2, -origin[1] - 0.003 * i,
+                                 &targets[i], SELTYPE_AISTARGET);
+  }
+  for (size_t i = 0; i < route_points.size(); i += 7) {
+    RoutePoint* rp = route_points[i].get();
+    rp->m_lat += 0.03;
+    rp->m_lon += 0.15;
+    if (rp->m_lon > 180) rp->m_lon -= 360;
+    select.UpdateSelectableRouteSegments(rp);
+  }
+  for (int i = 1; i < 40; i += 5) {
+    select.DeleteSelectablePoint(&targets[i], SELTYPE_AISTARGET);
+  }
+  for (size_t i = 0; i < track_points.size(); i += 9) {
+    select.DeletePointSelectableTrackSegments(track_points[i].get());
+  }
+
+  static const int kTypes[] = {SELTYPE_ROUTESEGMENT, SELTYPE_TRACKSEGMENT,
+                               SELTYPE_AISTARGET, SELTYPE_TIDEPOINT,
+                               SELTYPE_CURRENTPOINT};
+  static const int kPixels = 8;
+  select.SetSelectPixelRadius(kPixels);
+  size_t hits = 0;
+  for (double radius_deg : {0.02, 0.3}) {
+    SelectCtx ctx(true, kPixels / (radius_deg * 1852 * 60), 1.0);
+    const float radius = kPixels / (ctx.scale * 1852 * 60);
+    for (const auto& origin : kOrigins) {
+      for (int i = -20; i < 60; i++) {
+        for (int j = -20; j < 80; j++) {
+          const float lat = origin[0] + 0.01 * i;
+          float lon = origin[1] + 0.01 * j;
+          if (lon > 180) lon -= 360;
+          for (int type : kTypes) {
+            SelectableItemList list =
+                select.FindSelectionList(ctx, lat, lon, type);
+            SelectItem* first = select.FindSelection(ctx, lat, lon, type);
+            auto expected = WalkSelectList(select, radius, lat, lon, type);
+            std::vector<SelectItem*> found;
+            for (auto node = list.GetFirst(); node; node = node->GetNext())
+              found.push_back(node->GetData());
+            ASSERT_EQ(found, expected) << lat << " " << lon << " " << type;
+            ASSERT_EQ(first, expected.empty() ? nullptr : expected.front());
+            hits += found.size();
+          }
+        }
+      }
+    }
+  }
+  EXPECT_GT(hits, 1000u);
+}
+
+TEST(ThreadPool, Lanes) {
+  ThreadPool pool(1);
+  std::mutex mutex;
+  std::condition_variable cond_var;
+  bool blocked = true;
+  std::vector<int> order;
+  auto record = [&](int i) {
+    std::lock_guard<std::mutex> lock(mutex);
+    order.push_back(i);
+  };
+
+  // Keep the only worker busy while queueing in all lanes.
+  auto blocker = pool.Submit([&] {
+    std::unique_lock<std::mutex> lock(mutex);
+    cond_var.wait(lock, [&] { return !blocked; });
+  });
+  while (pool.GetQueuedCount() > 0) std::this_thread::sleep_for(1ms);
+  auto j1 = pool.Submit([&] { record(1); }, ThreadPool::Lane::kBackground);
+  auto j2 = pool.Submit([&] { record(2); }, ThreadPool::Lane::kPrefetch);
+  auto j3 = pool.Submit([&] { record(3); }, ThreadPool::Lane::kVisible);
+  auto j4 = pool.Submit([&] { record(4); }, ThreadPool::Lane::kVisible);
+  auto cancelled = pool.Submit([&] { record(5); });
+  EXPECT_TRUE(cancelled->Cancel());
+  EXPECT_FALSE(blocker->Cancel());
+  EXPECT_TRUE(blocker->IsCancelled());
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    blocked = false;
+  }
+  cond_var.notify_all();
+
+  for (int i = 0; i < 1000 && !j1->IsDone(); i++) {
+    std::this_thread::sleep_for(1ms);
+  }
+  ASSERT_TRUE(j1->IsDone());
+  EXPECT_TRUE(blocker->IsDone());
+  EXPECT_TRUE(cancelled->IsDone());
+  EXPECT_EQ(order, std::vector<int>({3, 4, 2, 1}));
+}
+
+TEST(ThreadPool, NestedSubmit) {
+  ThreadPool pool(4);
+  std::atomic<int> count(0);
+  std::function<void(int)> fork = [&](int depth) {
+    count++;
+    if (depth == 0) return;
+    pool.Submit([&, depth] { fork(depth - 1); });
+    pool.Submit([&, depth] { fork(depth - 1); });
+  };
+  pool.Submit([&] { fork(10); });
+  for (int i = 0; i < 5000 && count < 2047; i++) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_EQ(count, 2047);
+}
+
+TEST(HarmonicSeries, MatchesDirectSum) {
+  // Some M2, S2, K1, O1 like constituents, speeds in radians per second
+  const double amplitude[] = {1.2, 0.4, 0.35, 0.25, 0.02};
+  const double speed[] = {1.405189e-4, 1.454441e-4, 7.292117e-5, 6.759774e-5,
+                          1.99e-7};
+  const double phase[] = {0.3, -2.0, 1.1, 4.0, 0.7};
+  HarmonicSeries series;
+  for (int a = 0; a < 5; a++) series.Add(amplitude[a], speed[a], phase[a]);
+
+  const double step = 900;  // 15 minutes
+  const size_t count = 1000;
+  for (int deriv = 0; deriv <= 2; deriv++) {
+    std::vector<double> values(count);
+    series.Evaluate(step, count, values.data(), deriv);
+    for (size_t k = 0; k < count; k++) {
+      double expected = 0;
+      for (int a = 0; a < 5; a++) {
+        expected += amplitude[a] * pow(speed[a], deriv) *
+                    cos(phase[a] + M_PI / 2 * deriv + speed[a] * step * k);
+      }
+      const double scale = 2.24 * pow(1.5e-4, deriv);
+      ASSERT_NEAR(values[k], expected, 1e-12 * scale) << deriv << " " << k;
+    }
+  }
+}
+
+TEST(ThreadPool, ParallelFor) {
+  ThreadPool pool(4);
+  std::vector<std::atomic<int>> hits(1000);
+  pool.ParallelFor(hits.size(), [&](size_t i) { hits[i]++; });
+  for (auto& hit : hits) EXPECT_EQ(hit, 1);
+
+  // Nested in all workers at once, callers must not wait for queued
+  // helpers which no free worker can run.
+  std::atomic<int> sum(0);
+  pool.ParallelFor(8, [&](size_t) {
+    pool.ParallelFor(100, [&](size_t i) { sum += i; });
+  });
+  EXPECT_EQ(sum, 8 * 4950);
+  pool.ParallelFor(0, [&](size_t) { sum = 0; });
+  EXPECT_EQ(sum, 8 * 4950);
+}
+
 TEST(Navmsg, ActiveMessages) { NavMsgApp app; }
 
 #if API_VERSION_MINOR > 18
@@ -1108,3 +1799,441 @@ TEST(SemanticVersion, Basic) {
   v2 = SemanticVersion::parse("1.2.3").to_string();
   EXPECT_TRUE(v1 == v2);
 }
+
+/** Fresh database with the navobj tracks and trk_points tables. */
+static std::string MakeTrackDb(const char* name) {
+  auto path = (fs::path(CMAKE_BINARY_DIR) / name).string();
+  for (auto suffix : {"", "-wal", "-shm"}) fs::remove(path + suffix);
+  sqlite3* db;
+  sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
+                  nullptr);
+  sqlite3_exec(db, R"(
+      PRAGMA journal_mode = WAL;
+      PRAGMA synchronous = NORMAL;
+      CREATE TABLE tracks (guid TEXT PRIMARY KEY NOT NULL);
+      CREATE TABLE trk_points (
+          track_guid TEXT NOT NULL,
+          latitude REAL NOT NULL,
+          longitude REAL NOT NULL,
+          timestamp TEXT NOT NULL,
+          point_order INTEGER,
+          FOREIGN KEY (track_guid) REFERENCES tracks(guid) ON DELETE CASCADE
+      );
+      INSERT INTO tracks (guid) VALUES ('trk');
+    )",
+               nullptr, nullptr, nullptr);
+  sqlite3_close_v2(db);
+  return path;
+}
+
+/** Return count of points and whether point_order matches rowid order. */
+static std::pair<int, bool> ReadTrackDb(const std::string& path) {
+  sqlite3* db;
+  sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY, nullptr);
+  sqlite3_stmt* stmt;
+  sqlite3_prepare_v2(db, "SELECT point_order FROM trk_points ORDER BY rowid",
+                     -1, &stmt, nullptr);
+  int count = 0;
+  bool ordered = true;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    ordered &= sqlite3_column_int(stmt, 0) == count;
+    count++;
+  }
+  sqlite3_finalize(stmt);
+  sqlite3_close_v2(db);
+  return {count, ordered};
+}
+
+TEST(TrackPointWriter, Batches) {
+  auto path = MakeTrackDb("track_point_writer.db");
+  {
+    TrackPointWriter writer(path, std::chrono::milliseconds(20), 100);
+    ASSERT_TRUE(writer.IsOk());
+    for (int i = 0; i < 1234; i++) {
+      writer.Add({"trk", 59.0 + i * 1e-4, 18.0, "2025-06-01T12:00:00Z", i});
+    }
+    writer.Flush();
+    EXPECT_EQ(writer.GetWrittenCount(), 1234u);
+    EXPECT_TRUE(writer.TakeErrors().empty());
+
+    // A bad point is reported, the rest of its batch is written.
+    writer.Add({"no such track", 0, 0, "", 0});
+    writer.Add({"trk", 60.0, 18.0, "2025-06-01T13:00:00Z", 1234});
+    writer.Flush();
+    EXPECT_EQ(writer.GetWrittenCount(), 1235u);
+    EXPECT_EQ(writer.TakeErrors().size(), 1u);
+
+    // Not flushed, written by the destructor.
+    writer.Add({"trk", 60.1, 18.0, "2025-06-01T13:01:00Z", 1235});
+  }
+  auto result = ReadTrackDb(path);
+  EXPECT_EQ(result.first, 1236);
+  EXPECT_TRUE(result.second);
+}
+
+/**
+ * Points per second writing a recorded track through the writer. Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(TrackPointWriter, DISABLED_Benchmark) {
+  using clock = std::chrono::steady_clock;
+  const int kPoints = 1000000;
+  auto path = MakeTrackDb("track_point_writer_bench.db");
+
+  auto t0 = clock::now();
+  {
+    TrackPointWriter writer(path);
+    ASSERT_TRUE(writer.IsOk());
+    for (int i = 0; i < kPoints; i++) {
+      writer.Add({"trk", 59.0 + i * 1e-6, 18.0 + i * 1e-6,
+                  "2025-06-01T12:00:00Z", i});
+    }
+    writer.Flush();
+    EXPECT_EQ(writer.GetWrittenCount(), static_cast<uint64_t>(kPoints));
+  }
+  std::chrono::duration<double> s = clock::now() - t0;
+  EXPECT_EQ(ReadTrackDb(path).first, kPoints);
+  RecordProperty("wall_ms", std::to_string(s.count() * 1000));
+  RecordProperty("points_per_s", std::to_string(kPoints / s.count()));
+}
+
+/**
+ * Points per second importing a 1M point track as NavObj_dB::InsertTrack()
+ * does, in one transaction on the main connection, while another track is
+ * recorded. Only the database part of a GPX import is timed, parsing the
+ * GPX file and the NavObj_dB singleton are left out. Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(TrackPointWriter, DISABLED_ImportBenchmark) {
+  using clock = std::chrono::steady_clock;
+  const int kPoints = 1000000;
+  auto path = MakeTrackDb("track_point_import_bench.db");
+
+  std::vector<TrackPoint*> points;
+  for (int i = 0; i < kPoints; i++) {
+    points.push_back(new TrackPoint(59.0 + i * 1e-6, 18.0 + i * 1e-6,
+                                    "2025-06-01T12:00:00Z"));
+  }
+  sqlite3* db;
+  sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE, nullptr);
+  sqlite3_busy_timeout(db, 10000);
+  sqlite3_exec(db, "PRAGMA foreign_keys = ON;", nullptr, nullptr, nullptr);
+  sqlite3_stmt* stmt = nullptr;
+  sqlite3_prepare_v2(db, TrackPointWriter::GetInsertSql(), -1, &stmt,
+                     nullptr);
+
+  //  The recorded track is committed in small batches during the import
+  TrackPointWriter writer(path, std::chrono::milliseconds(1), 10);
+  std::atomic<bool> done(false);
+  std::thread recorder([&] {
+    for (int i = 0; !done; i++) {
+      writer.Add({"trk", 60.0, 18.0, "2025-06-01T13:00:00Z", i});
+      std::this_thread::sleep_for(1ms);
+    }
+  });
+
+  auto t0 = clock::now();
+  int begin = sqlite3_exec(db, "BEGIN IMMEDIATE", nullptr, nullptr, nullptr);
+  sqlite3_exec(db, "INSERT INTO tracks (guid) VALUES ('imp')", nullptr,
+               nullptr, nullptr);
+  int failed = TrackPointWriter::InsertTrackPoints(stmt, "imp", points);
+  int commit = sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr);
+  std::chrono::duration<double> s = clock::now() - t0;
+
+  done = true;
+  recorder.join();
+  writer.Flush();
+  EXPECT_EQ(begin, SQLITE_OK);
+  EXPECT_EQ(failed, 0);
+  EXPECT_EQ(commit, SQLITE_OK);
+  EXPECT_TRUE(writer.TakeErrors().empty());
+  EXPECT_GT(writer.GetWrittenCount(), 0u);
+
+  sqlite3_finalize(stmt);
+  sqlite3_prepare_v2(db,
+                     "SELECT count(*) FROM trk_points WHERE track_guid = 'imp'",
+                     -1, &stmt, nullptr);
+  sqlite3_step(stmt);
+  EXPECT_EQ(sqlite3_column_int(stmt, 0), kPoints);
+  sqlite3_finalize(stmt);
+  sqlite3_close_v2(db);
+  for (auto point : points) delete point;
+
+  RecordProperty("wall_ms", std::to_string(s.count() * 1000));
+  RecordProperty("points_per_s", std::to_string(kPoints / s.count()));
+}
+
+/** SENTENCE::Field() as it was, rescanning the sentence for each field. */
+static std::string ScanField(const std::string& sentence, int n) {
+  std::string field;
+  size_t index = 1;
+  int current = 0;
+  while (current < n && index < sentence.size()) {
+    if (sentence[index] == ',' || sentence[index] == '*') current++;
+    if (sentence[index] == '*') field += '*';
+    index++;
+  }
+  if (current == n) {
+    while (index < sentence.size() && sentence[index] != ',' &&
+           sentence[index] != '*' && sentence[index] != 0) {
+      field += sentence[index++];
+    }
+  }
+  return field;
+}
+
+TEST(FieldTokenizer, MatchesFieldScan) {
+  std::mt19937 rng(1234);
+  const std::string chars = "$,,,,ab1.N";
+  FieldTokenizer fields;
+  for (int i = 0; i < 2000; i++) {
+    // Random sentences, some with more fields than recorded. At most one
+    // '*' with no separator after it, as in all real sentences.
+    std::string s;
+    const int length = rng() % (i % 10 == 0 ? 400 : 90);
+    for (int j = 0; j < length; j++) s += chars[rng() % chars.size()];
+    if (i % 7 == 0 && !s.empty()) s[rng() % s.size()] = '\0';
+    if (i % 3 == 0) s += "*4F\r\n";
+    fields.Split(s);
+    const int count = fields.GetCount();
+    for (int n = -1; n < count + 3; n++) {
+      ASSERT_EQ(std::string(fields.Get(n)), ScanField(s, n)) << s << " " << n;
+    }
+    const size_t star = s.find('*', 1);
+    const std::string data = s.substr(0, star);
+    EXPECT_EQ(fields.GetNumberOfDataFields(),
+              std::count(data.begin() + !data.empty(), data.end(), ','));
+  }
+}
+
+TEST(FieldTokenizer, Numbers) {
+  for (const char* s : {"0", "5800.602", "-01145.789", "+12.", ".5", "1.5e3",
+                        "12.5abc", "0x1A", " 7", "-", "*", "00000000000.125",
+                        "0.1234567890123456789", "1e30",
+                        "3.14159265358979323846"}) {
+    EXPECT_EQ(FieldTokenizer::ToDouble(s), std::atof(s)) << s;
+    EXPECT_EQ(FieldTokenizer::ToInt(s), std::atoi(s)) << s;
+  }
+  EXPECT_TRUE(std::isnan(FieldTokenizer::ToDouble("")));
+  std::mt19937 rng(99);
+  for (int i = 0; i < 100000; i++) {
+    const std::string s = std::to_string(rng() % 100000) + "." +
+                          std::to_string(rng() % 1000000);
+    ASSERT_EQ(FieldTokenizer::ToDouble(s), std::atof(s.c_str())) << s;
+  }
+}
+
+static const std::string kRmc =
+    "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A"
+    "\r\n";
+static const std::string kGga =
+    "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+static const std::string kGsv =
+    "$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75"
+    "\r\n";
+static const std::string kVtg = "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*48\r\n";
+
+TEST(FieldTokenizer, DecodeSentences) {
+  CommDecoder decoder;
+  NavData data = {};
+  ASSERT_TRUE(decoder.DecodeRMC(kRmc, data));
+  EXPECT_NEAR(data.gLat, 48.1173, 1e-4);
+  EXPECT_NEAR(data.gLon, 11.5167, 1e-4);
+  EXPECT_DOUBLE_EQ(data.gSog, 22.4);
+  EXPECT_DOUBLE_EQ(data.gCog, 84.4);
+  EXPECT_DOUBLE_EQ(data.gVar, -3.1);
+
+  data = {};
+  ASSERT_TRUE(decoder.DecodeGGA(kGga, data));
+  EXPECT_NEAR(data.gLat, 48.1173, 1e-4);
+  EXPECT_NEAR(data.gLon, 11.5167, 1e-4);
+  EXPECT_EQ(data.n_satellites, 8);
+
+  data = {};
+  ASSERT_TRUE(decoder.DecodeGSV(kGsv, data));
+  EXPECT_EQ(data.n_satellites, 8);
+
+  data = {};
+  ASSERT_TRUE(decoder.DecodeVTG(kVtg, data));
+  EXPECT_DOUBLE_EQ(data.gSog, 5.5);
+}
+
+/**
+ * NMEA 0183 sentences decoded per second. Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(FieldTokenizer, DISABLED_Benchmark) {
+  using clock = std::chrono::steady_clock;
+  CommDecoder decoder;
+  NavData data = {};
+  const int kRounds = 50000;
+  int decoded = 0;
+  auto t0 = clock::now();
+  for (int i = 0; i < kRounds; i++) {
+    decoded += decoder.DecodeRMC(kRmc, data);
+    decoded += decoder.DecodeGGA(kGga, data);
+    decoded += decoder.DecodeGSV(kGsv, data);
+    decoded += decoder.DecodeVTG(kVtg, data);
+  }
+  std::chrono::duration<double> s = clock::now() - t0;
+  EXPECT_EQ(decoded, 4 * kRounds);
+  RecordProperty("sentences_per_s", std::to_string(4 * kRounds / s.count()));
+}
+
+/** Feed frame to map as the N2K drivers do, return true if msg is done. */
+static bool ReplayCanFrame(FastMessageMap& map, const can_frame& frame,
+                           std::vector<unsigned char>& msg) {
+  CanHeader header(frame);
+  int position = -1;
+  bool ready = true;
+  if (header.IsFastMessage()) {
+    position = map.FindMatchingEntry(header, frame.data[0]);
+    if (position < 0) {
+      if ((frame.data[0] & 0x1F) != 0) return false;
+      position = map.AddNewEntry();
+      ready = map.InsertEntry(header, frame.data, position);
+    } else {
+      ready = map.AppendEntry(header, frame.data, position);
+    }
+  }
+  if (!ready) return false;
+  if (position < 0) {
+    msg = MakeN2kDriverMsg(header, frame.data, CAN_MAX_DLEN);
+  } else {
+    msg = MakeN2kDriverMsg(header, map[position].data.data(),
+                           map[position].expected_length);
+    map.Remove(position);
+  }
+  return true;
+}
+
+/** Split payload into the frames of a fast message. */
+static std::vector<can_frame> MakeFastFrames(
+    int pgn, int source, int seq, const std::vector<unsigned char>& payload) {
+  std::vector<can_frame> frames;
+  size_t pos = 0;
+  for (int counter = 0; pos < payload.size() || counter == 0; counter++) {
+    can_frame frame = {};
+    frame.can_id = BuildCanID(3, source, 255, pgn);
+    frame.can_dlc = 8;
+    frame.data[0] = seq << 5 | counter;
+    int first = 1;
+    if (counter == 0) {
+      frame.data[1] = payload.size();
+      first = 2;
+    }
+    for (int i = first; i < 8; i++) {
+      frame.data[i] = pos < payload.size() ? payload[pos++] : 0xFF;
+    }
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+static std::vector<unsigned char> MakePayload(size_t size, int seed) {
+  std::vector<unsigned char> payload(size);
+  for (size_t i = 0; i < size; i++) payload[i] = (seed * 31 + i * 7) & 0xFF;
+  return payload;
+}
+
+TEST(FastMessageMap, Reassembly) {
+  FastMessageMap map;
+  std::vector<unsigned char> msg;
+
+  // Interleaved messages from three sources, same PGN and sequence.
+  std::vector<std::vector<can_frame>> messages;
+  for (int source = 1; source <= 3; source++) {
+    messages.push_back(
+        MakeFastFrames(129029, source, 2, MakePayload(43, source)));
+  }
+  int done = 0;
+  for (size_t i = 0; i < messages[0].size(); i++) {
+    for (int m = 0; m < 3; m++) {
+      if (!ReplayCanFrame(map, messages[m][i], msg)) continue;
+      done++;
+      ASSERT_EQ(msg.size(), 13u + 43 + 1);
+      EXPECT_EQ(msg[7], m + 1);  // source
+      EXPECT_EQ(msg[12], 43);
+      const auto expected = MakePayload(43, m + 1);
+      EXPECT_TRUE(std::equal(expected.begin(), expected.end(), &msg[13]));
+    }
+  }
+  EXPECT_EQ(done, 3);
+  EXPECT_EQ(map.GetCount(), 0u);
+
+  // A dropped frame drops the message.
+  auto frames = MakeFastFrames(129038, 5, 1, MakePayload(28, 5));
+  frames.erase(frames.begin() + 2);
+  for (const auto& frame : frames) {
+    EXPECT_FALSE(ReplayCanFrame(map, frame, msg));
+  }
+  EXPECT_EQ(map.GetCount(), 0u);
+
+  // A new start frame restarts an incomplete message.
+  frames = MakeFastFrames(129038, 5, 1, MakePayload(28, 6));
+  EXPECT_FALSE(ReplayCanFrame(map, frames[0], msg));
+  EXPECT_FALSE(ReplayCanFrame(map, frames[1], msg));
+  bool ready = false;
+  for (const auto& frame : frames) ready = ReplayCanFrame(map, frame, msg);
+  EXPECT_TRUE(ready);
+  EXPECT_EQ(msg[12], 28);
+  EXPECT_EQ(map.GetCount(), 0u);
+
+  // Single frame messages pass through.
+  can_frame frame = {};
+  frame.can_id = BuildCanID(2, 7, 255, 127488);
+  frame.can_dlc = 8;
+  EXPECT_TRUE(ReplayCanFrame(map, frame, msg));
+  EXPECT_EQ(msg.size(), 13u + 8 + 1);
+  EXPECT_EQ(msg[1], 0x13);
+}
+
+/**
+ * Frames per second replaying busy backbone traffic. Run with
+ * --gtest_also_run_disabled_tests.
+ */
+TEST(FastMessageMap, DISABLED_Benchmark) {
+  using clock = std::chrono::steady_clock;
+
+  // Engine and position rapid updates, GNSS and AIS fast messages from
+  // many transmitters, frames of concurrent messages interleaved.
+  std::vector<can_frame> frames;
+  int messages = 0;
+  for (int round = 0; round < 32; round++) {
+    std::vector<std::vector<can_frame>> batch;
+    for (int source = 0; source < 24; source++) {
+      const int pgn = source % 3 == 0 ? 129029 : source % 3 == 1 ? 129038
+                                                                 : 129039;
+      const size_t size = pgn == 129029 ? 43 : pgn == 129038 ? 28 : 27;
+      batch.push_back(MakeFastFrames(pgn, 10 + source, round % 8,
+                                     MakePayload(size, round + source)));
+    }
+    for (int source = 0; source < 8; source++) {
+      can_frame frame = {};
+      frame.can_id =
+          BuildCanID(2, 40 + source, 255, source % 2 ? 129025 : 127488);
+      frame.can_dlc = 8;
+      batch.push_back({frame});
+    }
+    messages += batch.size();
+    for (size_t i = 0; i < 7; i++) {
+      for (const auto& message : batch) {
+        if (i < message.size()) frames.push_back(message[i]);
+      }
+    }
+  }
+
+  const int kRounds = 2000;
+  FastMessageMap map;
+  std::vector<unsigned char> msg;
+  int done = 0;
+  auto t0 = clock::now();
+  for (int i = 0; i < kRounds; i++) {
+    for (const auto& frame : frames) done += ReplayCanFrame(map, frame, msg);
+  }
+  std::chrono::duration<double> s = clock::now() - t0;
+  EXPECT_EQ(done, kRounds * messages);
+  EXPECT_EQ(map.GetCount(), 0u);
+  RecordProperty("frames_per_s", std::to_string(kRounds * frames.size() /
+                                                s.count()));
+}